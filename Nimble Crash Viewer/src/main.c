@@ -0,0 +1,646 @@
+/*
+*  main.c
+*  Nimble Engine
+*
+*  Created by Avery Aaron on 2020-08-09.
+*  Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+*
+*/
+
+#ifndef _WIN32
+#  define _POSIX_C_SOURCE 200809L /* Needed for fdopen(). */
+#endif
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#  include <io.h>
+#  include <process.h>
+#else
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#include <Nimble/Errors/CrashDump.h>
+
+
+#define MODULES_MAX 1024 /* The maximum number of modules read from the maps. */
+#define PATH_MAX_LEN 1024 /* The maximum length of a module path. */
+#define SYMBOL_MAX 512 /* The maximum length of a symbolized frame. */
+#define NS_IN_SEC UINT64_C(1000000000) /* Nanoseconds in a second. */
+
+static const char *const x86_64Names[] = {
+    "rax", "rbx", "rcx", "rdx", "rsi", "rdi", "rbp", "rsp",
+    "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
+    "rip", "eflags"
+};
+
+static const char *const aarch64Names[] = {
+    "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7",
+    "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+    "x16", "x17", "x18", "x19", "x20", "x21", "x22", "x23",
+    "x24", "x25", "x26", "x27", "x28", "fp", "lr", "sp",
+    "pc", "pstate"
+};
+
+/**
+ * @brief The options given on the command line.
+ */
+typedef struct options {
+    const char *pathStr;
+    const char *logStr; /* The file to write the log section to, or NULL. */
+    int symbols;
+    int memory;
+    int maps;
+} options_t;
+
+/**
+ * @brief A file mapped into the crashed process.
+ */
+typedef struct module {
+    uint64_t start;
+    uint64_t end;
+    uint64_t base; /* The start of the module's mapping at offset 0. */
+    int dynamic; /* Whether addresses are relative to base (ET_DYN). */
+    char pathStr[PATH_MAX_LEN];
+} module_t;
+
+/**
+ * @brief The modules of the crashed process.
+ */
+typedef struct modules {
+    module_t list[MODULES_MAX];
+    int count;
+} modules_t;
+
+/**
+ * @brief A section read from the dump.
+ */
+typedef struct section {
+    nCrashSection_t header;
+    const uint8_t *data;
+} section_t;
+
+
+static void usage(const char *const nameStr)
+{
+    fprintf(stderr, "Usage: %s [options] <file>\n"
+     "  -s, --no-symbols     Print addresses as module+offset without running "
+     "addr2line.\n"
+     "  -m, --memory         Print the stack memory of the crashed thread as "
+     "hex.\n"
+     "  -M, --maps           Print the memory maps of the process.\n"
+     "  -l, --log <file>     Write the unwritten log records of the dump to a "
+     "binary log file.\n", nameStr);
+}
+
+static int parseOptions(const int argc, char **argv, options_t *const options)
+{
+    options->pathStr = NULL;
+    options->logStr = NULL;
+    options->symbols = 1;
+    options->memory = 0;
+    options->maps = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (!strcmp(arg, "-s") || !strcmp(arg, "--no-symbols"))
+        {
+            options->symbols = 0;
+        }
+        else if (!strcmp(arg, "-m") || !strcmp(arg, "--memory"))
+        {
+            options->memory = 1;
+        }
+        else if (!strcmp(arg, "-M") || !strcmp(arg, "--maps"))
+        {
+            options->maps = 1;
+        }
+        else if (!strcmp(arg, "-l") || !strcmp(arg, "--log"))
+        {
+            if (i + 1 >= argc)
+            {
+                fprintf(stderr, "Missing value of %s.\n", arg);
+                return 0;
+            }
+            options->logStr = argv[++i];
+        }
+        else if (!strcmp(arg, "-h") || !strcmp(arg, "--help"))
+        {
+            return 0;
+        }
+        else if ((arg[0] != '-') || !arg[1])
+        {
+            if (options->pathStr) return 0;
+            options->pathStr = arg;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return 0;
+        }
+    }
+    return options->pathStr != NULL;
+}
+
+/* Reads the whole file at pathStr. Returns NULL on failure. */
+static uint8_t *readFile(const char *const pathStr, size_t *const len)
+{
+    FILE *file = fopen(pathStr, "rb");
+    if (!file) return NULL;
+
+    uint8_t *data = NULL;
+    size_t cap = 0;
+    *len = 0;
+    for (;;)
+    {
+        if (*len == cap)
+        {
+            cap = cap ? cap * 2 : 65536;
+            uint8_t *newData = realloc(data, cap);
+            if (!newData)
+            {
+                free(data);
+                fclose(file);
+                return NULL;
+            }
+            data = newData;
+        }
+        const size_t got = fread(data + *len, 1, cap - *len, file);
+        *len += got;
+        if (!got) break;
+    }
+    const int failed = ferror(file);
+    fclose(file);
+    if (failed)
+    {
+        free(data);
+        return NULL;
+    }
+    return data;
+}
+
+/* Gets the next section of the dump. Returns 0 at the end of the dump, which
+ * may be cut short if the crashed process faulted again while writing it. */
+static int nextSection(const uint8_t *const data, const size_t len,
+ size_t *const pos, section_t *const section)
+{
+    if (*pos + sizeof(nCrashSection_t) > len) return 0;
+    memcpy(&section->header, data + *pos, sizeof(nCrashSection_t));
+    *pos += sizeof(nCrashSection_t);
+    if (section->header.len > len - *pos)
+    {
+        section->header.len = (uint32_t) (len - *pos);
+    }
+    section->data = data + *pos;
+    *pos += section->header.len;
+    return 1;
+}
+
+/* Checks whether the ELF file at pathStr is position independent. */
+static int isDynamic(const char *const pathStr)
+{
+    FILE *file = fopen(pathStr, "rb");
+    if (!file) return 1;
+    uint8_t ident[18];
+    const size_t got = fread(ident, 1, sizeof(ident), file);
+    fclose(file);
+    if ((got < sizeof(ident)) || memcmp(ident, "\177ELF", 4)) return 1;
+    /* e_type follows the 16 bytes of e_ident, in the file's byte order. */
+    const unsigned type = (ident[5] == 2) ? ((unsigned) ident[16] << 8) |
+     ident[17] : ((unsigned) ident[17] << 8) | ident[16];
+    return type != 2; /* ET_EXEC */
+}
+
+/* Reads the file backed mappings of the maps text. */
+static void parseMaps(const section_t *const section, modules_t *const modules)
+{
+    const char *line = (const char *) section->data;
+    const char *const end = line + section->header.len;
+    modules->count = 0;
+    while ((line < end) && (modules->count < MODULES_MAX))
+    {
+        const char *next = memchr(line, '\n', (size_t) (end - line));
+        if (!next) next = end;
+
+        char lineStr[PATH_MAX_LEN + 128];
+        const size_t lineLen = ((size_t) (next - line) < sizeof(lineStr) - 1) ?
+         (size_t) (next - line) : sizeof(lineStr) - 1;
+        memcpy(lineStr, line, lineLen);
+        lineStr[lineLen] = '\0';
+        line = next + 1;
+
+        unsigned long long start, stop, offset;
+        char perms[8];
+        int pathPos = 0;
+        if (sscanf(lineStr, "%llx-%llx %7s %llx %*s %*s %n", &start, &stop,
+         perms, &offset, &pathPos) < 4 || !pathPos) continue;
+        const char *pathStr = lineStr + pathPos;
+        if (pathStr[0] != '/') continue;
+
+        module_t *const module = &modules->list[modules->count++];
+        module->start = start;
+        module->end = stop;
+        module->base = start - offset;
+        snprintf(module->pathStr, PATH_MAX_LEN, "%s", pathStr);
+
+        /* Modules are mapped in segments, the first at offset 0. */
+        const module_t *first = NULL;
+        for (int i = 0; (i < modules->count - 1) && !first; i++)
+        {
+            if (!strcmp(modules->list[i].pathStr, module->pathStr))
+            {
+                first = &modules->list[i];
+            }
+        }
+        module->base = first ? first->base : module->base;
+        module->dynamic = first ? first->dynamic : isDynamic(pathStr);
+    }
+}
+
+static const module_t *findModule(const modules_t *const modules,
+ const uint64_t addr)
+{
+    for (int i = 0; i < modules->count; i++)
+    {
+        if ((addr >= modules->list[i].start) && (addr < modules->list[i].end))
+        {
+            return &modules->list[i];
+        }
+    }
+    return NULL;
+}
+
+/* Starts addr2line on addrStr in pathStr, reading its output from a pipe.
+ * The path comes from the dump, so it is passed as an argument rather than
+ * through a shell. Returns the output, or NULL if it could not be started. */
+static FILE *addr2lineOpen(const char *const pathStr, const char *const addrStr,
+ intptr_t *const child)
+{
+#ifdef _WIN32
+    /* The arguments are joined into one command line, so the path is quoted,
+     * and cannot contain quotes of its own. */
+    char quotedStr[PATH_MAX_LEN + 3];
+    if (strchr(pathStr, '"')) return NULL;
+    snprintf(quotedStr, sizeof(quotedStr), "\"%s\"", pathStr);
+    const char *const argv[] = {
+        "addr2line", "-f", "-C", "-e", quotedStr, addrStr, NULL
+    };
+
+    int fds[2];
+    if (_pipe(fds, 4096, _O_TEXT | _O_NOINHERIT)) return NULL;
+    fflush(stdout);
+    const int out = _dup(1);
+    if (out < 0)
+    {
+        _close(fds[0]);
+        _close(fds[1]);
+        return NULL;
+    }
+    _dup2(fds[1], 1);
+    *child = _spawnvp(_P_NOWAIT, argv[0], argv);
+    _dup2(out, 1);
+    _close(out);
+    _close(fds[1]);
+    if (*child == -1)
+    {
+        _close(fds[0]);
+        return NULL;
+    }
+
+    FILE *stream = _fdopen(fds[0], "r");
+    if (!stream)
+    {
+        _close(fds[0]);
+        _cwait(NULL, *child, 0);
+    }
+    return stream;
+#else
+    int fds[2];
+    if (pipe(fds)) return NULL;
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return NULL;
+    }
+    if (!pid)
+    {
+        dup2(fds[1], STDOUT_FILENO);
+        const int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) dup2(null, STDERR_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        char *const argv[] = {
+            "addr2line", "-f", "-C", "-e", (char *) pathStr, (char *) addrStr,
+            NULL
+        };
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+    close(fds[1]);
+    *child = pid;
+
+    FILE *stream = fdopen(fds[0], "r");
+    if (!stream)
+    {
+        close(fds[0]);
+        waitpid(pid, NULL, 0);
+    }
+    return stream;
+#endif
+}
+
+/* Closes the output of addr2line and waits for it to exit. */
+static void addr2lineClose(FILE *const pipe, const intptr_t child)
+{
+    fclose(pipe);
+#ifdef _WIN32
+    _cwait(NULL, child, 0);
+#else
+    waitpid((pid_t) child, NULL, 0);
+#endif
+}
+
+/* Symbolizes addr with addr2line. Returns 0 if it could not. */
+static int symbolize(const module_t *const module, const uint64_t addr,
+ char *const symbolStr)
+{
+    const uint64_t vaddr = module->dynamic ? addr - module->base : addr;
+    char addrStr[32];
+    snprintf(addrStr, sizeof(addrStr), "0x%" PRIx64, vaddr);
+    intptr_t child;
+    FILE *pipe = addr2lineOpen(module->pathStr, addrStr, &child);
+    if (!pipe) return 0;
+
+    char functionStr[SYMBOL_MAX / 2], lineStr[SYMBOL_MAX / 4];
+    const int ok = fgets(functionStr, sizeof(functionStr), pipe) &&
+     fgets(lineStr, sizeof(lineStr), pipe);
+    addr2lineClose(pipe, child);
+    if (!ok) return 0;
+    functionStr[strcspn(functionStr, "\r\n")] = '\0';
+    lineStr[strcspn(lineStr, "\r\n")] = '\0';
+    if (!strcmp(functionStr, "??")) return 0;
+
+    if (!strncmp(lineStr, "??", 2))
+    {
+        snprintf(symbolStr, SYMBOL_MAX, "%s", functionStr);
+    }
+    else
+    {
+        const char *fileStr = strrchr(lineStr, '/');
+        snprintf(symbolStr, SYMBOL_MAX, "%s (%s)", functionStr,
+         fileStr ? fileStr + 1 : lineStr);
+    }
+    return 1;
+}
+
+static void printFrame(const options_t *const options,
+ const modules_t *const modules, const uint32_t level, const uint64_t addr)
+{
+    /* Return addresses point after the call, so look up the call itself. */
+    const uint64_t lookup = level ? addr - 1 : addr;
+    const module_t *const module = findModule(modules, lookup);
+    printf("  #%-3" PRIu32 " 0x%016" PRIx64, level, addr);
+    if (!module)
+    {
+        printf("\n");
+        return;
+    }
+
+    const char *nameStr = strrchr(module->pathStr, '/');
+    nameStr = nameStr ? nameStr + 1 : module->pathStr;
+    char symbolStr[SYMBOL_MAX];
+    if (options->symbols && symbolize(module, lookup, symbolStr))
+    {
+        printf(" %s in %s\n", symbolStr, nameStr);
+    }
+    else
+    {
+        printf(" %s+0x%" PRIx64 "\n", nameStr, addr - module->base);
+    }
+}
+
+static void printInfo(const section_t *const section)
+{
+    nCrashInfo_t info;
+    if (section->header.len < sizeof(info)) return;
+    memcpy(&info, section->data, sizeof(info));
+
+    const time_t secs = (time_t) (info.time / NS_IN_SEC);
+    char timeStr[32] = "?";
+    const struct tm *tm = localtime(&secs);
+    if (tm) strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", tm);
+
+    printf("Crashed at %s with signal %" PRId32 " (code %" PRId32 ")",
+     timeStr, info.signal, info.code);
+    if (info.addr) printf(" at address 0x%" PRIx64, info.addr);
+    printf(".\nProcess %" PRIu32 ", thread %" PRIu32 ".\n", info.pid, info.tid);
+}
+
+static void printRegisters(const section_t *const section, const uint32_t arch)
+{
+    nCrashRegisters_t header;
+    if (section->header.len < sizeof(header)) return;
+    memcpy(&header, section->data, sizeof(header));
+    printf("\nRegisters of thread %" PRIu32 ":\n", header.tid);
+
+    const char *const *names = NULL;
+    uint32_t nameCount = 0;
+    if (arch == NCRASH_ARCH_X86_64)
+    {
+        names = x86_64Names;
+        nameCount = sizeof(x86_64Names) / sizeof(x86_64Names[0]);
+    }
+    else if (arch == NCRASH_ARCH_AARCH64)
+    {
+        names = aarch64Names;
+        nameCount = sizeof(aarch64Names) / sizeof(aarch64Names[0]);
+    }
+
+    const uint32_t max = (section->header.len - sizeof(header)) /
+     sizeof(uint64_t);
+    const uint32_t count = (header.count < max) ? header.count : max;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64_t value;
+        memcpy(&value, section->data + sizeof(header) + (i * sizeof(value)),
+         sizeof(value));
+        char nameStr[16];
+        if (i < nameCount) snprintf(nameStr, sizeof(nameStr), "%s", names[i]);
+        else snprintf(nameStr, sizeof(nameStr), "r%" PRIu32, i);
+        printf("  %6s 0x%016" PRIx64 "%s", nameStr, value,
+         ((i % 3) == 2) || (i + 1 == count) ? "\n" : "");
+    }
+}
+
+static void printStack(const options_t *const options,
+ const modules_t *const modules, const section_t *const section,
+ const uint32_t crashedTid)
+{
+    nCrashStack_t header;
+    if (section->header.len < sizeof(header)) return;
+    memcpy(&header, section->data, sizeof(header));
+
+    printf("\nThread %" PRIu32 " \"%.*s\"%s:\n", header.tid,
+     (int) sizeof(header.name), header.name,
+     (header.tid == crashedTid) ? " (crashed)" : "");
+    const uint32_t max = (section->header.len - sizeof(header)) /
+     sizeof(uint64_t);
+    const uint32_t levels = (header.levels < max) ? header.levels : max;
+    for (uint32_t i = 0; i < levels; i++)
+    {
+        uint64_t addr;
+        memcpy(&addr, section->data + sizeof(header) + (i * sizeof(addr)),
+         sizeof(addr));
+        printFrame(options, modules, i, addr);
+    }
+}
+
+static void printMemory(const section_t *const section)
+{
+    nCrashMemory_t header;
+    if (section->header.len < sizeof(header)) return;
+    memcpy(&header, section->data, sizeof(header));
+
+    const uint8_t *const bytes = section->data + sizeof(header);
+    const uint64_t len = section->header.len - sizeof(header);
+    printf("Stack memory, %" PRIu64 " bytes at 0x%" PRIx64 ":\n", len,
+     header.addr);
+    for (uint64_t i = 0; i < len; i += 16)
+    {
+        printf("  %016" PRIx64 " ", header.addr + i);
+        for (uint64_t j = i; (j < i + 16) && (j < len); j++)
+        {
+            printf(" %02x", bytes[j]);
+        }
+        printf("\n");
+    }
+}
+
+static int writeLog(const char *const pathStr, const section_t *const section)
+{
+    FILE *file = fopen(pathStr, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open %s.\n", pathStr);
+        return 0;
+    }
+    const int ok = (fwrite(section->data, 1, section->header.len, file) ==
+     section->header.len);
+    if (fclose(file) || !ok)
+    {
+        fprintf(stderr, "Failed to write %s.\n", pathStr);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    options_t options;
+    if (!parseOptions(argc, argv, &options))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t len;
+    uint8_t *data = readFile(options.pathStr, &len);
+    if (!data)
+    {
+        fprintf(stderr, "Failed to read %s.\n", options.pathStr);
+        return EXIT_FAILURE;
+    }
+
+    nCrashDumpHeader_t header;
+    if ((len < sizeof(header)) || (memcpy(&header, data, sizeof(header)),
+     memcmp(header.magic, NCRASH_DUMP_MAGIC, sizeof(header.magic))) ||
+     (header.version != NCRASH_DUMP_VERSION))
+    {
+        fprintf(stderr, "%s is not a crash dump.\n", options.pathStr);
+        free(data);
+        return EXIT_FAILURE;
+    }
+    if (header.order != NCRASH_DUMP_ORDER)
+    {
+        fprintf(stderr, "%s was written on a machine of another byte order.\n",
+         options.pathStr);
+        free(data);
+        return EXIT_FAILURE;
+    }
+
+    /* The maps and info are needed before the stacks can be printed. */
+    static modules_t modules;
+    modules.count = 0;
+    nCrashInfo_t info;
+    memset(&info, 0, sizeof(info));
+    section_t section;
+    size_t pos = sizeof(header);
+    while (nextSection(data, len, &pos, &section))
+    {
+        if (section.header.kind == NCRASH_SECTION_MAPS)
+        {
+            parseMaps(&section, &modules);
+        }
+        else if ((section.header.kind == NCRASH_SECTION_INFO) &&
+         (section.header.len >= sizeof(info)))
+        {
+            memcpy(&info, section.data, sizeof(info));
+        }
+    }
+
+    int ret = EXIT_SUCCESS;
+    pos = sizeof(header);
+    while (nextSection(data, len, &pos, &section))
+    {
+        switch (section.header.kind)
+        {
+            case NCRASH_SECTION_INFO:
+                printInfo(&section);
+                break;
+            case NCRASH_SECTION_REGISTERS:
+                printRegisters(&section, info.arch);
+                break;
+            case NCRASH_SECTION_STACK:
+                printStack(&options, &modules, &section, info.tid);
+                break;
+            case NCRASH_SECTION_MEMORY:
+                if (options.memory)
+                {
+                    printf("\n");
+                    printMemory(&section);
+                }
+                break;
+            case NCRASH_SECTION_MAPS:
+                if (options.maps)
+                {
+                    printf("\nMemory maps:\n%.*s", (int) section.header.len,
+                     (const char *) section.data);
+                }
+                break;
+            case NCRASH_SECTION_LOG:
+                if (options.logStr && !writeLog(options.logStr, &section))
+                {
+                    ret = EXIT_FAILURE;
+                }
+                break;
+            default:
+                /* Sections of newer writers are skipped. */
+                break;
+        }
+    }
+
+    free(data);
+    return ret;
+}
+
+// main.c
@@ -0,0 +1,222 @@
+/*
+ * Bench.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../include/Nimble/NimbleLicense.h"
+#include "Bench.h"
+
+/**
+ * @file Bench.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the microbenchmark harness.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/Nimble/Errors/Errors.h"
+#include "../include/Nimble/System/CPUInfo.h"
+#include "../include/Nimble/System/Memory.h"
+#include "../include/Nimble/System/Time.h"
+
+static int nBenchCompare(const void *a, const void *b)
+{
+    const double x = *(const double *) a;
+    const double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* Gets the value at fraction q of sorted values, interpolating between the
+ * nearest two. */
+static double nBenchQuantile(const double *const values, const uint32_t count,
+ const double q)
+{
+    const double pos = q * (double) (count - 1);
+    const uint32_t low = (uint32_t) pos;
+    if (low + 1 >= count) return values[count - 1];
+    return values[low] + ((pos - (double) low) * (values[low + 1] -
+     values[low]));
+}
+
+int nBenchRun(const nBench_t *const bench, uint32_t repetitions,
+ nBenchResult_t *const result)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "bench argument was NULL in nBenchRun()."
+    if (nErrorAssert(
+     (bench != NULL) && (bench->run != NULL),
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#  define einfoStr "result argument was NULL in nBenchRun()."
+    if (nErrorAssert(
+     result != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    if (!repetitions) repetitions = NBENCH_REPETITIONS;
+    void *data = bench->setup ? bench->setup() : NULL;
+
+    /* Warm the caches, branch predictors and CPU frequency, doubling the
+     * iterations until a batch takes long enough to time precisely. */
+    uint64_t iterations = 1;
+    const uint64_t warmupEnd = nTimeMonotonic() + NBENCH_WARMUP_NS;
+    for (;;)
+    {
+        const uint64_t start = nTimeMonotonic();
+        bench->run(data, iterations);
+        const uint64_t now = nTimeMonotonic();
+        if ((now - start) < NBENCH_BATCH_NS) iterations *= 2;
+        else if (now >= warmupEnd) break;
+    }
+
+    double *nanos = nAlloc(repetitions * sizeof(double));
+    double *cycles = nAlloc(repetitions * sizeof(double));
+    double sum = 0;
+    for (uint32_t i = 0; i < repetitions; i++)
+    {
+        const uint64_t startTicks = nTicksRaw();
+        const uint64_t start = nTimeMonotonic();
+        bench->run(data, iterations);
+        const uint64_t end = nTimeMonotonic();
+        const uint64_t endTicks = nTicksRaw();
+        nanos[i] = (double) (end - start) / (double) iterations;
+        cycles[i] = (double) (endTicks - startTicks) / (double) iterations;
+        sum += nanos[i];
+    }
+    if (bench->teardown) bench->teardown(data);
+
+    result->name = bench->name;
+    result->iterations = iterations;
+    result->repetitions = repetitions;
+    result->meanNs = sum / repetitions;
+    double variance = 0;
+    for (uint32_t i = 0; i < repetitions; i++)
+    {
+        variance += (nanos[i] - result->meanNs) * (nanos[i] - result->meanNs);
+    }
+    result->stddevNs = sqrt(variance / repetitions);
+
+    qsort(nanos, repetitions, sizeof(double), nBenchCompare);
+    qsort(cycles, repetitions, sizeof(double), nBenchCompare);
+    result->minNs = nanos[0];
+    result->medianNs = nBenchQuantile(nanos, repetitions, 0.5);
+    result->p99Ns = nBenchQuantile(nanos, repetitions, 0.99);
+    result->medianCycles = nBenchQuantile(cycles, repetitions, 0.5);
+    result->p99Cycles = nBenchQuantile(cycles, repetitions, 0.99);
+
+    nFree((void **) &nanos);
+    nFree((void **) &cycles);
+    return NSUCCESS;
+}
+
+/* Writes str as a JSON string. */
+static void nBenchWriteString(FILE *const file, const char *str)
+{
+    fputc('"', file);
+    for (; *str; str++)
+    {
+        if ((*str == '"') || (*str == '\\')) fprintf(file, "\\%c", *str);
+        else if ((unsigned char) *str < 0x20) fprintf(file, "\\u%04x", *str);
+        else fputc(*str, file);
+    }
+    fputc('"', file);
+}
+
+int nBenchWriteJSON(FILE *const file, const nBenchResult_t *const results,
+ const size_t count)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "file argument was NULL in nBenchWriteJSON()."
+    if (nErrorAssert(
+     file != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    fputs("{\n  \"context\": {\n    \"cpu\": ", file);
+    nBenchWriteString(file, NCPU_INFO);
+    fprintf(file, ",\n    \"logicalCores\": %u,\n"
+     "    \"tickFrequency\": %" PRIu64 ",\n"
+     "    \"tickCounter\": %s,\n"
+     "    \"timestamp\": %" PRIu64 "\n  },\n  \"benchmarks\": [",
+     NCPU_DETAILS.logicalCores, NTIME_TICK_FREQ,
+     NTIME_TICK_COUNTER ? "true" : "false", (uint64_t) time(NULL));
+    for (size_t i = 0; i < count; i++)
+    {
+        const nBenchResult_t *const r = &results[i];
+        fputs(i ? ",\n    {\n      \"name\": " : "\n    {\n      \"name\": ",
+         file);
+        nBenchWriteString(file, r->name);
+        fprintf(file, ",\n      \"iterations\": %" PRIu64 ",\n"
+         "      \"repetitions\": %u,\n"
+         "      \"minNs\": %.3f,\n"
+         "      \"medianNs\": %.3f,\n"
+         "      \"p99Ns\": %.3f,\n"
+         "      \"meanNs\": %.3f,\n"
+         "      \"stddevNs\": %.3f,\n"
+         "      \"medianCycles\": %.1f,\n"
+         "      \"p99Cycles\": %.1f\n    }",
+         r->iterations, r->repetitions, r->minNs, r->medianNs, r->p99Ns,
+         r->meanNs, r->stddevNs, r->medianCycles, r->p99Cycles);
+    }
+    fputs("\n  ]\n}\n", file);
+    return ferror(file) ? NERROR_IO : NSUCCESS;
+}
+
+void nBenchPrint(FILE *const file, const nBenchResult_t *const results,
+ const size_t count)
+{
+    fprintf(file, "%-28s %12s %12s %12s %12s %12s\n", "Benchmark", "Median ns",
+     "p99 ns", "Min ns", "Stddev ns", "Median cyc");
+    for (size_t i = 0; i < count; i++)
+    {
+        const nBenchResult_t *const r = &results[i];
+        fprintf(file, "%-28s %12.1f %12.1f %12.1f %12.1f %12.1f\n", r->name,
+         r->medianNs, r->p99Ns, r->minNs, r->stddevNs, r->medianCycles);
+    }
+}
+
+// Bench.c
@@ -0,0 +1,153 @@
+#include "../include/Nimble/NimbleLicense.h"
+/*
+ * Bench.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Bench.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the microbenchmark harness.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_BENCH_H
+#define NIMBLE_ENGINE_BENCH_H /**< Header definition */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../include/Nimble/Nimble.h"
+
+#ifndef NBENCH_WARMUP_NS
+#  define NBENCH_WARMUP_NS 50000000 /**< The nanoseconds a benchmark runs before it is measured. */
+#endif
+#ifndef NBENCH_REPETITIONS
+#  define NBENCH_REPETITIONS 101 /**< The default number of measured batches of each benchmark. */
+#endif
+#ifndef NBENCH_BATCH_NS
+#  define NBENCH_BATCH_NS 1000000 /**< The nanoseconds each measured batch should take. */
+#endif
+
+/**
+ * @brief The function run by a benchmark.
+ *
+ * @param[in,out] data The data returned by the benchmark's setup.
+ * @param[in] iterations The number of times to repeat the measured work.
+ */
+typedef void (*nBenchFunc_t)(void *data, uint64_t iterations);
+
+/**
+ * @brief A benchmark.
+ */
+typedef struct nBench {
+    const char *name; /**< The name of the benchmark. */
+    nBenchFunc_t run; /**< The function that repeats the measured work. */
+    void *(*setup)(void); /**< Prepares the data for @c run, or #NULL if unused. */
+    void (*teardown)(void *data); /**< Frees the data from @c setup, or #NULL if unused. */
+} nBench_t;
+
+/**
+ * @brief The statistics of a benchmark, per iteration.
+ */
+typedef struct nBenchResult {
+    const char *name; /**< The name of the benchmark. */
+    uint64_t iterations; /**< The number of iterations in each batch. */
+    uint32_t repetitions; /**< The number of measured batches. */
+    double minNs; /**< The fastest batch's nanoseconds per iteration. */
+    double medianNs; /**< The median nanoseconds per iteration. */
+    double p99Ns; /**< The 99th percentile nanoseconds per iteration. */
+    double meanNs; /**< The mean nanoseconds per iteration. */
+    double stddevNs; /**< The standard deviation of the nanoseconds per iteration. */
+    double medianCycles; /**< The median counter ticks per iteration. */
+    double p99Cycles; /**< The 99th percentile counter ticks per iteration. */
+} nBenchResult_t;
+
+/**
+ * @brief Keeps the compiler from optimizing away the value at @p ptr.
+ *
+ * @param[in] ptr The pointer to the value that must be computed.
+ */
+NIMBLE_INLINE
+void nBenchKeep(const void *ptr)
+{
+    asm volatile("" : : "r" (ptr) : "memory");
+}
+
+/**
+ * @brief Runs a benchmark.
+ *
+ * The benchmark is first run for #NBENCH_WARMUP_NS nanoseconds, which also
+ * finds the number of iterations that take #NBENCH_BATCH_NS nanoseconds. Then
+ * @p repetitions batches of that many iterations are timed with
+ * nTimeMonotonic() and nTicksRaw().
+ *
+ * @param[in] bench The benchmark to run.
+ * @param[in] repetitions The number of batches to time, or 0 for
+ * #NBENCH_REPETITIONS.
+ * @param[out] result The statistics of the batches.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ */
+int nBenchRun(const nBench_t *const bench, uint32_t repetitions,
+ nBenchResult_t *const result);
+
+/**
+ * @brief Writes the results of benchmarks as JSON, for regression tracking.
+ *
+ * @param[in] file The file to write to.
+ * @param[in] results The results to write.
+ * @param[in] count The number of results.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ */
+int nBenchWriteJSON(FILE *const file, const nBenchResult_t *const results,
+ const size_t count);
+
+/**
+ * @brief Prints the results of benchmarks as a table.
+ *
+ * @param[in] file The file to write to.
+ * @param[in] results The results to write.
+ * @param[in] count The number of results.
+ */
+void nBenchPrint(FILE *const file, const nBenchResult_t *const results,
+ const size_t count);
+
+#endif // NIMBLE_ENGINE_BENCH_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Bench.h
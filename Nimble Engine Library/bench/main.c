@@ -0,0 +1,273 @@
+/*
+ * main.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../include/Nimble/NimbleLicense.h"
+#include "Bench.h"
+
+/**
+ * @file main.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This file runs the engine's microbenchmarks.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+#include <unistd.h>
+#endif
+
+#include "../include/Nimble/Errors/Errors.h"
+#include "../include/Nimble/Output/Files.h"
+#include "../include/Nimble/System/CPUInfo.h"
+#include "../include/Nimble/System/Memory.h"
+#include "../include/Nimble/System/Threads.h"
+#include "../include/Nimble/System/Time.h"
+
+#define NBENCH_FILE_SIZE 65536 /**< The size of the file copied by the nFileCopy benchmark. */
+#define NBENCH_FILE_SRC "nimble_bench_src.tmp" /**< The file copied by the nFileCopy benchmark. */
+#define NBENCH_FILE_DST "nimble_bench_dst.tmp" /**< The copy made by the nFileCopy benchmark. */
+
+static void nBenchErrorCallback(const nErrorInfo_t errorInfo)
+{
+    (void) errorInfo;
+}
+
+static void nBenchAlloc(void *data, uint64_t iterations)
+{
+    (void) data;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        void *ptr = nAlloc(64);
+        nBenchKeep(ptr);
+        nFree(&ptr);
+    }
+}
+
+static void *nBenchStringSetup(void)
+{
+    char *str = nAlloc(512);
+    memset(str, 'a', 255);
+    str[255] = '\0';
+    return str;
+}
+
+static void nBenchStringCopy(void *data, uint64_t iterations)
+{
+    char *const str = data;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        nStringCopy(str + 256, str, 255);
+        nBenchKeep(str);
+    }
+}
+
+static void nBenchFree(void *data)
+{
+    nFree(&data);
+}
+
+static void *nBenchFileSetup(void)
+{
+    char *buffer = nAlloc(NBENCH_FILE_SIZE);
+    memset(buffer, 'n', NBENCH_FILE_SIZE);
+    FILE *file = fopen(NBENCH_FILE_SRC, "wb");
+    if (file)
+    {
+        fwrite(buffer, 1, NBENCH_FILE_SIZE, file);
+        fclose(file);
+    }
+    nFree((void **) &buffer);
+    return NULL;
+}
+
+static void nBenchFileCopy(void *data, uint64_t iterations)
+{
+    (void) data;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        nFileCopy(NBENCH_FILE_SRC, NBENCH_FILE_DST);
+    }
+}
+
+static void nBenchFileTeardown(void *data)
+{
+    (void) data;
+    remove(NBENCH_FILE_SRC);
+    remove(NBENCH_FILE_DST);
+}
+
+/* Repeats of the same error are deduplicated by nErrorThrow(), so this
+ * measures the cost of an error thrown in a loop. */
+static void nBenchErrorThrow(void *data, uint64_t iterations)
+{
+    (void) data;
+#define einfoStr "Benchmark error."
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        nErrorThrow(NERROR_INTERNAL_FAILURE, einfoStr, NCONST_STR_LEN(einfoStr),
+         0);
+    }
+#undef einfoStr
+}
+
+static void nBenchErrorStacktrace(void *data, uint64_t iterations)
+{
+    (void) data;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        char *stackStr = nErrorStacktrace(NULL, NULL
+#if NIMBLE_OS == NIMBLE_WINDOWS
+         , NULL
+#endif
+        );
+        nFree((void **) &stackStr);
+    }
+}
+
+static nThreadRoutine_t nBenchThreadRoutine(void *data)
+{
+    (void) data;
+    return (nThreadRoutine_t) 0;
+}
+
+static void nBenchThreadCreate(void *data, uint64_t iterations)
+{
+    (void) data;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        nThread_t thread;
+        if (nThreadCreate(&thread, nBenchThreadRoutine, NULL)) continue;
+        nThreadJoin(thread, NULL);
+    }
+}
+
+static void *nBenchMutexSetup(void)
+{
+    nMutex_t *mutex = nAlloc(sizeof(nMutex_t));
+    nThreadMutexCreate(mutex);
+    return mutex;
+}
+
+static void nBenchMutex(void *data, uint64_t iterations)
+{
+    nMutex_t *const mutex = data;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        nThreadMutexLock(mutex);
+        nThreadMutexUnlock(mutex);
+    }
+}
+
+static void nBenchMutexTeardown(void *data)
+{
+    nThreadMutexDestroy(data);
+    nFree(&data);
+}
+
+static const nBench_t benches[] = {
+    {"nAlloc", nBenchAlloc, NULL, NULL},
+    {"nStringCopy", nBenchStringCopy, nBenchStringSetup, nBenchFree},
+    {"nFileCopy", nBenchFileCopy, nBenchFileSetup, nBenchFileTeardown},
+    {"nErrorThrow", nBenchErrorThrow, NULL, NULL},
+    {"nErrorStacktrace", nBenchErrorStacktrace, NULL, NULL},
+    {"nThreadCreate/nThreadJoin", nBenchThreadCreate, NULL, NULL},
+    {"nThreadMutexLock/Unlock", nBenchMutex, nBenchMutexSetup,
+     nBenchMutexTeardown},
+};
+
+static void nBenchUsage(const char *const programStr)
+{
+    fprintf(stderr, "Usage: %s [-o results.json] [-f filter] [-r repetitions]"
+     "\n\n"
+     "  -o  Write the results as JSON to a file, or - for stdout.\n"
+     "  -f  Only run benchmarks whose name contains the filter.\n"
+     "  -r  The number of timed batches of each benchmark (default %u).\n",
+     programStr, NBENCH_REPETITIONS);
+}
+
+int main(int argc, char **argv)
+{
+    const char *jsonStr = NULL;
+    const char *filterStr = NULL;
+    uint32_t repetitions = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-o") && (i + 1 < argc)) jsonStr = argv[++i];
+        else if (!strcmp(argv[i], "-f") && (i + 1 < argc)) filterStr = argv[++i];
+        else if (!strcmp(argv[i], "-r") && (i + 1 < argc))
+        {
+            repetitions = (uint32_t) strtoul(argv[++i], NULL, 10);
+        }
+        else
+        {
+            nBenchUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    nSysGetCPUInfo(NULL);
+    nTimeCalibrate();
+    nErrorSetCallback(nBenchErrorCallback);
+
+    const size_t benchCount = sizeof(benches) / sizeof(benches[0]);
+    nBenchResult_t results[sizeof(benches) / sizeof(benches[0])];
+    size_t resultCount = 0;
+    for (size_t i = 0; i < benchCount; i++)
+    {
+        if (filterStr && !strstr(benches[i].name, filterStr)) continue;
+        if (nBenchRun(&benches[i], repetitions, &results[resultCount])) continue;
+        resultCount++;
+    }
+
+    nBenchPrint(jsonStr && !strcmp(jsonStr, "-") ? stderr : stdout, results,
+     resultCount);
+
+    int err = NSUCCESS;
+    if (jsonStr)
+    {
+        FILE *file = strcmp(jsonStr, "-") ? fopen(jsonStr, "w") : stdout;
+        if (!file)
+        {
+            fprintf(stderr, "Failed to open %s.\n", jsonStr);
+            return EXIT_FAILURE;
+        }
+        err = nBenchWriteJSON(file, results, resultCount);
+        if (file != stdout) fclose(file);
+    }
+    return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// main.c
@@ -64,6 +64,9 @@ extern "C" {
  * @note The callback function can only be called once. If an error occurs, the
  * program will abort with nCrashAbort(). Check nCrashDefault() for
  * parameter information.
+ * @note On POSIX systems the callback is not called for fatal signals, as it
+ * is not async-signal-safe. A crash dump is written and the signal ends the
+ * process instead.
  */
 NIMBLE_EXPORT
 NIMBLE_EXTERN
@@ -0,0 +1,214 @@
+#include "../NimbleLicense.h"
+/*
+ * CrashDump.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file CrashDump.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the crash dump writer.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_CRASHDUMP_H
+#define NIMBLE_ENGINE_CRASHDUMP_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#include <stdint.h>
+
+#ifndef NCRASH_THREADS_MAX
+#  define NCRASH_THREADS_MAX 256 /**< The maximum number of threads whose stacks are written to a crash dump. */
+#endif
+#ifndef NCRASH_STACK_MAX
+#  define NCRASH_STACK_MAX 128 /**< The maximum stack levels written for each thread. */
+#endif
+#ifndef NCRASH_STACK_BYTES
+#  define NCRASH_STACK_BYTES 16384 /**< The bytes of the crashed thread's stack memory written, starting at its stack pointer. */
+#endif
+#ifndef NCRASH_MAPS_SIZE
+#  define NCRASH_MAPS_SIZE 262144 /**< The size of the buffer for the memory maps of the process. Longer maps are truncated. */
+#endif
+#ifndef NCRASH_THREAD_WAIT
+#  define NCRASH_THREAD_WAIT 200 /**< The milliseconds to wait for the other threads to write their stacks. */
+#endif
+#ifndef NCRASH_THREAD_SIGNAL
+#  define NCRASH_THREAD_SIGNAL (SIGRTMIN + 3) /**< The signal sent to the other threads to capture their stacks. */
+#endif
+#ifndef NCRASH_SIGNAL_STACK
+#  define NCRASH_SIGNAL_STACK 65536 /**< The size of the alternate stack signals are handled on, which must fit writing a crash dump. */
+#endif
+#define NCRASH_PATH_MAX 4096 /**< The maximum length of a crash dump path, including the null terminator. */
+
+/* Crash dump files.
+ * A crash dump is an #nCrashDumpHeader_t followed by sections, each an
+ * #nCrashSection_t followed by @c len bytes. Sections are written in order of
+ * importance, so a dump that was cut short by a second fault is still usable.
+ * Numbers are stored in the byte order of the program that wrote the dump. */
+#define NCRASH_DUMP_MAGIC "NCRDUMP" /**< The magic of a crash dump, including the null terminator. */
+#define NCRASH_DUMP_VERSION 1 /**< The version of the crash dump format. */
+#define NCRASH_DUMP_ORDER 0x01020304 /**< Written in the byte order of the program to detect it. */
+
+#define NCRASH_SECTION_INFO      1 /**< An #nCrashInfo_t. */
+#define NCRASH_SECTION_REGISTERS 2 /**< An #nCrashRegisters_t followed by @c count 64-bit registers. */
+#define NCRASH_SECTION_STACK     3 /**< An #nCrashStack_t followed by @c levels 64-bit addresses. */
+#define NCRASH_SECTION_MEMORY    4 /**< An #nCrashMemory_t followed by @c len bytes of memory. */
+#define NCRASH_SECTION_MAPS      5 /**< The text of /proc/self/maps. */
+#define NCRASH_SECTION_LOG       6 /**< Records not yet written by the logging thread, in the binary log format. */
+
+#define NCRASH_ARCH_UNKNOWN 0 /**< Registers are not written. */
+#define NCRASH_ARCH_X86_64  1 /**< rax, rbx, rcx, rdx, rsi, rdi, rbp, rsp, r8-r15, rip, eflags. */
+#define NCRASH_ARCH_AARCH64 2 /**< x0-x30, sp, pc, pstate. */
+
+/**
+ * @brief The header of a crash dump.
+ */
+typedef struct nCrashDumpHeader {
+    char magic[8]; /**< #NCRASH_DUMP_MAGIC */
+    uint32_t version; /**< #NCRASH_DUMP_VERSION */
+    uint32_t order; /**< #NCRASH_DUMP_ORDER */
+} nCrashDumpHeader_t;
+
+/**
+ * @brief The header of each section of a crash dump.
+ */
+typedef struct nCrashSection {
+    uint32_t kind; /**< The NCRASH_SECTION_* kind of the section. */
+    uint32_t len; /**< The number of bytes following the header. */
+} nCrashSection_t;
+
+/**
+ * @brief The signal that caused a crash.
+ */
+typedef struct nCrashInfo {
+    uint64_t time; /**< The time of the crash, in nanoseconds since the epoch. */
+    uint64_t addr; /**< The faulting address of the signal, or 0. */
+    int32_t signal; /**< The signal number. */
+    int32_t code; /**< The @c si_code of the signal. */
+    uint32_t pid; /**< The ID of the process. */
+    uint32_t tid; /**< The ID of the crashed thread. */
+    uint32_t arch; /**< The NCRASH_ARCH_* of the registers. */
+    uint32_t reserved; /**< Zero. */
+} nCrashInfo_t;
+
+/**
+ * @brief The registers of a thread.
+ */
+typedef struct nCrashRegisters {
+    uint32_t tid; /**< The ID of the thread. */
+    uint32_t count; /**< The number of registers that follow. */
+} nCrashRegisters_t;
+
+/**
+ * @brief The stack of a thread.
+ */
+typedef struct nCrashStack {
+    uint32_t tid; /**< The ID of the thread. */
+    uint32_t levels; /**< The number of addresses that follow, the program counter first and then return addresses. */
+    char name[16]; /**< The name of the thread, which may not be null terminated. */
+} nCrashStack_t;
+
+/**
+ * @brief A range of memory.
+ */
+typedef struct nCrashMemory {
+    uint64_t addr; /**< The address of the first byte. */
+    uint64_t len; /**< The number of bytes that follow. */
+} nCrashMemory_t;
+
+/**
+ * @brief Prepares the crash dump writer, allocating everything it needs so
+ * that nCrashDumpWrite() does not.
+ *
+ * @param[in] dirStr The directory to write crash dumps to, or #NULL for the
+ * working directory. The path is copied.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ *
+ * @note This is called by nEngineInit().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nCrashDumpInit(const char *const dirStr);
+
+/**
+ * @brief Writes a crash dump for a caught signal or exception.
+ *
+ * On POSIX systems the dump is written in the format above to
+ * <tt>crash-[time]-[pid].ncd</tt>, which is read by the Nimble Crash Viewer.
+ * It holds the signal, the registers, stack and stack memory of the crashed
+ * thread, the stack of each other thread, the memory maps of the process and
+ * the records the logging thread had not written yet. Only async-signal-safe
+ * functions are used. On Linux, the other threads are sent
+ * #NCRASH_THREAD_SIGNAL to capture their stacks, waiting at most
+ * #NCRASH_THREAD_WAIT milliseconds; elsewhere only the crashed thread is
+ * written.
+ *
+ * On Windows a minidump is written to <tt>crash-[time]-[pid].dmp</tt> with
+ * MiniDumpWriteDump(), which debuggers can open.
+ *
+ * @param[in] signum The signal caught, or the exception code on Windows.
+ * @param[in] info The @c siginfo_t of the signal, or the
+ * @c EXCEPTION_POINTERS on Windows. This can be #NULL.
+ * @param[in] context The @c ucontext_t of the signal. This can be #NULL, and
+ * is unused on Windows.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ *
+ * @note Only one dump is written; later calls return #NERROR_WARN. A call made
+ * while another thread is writing the dump waits until it is written first,
+ * so that a second crash does not end the process with the dump cut short.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nCrashDumpWrite(const int signum,
+                    const void *const info,
+                    const void *const context);
+
+/**
+ * @brief Gets the path of the crash dump written by nCrashDumpWrite().
+ *
+ * @return The path is returned, or an empty string if no dump was written.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+const char *nCrashDumpPath(void);
+
+#endif // NIMBLE_ENGINE_CRASHDUMP_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// CrashDump.h
@@ -61,6 +61,21 @@ extern "C" {
 #  define NERRORS_STACK_MAX 512 /**< The maximum stack levels to take from nErrorStacktrace(). */
 #endif
 #define NERRORS_STACK_DEFAULT 32 /**< The default number of stack levels to take from nErrorStacktrace(). */
+#ifndef NERRORS_FRAME_MAX
+#  define NERRORS_FRAME_MAX 0x100000 /**< The largest stack frame in bytes that nErrorStackWalk() follows. */
+#endif
+#ifndef NERRORS_DEDUP_SIZE
+#  define NERRORS_DEDUP_SIZE 64 /**< The number of recent errors nErrorThrow() remembers to suppress repeats. Must be a power of two. */
+#endif
+#ifndef NERRORS_DEDUP_FRAMES
+#  define NERRORS_DEDUP_FRAMES 4 /**< The number of return addresses that identify where an error was thrown from. */
+#endif
+#ifndef NERRORS_DEDUP_WINDOW
+#  define NERRORS_DEDUP_WINDOW 1000 /**< The milliseconds repeats of an error are suppressed for after it is reported. Zero (0) disables suppression. */
+#endif
+#ifndef NERRORS_DEDUP_INFO_MAX
+#  define NERRORS_DEDUP_INFO_MAX 128 /**< The length of info kept for reporting suppressed errors. */
+#endif
 
 typedef struct nErrorInfo {
     int error; /**< The error value of the error. */
@@ -108,6 +123,10 @@ extern nMutex_t nStacktraceMutex;
  * @return Returns the final error.
  *
  * @note The program will crash if this is unsuccessful.
+ * @note An error thrown again from the same place with the same @p info within
+ * #NERRORS_DEDUP_WINDOW milliseconds of being reported is not sent to the
+ * callback. The number of times it was suppressed is appended to the info of
+ * its next report, or reported by nErrorFlushRepeats().
  */
 NIMBLE_EXPORT
 NIMBLE_EXTERN
@@ -116,6 +135,18 @@ int nErrorThrow(const int error,
                 size_t infoLen,
                 const int setError);
 
+/**
+ * @brief Reports the errors suppressed by nErrorThrow() since they were last
+ * reported.
+ *
+ * Each error that was repeated is sent to the error callback once, with the
+ * number of times it was suppressed appended to its info. This is called when
+ * the engine exits.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nErrorFlushRepeats(void);
+
 /**
  * @brief Clears the current errors.
  */
@@ -256,6 +287,82 @@ NIMBLE_EXPORT
 NIMBLE_EXTERN
 void nErrorSetCallback(void (*const callback)(const nErrorInfo_t errorInfo));
 
+/**
+ * @brief Records the top of the invoking thread's stack, which bounds the
+ * frames that nErrorStackWalk() follows.
+ *
+ * nThreadCreate() and nEngineInit() call this for the threads they start, so it
+ * only needs calling from other threads whose stacks are walked.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nErrorStackRegister(void);
+
+/**
+ * @brief Returns the stack top recorded by nErrorStackRegister() for the
+ * invoking thread.
+ * @return The top of the invoking thread's stack is returned, or #NULL if it
+ * was not recorded.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+const void *nErrorStackTop(void);
+
+/**
+ * @brief Walks the frame pointer chain from @p framePtr, storing the return
+ * address of each frame in @p stack.
+ *
+ * The engine is built with @c -fno-omit-frame-pointer, so each frame begins
+ * with the frame pointer of its caller followed by its return address. The
+ * walk stops at the first frame that is misaligned, not above the last one,
+ * more than #NERRORS_FRAME_MAX bytes above it, or past @p stackTop, so that a
+ * frame pointer used for other data by code built without frame pointers ends
+ * the walk rather than being followed. It only reads memory, so it is
+ * async-signal-safe.
+ *
+ * @param[in] framePtr The frame pointer to start at, such as one from a signal
+ * context, or #NULL to start at the caller of this function.
+ * @param[in] stackPtr The stack pointer of the same context, below which no
+ * frame can be. This can be #NULL.
+ * @param[in] stackTop The top of the stack that @p framePtr is in, or #NULL for
+ * the invoking thread's from nErrorStackTop().
+ * @param[out] stack The return addresses, innermost first.
+ * @param[in] maxLevels The maximum number of addresses to store.
+ * @return The number of addresses stored is returned. If @p framePtr is given
+ * but the stack top is unknown, nothing is walked and zero (0) is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nErrorStackWalk(const void *framePtr,
+                    const void *const stackPtr,
+                    const void *stackTop,
+                    void **const stack,
+                    const int maxLevels);
+
+/**
+ * @brief Walks the stack of the thread interrupted by a signal or exception.
+ *
+ * The program counter of @p context is stored first, followed by the return
+ * addresses found by nErrorStackWalk() from the frame pointer of @p context.
+ * This is async-signal-safe.
+ *
+ * @param[in] context The @c ucontext_t passed to an @c SA_SIGINFO signal
+ * handler, or the @c CONTEXT of a thread on Windows.
+ * @param[in] stackTop The top of the interrupted thread's stack, or #NULL if it
+ * is the invoking thread.
+ * @param[out] stack The addresses, innermost first.
+ * @param[in] maxLevels The maximum number of addresses to store.
+ * @return The number of addresses stored is returned. If the registers of
+ * @p context are unknown for this platform, the stack of the caller is walked
+ * instead.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nErrorStackWalkContext(const void *const context,
+                           const void *const stackTop,
+                           void **const stack,
+                           const int maxLevels);
+
 /**
  * @brief Returns the current stack trace as a string.
  * 
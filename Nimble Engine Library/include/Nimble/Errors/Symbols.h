@@ -0,0 +1,139 @@
+#include "../NimbleLicense.h"
+/*
+ * Symbols.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Symbols.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines stack symbolization functions.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_SYMBOLS_H
+#define NIMBLE_ENGINE_SYMBOLS_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#include "Errors.h"
+
+
+#ifndef NERRORS_SYMBOL_CACHE_SIZE
+#  define NERRORS_SYMBOL_CACHE_SIZE 4096 /**< The number of addresses cached by nErrorSymbolize(). Must be a power of two. */
+#endif
+#ifndef NERRORS_SYMBOL_MODULES_MAX
+#  define NERRORS_SYMBOL_MODULES_MAX 256 /**< The maximum number of loaded objects tracked by nErrorSymbolize(). */
+#endif
+
+/**
+ * @brief The symbol information of a code address.
+ *
+ * @note All strings point to memory owned by the symbolizer, and stay valid
+ * until the program exits. They must not be freed.
+ */
+typedef struct nErrorSymbol {
+    const void *addr; /**< The address that was symbolized. */
+
+    const char *funcStr; /**< The name of the function containing @c addr, or #NULL if unknown. */
+    size_t funcOffset; /**< The offset of @c addr from the start of the function. */
+
+    const char *fileStr; /**< The source file containing @c addr, or #NULL if unknown. */
+    const char *dirStr; /**< The directory of @c fileStr, or #NULL if unknown or if @c fileStr is absolute. */
+    int line; /**< The source line of @c addr, or 0 if unknown. */
+
+    const char *moduleStr; /**< The path of the executable or shared object containing @c addr, or #NULL if unknown. */
+} nErrorSymbol_t;
+
+/**
+ * @brief Gets the function, source file and line of @p addr.
+ *
+ * The first time an address in an executable or shared object is symbolized,
+ * the object is mapped into memory and its symbol table (@c .symtab, or
+ * @c .dynsym if stripped) and line table (@c .debug_line) are parsed into
+ * sorted lookup tables. Later lookups are binary searches, and each resolved
+ * address is cached, so symbolizing a stack costs microseconds per frame.
+ *
+ * Example:
+ * @code
+ * nErrorSymbol_t symbol;
+ * if (!nErrorSymbolize(stack[0], &symbol))
+ * {
+ *     printf("%s at %s:%d\n", symbol.funcStr, symbol.fileStr, symbol.line);
+ * }
+ * @endcode
+ *
+ * @param[in] addr The code address to symbolize, such as a return address.
+ * @param[out] symbol The symbol information to set. Unknown fields are set to
+ * #NULL or zero.
+ * @return #NSUCCESS is returned if any information was found; otherwise -1 is
+ * returned.
+ *
+ * @note This function is thread safe. It does not report errors through the
+ * error callback, as it is used while handling errors.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nErrorSymbolize(const void *const addr,
+                    nErrorSymbol_t *const symbol);
+
+/**
+ * @brief Formats the return addresses @p stack as a stack trace string.
+ *
+ * Each level is written on its own line as:
+ * <tt>#[level] [address] in [function]+[offset] at [file]:[line] ([module])</tt>
+ * where unknown parts are left out.
+ *
+ * @param[in] stack The return addresses to format.
+ * @param[in] levels The number of addresses in @p stack.
+ * @param[out] stackLen The length of the string returned. This can be #NULL.
+ * @return A newly allocated string is returned, which should be freed with
+ * nFree().
+ */
+NIMBLE_EXPORT
+NIMBLE_USE_RESULT
+NIMBLE_EXTERN
+char *
+nErrorStackString(void *const *const stack,
+                  const int levels,
+                  size_t *stackLen);
+
+#endif // NIMBLE_ENGINE_SYMBOLS_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Symbols.h
@@ -0,0 +1,176 @@
+#include "../NimbleLicense.h"
+/*
+ * Loop.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Loop.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the game loop.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_LOOP_H
+#define NIMBLE_ENGINE_LOOP_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#include "../Errors/ErrorValues.h"
+
+#ifndef NLOOP_MAX_TICKS
+#  define NLOOP_MAX_TICKS 8 /**< The default maximum number of ticks run to catch up in a frame. */
+#endif
+
+/**
+ * @brief Statistics of an #nLoop_t.
+ */
+typedef struct nLoopStats {
+    uint64_t frames; /**< The number of frames run. */
+    uint64_t ticks; /**< The number of ticks run. */
+    uint64_t missedTicks; /**< The number of ticks dropped by the catch-up limit. */
+    uint64_t lateFrames; /**< The number of frames that started after their deadline. */
+    uint64_t lastFrameNanos; /**< The duration of the last frame, in nanoseconds. */
+    uint64_t maxUpdateNanos; /**< The longest duration of an update, in nanoseconds. */
+    uint64_t maxWakeNanos; /**< The longest time woken after a deadline, in nanoseconds. */
+    uint64_t totalWakeNanos; /**< The total time woken after deadlines, in nanoseconds. */
+} nLoopStats_t;
+
+/**
+ * @brief A game loop running updates at a fixed timestep.
+ *
+ * Each frame adds the time since the last frame to an accumulator and runs
+ * updates of #tickNanos until less than a tick is left, then renders with the
+ * fraction of a tick left as the interpolation alpha. When the updates fall so
+ * far behind that more than #maxTicks would be needed, the extra time is
+ * dropped and counted as missed ticks rather than trying to catch up.
+ *
+ * Frames are paced to #frameNanos if set. Otherwise, loops without a render
+ * callback, such as servers, sleep until the next tick, and loops with one run
+ * as fast as rendering allows.
+ *
+ * @note Initialize the loop with nLoopInit().
+ */
+typedef struct nLoop {
+    uint64_t tickNanos; /**< The nanoseconds simulated by each update. */
+    uint64_t frameNanos; /**< The target nanoseconds of each frame, or 0 to not pace rendered frames. */
+    uint32_t maxTicks; /**< The maximum number of updates run in a frame. */
+    void (*update)(const double dt, void *data); /**< Invoked for each tick with the tick length in seconds. */
+    void (*render)(const double alpha, void *data); /**< Invoked for each frame with the fraction of a tick to interpolate by, or #NULL. */
+    void *data; /**< Passed to the callbacks. */
+
+    volatile int running; /**< Nonzero while nLoopRun() is running. */
+    uint64_t accumulator; /**< The nanoseconds that have not been simulated. */
+    uint64_t lastTime; /**< The time of nTimeMonotonic() at the start of the last frame. */
+    uint64_t nextFrame; /**< The time of nTimeMonotonic() the next frame starts at. */
+    nLoopStats_t stats; /**< The statistics of the loop. */
+} nLoop_t;
+
+/**
+ * @brief Initializes @p loop.
+ *
+ * @param[out] loop The loop to initialize.
+ * @param[in] tickRate The number of updates per second.
+ * @param[in] frameRate The number of frames per second to pace to, or 0 to not
+ * pace rendered frames.
+ * @param[in] update The function to invoke for each tick.
+ * @param[in] render The function to invoke for each frame, or #NULL.
+ * @param[in] data The data passed to @p update and @p render.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned
+ * and a corresponding error is sent to the error callback set by
+ * nErrorHandlerSetErrorCallback().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nLoopInit(nLoop_t *const loop,
+              const uint32_t tickRate,
+              const uint32_t frameRate,
+              void (*const update)(const double dt, void *data),
+              void (*const render)(const double alpha, void *data),
+              void *const data);
+
+/**
+ * @brief Runs a single frame of @p loop, without pacing it.
+ *
+ * This is used to drive the loop from another main loop. Each frame sends a
+ * heartbeat to the watchdog, if the thread is registered with it.
+ *
+ * @param[in,out] loop The loop to run a frame of.
+ * @return Returns the number of updates run.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint32_t nLoopStep(nLoop_t *const loop);
+
+/**
+ * @brief Runs @p loop until nLoopStop() is invoked.
+ *
+ * The invoking thread is registered with the watchdog as "Loop" while the loop
+ * runs, unless it is already registered, so a frame that takes longer than
+ * #NWATCHDOG_TIMEOUT is reported.
+ *
+ * @param[in,out] loop The loop to run.
+ * @return #NSUCCESS is returned when the loop stops.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nLoopRun(nLoop_t *const loop);
+
+/**
+ * @brief Stops @p loop after its current frame.
+ *
+ * @param[in,out] loop The loop to stop. This can be invoked from a callback of
+ * the loop or another thread.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLoopStop(nLoop_t *const loop);
+
+/**
+ * @brief Clears the statistics of @p loop.
+ *
+ * @param[in,out] loop The loop to clear the statistics of.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLoopResetStats(nLoop_t *const loop);
+
+#endif // NIMBLE_ENGINE_LOOP_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Loop.h
@@ -0,0 +1,317 @@
+#include "../NimbleLicense.h"
+/*
+ * BigNumber.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file BigNumber.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines arbitrary precision integers and their math.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_BIGNUMBER_H
+#define NIMBLE_ENGINE_BIGNUMBER_H /**< Header definition */
+
+#include "../Nimble.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef NBIG_INLINE_LIMBS
+#  define NBIG_INLINE_LIMBS 2 /**< The number of limbs stored in an #nBig_t itself, so that numbers up to this many limbs never allocate. */
+#endif
+#ifndef NBIG_KARATSUBA_THRESHOLD
+#  define NBIG_KARATSUBA_THRESHOLD 48 /**< The number of limbs of the smaller factor from which nBigMul() uses Karatsuba multiplication. */
+#endif
+#ifndef NBIG_TOOM3_THRESHOLD
+#  define NBIG_TOOM3_THRESHOLD 768 /**< The number of limbs of the smaller factor from which nBigMul() uses Toom-3 multiplication. */
+#endif
+
+/**
+ * @brief A limb, one base 2^64 digit of an #nBig_t.
+ */
+typedef uint64_t nLimb_t;
+
+#define NBIG_LIMB_BITS 64 /**< The number of bits in an #nLimb_t. */
+
+/**
+ * @brief An arbitrary precision integer.
+ *
+ * The magnitude is stored as little endian limbs, which are kept in the number
+ * itself until it needs more than #NBIG_INLINE_LIMBS. Use nBigLimbs() to get
+ * them wherever they are. Fixed point numbers are integers scaled by a power
+ * of two, which nBigMulFixed() keeps when multiplying.
+ *
+ * @note Initialize numbers with #NBIG_INIT or nBigInit(), and free them with
+ * nBigFree(). Copying an #nBig_t by assignment shares its allocation, so use
+ * nBigCopy() instead.
+ */
+typedef struct nBig {
+    nLimb_t *heap; /**< The limbs if allocated, or #NULL if @p small is used. */
+    size_t size; /**< The number of limbs in use, with no leading zeros. Zero has no limbs. */
+    size_t capacity; /**< The number of limbs that fit without allocating. */
+    int negative; /**< 1 if the number is negative, or 0 otherwise. Zero is never negative. */
+    nLimb_t small[NBIG_INLINE_LIMBS]; /**< The limbs of small numbers. */
+} nBig_t;
+
+#define NBIG_INIT {NULL, 0, NBIG_INLINE_LIMBS, 0, {0}} /**< The initializer of a zero #nBig_t. */
+
+/**
+ * @brief Gets the limbs of a number, least significant first.
+ */
+NIMBLE_INLINE
+nLimb_t *nBigLimbs(const nBig_t *const a)
+{
+    return a->heap ? a->heap : (nLimb_t *) a->small;
+}
+
+/**
+ * @brief Sets a number to zero without allocating.
+ *
+ * @param[out] a The number to initialize.
+ */
+NIMBLE_INLINE
+void nBigInit(nBig_t *const a)
+{
+    *a = (nBig_t) NBIG_INIT;
+}
+
+/**
+ * @brief Frees the limbs of a number and sets it to zero.
+ *
+ * @param[in,out] a The number to free.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nBigFree(nBig_t *const a);
+
+/**
+ * @brief Makes room for @p limbs limbs in a number.
+ *
+ * @param[in,out] a The number.
+ * @param[in] limbs The number of limbs needed.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigReserve(nBig_t *const a, const size_t limbs);
+
+/**
+ * @brief Sets a number to a signed integer.
+ *
+ * This never allocates, as #NBIG_INLINE_LIMBS is at least 1.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nBigSetInt(nBig_t *const a, const int64_t value);
+
+/**
+ * @brief Sets a number to an unsigned integer.
+ *
+ * This never allocates, as #NBIG_INLINE_LIMBS is at least 1.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nBigSetUint(nBig_t *const a, const uint64_t value);
+
+/**
+ * @brief Copies a number.
+ *
+ * @param[out] dst The copy.
+ * @param[in] src The number to copy.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigCopy(nBig_t *const dst, const nBig_t *const src);
+
+/**
+ * @brief Compares two numbers.
+ *
+ * @return A negative number is returned if @p a < @p b, 0 if they are equal,
+ * or a positive number if @p a > @p b.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigCompare(const nBig_t *const a, const nBig_t *const b);
+
+/**
+ * @brief Computes @p dst = @p a + @p b.
+ *
+ * @note The destination may be the same number as either source, as in the
+ * rest of the arithmetic functions.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigAdd(nBig_t *const dst, const nBig_t *const a, const nBig_t *const b);
+
+/**
+ * @brief Computes @p dst = @p a - @p b.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigSub(nBig_t *const dst, const nBig_t *const a, const nBig_t *const b);
+
+/**
+ * @brief Computes @p dst = @p a * @p b.
+ *
+ * Factors whose smaller one has fewer than #NBIG_KARATSUBA_THRESHOLD limbs are
+ * multiplied by schoolbook multiplication, using the MULX and ADX instructions
+ * where the CPU has them. Larger factors are multiplied by Karatsuba
+ * multiplication, and from #NBIG_TOOM3_THRESHOLD limbs by Toom-3
+ * multiplication.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigMul(nBig_t *const dst, const nBig_t *const a, const nBig_t *const b);
+
+/**
+ * @brief Divides two numbers, rounding toward zero.
+ *
+ * @param[out] quotient The quotient, or #NULL if it is not needed.
+ * @param[out] remainder The remainder, which has the sign of @p a, or #NULL if
+ * it is not needed. This must not be the same number as @p quotient.
+ * @param[in] a The dividend.
+ * @param[in] b The divisor.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_DOMAIN is
+ * returned if @p b is zero, or #NERROR_NO_MEMORY if allocation failed.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigDivMod(nBig_t *const quotient, nBig_t *const remainder,
+               const nBig_t *const a, const nBig_t *const b);
+
+/**
+ * @brief Computes @p dst = @p a * 2^@p bits.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigShiftLeft(nBig_t *const dst, const nBig_t *const a, const size_t bits);
+
+/**
+ * @brief Computes @p dst = @p a / 2^@p bits, rounding toward zero.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigShiftRight(nBig_t *const dst, const nBig_t *const a, const size_t bits);
+
+/**
+ * @brief Multiplies two fixed point numbers.
+ *
+ * @param[out] dst The product, with @p fracBits fractional bits.
+ * @param[in] a The first factor, with @p fracBits fractional bits.
+ * @param[in] b The second factor, with @p fracBits fractional bits.
+ * @param[in] fracBits The number of fractional bits of the numbers.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NO_MEMORY is
+ * returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigMulFixed(nBig_t *const dst, const nBig_t *const a,
+                 const nBig_t *const b, const size_t fracBits);
+
+/**
+ * @brief Computes @p dst = @p base ^ @p exponent mod @p modulus.
+ *
+ * Odd moduli, as in cryptography, use Montgomery multiplication, which reduces
+ * without dividing. Even moduli reduce by nBigDivMod().
+ *
+ * @param[out] dst The result, from 0 to @p modulus - 1.
+ * @param[in] base The base, which may be negative.
+ * @param[in] exponent The exponent, which must not be negative.
+ * @param[in] modulus The modulus, which must be positive.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_DOMAIN is
+ * returned if @p exponent is negative or @p modulus is not positive, or
+ * #NERROR_NO_MEMORY if allocation failed.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigModPow(nBig_t *const dst, const nBig_t *const base,
+               const nBig_t *const exponent, const nBig_t *const modulus);
+
+/**
+ * @brief Parses a decimal number, with an optional leading '-'.
+ *
+ * @param[out] dst The number.
+ * @param[in] str The string to parse.
+ * @param[in] len The length of @p str.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_INV_ARG is
+ * returned if @p str is not a decimal number, or #NERROR_NO_MEMORY if
+ * allocation failed.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nBigFromString(nBig_t *const dst, const char *const str, const size_t len);
+
+/**
+ * @brief Writes a number in decimal.
+ *
+ * @param[out] dst The string to write to, which is always null terminated if
+ * @p size is not zero.
+ * @param[in] size The size of @p dst in bytes.
+ * @param[in] a The number to write.
+ * @return The length of the whole number in decimal is returned, which is
+ * greater than or equal to @p size if @p dst was too small, or -1 if
+ * allocation failed.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+ssize_t nBigToString(char *const dst, const size_t size, const nBig_t *const a);
+
+#endif // NIMBLE_ENGINE_BIGNUMBER_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// BigNumber.h
@@ -0,0 +1,691 @@
+#include "../NimbleLicense.h"
+/*
+ * FixedPoint.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file FixedPoint.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines deterministic fixed point numbers and their math.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_FIXEDPOINT_H
+#define NIMBLE_ENGINE_FIXEDPOINT_H /**< Header definition */
+
+#include "../Nimble.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Every function here is computed with integer operations only, so results are
+ * bit-identical on every compiler, CPU and optimization level, unlike floats
+ * under -Ofast. Signed right shifts are assumed to be arithmetic, as GCC and
+ * Clang define them. Results that overflow wrap, except where noted. */
+
+/**
+ * @brief A Q16.16 fixed point number, with 16 integer and 16 fractional bits.
+ */
+typedef int32_t nFix16_t;
+
+/**
+ * @brief A Q32.32 fixed point number, with 32 integer and 32 fractional bits.
+ */
+typedef int64_t nFix32_t;
+
+#define NFIX16_ONE     ((nFix16_t) 0x10000) /**< 1 as a Q16.16 number. */
+#define NFIX16_HALF    ((nFix16_t) 0x8000) /**< 0.5 as a Q16.16 number. */
+#define NFIX16_MAX     ((nFix16_t) INT32_MAX) /**< The largest Q16.16 number, just under 32768. */
+#define NFIX16_MIN     ((nFix16_t) INT32_MIN) /**< The smallest Q16.16 number, -32768. */
+#define NFIX16_PI      ((nFix16_t) 205887) /**< Pi as a Q16.16 number. */
+#define NFIX16_HALF_PI ((nFix16_t) 102944) /**< Pi / 2 as a Q16.16 number. */
+#define NFIX16_TWO_PI  ((nFix16_t) 411775) /**< 2 * Pi as a Q16.16 number. */
+
+#define NFIX32_ONE     ((nFix32_t) 0x100000000LL) /**< 1 as a Q32.32 number. */
+#define NFIX32_HALF    ((nFix32_t) 0x80000000LL) /**< 0.5 as a Q32.32 number. */
+#define NFIX32_MAX     ((nFix32_t) INT64_MAX) /**< The largest Q32.32 number, just under 2^31. */
+#define NFIX32_MIN     ((nFix32_t) INT64_MIN) /**< The smallest Q32.32 number, -2^31. */
+#define NFIX32_PI      ((nFix32_t) 13493037705LL) /**< Pi as a Q32.32 number. */
+#define NFIX32_HALF_PI ((nFix32_t) 6746518852LL) /**< Pi / 2 as a Q32.32 number. */
+#define NFIX32_TWO_PI  ((nFix32_t) 26986075409LL) /**< 2 * Pi as a Q32.32 number. */
+
+
+/* Q16.16 */
+
+/**
+ * @brief Converts an integer to a Q16.16 number.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16FromInt(const int32_t a)
+{
+    return (nFix16_t) ((uint32_t) a << 16);
+}
+
+/**
+ * @brief Converts a Q16.16 number to an integer, rounding down.
+ */
+NIMBLE_INLINE
+int32_t nFix16ToInt(const nFix16_t a)
+{
+    return a >> 16;
+}
+
+/**
+ * @brief Converts a float to the nearest Q16.16 number.
+ *
+ * @note Use this for constants and loading data, as the float itself may
+ * differ between builds.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16FromFloat(const float a)
+{
+    return (nFix16_t) ((a * 65536.0f) + ((a >= 0.0f) ? 0.5f : -0.5f));
+}
+
+/**
+ * @brief Converts a Q16.16 number to a float, such as for rendering.
+ */
+NIMBLE_INLINE
+float nFix16ToFloat(const nFix16_t a)
+{
+    return (float) a * (1.0f / 65536.0f);
+}
+
+/**
+ * @brief Adds two Q16.16 numbers.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Add(const nFix16_t a, const nFix16_t b)
+{
+    return (nFix16_t) ((uint32_t) a + (uint32_t) b);
+}
+
+/**
+ * @brief Subtracts two Q16.16 numbers.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Sub(const nFix16_t a, const nFix16_t b)
+{
+    return (nFix16_t) ((uint32_t) a - (uint32_t) b);
+}
+
+/**
+ * @brief Rounds a product with 32 fractional bits to a Q16.16 number, with
+ * halves rounded up.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Round(const int64_t a)
+{
+    return (nFix16_t) ((int64_t) ((uint64_t) a + 0x8000U) >> 16);
+}
+
+/**
+ * @brief Multiplies two Q16.16 numbers, rounding to nearest.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Mul(const nFix16_t a, const nFix16_t b)
+{
+    return nFix16Round((int64_t) a * b);
+}
+
+/**
+ * @brief Divides two Q16.16 numbers, rounding toward zero.
+ *
+ * @return The quotient is returned, saturated to #NFIX16_MIN or #NFIX16_MAX if
+ * it overflows or @p b is zero.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Div(const nFix16_t a, const nFix16_t b)
+{
+    if (!b) return (a >= 0) ? NFIX16_MAX : NFIX16_MIN;
+
+    const int64_t q = ((int64_t) a * 65536) / b;
+    return (q > INT32_MAX) ? NFIX16_MAX : (q < INT32_MIN) ? NFIX16_MIN :
+     (nFix16_t) q;
+}
+
+/**
+ * @brief Gets the absolute value of a Q16.16 number.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Abs(const nFix16_t a)
+{
+    return (a < 0) ? (nFix16_t) (0U - (uint32_t) a) : a;
+}
+
+/**
+ * @brief Gets the square root of a Q16.16 number, rounding down.
+ *
+ * @return The square root is returned, or 0 if @p a is not positive.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16_t nFix16Sqrt(const nFix16_t a);
+
+/**
+ * @brief Gets the sine of an angle.
+ *
+ * A quarter wave table of 256 steps is interpolated, for an error under 2^-15
+ * for angles within 2^14 radians.
+ *
+ * @param[in] a The angle in radians.
+ * @return The sine is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16_t nFix16Sin(const nFix16_t a);
+
+/**
+ * @brief Gets the cosine of an angle.
+ *
+ * @param[in] a The angle in radians.
+ * @return The cosine is returned.
+ *
+ * @see nFix16Sin()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16_t nFix16Cos(const nFix16_t a);
+
+/**
+ * @brief Gets the angle of a point from the X axis.
+ *
+ * @param[in] y The Y coordinate.
+ * @param[in] x The X coordinate.
+ * @return The angle from -Pi to Pi is returned, or 0 if both coordinates are
+ * zero.
+ *
+ * @see nFix32Atan2()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16_t nFix16Atan2(const nFix16_t y, const nFix16_t x);
+
+
+/* Q32.32 */
+
+/**
+ * @brief Converts an integer to a Q32.32 number.
+ */
+NIMBLE_INLINE
+nFix32_t nFix32FromInt(const int32_t a)
+{
+    return (nFix32_t) ((uint64_t) (int64_t) a << 32);
+}
+
+/**
+ * @brief Converts a Q32.32 number to an integer, rounding down.
+ */
+NIMBLE_INLINE
+int32_t nFix32ToInt(const nFix32_t a)
+{
+    return (int32_t) (a >> 32);
+}
+
+/**
+ * @brief Converts a Q16.16 number to a Q32.32 number.
+ */
+NIMBLE_INLINE
+nFix32_t nFix32FromFix16(const nFix16_t a)
+{
+    return (nFix32_t) ((uint64_t) (int64_t) a << 16);
+}
+
+/**
+ * @brief Converts a Q32.32 number to a Q16.16 number, rounding to nearest.
+ */
+NIMBLE_INLINE
+nFix16_t nFix32ToFix16(const nFix32_t a)
+{
+    return nFix16Round(a);
+}
+
+/**
+ * @brief Converts a double to the nearest Q32.32 number.
+ *
+ * @note Use this for constants and loading data, as the double itself may
+ * differ between builds.
+ */
+NIMBLE_INLINE
+nFix32_t nFix32FromDouble(const double a)
+{
+    return (nFix32_t) ((a * 4294967296.0) + ((a >= 0.0) ? 0.5 : -0.5));
+}
+
+/**
+ * @brief Converts a Q32.32 number to a double, such as for rendering.
+ */
+NIMBLE_INLINE
+double nFix32ToDouble(const nFix32_t a)
+{
+    return (double) a * (1.0 / 4294967296.0);
+}
+
+/**
+ * @brief Adds two Q32.32 numbers.
+ */
+NIMBLE_INLINE
+nFix32_t nFix32Add(const nFix32_t a, const nFix32_t b)
+{
+    return (nFix32_t) ((uint64_t) a + (uint64_t) b);
+}
+
+/**
+ * @brief Subtracts two Q32.32 numbers.
+ */
+NIMBLE_INLINE
+nFix32_t nFix32Sub(const nFix32_t a, const nFix32_t b)
+{
+    return (nFix32_t) ((uint64_t) a - (uint64_t) b);
+}
+
+/**
+ * @brief Multiplies two Q32.32 numbers, rounding to nearest.
+ *
+ * 32-bit targets without 128-bit integers build the 128-bit product from
+ * 32-bit halves, which gives the same result.
+ */
+NIMBLE_INLINE
+nFix32_t nFix32Mul(const nFix32_t a, const nFix32_t b)
+{
+#ifdef __SIZEOF_INT128__
+    const __int128 p = (__int128) a * b;
+    return (nFix32_t) ((p + 0x80000000LL) >> 32);
+#else
+    /* The unsigned product, corrected to the signed product by subtracting
+     * the other factor from the high limb for each negative factor. */
+    const uint64_t ua = (uint64_t) a, ub = (uint64_t) b;
+    const uint64_t ll = (ua & 0xffffffffU) * (ub & 0xffffffffU);
+    const uint64_t lh = (ua & 0xffffffffU) * (ub >> 32);
+    const uint64_t hl = (ua >> 32) * (ub & 0xffffffffU);
+    const uint64_t mid = (ll >> 32) + (lh & 0xffffffffU) + (hl & 0xffffffffU);
+    uint64_t hi = ((ua >> 32) * (ub >> 32)) + (lh >> 32) + (hl >> 32) +
+     (mid >> 32);
+    uint64_t lo = (mid << 32) | (ll & 0xffffffffU);
+    if (a < 0) hi -= ub;
+    if (b < 0) hi -= ua;
+    lo += 0x80000000U;
+    hi += (lo < 0x80000000U);
+    return (nFix32_t) ((hi << 32) | (lo >> 32));
+#endif
+}
+
+/**
+ * @brief Divides two Q32.32 numbers, rounding toward zero.
+ *
+ * @return The quotient is returned, saturated to #NFIX32_MIN or #NFIX32_MAX if
+ * it overflows or @p b is zero.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix32_t nFix32Div(const nFix32_t a, const nFix32_t b);
+
+/**
+ * @brief Gets the square root of a Q32.32 number, rounding down.
+ *
+ * @return The square root is returned, or 0 if @p a is not positive.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix32_t nFix32Sqrt(const nFix32_t a);
+
+/**
+ * @brief Gets the sine of an angle.
+ *
+ * CORDIC rotates by 40 angles with 40 fractional bits, for an error of a few
+ * 2^-32. Angles are reduced by a rounded 2 * Pi, so the error grows with the
+ * number of turns, to about 2^-28 at 2^11 radians.
+ *
+ * @param[in] a The angle in radians.
+ * @return The sine is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix32_t nFix32Sin(const nFix32_t a);
+
+/**
+ * @brief Gets the cosine of an angle.
+ *
+ * @param[in] a The angle in radians.
+ * @return The cosine is returned.
+ *
+ * @see nFix32Sin()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix32_t nFix32Cos(const nFix32_t a);
+
+/**
+ * @brief Gets the sine and cosine of an angle at once.
+ *
+ * @param[in] a The angle in radians.
+ * @param[out] sin The sine.
+ * @param[out] cos The cosine.
+ *
+ * @see nFix32Sin()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nFix32SinCos(const nFix32_t a, nFix32_t *const sin, nFix32_t *const cos);
+
+/**
+ * @brief Gets the angle of a point from the X axis.
+ *
+ * CORDIC rotates the point onto the X axis, summing the angles it rotates by.
+ *
+ * @param[in] y The Y coordinate.
+ * @param[in] x The X coordinate.
+ * @return The angle from -Pi to Pi is returned, or 0 if both coordinates are
+ * zero.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix32_t nFix32Atan2(const nFix32_t y, const nFix32_t x);
+
+
+/* Q16.16 vectors, matrices and quaternions
+ * Sums of products are accumulated with 32 fractional bits and rounded once,
+ * so they are more precise than chained nFix16Mul() calls. */
+
+/**
+ * @brief A Q16.16 3D vector, padded to 16 bytes for the batch functions.
+ *
+ * @note @c w is padding, which the functions keep at zero.
+ */
+typedef struct nFix16Vec3 {
+    nFix16_t x; /**< The X component. */
+    nFix16_t y; /**< The Y component. */
+    nFix16_t z; /**< The Z component. */
+    nFix16_t w; /**< Padding. */
+} __attribute__((aligned(16))) nFix16Vec3_t;
+
+/**
+ * @brief A Q16.16 4x4 matrix, stored column-major like #nMat4_t.
+ */
+typedef struct nFix16Mat4 {
+    nFix16_t m[16]; /**< The elements, column by column. */
+} __attribute__((aligned(16))) nFix16Mat4_t;
+
+/**
+ * @brief A Q16.16 quaternion, where @c w is the real part.
+ */
+typedef struct nFix16Quat {
+    nFix16_t x; /**< The first imaginary component. */
+    nFix16_t y; /**< The second imaginary component. */
+    nFix16_t z; /**< The third imaginary component. */
+    nFix16_t w; /**< The real component. */
+} __attribute__((aligned(16))) nFix16Quat_t;
+
+/**
+ * @brief Makes a Q16.16 3D vector.
+ */
+NIMBLE_INLINE
+nFix16Vec3_t nFix16Vec3Set(const nFix16_t x, const nFix16_t y,
+                           const nFix16_t z)
+{
+    return (nFix16Vec3_t) {x, y, z, 0};
+}
+
+/**
+ * @brief Adds two Q16.16 3D vectors.
+ */
+NIMBLE_INLINE
+nFix16Vec3_t nFix16Vec3Add(const nFix16Vec3_t a, const nFix16Vec3_t b)
+{
+    return nFix16Vec3Set(nFix16Add(a.x, b.x), nFix16Add(a.y, b.y),
+     nFix16Add(a.z, b.z));
+}
+
+/**
+ * @brief Subtracts two Q16.16 3D vectors.
+ */
+NIMBLE_INLINE
+nFix16Vec3_t nFix16Vec3Sub(const nFix16Vec3_t a, const nFix16Vec3_t b)
+{
+    return nFix16Vec3Set(nFix16Sub(a.x, b.x), nFix16Sub(a.y, b.y),
+     nFix16Sub(a.z, b.z));
+}
+
+/**
+ * @brief Multiplies a Q16.16 3D vector by a number.
+ */
+NIMBLE_INLINE
+nFix16Vec3_t nFix16Vec3Scale(const nFix16Vec3_t a, const nFix16_t s)
+{
+    return nFix16Vec3Set(nFix16Mul(a.x, s), nFix16Mul(a.y, s),
+     nFix16Mul(a.z, s));
+}
+
+/**
+ * @brief Gets the dot product of two Q16.16 3D vectors with 32 fractional
+ * bits, before it is rounded.
+ */
+NIMBLE_INLINE
+int64_t nFix16Vec3DotWide(const nFix16Vec3_t a, const nFix16Vec3_t b)
+{
+    return (int64_t) ((uint64_t) ((int64_t) a.x * b.x) +
+     (uint64_t) ((int64_t) a.y * b.y) + (uint64_t) ((int64_t) a.z * b.z));
+}
+
+/**
+ * @brief Gets the dot product of two Q16.16 3D vectors.
+ */
+NIMBLE_INLINE
+nFix16_t nFix16Vec3Dot(const nFix16Vec3_t a, const nFix16Vec3_t b)
+{
+    return nFix16Round(nFix16Vec3DotWide(a, b));
+}
+
+/**
+ * @brief Gets the cross product of two Q16.16 3D vectors.
+ */
+NIMBLE_INLINE
+nFix16Vec3_t nFix16Vec3Cross(const nFix16Vec3_t a, const nFix16Vec3_t b)
+{
+    return nFix16Vec3Set(
+     nFix16Round(((int64_t) a.y * b.z) - ((int64_t) a.z * b.y)),
+     nFix16Round(((int64_t) a.z * b.x) - ((int64_t) a.x * b.z)),
+     nFix16Round(((int64_t) a.x * b.y) - ((int64_t) a.y * b.x)));
+}
+
+/**
+ * @brief Gets the length of a Q16.16 3D vector, rounding down.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16_t nFix16Vec3Length(const nFix16Vec3_t a);
+
+/**
+ * @brief Scales a Q16.16 3D vector to a length of 1.
+ *
+ * @return The unit vector is returned, or a zero vector if @p a has no length.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Vec3_t nFix16Vec3Normalize(const nFix16Vec3_t a);
+
+/**
+ * @brief Gets the Q16.16 identity matrix.
+ */
+NIMBLE_INLINE
+nFix16Mat4_t nFix16Mat4Identity(void)
+{
+    return (nFix16Mat4_t) {{
+        NFIX16_ONE, 0, 0, 0,
+        0, NFIX16_ONE, 0, 0,
+        0, 0, NFIX16_ONE, 0,
+        0, 0, 0, NFIX16_ONE
+    }};
+}
+
+/**
+ * @brief Multiplies two Q16.16 matrices.
+ *
+ * @return @p a * @p b is returned, which applies @p b first.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Mat4_t nFix16Mat4Mul(const nFix16Mat4_t *const a,
+                           const nFix16Mat4_t *const b);
+
+/**
+ * @brief Transforms a point by a Q16.16 matrix, with a W of 1.
+ *
+ * @return The transformed point is returned. The bottom row of @p a is not
+ * used, so it should be an affine transform.
+ */
+NIMBLE_INLINE
+nFix16Vec3_t nFix16Mat4TransformPoint(const nFix16Mat4_t *const a,
+                                      const nFix16Vec3_t p)
+{
+    const nFix16_t *const m = a->m;
+    nFix16_t r[3];
+    for (int i = 0; i < 3; i++)
+    {
+        r[i] = nFix16Round((int64_t) ((uint64_t) ((int64_t) m[i] * p.x) +
+         (uint64_t) ((int64_t) m[4 + i] * p.y) +
+         (uint64_t) ((int64_t) m[8 + i] * p.z) +
+         ((uint64_t) (int64_t) m[12 + i] << 16)));
+    }
+    return nFix16Vec3Set(r[0], r[1], r[2]);
+}
+
+/**
+ * @brief Transforms an array of points by a Q16.16 matrix.
+ *
+ * The points are transformed with the widest integer instructions bound by
+ * nSimdBind(), giving the same result as nFix16Mat4TransformPoint() on every
+ * level.
+ *
+ * @param[in] a The affine transform.
+ * @param[in] in The points to transform.
+ * @param[out] out The @p count transformed points, which may be @p in.
+ * @param[in] count The number of points.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nFix16Mat4TransformPoints(const nFix16Mat4_t *const a,
+                               const nFix16Vec3_t *in, nFix16Vec3_t *out,
+                               const size_t count);
+
+/**
+ * @brief Makes a Q16.16 quaternion.
+ */
+NIMBLE_INLINE
+nFix16Quat_t nFix16QuatSet(const nFix16_t x, const nFix16_t y,
+                           const nFix16_t z, const nFix16_t w)
+{
+    return (nFix16Quat_t) {x, y, z, w};
+}
+
+/**
+ * @brief Gets the Q16.16 identity quaternion.
+ */
+NIMBLE_INLINE
+nFix16Quat_t nFix16QuatIdentity(void)
+{
+    return nFix16QuatSet(0, 0, 0, NFIX16_ONE);
+}
+
+/**
+ * @brief Gets the conjugate of a Q16.16 quaternion, the inverse of a unit
+ * quaternion.
+ */
+NIMBLE_INLINE
+nFix16Quat_t nFix16QuatConjugate(const nFix16Quat_t q)
+{
+    return nFix16QuatSet(-q.x, -q.y, -q.z, q.w);
+}
+
+/**
+ * @brief Multiplies two Q16.16 quaternions.
+ *
+ * @return @p a * @p b is returned, which rotates by @p b and then by @p a.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Quat_t nFix16QuatMul(const nFix16Quat_t a, const nFix16Quat_t b);
+
+/**
+ * @brief Makes a Q16.16 quaternion that rotates around an axis.
+ *
+ * @param[in] axis The unit axis.
+ * @param[in] angle The angle in radians, counterclockwise when looking down
+ * @p axis.
+ * @return The unit quaternion is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Quat_t nFix16QuatFromAxisAngle(const nFix16Vec3_t axis,
+                                     const nFix16_t angle);
+
+/**
+ * @brief Scales a Q16.16 quaternion to a length of 1.
+ *
+ * @return The unit quaternion is returned, or the identity if @p q has no
+ * length.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Quat_t nFix16QuatNormalize(const nFix16Quat_t q);
+
+/**
+ * @brief Rotates a Q16.16 3D vector by a unit quaternion.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Vec3_t nFix16QuatRotate(const nFix16Quat_t q, const nFix16Vec3_t v);
+
+/**
+ * @brief Interpolates between two Q16.16 unit quaternions along the shorter
+ * arc, normalizing the linear interpolation.
+ *
+ * @param[in] a The rotation at @p t = 0.
+ * @param[in] b The rotation at @p t = 1.
+ * @param[in] t The interpolant from 0 to 1.
+ * @return The unit quaternion is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nFix16Quat_t nFix16QuatNlerp(const nFix16Quat_t a, const nFix16Quat_t b,
+                             const nFix16_t t);
+
+#endif // NIMBLE_ENGINE_FIXEDPOINT_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// FixedPoint.h
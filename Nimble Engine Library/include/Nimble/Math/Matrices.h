@@ -0,0 +1,347 @@
+#include "../NimbleLicense.h"
+/*
+ * Matrices.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Matrices.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines 4x4 matrices and their math.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_MATRICES_H
+#define NIMBLE_ENGINE_MATRICES_H /**< Header definition */
+
+#include "../Nimble.h"
+#include "Vectors.h"
+
+#ifndef NMAT4_DEPTH_ZERO_TO_ONE
+#  define NMAT4_DEPTH_ZERO_TO_ONE 0 /**< Set to 1 for projections to clip depth to [0, 1] as Vulkan and Direct3D do, rather than [-1, 1] as OpenGL does. */
+#endif
+#ifndef NMAT4_PREFETCH
+#  define NMAT4_PREFETCH 16 /**< How many points ahead nMat4TransformPoints() prefetches. */
+#endif
+
+/**
+ * @brief A 4x4 matrix, stored column-major.
+ *
+ * Element (row, column) is @c m[(column * 4) + row], so @c col[3] holds the
+ * translation of an affine transform. Vectors are columns, multiplied on the
+ * right.
+ */
+typedef union nMat4 {
+    nVec4_t col[4]; /**< The columns. */
+    float m[16]; /**< The elements, column-major. */
+} nMat4_t;
+
+/**
+ * @brief The top three rows of an affine transform, whose bottom row is always
+ * 0, 0, 0, 1.
+ *
+ * This is 25% smaller than an #nMat4_t, which is the layout to upload to
+ * shaders or store per instance.
+ */
+typedef union nMat3x4 {
+    nVec4_t row[3]; /**< The rows. */
+    float m[12]; /**< The elements, row-major. */
+} nMat3x4_t;
+
+
+/**
+ * @brief Gets the identity matrix.
+ */
+NIMBLE_INLINE
+nMat4_t nMat4Identity(void)
+{
+    return (nMat4_t) {.col = {
+        nVec4Set(1.0f, 0.0f, 0.0f, 0.0f),
+        nVec4Set(0.0f, 1.0f, 0.0f, 0.0f),
+        nVec4Set(0.0f, 0.0f, 1.0f, 0.0f),
+        nVec4Set(0.0f, 0.0f, 0.0f, 1.0f)
+    }};
+}
+
+/**
+ * @brief Multiplies a 4D vector by a matrix.
+ *
+ * @return @p a * @p v is returned.
+ */
+NIMBLE_INLINE
+nVec4_t nMat4MulVec4(const nMat4_t a, const nVec4_t v)
+{
+    nVecReg_t r = nVecRegMul(a.col[0].m, nVecRegSplat(v.x));
+    r = nVecRegAdd(r, nVecRegMul(a.col[1].m, nVecRegSplat(v.y)));
+    r = nVecRegAdd(r, nVecRegMul(a.col[2].m, nVecRegSplat(v.z)));
+    r = nVecRegAdd(r, nVecRegMul(a.col[3].m, nVecRegSplat(v.w)));
+    return (nVec4_t) {.m = r};
+}
+
+/**
+ * @brief Multiplies two matrices.
+ *
+ * @return @p a * @p b is returned, which applies @p b and then @p a.
+ *
+ * @note To multiply arrays of matrices, use NSIMD.mat4Mul().
+ */
+NIMBLE_INLINE
+nMat4_t nMat4Mul(const nMat4_t a, const nMat4_t b)
+{
+    return (nMat4_t) {.col = {
+        nMat4MulVec4(a, b.col[0]),
+        nMat4MulVec4(a, b.col[1]),
+        nMat4MulVec4(a, b.col[2]),
+        nMat4MulVec4(a, b.col[3])
+    }};
+}
+
+/**
+ * @brief Transforms a point by a matrix, treating it as having a W of 1.
+ *
+ * @return The point is returned. The bottom row of @p a is ignored, so use
+ * nMat4MulVec4() for projections.
+ */
+NIMBLE_INLINE
+nVec3_t nMat4TransformPoint(const nMat4_t a, const nVec3_t p)
+{
+    nVecReg_t r = nVecRegAdd(a.col[3].m, nVecRegMul(a.col[0].m,
+     nVecRegSplat(p.x)));
+    r = nVecRegAdd(r, nVecRegMul(a.col[1].m, nVecRegSplat(p.y)));
+    r = nVecRegAdd(r, nVecRegMul(a.col[2].m, nVecRegSplat(p.z)));
+    nVec3_t point = {.m = r};
+    point.w = 0.0f;
+    return point;
+}
+
+/**
+ * @brief Transforms a direction by a matrix, treating it as having a W of 0,
+ * so translation does not apply.
+ */
+NIMBLE_INLINE
+nVec3_t nMat4TransformDir(const nMat4_t a, const nVec3_t d)
+{
+    nVecReg_t r = nVecRegMul(a.col[0].m, nVecRegSplat(d.x));
+    r = nVecRegAdd(r, nVecRegMul(a.col[1].m, nVecRegSplat(d.y)));
+    r = nVecRegAdd(r, nVecRegMul(a.col[2].m, nVecRegSplat(d.z)));
+    nVec3_t dir = {.m = r};
+    dir.w = 0.0f;
+    return dir;
+}
+
+/**
+ * @brief Transposes a matrix.
+ */
+NIMBLE_INLINE
+nMat4_t nMat4Transpose(const nMat4_t a)
+{
+#if defined(NVEC_SSE)
+    __m128 c0 = a.col[0].m, c1 = a.col[1].m, c2 = a.col[2].m, c3 = a.col[3].m;
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    return (nMat4_t) {.col = {{.m = c0}, {.m = c1}, {.m = c2}, {.m = c3}}};
+#elif defined(NVEC_NEON)
+    const float32x4x4_t t = vld4q_f32(a.m);
+    return (nMat4_t) {.col = {{.m = t.val[0]}, {.m = t.val[1]},
+     {.m = t.val[2]}, {.m = t.val[3]}}};
+#else
+    nMat4_t r;
+    for (int col = 0; col < 4; col++)
+    {
+        for (int row = 0; row < 4; row++) r.m[(col * 4) + row] = a.m[(row * 4) + col];
+    }
+    return r;
+#endif
+}
+
+/**
+ * @brief Makes a translation matrix.
+ */
+NIMBLE_INLINE
+nMat4_t nMat4Translation(const nVec3_t t)
+{
+    nMat4_t r = nMat4Identity();
+    r.col[3] = nVec4Set(t.x, t.y, t.z, 1.0f);
+    return r;
+}
+
+/**
+ * @brief Makes a scale matrix.
+ */
+NIMBLE_INLINE
+nMat4_t nMat4Scaling(const nVec3_t s)
+{
+    nMat4_t r = nMat4Identity();
+    r.m[0] = s.x;
+    r.m[5] = s.y;
+    r.m[10] = s.z;
+    return r;
+}
+
+/**
+ * @brief Converts an affine matrix to its compact form.
+ */
+NIMBLE_INLINE
+nMat3x4_t nMat3x4FromMat4(const nMat4_t a)
+{
+    const nMat4_t t = nMat4Transpose(a);
+    return (nMat3x4_t) {.row = {t.col[0], t.col[1], t.col[2]}};
+}
+
+/**
+ * @brief Expands the compact form of an affine matrix.
+ */
+NIMBLE_INLINE
+nMat4_t nMat4FromMat3x4(const nMat3x4_t a)
+{
+    const nMat4_t t = {.col = {a.row[0], a.row[1], a.row[2],
+     nVec4Set(0.0f, 0.0f, 0.0f, 1.0f)}};
+    return nMat4Transpose(t);
+}
+
+/**
+ * @brief Inverts an affine matrix, whose bottom row is 0, 0, 0, 1.
+ *
+ * This is several times cheaper than a general inverse, as only the upper 3x3
+ * is inverted. It allows scale and shear.
+ *
+ * @param[in] a The matrix to invert.
+ * @return The inverse is returned. If @p a is singular, it has infinite
+ * elements.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nMat4_t nMat4InverseAffine(const nMat4_t a);
+
+/**
+ * @brief Inverts a rigid transform, which only rotates and translates.
+ *
+ * This is the cheapest inverse, as the rotation is inverted by transposing it.
+ *
+ * @param[in] a The matrix to invert.
+ * @return The inverse is returned. If @p a scales, the result is wrong, so use
+ * nMat4InverseAffine() instead.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nMat4_t nMat4InverseRigid(const nMat4_t a);
+
+/**
+ * @brief Makes a right-handed view matrix.
+ *
+ * @param[in] eye The position of the camera.
+ * @param[in] target The position the camera looks at.
+ * @param[in] up The up direction of the world, which must not be parallel to
+ * the view direction.
+ * @return The matrix that transforms world space to view space, where the
+ * camera looks down -Z, is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nMat4_t nMat4LookAt(const nVec3_t eye, const nVec3_t target, const nVec3_t up);
+
+/**
+ * @brief Makes a right-handed perspective projection matrix.
+ *
+ * @param[in] fovY The vertical field of view in radians.
+ * @param[in] aspect The width of the view divided by its height.
+ * @param[in] nearZ The distance to the near plane, which must be positive.
+ * @param[in] farZ The distance to the far plane.
+ * @return The matrix that transforms view space to clip space is returned.
+ * Depth is clipped to [-1, 1], or [0, 1] if #NMAT4_DEPTH_ZERO_TO_ONE is set.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nMat4_t nMat4Perspective(const float fovY, const float aspect,
+                         const float nearZ, const float farZ);
+
+/**
+ * @brief Makes a right-handed orthographic projection matrix.
+ *
+ * @param[in] left The left edge of the view.
+ * @param[in] right The right edge of the view.
+ * @param[in] bottom The bottom edge of the view.
+ * @param[in] top The top edge of the view.
+ * @param[in] nearZ The distance to the near plane.
+ * @param[in] farZ The distance to the far plane.
+ * @return The projection matrix is returned, with depth clipped as by
+ * nMat4Perspective().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nMat4_t nMat4Orthographic(const float left, const float right,
+                          const float bottom, const float top,
+                          const float nearZ, const float farZ);
+
+/**
+ * @brief Transforms an array of points by a matrix, as
+ * nMat4TransformPoint() does.
+ *
+ * The points are transformed 2 at a time with AVX2 and 4 at a time with
+ * AVX-512, prefetching #NMAT4_PREFETCH points ahead.
+ *
+ * @param[in] a The matrix.
+ * @param[in] in The points to transform.
+ * @param[out] out The @p count transformed points, which may be @p in.
+ * @param[in] count The number of points.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nMat4TransformPoints(const nMat4_t *const a, const nVec3_t *in,
+                          nVec3_t *out, const size_t count);
+
+/**
+ * @brief Transforms an array of points stored as structure of arrays, as
+ * nMat4TransformPoint() does.
+ *
+ * This is faster than nMat4TransformPoints(), as every lane of a register does
+ * useful work: 4, 8 or 16 points are transformed per instruction.
+ *
+ * @param[in] a The matrix.
+ * @param[in] in The points to transform.
+ * @param[out] out The @p count transformed points, which may be @p in.
+ * @param[in] count The number of points.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nMat4TransformPointsSoA(const nMat4_t *const a, const nVec3SoA_t in,
+                             const nVec3SoA_t out, const size_t count);
+
+#endif // NIMBLE_ENGINE_MATRICES_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Matrices.h
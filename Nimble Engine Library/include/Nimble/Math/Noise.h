@@ -0,0 +1,273 @@
+#include "../NimbleLicense.h"
+/*
+ * Noise.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Noise.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines SIMD gradient and simplex noise.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_NOISE_H
+#define NIMBLE_ENGINE_NOISE_H /**< Header definition */
+
+#include "../Nimble.h"
+#include "Vectors.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NNOISE_GRADIENT 0 /**< Gradient (Perlin) noise, interpolated between the corners of a square lattice. */
+#define NNOISE_SIMPLEX  1 /**< Simplex noise, summed over the corners of a simplex lattice, which scales better to 4D. */
+
+#define NNOISE_FBM    0 /**< Fractal Brownian motion, which sums the octaves as they are. */
+#define NNOISE_RIDGED 1 /**< Ridged noise, which sums (1 - |n|)^2 of each octave for sharp ridges. */
+
+#define NNOISE_MAX_OCTAVES 16 /**< The most octaves of one noise. */
+
+/**
+ * @brief The settings of a fractal noise.
+ *
+ * Each octave samples the basis at @c lacunarity times the frequency and
+ * @c gain times the amplitude of the octave before it, with its own seed.
+ * Where @c warpAmplitude is not zero, the points are first displaced by
+ * another noise of @c warpFrequency along each axis.
+ *
+ * @note Initialize settings with #NNOISE_INIT, then change what is needed.
+ */
+typedef struct nNoise {
+    int basis; /**< #NNOISE_GRADIENT or #NNOISE_SIMPLEX. */
+    int dimensions; /**< 2, 3 or 4. */
+    int fractal; /**< #NNOISE_FBM or #NNOISE_RIDGED. */
+    uint32_t seed; /**< The seed, which selects an unrelated noise for each value. */
+    uint32_t octaves; /**< The number of octaves, from 1 to #NNOISE_MAX_OCTAVES. */
+    float frequency; /**< The frequency of the first octave. */
+    float lacunarity; /**< The frequency of each octave over the one before it. */
+    float gain; /**< The amplitude of each octave over the one before it. */
+    float warpAmplitude; /**< The greatest displacement of the points, or 0 to not warp them. */
+    float warpFrequency; /**< The frequency of the warp noise. */
+} nNoise_t;
+
+/**
+ * @brief The initializer of one octave of @p basis noise in @p dimensions
+ * dimensions, with a lacunarity of 2 and a gain of 0.5 for more octaves.
+ */
+#define NNOISE_INIT(basis, dimensions, seed) \
+ {(basis), (dimensions), NNOISE_FBM, (seed), 1, 1.0f, 2.0f, 0.5f, 0.0f, 1.0f}
+
+/**
+ * @brief A grid of samples, such as a chunk of terrain.
+ *
+ * Sample (x, y, z) is at @c step times (@c origin + (x, y, z)), and is
+ * stored at (z * @c size[1] + y) * @c size[0] + x. Positions are computed from
+ * the integer index of each sample, so neighbouring grids sample the same
+ * positions where they meet.
+ */
+typedef struct nNoiseGrid {
+    int32_t origin[3]; /**< The index of the first sample along each axis. */
+    uint32_t size[3]; /**< The number of samples along each axis. 2D noise ignores Z, so size[2] is usually 1. */
+    float step; /**< The distance between neighbouring samples. */
+    float w; /**< The W coordinate of every sample of 4D noise. */
+} nNoiseGrid_t;
+
+/**
+ * @brief Samples noise at an array of points.
+ *
+ * The points are evaluated 16 at a time with the kernels bound by
+ * nSimdBind(). Samples of the same noise differ slightly between SIMD levels,
+ * as fused multiply-adds round differently, so generate a world at one level.
+ *
+ * @param[out] dst The @p count samples. Fractal Brownian motion is about -1
+ * to 1, and ridged noise is 0 to 1.
+ * @param[in] noise The noise to sample.
+ * @param[in] points The points. Components past @p noise->dimensions are
+ * ignored, and may be #NULL.
+ * @param[in] count The number of points.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an array is #NULL, or #NERROR_INV_ARG if @p noise is not valid.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nNoiseSample(float *dst, const nNoise_t *const noise,
+                 const nVec4SoA_t points, const size_t count);
+
+/**
+ * @brief Fills a grid with noise across several threads.
+ *
+ * The rows of the grid are shared between the calling thread and up to
+ * @p threads - 1 worker threads, which take rows as they finish them. Small
+ * grids use fewer threads, as starting one costs about as much as sampling a
+ * few thousand points.
+ *
+ * @param[out] dst The samples, as described by #nNoiseGrid_t.
+ * @param[in] noise The noise to sample.
+ * @param[in] grid The grid to fill.
+ * @param[in] threads The most threads to use, or 0 for one per logical
+ * processor.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, or #NERROR_INV_ARG if @p noise is not
+ * valid. If worker threads cannot be started, the calling thread fills the
+ * rest of the grid.
+ *
+ * @see nNoiseSample()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nNoiseFillGrid(float *dst, const nNoise_t *const noise,
+                   const nNoiseGrid_t *const grid, uint32_t threads);
+
+/**
+ * @brief A cache of noise tiles shared by the threads that generate a world.
+ *
+ * A tile is the block of samples of an #nNoiseGrid_t whose origin is its tile
+ * coordinate times the tile size. Tiles are keyed by the settings of their
+ * noise, the step and W of their grid, and their tile coordinate, and are
+ * stored in one arena allocated with the cache. When a new tile is needed,
+ * the least recently used tile that no thread holds is replaced.
+ *
+ * Looking up a tile takes a short lock. The samples of a held tile are read
+ * without locking, so any number of threads can read the same tiles at once.
+ * A missing tile is generated by the thread that first asks for it, and
+ * other threads that ask for it meanwhile wait for it.
+ */
+typedef struct nNoiseCache nNoiseCache_t;
+
+/**
+ * @brief Creates a noise tile cache.
+ *
+ * @param[out] cache The created cache.
+ * @param[in] size The number of samples of each tile along X, Y and Z. Use a
+ * Z size of 1 for 2D noise.
+ * @param[in] capacity The number of tiles that fit in the arena.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, #NERROR_INV_ARG if a size is zero or the
+ * arena is too large, or #NERROR_NO_MEMORY if the arena could not be
+ * allocated.
+ *
+ * @note Destroy the cache with nNoiseCacheDestroy().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nNoiseCacheCreate(nNoiseCache_t **cache, const uint32_t size[3],
+                      const uint32_t capacity);
+
+/**
+ * @brief Destroys a noise tile cache and frees its arena.
+ *
+ * @param[in,out] cache The cache to destroy, which is set to #NULL.
+ *
+ * @note No thread may hold a tile of the cache.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nNoiseCacheDestroy(nNoiseCache_t **cache);
+
+/**
+ * @brief Gets a tile of noise, generating it if it is not cached.
+ *
+ * The tile is held until nNoiseCacheRelease() is called, so that it is not
+ * replaced while it is read.
+ *
+ * @param[out] samples The samples of the tile, laid out as an #nNoiseGrid_t of
+ * the tile size.
+ * @param[in] cache The cache.
+ * @param[in] noise The noise of the tile.
+ * @param[in] step The distance between neighbouring samples.
+ * @param[in] w The W coordinate of 4D noise, which other noise ignores.
+ * @param[in] tile The tile coordinate. 2D noise ignores Z.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, #NERROR_INV_ARG if @p noise is not valid,
+ * or #NERROR_NO_MEMORY if every tile of the cache is held.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nNoiseCacheAcquire(const float **samples, nNoiseCache_t *const cache,
+                       const nNoise_t *const noise, const float step,
+                       const float w, const int32_t tile[3]);
+
+/**
+ * @brief Lets a tile from nNoiseCacheAcquire() be replaced again.
+ *
+ * @param[in] cache The cache of the tile.
+ * @param[in] samples The samples of the tile.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nNoiseCacheRelease(nNoiseCache_t *const cache, const float *samples);
+
+/**
+ * @brief Fills a grid with noise from the tiles of a cache.
+ *
+ * The grid may have any origin and size. Each tile it covers is taken from
+ * the cache, or generated once, and its part of the grid is copied.
+ *
+ * @param[out] dst The samples, as described by #nNoiseGrid_t.
+ * @param[in] cache The cache.
+ * @param[in] noise The noise to sample.
+ * @param[in] grid The grid to fill.
+ * @return #NSUCCESS is returned if successful; otherwise an error of
+ * nNoiseCacheAcquire() is returned.
+ *
+ * @see nNoiseFillGrid()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nNoiseCacheFillGrid(float *dst, nNoiseCache_t *const cache,
+                        const nNoise_t *const noise,
+                        const nNoiseGrid_t *const grid);
+
+/**
+ * @brief Gets the number of tiles found in a cache and generated for it.
+ *
+ * @param[in] cache The cache.
+ * @param[out] hits The number of requested tiles that were cached, or #NULL.
+ * @param[out] misses The number of requested tiles that were generated, or
+ * #NULL.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nNoiseCacheStats(const nNoiseCache_t *const cache, uint64_t *hits,
+                      uint64_t *misses);
+
+#endif // NIMBLE_ENGINE_NOISE_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Noise.h
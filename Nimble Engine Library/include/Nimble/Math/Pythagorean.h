@@ -0,0 +1,275 @@
+#include "../NimbleLicense.h"
+/*
+ * Pythagorean.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Pythagorean.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines distances and their math.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_PYTHAGOREAN_H
+#define NIMBLE_ENGINE_PYTHAGOREAN_H /**< Header definition */
+
+#include "../Nimble.h"
+#include "Vectors.h"
+
+/**
+ * @brief Checks if a float is infinite from its bits.
+ *
+ * Unlike @c isinf(), this still works when the engine is built with fast math,
+ * which assumes there are no infinities and folds @c isinf() to false.
+ *
+ * @param[in] x The float to check.
+ * @return Nonzero is returned if @p x is positive or negative infinity.
+ */
+NIMBLE_INLINE
+int nFloatIsInf(const float x)
+{
+    const union {
+        float f;
+        uint32_t i;
+    } u = {.f = x};
+    return (u.i & 0x7fffffffU) == 0x7f800000U;
+}
+
+/**
+ * @brief Gets the length of the hypotenuse of a right triangle without
+ * overflow or underflow.
+ *
+ * The legs are scaled by the largest of them before they are squared, so that
+ * legs near @c FLT_MAX or the smallest normal float still give an accurate
+ * result. Use nVec3DistanceSq() when only comparing distances.
+ *
+ * @param[in] x The first leg.
+ * @param[in] y The second leg.
+ * @return The square root of @p x squared plus @p y squared is returned, or
+ * infinity if either leg is infinite.
+ */
+NIMBLE_INLINE
+float nHypot2(const float x, const float y)
+{
+    const float ax = fabsf(x), ay = fabsf(y);
+    const float big = (ax > ay) ? ax : ay;
+    const float small = (ax > ay) ? ay : ax;
+    if ((big == 0.0f) || nFloatIsInf(big)) return big;
+
+    const float r = small / big;
+    return big * sqrtf(1.0f + (r * r));
+}
+
+/**
+ * @brief Gets the length of a 3D hypotenuse without overflow or underflow.
+ *
+ * @param[in] x The X component.
+ * @param[in] y The Y component.
+ * @param[in] z The Z component.
+ * @return The square root of the sum of the squared components is returned, or
+ * infinity if any component is infinite.
+ *
+ * @see nHypot2()
+ */
+NIMBLE_INLINE
+float nHypot3(const float x, const float y, const float z)
+{
+    const float ax = fabsf(x), ay = fabsf(y), az = fabsf(z);
+    float big = (ax > ay) ? ax : ay;
+    big = (az > big) ? az : big;
+    if ((big == 0.0f) || nFloatIsInf(big)) return big;
+
+    const float inv = 1.0f / big;
+    const float rx = ax * inv, ry = ay * inv, rz = az * inv;
+    return big * sqrtf((rx * rx) + (ry * ry) + (rz * rz));
+}
+
+/**
+ * @brief Approximates the reciprocal of a square root.
+ *
+ * The estimate instruction of the CPU is refined with one Newton-Raphson step,
+ * for a relative error under 0.00002%. Where there is no estimate instruction,
+ * an integer approximation is refined instead, for a relative error under
+ * 0.2%. This is faster than <tt>1.0f / sqrtf(x)</tt> where an approximation is
+ * enough, such as normalizing directions.
+ *
+ * @param[in] x The positive number.
+ * @return The approximate reciprocal of the square root of @p x is returned.
+ */
+NIMBLE_INLINE
+float nRsqrt(const float x)
+{
+#if defined(NVEC_SSE)
+    const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - (0.5f * x * y * y));
+#elif defined(NVEC_NEON)
+    const float y = vrsqrtes_f32(x);
+    return y * vrsqrtss_f32(x * y, y);
+#else
+    union {
+        float f;
+        uint32_t i;
+    } u = {.f = x};
+    u.i = 0x5f375a86U - (u.i >> 1);
+    const float y = u.f;
+    return y * (1.5f - (0.5f * x * y * y));
+#endif
+}
+
+/**
+ * @brief Gets the squared distance between two 3D points.
+ */
+NIMBLE_INLINE
+float nVec3DistanceSq(const nVec3_t a, const nVec3_t b)
+{
+    const nVec3_t d = nVec3Sub(b, a);
+    return nVec3Dot(d, d);
+}
+
+/**
+ * @brief Gets the distance between two 3D points without overflow or
+ * underflow.
+ *
+ * @see nHypot3()
+ */
+NIMBLE_INLINE
+float nVec3Distance(const nVec3_t a, const nVec3_t b)
+{
+    return nHypot3(b.x - a.x, b.y - a.y, b.z - a.z);
+}
+
+/**
+ * @brief Gets the distance between two 2D points without overflow or
+ * underflow.
+ *
+ * @see nHypot2()
+ */
+NIMBLE_INLINE
+float nVec2Distance(const nVec2_t a, const nVec2_t b)
+{
+    return nHypot2(b.x - a.x, b.y - a.y);
+}
+
+
+/* Batch functions
+ * These process structure of arrays with the widest instructions bound by
+ * nSimdBind(), like the batch functions of Vectors.h. They square distances
+ * rather than scaling them, as proximity queries compare distances within the
+ * range of a world, so a point must be less than about 1.8e19 units from the
+ * origin of a query. Point indices are 32 bits, so @p count must be less than
+ * @c UINT32_MAX. */
+
+/**
+ * @brief Approximates the reciprocals of the square roots of an array.
+ *
+ * @param[out] dst The @p count reciprocals. This may be the same as @p src.
+ * @param[in] src The positive numbers.
+ * @param[in] count The number of numbers.
+ *
+ * @see nRsqrt()
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nRsqrtArray(float *dst, const float *src, const size_t count);
+
+/**
+ * @brief Computes the squared distances from one point to an array of points.
+ *
+ * @param[out] dst The @p count squared distances.
+ * @param[in] points The points.
+ * @param[in] origin The point to measure from.
+ * @param[in] count The number of points.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec3DistanceSqSoA(float *dst, const nVec3SoA_t points,
+                        const nVec3_t origin, const size_t count);
+
+/**
+ * @brief Finds the points within a radius of a point.
+ *
+ * Blocks of points with none in the radius are rejected after comparing their
+ * squared distances, so sparse queries such as aggro and interest radii mostly
+ * cost the distance computation.
+ *
+ * @param[out] indices The indices of the points in the radius, in ascending
+ * order. This must have room for @p count indices.
+ * @param[in] points The points.
+ * @param[in] origin The center of the radius.
+ * @param[in] radius The radius. Points exactly on it are excluded.
+ * @param[in] count The number of points.
+ * @return The number of indices written to @p indices is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+size_t nVec3WithinRadiusSoA(uint32_t *indices, const nVec3SoA_t points,
+                            const nVec3_t origin, const float radius,
+                            const size_t count);
+
+/**
+ * @brief Finds the nearest points to a point.
+ *
+ * A block of points is rejected unless one is nearer than the farthest of the
+ * nearest points found so far, so once @p k points are found, most points
+ * cost only the distance computation.
+ *
+ * @param[out] indices The indices of the nearest points, nearest first. This
+ * must have room for @p k indices.
+ * @param[out] distSq The squared distances of the nearest points, which are
+ * also used to track them while searching. This must have room for @p k
+ * distances.
+ * @param[in] k The number of points to find.
+ * @param[in] points The points.
+ * @param[in] origin The point to measure from.
+ * @param[in] radius The radius to search in. Use @c INFINITY to search every
+ * point.
+ * @param[in] count The number of points.
+ * @return The number of points found is returned, which is less than @p k if
+ * fewer than @p k points are within @p radius.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+size_t nVec3NearestSoA(uint32_t *indices, float *distSq, const size_t k,
+                       const nVec3SoA_t points, const nVec3_t origin,
+                       const float radius, const size_t count);
+
+#endif // NIMBLE_ENGINE_PYTHAGOREAN_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Pythagorean.h
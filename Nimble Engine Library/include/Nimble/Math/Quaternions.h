@@ -0,0 +1,289 @@
+#include "../NimbleLicense.h"
+/*
+ * Quaternions.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Quaternions.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines quaternions and their math.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_QUATERNIONS_H
+#define NIMBLE_ENGINE_QUATERNIONS_H /**< Header definition */
+
+#include "../Nimble.h"
+#include "Matrices.h"
+#include "Vectors.h"
+
+/**
+ * @brief A rotation quaternion, x i + y j + z k + w.
+ */
+typedef union nQuat {
+    struct {
+        float x; /**< The I component. */
+        float y; /**< The J component. */
+        float z; /**< The K component. */
+        float w; /**< The real component. */
+    };
+    float v[4]; /**< The components as an array. */
+    nVecReg_t m; /**< The components as a register. */
+} nQuat_t;
+
+
+/**
+ * @brief Makes a quaternion.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatSet(const float x, const float y, const float z, const float w)
+{
+    return (nQuat_t) {.m = nVecRegSet(x, y, z, w)};
+}
+
+/**
+ * @brief Gets the quaternion that does not rotate.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatIdentity(void)
+{
+    return nQuatSet(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Makes a quaternion that rotates around an axis.
+ *
+ * @param[in] axis The unit axis to rotate around.
+ * @param[in] angle The angle to rotate by in radians, counter-clockwise when
+ * looking down @p axis.
+ * @return The quaternion is returned.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatFromAxisAngle(const nVec3_t axis, const float angle)
+{
+    const float s = sinf(angle * 0.5f);
+    return nQuatSet(axis.x * s, axis.y * s, axis.z * s, cosf(angle * 0.5f));
+}
+
+/**
+ * @brief Gets the dot product of two quaternions, which is the cosine of half
+ * the angle between them.
+ */
+NIMBLE_INLINE
+float nQuatDot(const nQuat_t a, const nQuat_t b)
+{
+    return nVecRegSum4(nVecRegMul(a.m, b.m));
+}
+
+/**
+ * @brief Gets the inverse of a unit quaternion.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatConjugate(const nQuat_t a)
+{
+    return nQuatSet(-a.x, -a.y, -a.z, a.w);
+}
+
+/**
+ * @brief Scales a quaternion to a length of 1.
+ *
+ * @return The unit quaternion is returned, or the identity if @p a has no
+ * length.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatNormalize(const nQuat_t a)
+{
+    const float len = sqrtf(nQuatDot(a, a));
+    return (len > 0.0f) ? (nQuat_t) {.m = nVecRegMul(a.m,
+     nVecRegSplat(1.0f / len))} : nQuatIdentity();
+}
+
+/**
+ * @brief Multiplies two quaternions.
+ *
+ * @return @p a * @p b is returned, which rotates by @p b and then by @p a.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatMul(const nQuat_t a, const nQuat_t b)
+{
+#if defined(NVEC_SSE)
+    /* Each component of a scales b, shuffled and with some signs flipped. */
+    const __m128 xSigns = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const __m128 ySigns = _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f);
+    const __m128 zSigns = _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f);
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(a.m, a.m, 0xff), b.m);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a.m, a.m, 0x00),
+     _mm_xor_ps(_mm_shuffle_ps(b.m, b.m, 0x1b), xSigns)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a.m, a.m, 0x55),
+     _mm_xor_ps(_mm_shuffle_ps(b.m, b.m, 0x4e), ySigns)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a.m, a.m, 0xaa),
+     _mm_xor_ps(_mm_shuffle_ps(b.m, b.m, 0xb1), zSigns)));
+    return (nQuat_t) {.m = r};
+#else
+    return nQuatSet(
+     (a.w * b.x) + (a.x * b.w) + (a.y * b.z) - (a.z * b.y),
+     (a.w * b.y) - (a.x * b.z) + (a.y * b.w) + (a.z * b.x),
+     (a.w * b.z) + (a.x * b.y) - (a.y * b.x) + (a.z * b.w),
+     (a.w * b.w) - (a.x * b.x) - (a.y * b.y) - (a.z * b.z));
+#endif
+}
+
+/**
+ * @brief Rotates a vector by a unit quaternion.
+ */
+NIMBLE_INLINE
+nVec3_t nQuatRotate(const nQuat_t q, const nVec3_t v)
+{
+    /* v + w t + u x t, where u is the vector part of q and t = 2 u x v. */
+    const nVec3_t u = nVec3Set(q.x, q.y, q.z);
+    const nVec3_t t = nVec3Scale(nVec3Cross(u, v), 2.0f);
+    return nVec3Add(nVec3Add(v, nVec3Scale(t, q.w)), nVec3Cross(u, t));
+}
+
+/**
+ * @brief Adjusts the interpolant of nQuatNlerp() so that the result follows
+ * nQuatSlerp() closely.
+ *
+ * @param[in] t The interpolant.
+ * @param[in] d The absolute dot product of the quaternions.
+ * @return The adjusted interpolant is returned.
+ */
+NIMBLE_INLINE
+float nQuatNlerpAdjust(const float t, const float d)
+{
+    /* A cubic correction fitted to slerp over the whole range of d. */
+    const float a = 1.0904f + (d * (-3.2452f + (d * (3.55645f -
+     (d * 1.43519f)))));
+    const float b = 0.848013f + (d * (-1.06021f + (d * 0.215638f)));
+    const float k = (a * (t - 0.5f) * (t - 0.5f)) + b;
+    return t + (t * (t - 0.5f) * (t - 1.0f) * k);
+}
+
+/**
+ * @brief Interpolates between two unit quaternions along the shortest path,
+ * approximating nQuatSlerp() with a polynomial.
+ *
+ * This is several times faster than nQuatSlerp(), as it needs no
+ * trigonometry, and its angle differs by less than 0.001 radians.
+ *
+ * @param[in] a The rotation at @p t = 0.
+ * @param[in] b The rotation at @p t = 1.
+ * @param[in] t The interpolant, from 0 to 1.
+ * @return The unit quaternion is returned.
+ */
+NIMBLE_INLINE
+nQuat_t nQuatNlerp(const nQuat_t a, const nQuat_t b, const float t)
+{
+    const float d = nQuatDot(a, b);
+    const float adjusted = nQuatNlerpAdjust(t, fabsf(d));
+    /* q and -q are the same rotation, so take the nearer one. */
+    const nVecReg_t bNear = (d < 0.0f) ? nVecRegMul(b.m, nVecRegSplat(-1.0f)) :
+     b.m;
+    return nQuatNormalize((nQuat_t) {.m = nVecRegAdd(a.m, nVecRegMul(
+     nVecRegSub(bNear, a.m), nVecRegSplat(adjusted)))});
+}
+
+/**
+ * @brief Spherically interpolates between two unit quaternions along the
+ * shortest path, at a constant angular velocity.
+ *
+ * @param[in] a The rotation at @p t = 0.
+ * @param[in] b The rotation at @p t = 1.
+ * @param[in] t The interpolant, from 0 to 1.
+ * @return The unit quaternion is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nQuat_t nQuatSlerp(const nQuat_t a, const nQuat_t b, const float t);
+
+/**
+ * @brief Converts a unit quaternion to a rotation matrix.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nMat4_t nQuatToMat4(const nQuat_t q);
+
+/**
+ * @brief Converts the rotation of a matrix to a quaternion.
+ *
+ * @param[in] a The matrix, whose upper 3x3 must be a rotation without scale.
+ * @return The unit quaternion is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nQuat_t nQuatFromMat4(const nMat4_t a);
+
+/**
+ * @brief Multiplies arrays of quaternions, computing @p dst[i] = @p a[i] *
+ * @p b[i].
+ *
+ * This composes rotations 2 at a time with AVX2 and 4 at a time with AVX-512.
+ *
+ * @param[out] dst The @p count products, which may be @p a or @p b.
+ * @param[in] a The left quaternions.
+ * @param[in] b The right quaternions.
+ * @param[in] count The number of quaternions in each array.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nQuatMulArray(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+                   const size_t count);
+
+/**
+ * @brief Blends arrays of unit quaternions, such as the joints of two poses,
+ * as nQuatNlerp() does.
+ *
+ * This blends rotations 2 at a time with AVX2 and 4 at a time with AVX-512.
+ *
+ * @param[out] dst The @p count blended quaternions, which may be @p a or
+ * @p b.
+ * @param[in] a The rotations at @p t = 0.
+ * @param[in] b The rotations at @p t = 1.
+ * @param[in] t The interpolant, from 0 to 1.
+ * @param[in] count The number of quaternions in each array.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nQuatNlerpArray(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+                     const float t, const size_t count);
+
+#endif // NIMBLE_ENGINE_QUATERNIONS_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Quaternions.h
@@ -0,0 +1,247 @@
+#include "../NimbleLicense.h"
+/*
+ * RayMarching.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file RayMarching.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines a CPU ray marcher for scenes of signed distance
+ * fields.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_RAYMARCHING_H
+#define NIMBLE_ENGINE_RAYMARCHING_H /**< Header definition */
+
+#include "../Nimble.h"
+#include "Vectors.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NRAY_OP_SPHERE         0 /**< A sphere: center X, Y, Z and radius. */
+#define NRAY_OP_BOX            1 /**< A box along the axes: center X, Y, Z, half extents X, Y, Z and the radius of its rounded edges. */
+#define NRAY_OP_PLANE          2 /**< A plane: normal X, Y, Z and distance from the origin along the normal. Points behind it are inside. */
+#define NRAY_OP_CAPSULE        3 /**< A capsule: end A X, Y, Z, end B X, Y, Z and radius. */
+#define NRAY_OP_TORUS          4 /**< A torus around the Y axis: center X, Y, Z, major radius and minor radius. */
+#define NRAY_OP_CYLINDER       5 /**< A capped cylinder along the Y axis: center X, Y, Z, radius and half height. */
+#define NRAY_OP_UNION          6 /**< The union of both children. */
+#define NRAY_OP_INTERSECTION   7 /**< The intersection of both children. */
+#define NRAY_OP_SUBTRACTION    8 /**< The first child with the second child cut out of it. */
+#define NRAY_OP_SMOOTH_UNION   9 /**< The union of both children, blended where they are closer than the first parameter. */
+
+#define NRAY_MAX_STACK 32 /**< The most distances a scene holds at once while it is evaluated. */
+#define NRAY_MAX_CODE 65536 /**< The most instructions of a compiled scene. */
+#define NRAY_MISS (-1.0f) /**< The distance of a ray that hits nothing. */
+
+/**
+ * @brief A node of a scene of signed distance fields.
+ *
+ * Primitives use @c params as described by their operation, and ignore
+ * @c children. Operations combine the nodes at the indices in @c children,
+ * which must come before the node in the array, so that the nodes form a
+ * tree or a graph without cycles.
+ *
+ * @note Make nodes with the NRAY_*_NODE() initializers.
+ */
+typedef struct nRayNode {
+    int op; /**< One of the NRAY_OP_* operations. */
+    uint32_t children[2]; /**< The indices of the nodes combined by an operation. */
+    float params[7]; /**< The parameters of the operation. */
+} nRayNode_t;
+
+#define NRAY_SPHERE_NODE(x, y, z, radius) \
+ {NRAY_OP_SPHERE, {0, 0}, {(x), (y), (z), (radius)}} /**< The initializer of a sphere. */
+#define NRAY_BOX_NODE(x, y, z, hx, hy, hz, rounding) \
+ {NRAY_OP_BOX, {0, 0}, {(x), (y), (z), (hx), (hy), (hz), (rounding)}} /**< The initializer of a box. */
+#define NRAY_PLANE_NODE(nx, ny, nz, distance) \
+ {NRAY_OP_PLANE, {0, 0}, {(nx), (ny), (nz), (distance)}} /**< The initializer of a plane. */
+#define NRAY_CAPSULE_NODE(ax, ay, az, bx, by, bz, radius) \
+ {NRAY_OP_CAPSULE, {0, 0}, {(ax), (ay), (az), (bx), (by), (bz), (radius)}} /**< The initializer of a capsule. */
+#define NRAY_TORUS_NODE(x, y, z, major, minor) \
+ {NRAY_OP_TORUS, {0, 0}, {(x), (y), (z), (major), (minor)}} /**< The initializer of a torus. */
+#define NRAY_CYLINDER_NODE(x, y, z, radius, halfHeight) \
+ {NRAY_OP_CYLINDER, {0, 0}, {(x), (y), (z), (radius), (halfHeight)}} /**< The initializer of a cylinder. */
+#define NRAY_CSG_NODE(op, a, b) \
+ {(op), {(a), (b)}, {0}} /**< The initializer of a union, intersection or subtraction of nodes @p a and @p b. */
+#define NRAY_SMOOTH_UNION_NODE(a, b, blend) \
+ {NRAY_OP_SMOOTH_UNION, {(a), (b)}, {(blend)}} /**< The initializer of a smooth union of nodes @p a and @p b. */
+
+/**
+ * @brief A scene compiled to flat bytecode.
+ *
+ * The nodes are written in postfix order, so that a scene is evaluated in one
+ * pass over its instructions with a small stack of distances. The children of
+ * unions and intersections are ordered to keep the stack shallow.
+ */
+typedef struct nRayScene nRayScene_t;
+
+/**
+ * @brief The settings of sphere tracing.
+ *
+ * Each step moves a ray @c relaxation times the distance to the scene. Where
+ * the sphere of a step does not overlap the sphere before it, or the step
+ * ends inside the scene, the step may have passed a surface, so the ray goes
+ * back to the end of a plain step and stops over-relaxing. Only the ends of
+ * plain or verified steps count as hits or as passing the greatest distance.
+ *
+ * @note Initialize settings with #NRAY_MARCH_INIT, then change what is needed.
+ */
+typedef struct nRayMarch {
+    float epsilon; /**< The distance to a surface that counts as hitting it. */
+    float relaxation; /**< The over-relaxation, from 1 for plain sphere tracing to below 2. */
+    uint32_t maxSteps; /**< The most steps of one ray. */
+} nRayMarch_t;
+
+/**
+ * @brief The initializer of settings with an epsilon of 0.001, a relaxation
+ * of 1.6 and 128 steps.
+ */
+#define NRAY_MARCH_INIT {0.001f, 1.6f, 128}
+
+/**
+ * @brief Compiles a scene of signed distance fields.
+ *
+ * @param[out] scene The scene, which is destroyed with nRaySceneDestroy().
+ * @param[in] nodes The nodes of the scene.
+ * @param[in] count The number of nodes.
+ * @param[in] root The index of the node of the whole scene.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, #NERROR_INV_ARG if a node is not valid or
+ * the scene needs more than #NRAY_MAX_STACK distances or #NRAY_MAX_CODE
+ * instructions, or #NERROR_NO_MEMORY if the scene could not be allocated.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRaySceneCompile(nRayScene_t **scene, const nRayNode_t *nodes,
+                     const uint32_t count, const uint32_t root);
+
+/**
+ * @brief Destroys a scene compiled by nRaySceneCompile().
+ *
+ * @param[in,out] scene The scene, which is set to #NULL.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nRaySceneDestroy(nRayScene_t **scene);
+
+/**
+ * @brief Evaluates the signed distance from points to a scene.
+ *
+ * @param[out] dst The @p count distances, which are negative inside.
+ * @param[in] scene The scene.
+ * @param[in] points The points.
+ * @param[in] count The number of points.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRaySceneDistance(float *dst, const nRayScene_t *const scene,
+                      const nVec3SoA_t points, const size_t count);
+
+/**
+ * @brief Gets the normals of a scene at points, such as the hit points of
+ * rays.
+ *
+ * The normal is the gradient of the distance, estimated from four samples
+ * @p h away from each point.
+ *
+ * @param[out] dst The @p count normals, which are normalized.
+ * @param[in] scene The scene.
+ * @param[in] points The points.
+ * @param[in] count The number of points.
+ * @param[in] h The distance of the samples, about the epsilon of the rays.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, or #NERROR_INV_ARG if @p h is not
+ * positive.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRaySceneNormal(const nVec3SoA_t dst, const nRayScene_t *const scene,
+                    const nVec3SoA_t points, const size_t count,
+                    const float h);
+
+/**
+ * @brief Checks the settings of sphere tracing.
+ * @param[in] march The settings to check.
+ * @return One (1) is returned if @p march has a positive epsilon, a relaxation
+ * from 1 to below 2 and at least one step; otherwise zero (0) is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRayMarchValid(const nRayMarch_t *const march);
+
+/**
+ * @brief Traces rays through a scene with sphere tracing.
+ *
+ * Rays are traced in packets of 16 with the kernels bound by nSimdBind(),
+ * which are one register of AVX-512, two of AVX2, or four of SSE or NEON.
+ * Each ray stops as soon as it hits, misses or runs out of steps, and its lane
+ * takes the next ray, so the lanes stay busy however far each ray goes.
+ *
+ * @param[out] dst The distance along each ray to the surface it hits, or
+ * #NRAY_MISS if it hits nothing within its greatest distance. A ray that runs
+ * out of steps within a few epsilons of a surface is grazing it, and is
+ * reported as hitting it where it stopped, while any other ray that runs out
+ * of steps or leaves the range of floats misses. A ray that starts inside the
+ * scene hits at 0.
+ * @param[in] scene The scene.
+ * @param[in] march The settings of the tracing.
+ * @param[in] origins The origins of the rays.
+ * @param[in] directions The directions of the rays, which need not be
+ * normalized. A ray with no direction hits nothing.
+ * @param[in] tmax The greatest distance along each ray.
+ * @param[in] count The number of rays.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, or #NERROR_INV_ARG if nRayMarchValid()
+ * rejects @p march.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRayMarch(float *dst, const nRayScene_t *const scene,
+              const nRayMarch_t *const march, const nVec3SoA_t origins,
+              const nVec3SoA_t directions, const float *tmax,
+              const size_t count);
+
+#endif // NIMBLE_ENGINE_RAYMARCHING_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// RayMarching.h
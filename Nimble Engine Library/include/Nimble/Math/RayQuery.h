@@ -0,0 +1,186 @@
+#include "../NimbleLicense.h"
+/*
+ * RayQuery.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file RayQuery.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines batched ray casts against meshes and scenes of signed distance fields.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_RAYQUERY_H
+#define NIMBLE_ENGINE_RAYQUERY_H /**< Header definition */
+
+#include "../Nimble.h"
+#include "RayMarching.h"
+#include "Vectors.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NRAY_NO_PRIMITIVE 0xFFFFFFFFU /**< The primitive of a ray that hits nothing. */
+#define NRAY_MASK_ALL 0xFFFFFFFFU /**< The mask of a ray or triangle in every layer. */
+
+/**
+ * @brief A batch of rays stored as structure of arrays.
+ *
+ * Systems that cast rays on their own, such as perception, hit scans and
+ * sound occlusion, can gather their rays into one batch, which is sorted so
+ * that rays going the same way from the same place are traced together.
+ */
+typedef struct nRayBatch {
+    nVec3SoA_t origins; /**< The origins of the rays. */
+    nVec3SoA_t directions; /**< The directions of the rays, which need not be normalized. A ray with no direction hits nothing. */
+    const float *tmax; /**< The greatest distance along each ray. */
+    const uint32_t *masks; /**< The layers each ray can hit, or #NULL for #NRAY_MASK_ALL. A ray with a mask of 0 hits nothing. */
+    size_t count; /**< The number of rays. */
+} nRayBatch_t;
+
+/**
+ * @brief The hits of a batch of rays stored as structure of arrays.
+ *
+ * Each array holds one value for each ray of the batch, in the order of the
+ * batch. Any array but @c t may be #NULL if it is not needed.
+ */
+typedef struct nRayHits {
+    float *t; /**< The distance along each ray to what it hits, or #NRAY_MISS. */
+    uint32_t *primitives; /**< The index of the triangle each ray hits, or #NRAY_NO_PRIMITIVE. */
+    nVec3SoA_t normals; /**< The normalized normal where each ray hits, facing the ray, or 0 if it misses. */
+} nRayHits_t;
+
+/**
+ * @brief A mesh of triangles in a bounding volume hierarchy.
+ *
+ * The triangles are sorted into a tree of boxes split by the surface area
+ * heuristic, so that a ray only tests the triangles in the boxes it passes
+ * through. Each box also holds the layers of its triangles, so rays skip the
+ * boxes they cannot hit.
+ */
+typedef struct nRayMesh nRayMesh_t;
+
+/**
+ * @brief Builds a mesh of triangles for ray queries.
+ *
+ * @param[out] mesh The mesh, which is destroyed with nRayMeshDestroy().
+ * @param[in] vertices The vertices of the mesh.
+ * @param[in] vertexCount The number of vertices.
+ * @param[in] indices The three indices of the vertices of each triangle.
+ * @param[in] masks The layers of each triangle, or #NULL for
+ * #NRAY_MASK_ALL.
+ * @param[in] triangles The number of triangles.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, #NERROR_INV_ARG if an index is not less
+ * than @p vertexCount, or #NERROR_NO_MEMORY if the mesh could not be
+ * allocated.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRayMeshCreate(nRayMesh_t **mesh, const nVec3SoA_t vertices,
+                   const uint32_t vertexCount, const uint32_t *indices,
+                   const uint32_t *masks, const uint32_t triangles);
+
+/**
+ * @brief Destroys a mesh built by nRayMeshCreate().
+ *
+ * @param[in,out] mesh The mesh, which is set to #NULL.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nRayMeshDestroy(nRayMesh_t **mesh);
+
+/**
+ * @brief Casts a batch of rays against a mesh.
+ *
+ * The rays are sorted by the octant of their direction and the cell of their
+ * origin, then traced in packets of neighbouring rays across @p threads
+ * threads. Each packet walks the tree once, testing each box and triangle
+ * against all of its rays at a time. A ray hits the nearest triangle in
+ * front of it that shares a layer with it, from either side.
+ *
+ * @param[out] hits The hits of the rays.
+ * @param[in] mesh The mesh.
+ * @param[in] rays The rays.
+ * @param[in] threads The most threads to use, or 0 for one per logical
+ * core.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, #NERROR_INV_ARG if the batch has more than
+ * @c UINT32_MAX rays, or #NERROR_NO_MEMORY if the rays could not be sorted. If
+ * worker threads cannot be started, the calling thread casts the rays on its
+ * own.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRayQueryMesh(const nRayHits_t hits, const nRayMesh_t *const mesh,
+                  const nRayBatch_t *const rays, uint32_t threads);
+
+/**
+ * @brief Casts a batch of rays against a scene of signed distance fields.
+ *
+ * The rays are split across @p threads threads, which each trace runs of
+ * rays with nRayMarch(). The rays are not sorted like in nRayQueryMesh(), as
+ * the marcher evaluates the whole scene for every ray wherever it goes.
+ * Normals are estimated with nRaySceneNormal().
+ *
+ * @param[out] hits The hits of the rays. The primitives are always
+ * #NRAY_NO_PRIMITIVE.
+ * @param[in] scene The scene.
+ * @param[in] march The settings of the tracing.
+ * @param[in] mask The layers of the scene, which the rays must share to hit
+ * it.
+ * @param[in] rays The rays.
+ * @param[in] threads The most threads to use, or 0 for one per logical
+ * core.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_NULL is
+ * returned if an argument is #NULL, #NERROR_INV_ARG if nRayMarchValid()
+ * rejects @p march or the batch has more than @c UINT32_MAX rays, or
+ * #NERROR_NO_MEMORY if the rays could not be split. If worker threads cannot be started, the calling
+ * thread casts the rays on its own.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nRayQueryScene(const nRayHits_t hits, const nRayScene_t *const scene,
+                   const nRayMarch_t *const march, const uint32_t mask,
+                   const nRayBatch_t *const rays, uint32_t threads);
+
+#endif // NIMBLE_ENGINE_RAYQUERY_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// RayQuery.h
@@ -0,0 +1,710 @@
+#include "../NimbleLicense.h"
+/*
+ * Vectors.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Vectors.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines 2D, 3D and 4D vectors and their math.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_VECTORS_H
+#define NIMBLE_ENGINE_VECTORS_H /**< Header definition */
+
+#include "../Nimble.h"
+#include <math.h>
+#include <stddef.h>
+
+#if defined(__SSE2__)
+#  include <immintrin.h>
+#  define NVEC_SSE /**< The vector functions use SSE2, which every x86-64 CPU has. */
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#  include <arm_neon.h>
+#  define NVEC_NEON /**< The vector functions use NEON, which every ARMv8 CPU has. */
+#endif
+
+/**
+ * @brief The register type of the vector functions.
+ */
+#if defined(NVEC_SSE)
+typedef __m128 nVecReg_t;
+#elif defined(NVEC_NEON)
+typedef float32x4_t nVecReg_t;
+#else
+typedef float nVecReg_t __attribute__((vector_size(16)));
+#endif
+
+/**
+ * @brief A 2D vector.
+ */
+typedef union nVec2 {
+    struct {
+        float x; /**< The X component. */
+        float y; /**< The Y component. */
+    };
+    float v[2]; /**< The components as an array. */
+} __attribute__((aligned(8))) nVec2_t;
+
+/**
+ * @brief A 3D vector, padded to the 16 bytes of a register.
+ *
+ * @note @c w is padding, which the nVec3 functions keep at zero. Use
+ * nVec3Set() to make a vector rather than setting the components directly.
+ */
+typedef union nVec3 {
+    struct {
+        float x; /**< The X component. */
+        float y; /**< The Y component. */
+        float z; /**< The Z component. */
+        float w; /**< Padding. */
+    };
+    float v[4]; /**< The components as an array. */
+    nVecReg_t m; /**< The components as a register. */
+} nVec3_t;
+
+/**
+ * @brief A 4D vector.
+ */
+typedef union nVec4 {
+    struct {
+        float x; /**< The X component. */
+        float y; /**< The Y component. */
+        float z; /**< The Z component. */
+        float w; /**< The W component. */
+    };
+    float v[4]; /**< The components as an array. */
+    nVecReg_t m; /**< The components as a register. */
+} nVec4_t;
+
+/**
+ * @brief An array of 3D vectors stored as structure of arrays.
+ *
+ * Each of @c x, @c y and @c z points to the components of every vector, so
+ * that the batch functions can load the same component of several vectors
+ * into one register.
+ */
+typedef struct nVec3SoA {
+    float *x; /**< The X components. */
+    float *y; /**< The Y components. */
+    float *z; /**< The Z components. */
+} nVec3SoA_t;
+
+/**
+ * @brief An array of 4D vectors stored as structure of arrays.
+ */
+typedef struct nVec4SoA {
+    float *x; /**< The X components. */
+    float *y; /**< The Y components. */
+    float *z; /**< The Z components. */
+    float *w; /**< The W components. */
+} nVec4SoA_t;
+
+
+/* Register operations used by the vector functions. */
+NIMBLE_INLINE
+nVecReg_t nVecRegSet(const float x, const float y, const float z,
+ const float w)
+{
+#if defined(NVEC_SSE)
+    return _mm_setr_ps(x, y, z, w);
+#elif defined(NVEC_NEON)
+    const float v[4] = {x, y, z, w};
+    return vld1q_f32(v);
+#else
+    return (nVecReg_t) {x, y, z, w};
+#endif
+}
+
+NIMBLE_INLINE
+nVecReg_t nVecRegSplat(const float s)
+{
+#if defined(NVEC_SSE)
+    return _mm_set1_ps(s);
+#elif defined(NVEC_NEON)
+    return vdupq_n_f32(s);
+#else
+    return (nVecReg_t) {s, s, s, s};
+#endif
+}
+
+NIMBLE_INLINE
+nVecReg_t nVecRegAdd(const nVecReg_t a, const nVecReg_t b)
+{
+#if defined(NVEC_SSE)
+    return _mm_add_ps(a, b);
+#elif defined(NVEC_NEON)
+    return vaddq_f32(a, b);
+#else
+    return a + b;
+#endif
+}
+
+NIMBLE_INLINE
+nVecReg_t nVecRegSub(const nVecReg_t a, const nVecReg_t b)
+{
+#if defined(NVEC_SSE)
+    return _mm_sub_ps(a, b);
+#elif defined(NVEC_NEON)
+    return vsubq_f32(a, b);
+#else
+    return a - b;
+#endif
+}
+
+NIMBLE_INLINE
+nVecReg_t nVecRegMul(const nVecReg_t a, const nVecReg_t b)
+{
+#if defined(NVEC_SSE)
+    return _mm_mul_ps(a, b);
+#elif defined(NVEC_NEON)
+    return vmulq_f32(a, b);
+#else
+    return a * b;
+#endif
+}
+
+NIMBLE_INLINE
+nVecReg_t nVecRegMin(const nVecReg_t a, const nVecReg_t b)
+{
+#if defined(NVEC_SSE)
+    return _mm_min_ps(a, b);
+#elif defined(NVEC_NEON)
+    return vminq_f32(a, b);
+#else
+    nVecReg_t r;
+    for (int i = 0; i < 4; i++) r[i] = (a[i] < b[i]) ? a[i] : b[i];
+    return r;
+#endif
+}
+
+NIMBLE_INLINE
+nVecReg_t nVecRegMax(const nVecReg_t a, const nVecReg_t b)
+{
+#if defined(NVEC_SSE)
+    return _mm_max_ps(a, b);
+#elif defined(NVEC_NEON)
+    return vmaxq_f32(a, b);
+#else
+    nVecReg_t r;
+    for (int i = 0; i < 4; i++) r[i] = (a[i] > b[i]) ? a[i] : b[i];
+    return r;
+#endif
+}
+
+/* Sums the first three lanes of a. */
+NIMBLE_INLINE
+float nVecRegSum3(const nVecReg_t a)
+{
+#if defined(NVEC_SSE)
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(a, _mm_shuffle_ps(a, a, 1)),
+     _mm_movehl_ps(a, a)));
+#elif defined(NVEC_NEON)
+    return vaddvq_f32(vsetq_lane_f32(0.0f, a, 3));
+#else
+    return a[0] + a[1] + a[2];
+#endif
+}
+
+/* Sums the lanes of a. */
+NIMBLE_INLINE
+float nVecRegSum4(const nVecReg_t a)
+{
+#if defined(NVEC_SSE)
+    const __m128 sum = _mm_add_ps(a, _mm_movehl_ps(a, a));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+#elif defined(NVEC_NEON)
+    return vaddvq_f32(a);
+#else
+    return a[0] + a[1] + a[2] + a[3];
+#endif
+}
+
+
+/**
+ * @brief Makes a 2D vector.
+ *
+ * @param[in] x The X component.
+ * @param[in] y The Y component.
+ * @return The vector is returned.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Set(const float x, const float y)
+{
+    return (nVec2_t) {.x = x, .y = y};
+}
+
+/**
+ * @brief Adds two 2D vectors.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Add(const nVec2_t a, const nVec2_t b)
+{
+    return nVec2Set(a.x + b.x, a.y + b.y);
+}
+
+/**
+ * @brief Subtracts 2D vector @p b from @p a.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Sub(const nVec2_t a, const nVec2_t b)
+{
+    return nVec2Set(a.x - b.x, a.y - b.y);
+}
+
+/**
+ * @brief Multiplies two 2D vectors component-wise.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Mul(const nVec2_t a, const nVec2_t b)
+{
+    return nVec2Set(a.x * b.x, a.y * b.y);
+}
+
+/**
+ * @brief Multiplies a 2D vector by a scalar.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Scale(const nVec2_t a, const float s)
+{
+    return nVec2Set(a.x * s, a.y * s);
+}
+
+/**
+ * @brief Gets the dot product of two 2D vectors.
+ */
+NIMBLE_INLINE
+float nVec2Dot(const nVec2_t a, const nVec2_t b)
+{
+    return (a.x * b.x) + (a.y * b.y);
+}
+
+/**
+ * @brief Gets the length of a 2D vector.
+ */
+NIMBLE_INLINE
+float nVec2Length(const nVec2_t a)
+{
+    return sqrtf(nVec2Dot(a, a));
+}
+
+/**
+ * @brief Scales a 2D vector to a length of 1.
+ *
+ * @return The unit vector is returned, or a zero vector if @p a has no length.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Normalize(const nVec2_t a)
+{
+    const float len = nVec2Length(a);
+    return (len > 0.0f) ? nVec2Scale(a, 1.0f / len) : nVec2Set(0.0f, 0.0f);
+}
+
+/**
+ * @brief Linearly interpolates between two 2D vectors.
+ *
+ * @param[in] a The vector at @p t = 0.
+ * @param[in] b The vector at @p t = 1.
+ * @param[in] t The interpolant.
+ * @return @p a + (@p b - @p a) * @p t is returned.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Lerp(const nVec2_t a, const nVec2_t b, const float t)
+{
+    return nVec2Set(a.x + ((b.x - a.x) * t), a.y + ((b.y - a.y) * t));
+}
+
+/**
+ * @brief Gets the component-wise minimum of two 2D vectors.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Min(const nVec2_t a, const nVec2_t b)
+{
+    return nVec2Set((a.x < b.x) ? a.x : b.x, (a.y < b.y) ? a.y : b.y);
+}
+
+/**
+ * @brief Gets the component-wise maximum of two 2D vectors.
+ */
+NIMBLE_INLINE
+nVec2_t nVec2Max(const nVec2_t a, const nVec2_t b)
+{
+    return nVec2Set((a.x > b.x) ? a.x : b.x, (a.y > b.y) ? a.y : b.y);
+}
+
+
+/**
+ * @brief Makes a 3D vector.
+ *
+ * @param[in] x The X component.
+ * @param[in] y The Y component.
+ * @param[in] z The Z component.
+ * @return The vector is returned.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Set(const float x, const float y, const float z)
+{
+    return (nVec3_t) {.m = nVecRegSet(x, y, z, 0.0f)};
+}
+
+/**
+ * @brief Adds two 3D vectors.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Add(const nVec3_t a, const nVec3_t b)
+{
+    return (nVec3_t) {.m = nVecRegAdd(a.m, b.m)};
+}
+
+/**
+ * @brief Subtracts 3D vector @p b from @p a.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Sub(const nVec3_t a, const nVec3_t b)
+{
+    return (nVec3_t) {.m = nVecRegSub(a.m, b.m)};
+}
+
+/**
+ * @brief Multiplies two 3D vectors component-wise.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Mul(const nVec3_t a, const nVec3_t b)
+{
+    return (nVec3_t) {.m = nVecRegMul(a.m, b.m)};
+}
+
+/**
+ * @brief Multiplies a 3D vector by a scalar.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Scale(const nVec3_t a, const float s)
+{
+    return (nVec3_t) {.m = nVecRegMul(a.m, nVecRegSplat(s))};
+}
+
+/**
+ * @brief Gets the dot product of two 3D vectors.
+ */
+NIMBLE_INLINE
+float nVec3Dot(const nVec3_t a, const nVec3_t b)
+{
+    return nVecRegSum3(nVecRegMul(a.m, b.m));
+}
+
+/**
+ * @brief Gets the cross product of two 3D vectors.
+ *
+ * @return @p a x @p b is returned, which is perpendicular to both.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Cross(const nVec3_t a, const nVec3_t b)
+{
+#if defined(NVEC_SSE)
+    /* (a * b.yzx - a.yzx * b).yzx */
+    const __m128 aYZX = _mm_shuffle_ps(a.m, a.m, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 bYZX = _mm_shuffle_ps(b.m, b.m, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a.m, bYZX), _mm_mul_ps(aYZX, b.m));
+    return (nVec3_t) {.m = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1))};
+#else
+    return nVec3Set((a.y * b.z) - (a.z * b.y), (a.z * b.x) - (a.x * b.z),
+     (a.x * b.y) - (a.y * b.x));
+#endif
+}
+
+/**
+ * @brief Gets the length of a 3D vector.
+ */
+NIMBLE_INLINE
+float nVec3Length(const nVec3_t a)
+{
+    return sqrtf(nVec3Dot(a, a));
+}
+
+/**
+ * @brief Scales a 3D vector to a length of 1.
+ *
+ * @return The unit vector is returned, or a zero vector if @p a has no length.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Normalize(const nVec3_t a)
+{
+    const float len = nVec3Length(a);
+    return (len > 0.0f) ? nVec3Scale(a, 1.0f / len) :
+     nVec3Set(0.0f, 0.0f, 0.0f);
+}
+
+/**
+ * @brief Linearly interpolates between two 3D vectors.
+ *
+ * @param[in] a The vector at @p t = 0.
+ * @param[in] b The vector at @p t = 1.
+ * @param[in] t The interpolant.
+ * @return @p a + (@p b - @p a) * @p t is returned.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Lerp(const nVec3_t a, const nVec3_t b, const float t)
+{
+    return (nVec3_t) {.m = nVecRegAdd(a.m, nVecRegMul(nVecRegSub(b.m, a.m),
+     nVecRegSplat(t)))};
+}
+
+/**
+ * @brief Gets the component-wise minimum of two 3D vectors.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Min(const nVec3_t a, const nVec3_t b)
+{
+    return (nVec3_t) {.m = nVecRegMin(a.m, b.m)};
+}
+
+/**
+ * @brief Gets the component-wise maximum of two 3D vectors.
+ */
+NIMBLE_INLINE
+nVec3_t nVec3Max(const nVec3_t a, const nVec3_t b)
+{
+    return (nVec3_t) {.m = nVecRegMax(a.m, b.m)};
+}
+
+
+/**
+ * @brief Makes a 4D vector.
+ *
+ * @param[in] x The X component.
+ * @param[in] y The Y component.
+ * @param[in] z The Z component.
+ * @param[in] w The W component.
+ * @return The vector is returned.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Set(const float x, const float y, const float z, const float w)
+{
+    return (nVec4_t) {.m = nVecRegSet(x, y, z, w)};
+}
+
+/**
+ * @brief Adds two 4D vectors.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Add(const nVec4_t a, const nVec4_t b)
+{
+    return (nVec4_t) {.m = nVecRegAdd(a.m, b.m)};
+}
+
+/**
+ * @brief Subtracts 4D vector @p b from @p a.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Sub(const nVec4_t a, const nVec4_t b)
+{
+    return (nVec4_t) {.m = nVecRegSub(a.m, b.m)};
+}
+
+/**
+ * @brief Multiplies two 4D vectors component-wise.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Mul(const nVec4_t a, const nVec4_t b)
+{
+    return (nVec4_t) {.m = nVecRegMul(a.m, b.m)};
+}
+
+/**
+ * @brief Multiplies a 4D vector by a scalar.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Scale(const nVec4_t a, const float s)
+{
+    return (nVec4_t) {.m = nVecRegMul(a.m, nVecRegSplat(s))};
+}
+
+/**
+ * @brief Gets the dot product of two 4D vectors.
+ */
+NIMBLE_INLINE
+float nVec4Dot(const nVec4_t a, const nVec4_t b)
+{
+    return nVecRegSum4(nVecRegMul(a.m, b.m));
+}
+
+/**
+ * @brief Gets the length of a 4D vector.
+ */
+NIMBLE_INLINE
+float nVec4Length(const nVec4_t a)
+{
+    return sqrtf(nVec4Dot(a, a));
+}
+
+/**
+ * @brief Scales a 4D vector to a length of 1.
+ *
+ * @return The unit vector is returned, or a zero vector if @p a has no length.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Normalize(const nVec4_t a)
+{
+    const float len = nVec4Length(a);
+    return (len > 0.0f) ? nVec4Scale(a, 1.0f / len) :
+     nVec4Set(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+/**
+ * @brief Linearly interpolates between two 4D vectors.
+ *
+ * @param[in] a The vector at @p t = 0.
+ * @param[in] b The vector at @p t = 1.
+ * @param[in] t The interpolant.
+ * @return @p a + (@p b - @p a) * @p t is returned.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Lerp(const nVec4_t a, const nVec4_t b, const float t)
+{
+    return (nVec4_t) {.m = nVecRegAdd(a.m, nVecRegMul(nVecRegSub(b.m, a.m),
+     nVecRegSplat(t)))};
+}
+
+/**
+ * @brief Gets the component-wise minimum of two 4D vectors.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Min(const nVec4_t a, const nVec4_t b)
+{
+    return (nVec4_t) {.m = nVecRegMin(a.m, b.m)};
+}
+
+/**
+ * @brief Gets the component-wise maximum of two 4D vectors.
+ */
+NIMBLE_INLINE
+nVec4_t nVec4Max(const nVec4_t a, const nVec4_t b)
+{
+    return (nVec4_t) {.m = nVecRegMax(a.m, b.m)};
+}
+
+
+/* Batch functions
+ * These process structure of arrays with the widest instructions bound by
+ * nSimdBind(): 4 vectors at a time with SSE4.2 or NEON, 8 with AVX2 and 16
+ * with AVX-512. The destinations may be the same arrays as the sources, but
+ * must not otherwise overlap them. */
+
+/**
+ * @brief Computes the dot products of arrays of 3D vectors.
+ *
+ * @param[out] dst The @p count dot products.
+ * @param[in] a The first vectors.
+ * @param[in] b The second vectors.
+ * @param[in] count The number of vectors in each array.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec3DotSoA(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+                 const size_t count);
+
+/**
+ * @brief Computes the cross products of arrays of 3D vectors.
+ *
+ * @param[out] dst The @p count cross products, @p a[i] x @p b[i].
+ * @param[in] a The first vectors.
+ * @param[in] b The second vectors.
+ * @param[in] count The number of vectors in each array.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec3CrossSoA(const nVec3SoA_t dst, const nVec3SoA_t a,
+                   const nVec3SoA_t b, const size_t count);
+
+/**
+ * @brief Computes the lengths of an array of 3D vectors.
+ *
+ * @param[out] dst The @p count lengths.
+ * @param[in] a The vectors.
+ * @param[in] count The number of vectors.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec3LengthSoA(float *dst, const nVec3SoA_t a, const size_t count);
+
+/**
+ * @brief Scales an array of 3D vectors to a length of 1.
+ *
+ * @param[out] dst The @p count unit vectors. Vectors with no length are set to
+ * zero.
+ * @param[in] a The vectors.
+ * @param[in] count The number of vectors.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec3NormalizeSoA(const nVec3SoA_t dst, const nVec3SoA_t a,
+                       const size_t count);
+
+/**
+ * @brief Linearly interpolates between arrays of 3D vectors.
+ *
+ * @param[out] dst The @p count vectors, @p a[i] + (@p b[i] - @p a[i]) * @p t.
+ * @param[in] a The vectors at @p t = 0.
+ * @param[in] b The vectors at @p t = 1.
+ * @param[in] t The interpolant.
+ * @param[in] count The number of vectors in each array.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec3LerpSoA(const nVec3SoA_t dst, const nVec3SoA_t a, const nVec3SoA_t b,
+                  const float t, const size_t count);
+
+/**
+ * @brief Computes the dot products of arrays of 4D vectors.
+ *
+ * @param[out] dst The @p count dot products.
+ * @param[in] a The first vectors.
+ * @param[in] b The second vectors.
+ * @param[in] count The number of vectors in each array.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nVec4DotSoA(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+                 const size_t count);
+
+#endif // NIMBLE_ENGINE_VECTORS_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Vectors.h
@@ -59,6 +59,7 @@ extern "C" {
 #include <windows.h>
 
 #elif defined(NIMBLE_STD_UNIX)
+#include <dirent.h>
 #include <unistd.h>
 #endif
 
@@ -387,6 +388,32 @@ NIMBLE_EXTERN
 int nFileCopy(const char *const restrict src,
               const char *const restrict dst);
 
+/**
+ * @brief The callback for each file found by nFileListDir().
+ *
+ * @param[in] name The name of the file, without the directory.
+ * @param[in] size The size of the file in bytes.
+ * @param[in] data The data passed to nFileListDir().
+ * @return Nonzero is returned to stop listing files.
+ */
+typedef int (*nFileListCallback_t)(const char *const name,
+                                   const uint64_t size,
+                                   void *data);
+
+/**
+ * @brief Invokes @p callback for each regular file in directory @p dir.
+ *
+ * @param[in] dir The path of the directory to list.
+ * @param[in] callback The function to invoke for each file.
+ * @param[in] data The data passed to @p callback.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nFileListDir(const char *const dir,
+                 nFileListCallback_t callback,
+                 void *data);
+
 #endif // NIMBLE_ENGINE_FILES_H
 
 #ifdef __cplusplus
@@ -0,0 +1,415 @@
+#include "../NimbleLicense.h"
+/*
+ * Logging.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2021-01-06.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Logging.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2021-01-06
+ *
+ * @brief This class defines logging functions.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_LOGGING_H
+#define NIMBLE_ENGINE_LOGGING_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#include <stdarg.h>
+
+#include "../Errors/ErrorValues.h"
+
+
+#define NLOG_TRACE 0 /**< Log level for tracing execution. */
+#define NLOG_DEBUG 1 /**< Log level for debugging information. */
+#define NLOG_INFO  2 /**< Log level for general information. */
+#define NLOG_WARN  3 /**< Log level for warnings. */
+#define NLOG_ERROR 4 /**< Log level for errors. */
+#define NLOG_FATAL 5 /**< Log level for errors that crash the program. */
+#define NLOG_PAD   0xFF /**< Level of the records that pad the end of a ring. */
+
+#ifndef NLOG_SLOT_SIZE
+#  define NLOG_SLOT_SIZE 128 /**< The size of a ring slot. A record takes one or more slots. Must be a power of two. */
+#endif
+#ifndef NLOG_RING_SLOTS
+#  define NLOG_RING_SLOTS 2048 /**< The number of slots in each thread's ring. Must be a power of two. */
+#endif
+#ifndef NLOG_RECORD_SLOTS_MAX
+#  define NLOG_RECORD_SLOTS_MAX 64 /**< The maximum slots a record can take. Longer strings are truncated. */
+#endif
+#ifndef NLOG_ARGS_MAX
+#  define NLOG_ARGS_MAX 8 /**< The maximum number of arguments to nLog(). */
+#endif
+#ifndef NLOG_FLUSH_INTERVAL
+#  define NLOG_FLUSH_INTERVAL 10 /**< The milliseconds the logging thread sleeps when there are no records. */
+#endif
+#ifndef NLOG_BATCH_IOV
+#  define NLOG_BATCH_IOV 512 /**< The maximum buffers written at once by the logging thread. */
+#endif
+#ifndef NLOG_BATCH_SIZE
+#  define NLOG_BATCH_SIZE 32768 /**< The size of the logging thread's buffer for formatted text. */
+#endif
+#ifndef NLOG_ROTATE_SIZE
+#  define NLOG_ROTATE_SIZE (64 * 1024 * 1024) /**< The default size in bytes at which log files are rotated, or 0 to not rotate by size. */
+#endif
+#ifndef NLOG_ROTATE_AGE
+#  define NLOG_ROTATE_AGE (24 * 60 * 60) /**< The default seconds after which log files are rotated, or 0 to not rotate by age. */
+#endif
+#ifndef NLOG_RETAIN_FILES
+#  define NLOG_RETAIN_FILES 30 /**< The default maximum number of rotated segments kept of each log file, or 0 for no limit. */
+#endif
+#ifndef NLOG_RETAIN_SIZE
+#  define NLOG_RETAIN_SIZE (1024 * 1024 * 1024) /**< The default maximum total size in bytes of the rotated segments of each log file, or 0 for no limit. */
+#endif
+#ifndef NLOG_ARCHIVE_QUEUE
+#  define NLOG_ARCHIVE_QUEUE 16 /**< The maximum rotated segments waiting for the archiver thread. Must be a power of two. */
+#endif
+#ifndef NLOG_ARCHIVE_BUFFER
+#  define NLOG_ARCHIVE_BUFFER 65536 /**< The size of the archiver thread's buffers for compression. */
+#endif
+
+/* Argument types passed to nLogPush(), by promoted C type. */
+#define NLOG_ARG_INT     1 /**< An @c int argument. */
+#define NLOG_ARG_UINT    2 /**< An @c unsigned @c int argument. */
+#define NLOG_ARG_LONG    3 /**< A @c long argument. */
+#define NLOG_ARG_ULONG   4 /**< An @c unsigned @c long argument. */
+#define NLOG_ARG_LLONG   5 /**< A @c long @c long argument. */
+#define NLOG_ARG_ULLONG  6 /**< An @c unsigned @c long @c long argument. */
+#define NLOG_ARG_DOUBLE  7 /**< A @c double argument. */
+#define NLOG_ARG_LDOUBLE 8 /**< A @c long @c double argument. */
+#define NLOG_ARG_STR     9 /**< A @c char * argument. */
+#define NLOG_ARG_PTR     10 /**< Any other pointer argument. */
+
+/* Argument types stored in records. */
+#define NLOG_TYPE_I64 1 /**< A signed 64-bit integer. */
+#define NLOG_TYPE_U64 2 /**< An unsigned 64-bit integer. */
+#define NLOG_TYPE_F64 3 /**< A double. */
+#define NLOG_TYPE_STR 4 /**< A 16-bit length followed by that many characters. */
+#define NLOG_TYPE_PTR 5 /**< A 64-bit address. */
+
+/**
+ * @brief The header of a log record.
+ *
+ * A record is stored in one or more consecutive slots of #NLOG_SLOT_SIZE
+ * bytes, with its packed arguments following the header. Numbers and pointers
+ * are stored in 8 bytes, and strings as a 16-bit length and their characters.
+ */
+typedef struct nLogRecord {
+    uint64_t time; /**< The time of the record, in nanoseconds since the epoch. */
+    const char *format; /**< The format string, which must be static. */
+    uint32_t thread; /**< The number of the thread that logged the record. */
+    uint16_t len; /**< The length of the packed arguments in @c data. */
+    uint8_t slots; /**< The number of slots the record takes. */
+    uint8_t level; /**< The log level, or #NLOG_PAD. */
+    uint8_t argc; /**< The number of arguments. */
+    uint8_t types[NLOG_ARGS_MAX]; /**< The NLOG_TYPE_* of each argument. */
+    uint8_t data[]; /**< The packed arguments. */
+} nLogRecord_t;
+
+/* Binary log files.
+ * A binary log file is a sequence of chunks, each an #nLogChunk_t followed by
+ * @c len bytes. Every time the file is opened a session chunk is written, and
+ * each format string is written once per session, so records only store the
+ * number of their format and their packed arguments. Numbers are stored in the
+ * byte order of the program that wrote the file. */
+#define NLOG_BINARY_MAGIC "NLOGBIN" /**< The magic of a session chunk, including the null terminator. */
+#define NLOG_BINARY_VERSION 1 /**< The version of the binary log format. */
+#define NLOG_BINARY_ORDER 0x01020304 /**< Written in the byte order of the program to detect it. */
+
+#define NLOG_CHUNK_SESSION 1 /**< An #nLogSessionChunk_t. */
+#define NLOG_CHUNK_FORMAT  2 /**< A 32-bit format number followed by the format string, without a null terminator. */
+#define NLOG_CHUNK_RECORD  3 /**< An #nLogRecordChunk_t followed by @c argc NLOG_TYPE_* and @c len bytes of packed arguments. */
+#define NLOG_CHUNK_DROPPED 4 /**< An #nLogDroppedChunk_t. */
+
+/**
+ * @brief The header of each chunk of a binary log file.
+ */
+typedef struct nLogChunk {
+    uint32_t kind; /**< The NLOG_CHUNK_* kind of the chunk. */
+    uint32_t len; /**< The number of bytes following the header. */
+} nLogChunk_t;
+
+/**
+ * @brief The chunk starting each session of a binary log file.
+ *
+ * @note Format numbers only apply to the session they are written in.
+ */
+typedef struct nLogSessionChunk {
+    char magic[8]; /**< #NLOG_BINARY_MAGIC */
+    uint32_t version; /**< #NLOG_BINARY_VERSION */
+    uint32_t order; /**< #NLOG_BINARY_ORDER */
+    uint64_t time; /**< The time the session started, in nanoseconds since the epoch. */
+} nLogSessionChunk_t;
+
+/**
+ * @brief The header of a record in a binary log file.
+ */
+typedef struct nLogRecordChunk {
+    uint64_t time; /**< The time of the record, in nanoseconds since the epoch. */
+    uint32_t format; /**< The number of the format string. */
+    uint32_t thread; /**< The number of the thread that logged the record. */
+    uint16_t len; /**< The length of the packed arguments. */
+    uint8_t level; /**< The log level. */
+    uint8_t argc; /**< The number of arguments. */
+    uint32_t reserved; /**< Zero. */
+} nLogRecordChunk_t;
+
+/**
+ * @brief A count of records that were dropped, in a binary log file.
+ */
+typedef struct nLogDroppedChunk {
+    uint32_t thread; /**< The number of the thread whose records were dropped. */
+    uint32_t reserved; /**< Zero. */
+    uint64_t count; /**< The number of records dropped. */
+} nLogDroppedChunk_t;
+
+/**
+ * @brief The lowest level of records that get logged.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+volatile int nLogLevel;
+
+/**
+ * @brief Gets the NLOG_ARG_* type of @p arg.
+ */
+#define nLogArgType(arg) _Generic((arg),\
+    _Bool: NLOG_ARG_INT,\
+    char: NLOG_ARG_INT,\
+    signed char: NLOG_ARG_INT,\
+    unsigned char: NLOG_ARG_INT,\
+    short: NLOG_ARG_INT,\
+    unsigned short: NLOG_ARG_INT,\
+    int: NLOG_ARG_INT,\
+    unsigned int: NLOG_ARG_UINT,\
+    long: NLOG_ARG_LONG,\
+    unsigned long: NLOG_ARG_ULONG,\
+    long long: NLOG_ARG_LLONG,\
+    unsigned long long: NLOG_ARG_ULLONG,\
+    float: NLOG_ARG_DOUBLE,\
+    double: NLOG_ARG_DOUBLE,\
+    long double: NLOG_ARG_LDOUBLE,\
+    char *: NLOG_ARG_STR,\
+    const char *: NLOG_ARG_STR,\
+    default: NLOG_ARG_PTR)
+
+/* Argument counting and type list helpers for nLog(). */
+#define NLOG_CAT_(a, b) a##b
+#define NLOG_CAT(a, b) NLOG_CAT_(a, b)
+#define NLOG_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, n, ...) n
+#define NLOG_NARGS(...) NLOG_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0)
+#define NLOG_TYPES_0(f)
+#define NLOG_TYPES_1(f, a) nLogArgType(a)
+#define NLOG_TYPES_2(f, a, ...) nLogArgType(a), NLOG_TYPES_1(f, __VA_ARGS__)
+#define NLOG_TYPES_3(f, a, ...) nLogArgType(a), NLOG_TYPES_2(f, __VA_ARGS__)
+#define NLOG_TYPES_4(f, a, ...) nLogArgType(a), NLOG_TYPES_3(f, __VA_ARGS__)
+#define NLOG_TYPES_5(f, a, ...) nLogArgType(a), NLOG_TYPES_4(f, __VA_ARGS__)
+#define NLOG_TYPES_6(f, a, ...) nLogArgType(a), NLOG_TYPES_5(f, __VA_ARGS__)
+#define NLOG_TYPES_7(f, a, ...) nLogArgType(a), NLOG_TYPES_6(f, __VA_ARGS__)
+#define NLOG_TYPES_8(f, a, ...) nLogArgType(a), NLOG_TYPES_7(f, __VA_ARGS__)
+
+/**
+ * @brief Logs a printf() style message without formatting it on the invoking
+ * thread.
+ *
+ * The arguments are copied into a record in the invoking thread's ring along
+ * with the address of the format string, and the logging thread formats and
+ * writes it later. Up to #NLOG_ARGS_MAX arguments can be logged.
+ *
+ * Example:
+ * @code
+ * nLog(NLOG_INFO, "Loaded %s in %" PRIu64 " ms.", nameStr, elapsed);
+ * @endcode
+ *
+ * @param[in] level The NLOG_* level of the message. Messages below #nLogLevel
+ * are skipped.
+ * @param[in] ... The format string, which must be a string literal or
+ * otherwise stay valid for the life of the program, followed by its arguments.
+ *
+ * @note String arguments are copied, so they can be freed after logging.
+ */
+#define nLog(level, ...) (((level) >= nLogLevel) ?\
+    nLogPush((level), NLOG_NARGS(__VA_ARGS__),\
+     (const uint8_t []) {0,\
+     NLOG_CAT(NLOG_TYPES_, NLOG_NARGS(__VA_ARGS__))(__VA_ARGS__)},\
+     __VA_ARGS__) : NSUCCESS)
+
+/**
+ * @brief Pushes a record to the invoking thread's ring. Use nLog() instead.
+ *
+ * @param[in] level The NLOG_* level of the record.
+ * @param[in] argc The number of arguments after @p format.
+ * @param[in] types The NLOG_ARG_* type of each argument, starting at index 1.
+ * @param[in] format The static format string.
+ * @param[in] ... The arguments of @p format.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_OVERFLOW is
+ * returned if the ring was full, and the record was dropped.
+ *
+ * @note This function is thread safe and never blocks. Dropped records are
+ * counted and reported by the logging thread rather than thrown as errors.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nLogPush(const int level,
+             const int argc,
+             const uint8_t *const types,
+             const char *const format,
+             ...);
+
+/**
+ * @brief Starts the logging thread.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ *
+ * @note This is called by nEngineInit().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nLogStart(void);
+
+/**
+ * @brief Writes the remaining records and stops the logging thread.
+ *
+ * @note This is called when the engine exits.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLogStop(void);
+
+/**
+ * @brief Checks if the logging thread is running.
+ *
+ * @return Nonzero is returned if the logging thread is running.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nLogRunning(void);
+
+/**
+ * @brief Waits until the records logged before invoking are written.
+ *
+ * @note This returns immediately if the logging thread is not running.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLogFlush(void);
+
+/**
+ * @brief Sets the file records are appended to as text.
+ *
+ * @param[in] pathStr The path of the file to log to, or #NULL to stop logging
+ * to a file. The path is copied.
+ *
+ * @note The file is opened by the logging thread.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLogSetFile(const char *const pathStr);
+
+/**
+ * @brief Sets the file records are appended to in the binary log format.
+ *
+ * Records written to a binary file are not formatted by the logging thread.
+ * Use Nimble Log Decoder to read the file.
+ *
+ * @param[in] pathStr The path of the file to log to, or #NULL to stop logging
+ * to a binary file. The path is copied.
+ *
+ * @note The file is opened by the logging thread.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLogSetBinaryFile(const char *const pathStr);
+
+/**
+ * @brief Sets whether records are written to the console (stderr).
+ *
+ * @param[in] enabled Nonzero to write records to the console. This is the
+ * default.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLogSetConsole(const int enabled);
+
+/**
+ * @brief Sets when log files are rotated and how many rotated segments are
+ * kept.
+ *
+ * When a text or binary log file reaches @p maxSize bytes or @p maxAge seconds
+ * since it was opened, the logging thread renames it to
+ * @c path.YYYYmmdd-HHMMSS.mmm and opens a new file at the path. The segment is
+ * then compressed to @c path.YYYYmmdd-HHMMSS.mmm.gz on a low priority archiver
+ * thread if the engine was built with zlib, after which the oldest segments
+ * that exceed @p maxFiles or @p maxTotal are deleted.
+ *
+ * @param[in] maxSize The size in bytes to rotate at, or 0 to not rotate by
+ * size. The default is #NLOG_ROTATE_SIZE.
+ * @param[in] maxAge The seconds to rotate after, or 0 to not rotate by age. The
+ * default is #NLOG_ROTATE_AGE.
+ * @param[in] maxFiles The maximum number of segments kept, or 0 for no limit.
+ * The default is #NLOG_RETAIN_FILES.
+ * @param[in] maxTotal The maximum total size in bytes of the segments kept, or
+ * 0 for no limit. The default is #NLOG_RETAIN_SIZE.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nLogSetRotation(const uint64_t maxSize,
+                     const uint64_t maxAge,
+                     const uint32_t maxFiles,
+                     const uint64_t maxTotal);
+
+/**
+ * @brief Writes the records that the logging thread has not written yet to
+ * @p fd in the binary log format, for crash dumps.
+ *
+ * A session chunk is written first, followed by each record with its format
+ * string. The rings are read without waiting on the logging thread, and only
+ * write() is used, so this is async-signal-safe.
+ *
+ * @param[in] fd The file descriptor to write to.
+ * @return The number of records written is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint32_t nLogCrashWrite(const int fd);
+
+#endif // NIMBLE_ENGINE_LOGGING_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Logging.h
@@ -64,9 +64,115 @@ NIMBLE_EXPORT
 NIMBLE_EXTERN
 size_t NCPU_INFO_LEN;
 
+#ifndef NCPU_MAX_CACHES
+#  define NCPU_MAX_CACHES 8 /**< The maximum number of caches stored in an #nCPUInfo_t. */
+#endif
+
+#define NCPU_CACHE_DATA        1 /**< A data cache. */
+#define NCPU_CACHE_INSTRUCTION 2 /**< An instruction cache. */
+#define NCPU_CACHE_UNIFIED     3 /**< A cache of both data and instructions. */
+
+#define NCPU_FEATURE_SSE2     (1ULL << 0) /**< x86 SSE2 instructions. */
+#define NCPU_FEATURE_SSE3     (1ULL << 1) /**< x86 SSE3 instructions. */
+#define NCPU_FEATURE_SSSE3    (1ULL << 2) /**< x86 SSSE3 instructions. */
+#define NCPU_FEATURE_SSE41    (1ULL << 3) /**< x86 SSE4.1 instructions. */
+#define NCPU_FEATURE_SSE42    (1ULL << 4) /**< x86 SSE4.2 instructions. */
+#define NCPU_FEATURE_POPCNT   (1ULL << 5) /**< x86 POPCNT instruction. */
+#define NCPU_FEATURE_AES      (1ULL << 6) /**< x86 AES-NI or ARM AES instructions. */
+#define NCPU_FEATURE_AVX      (1ULL << 7) /**< x86 AVX instructions, supported by the OS. */
+#define NCPU_FEATURE_AVX2     (1ULL << 8) /**< x86 AVX2 instructions, supported by the OS. */
+#define NCPU_FEATURE_FMA      (1ULL << 9) /**< x86 FMA3 instructions, supported by the OS. */
+#define NCPU_FEATURE_F16C     (1ULL << 10) /**< x86 half precision conversion instructions. */
+#define NCPU_FEATURE_BMI1     (1ULL << 11) /**< x86 BMI1 instructions. */
+#define NCPU_FEATURE_BMI2     (1ULL << 12) /**< x86 BMI2 instructions. */
+#define NCPU_FEATURE_AVX512F  (1ULL << 13) /**< x86 AVX-512 foundation instructions, supported by the OS. */
+#define NCPU_FEATURE_AVX512DQ (1ULL << 14) /**< x86 AVX-512 doubleword and quadword instructions. */
+#define NCPU_FEATURE_AVX512BW (1ULL << 15) /**< x86 AVX-512 byte and word instructions. */
+#define NCPU_FEATURE_AVX512VL (1ULL << 16) /**< x86 AVX-512 vector length extensions. */
+#define NCPU_FEATURE_NEON     (1ULL << 17) /**< ARM NEON (Advanced SIMD) instructions. */
+#define NCPU_FEATURE_SVE      (1ULL << 18) /**< ARM scalable vector extension. */
+#define NCPU_FEATURE_SVE2     (1ULL << 19) /**< ARM scalable vector extension 2. */
+#define NCPU_FEATURE_CRC32    (1ULL << 20) /**< x86 SSE4.2 or ARM CRC32 instructions. */
+#define NCPU_FEATURE_ADX      (1ULL << 21) /**< x86 ADX multi-precision add-carry instructions. */
+
+/**
+ * @brief A cache of the CPU.
+ */
+typedef struct nCPUCache {
+    uint32_t level; /**< The level of the cache, starting at 1. */
+    uint32_t type; /**< The type of the cache, such as #NCPU_CACHE_DATA. */
+    uint32_t size; /**< The size of the cache in bytes. */
+    uint32_t lineSize; /**< The size of a cache line in bytes. */
+    uint32_t ways; /**< The associativity of the cache. */
+    uint32_t sharing; /**< The number of logical processors that share one of these caches. */
+} nCPUCache_t;
+
+/**
+ * @brief The topology, caches, and features of the CPU.
+ */
+typedef struct nCPUInfo {
+    uint32_t logicalCores; /**< The number of logical processors that are online. */
+    uint32_t physicalCores; /**< The number of physical cores. */
+    uint32_t threadsPerCore; /**< The number of SMT siblings of each physical core. */
+    uint32_t packages; /**< The number of physical packages (sockets). */
+    uint32_t numaNodes; /**< The number of NUMA nodes. */
+    uint32_t cacheLineSize; /**< The line size of the level 1 data cache in bytes. */
+    uint32_t cacheCount; /**< The number of caches in @c caches. */
+    nCPUCache_t caches[NCPU_MAX_CACHES]; /**< The caches of each level as seen by one core, ordered by level. */
+    uint64_t features; /**< The supported instruction set features, such as #NCPU_FEATURE_AVX2. */
+} nCPUInfo_t;
+
+/**
+ * @brief The topology, caches, and features of the CPU.
+ *
+ * @note To set this value, call nSysGetCPUInfo().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nCPUInfo_t NCPU_DETAILS;
+
+/**
+ * @brief Checks if the CPU supports all of @p features.
+ *
+ * @param[in] features The features to check, such as #NCPU_FEATURE_AVX2.
+ * @return Nonzero is returned if all of the features are supported.
+ *
+ * @note nSysGetCPUInfo() must be called first.
+ */
+NIMBLE_INLINE
+int nCPUHasFeatures(const uint64_t features)
+{
+    return (NCPU_DETAILS.features & features) == features;
+}
+
+/**
+ * @brief Gets the size of the cache of @p level and @p type.
+ *
+ * @param[in] level The level of the cache, starting at 1.
+ * @param[in] type The type of the cache, such as #NCPU_CACHE_DATA. Unified
+ * caches match any type.
+ * @return The size of the cache in bytes is returned if found; otherwise 0 is
+ * returned.
+ *
+ * @note nSysGetCPUInfo() must be called first.
+ */
+NIMBLE_INLINE
+uint32_t nCPUCacheSize(const uint32_t level, const uint32_t type)
+{
+    for (uint32_t i = 0; i < NCPU_DETAILS.cacheCount; i++)
+    {
+        const nCPUCache_t *const cache = &NCPU_DETAILS.caches[i];
+        if ((cache->level == level) && ((cache->type == type) ||
+         (cache->type == NCPU_CACHE_UNIFIED))) return cache->size;
+    }
+    return 0;
+}
+
 /**
  * @brief Gets the CPU info of the system.
- * Gets the CPU info of the system and sets #NCPU_INFO and #NCPU_INFO_LEN.
+ * Gets the CPU info of the system and sets #NCPU_INFO and #NCPU_INFO_LEN. The
+ * topology, caches, and features of the CPU are also detected, and stored in
+ * #NCPU_DETAILS.
  *
  * @param[out] len The length of the string returned. This can be @c #NULL.
  * @return A pointer to the string of the CPU info is returned if successful;
@@ -0,0 +1,275 @@
+#include "../NimbleLicense.h"
+/*
+ * Profiler.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Profiler.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the instrumentation profiler.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_PROFILER_H
+#define NIMBLE_ENGINE_PROFILER_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#include "Time.h"
+
+#ifndef NPROFILE_BUFFER_EVENTS
+#  define NPROFILE_BUFFER_EVENTS 65536 /**< The events buffered per thread until written. Must be a power of 2. */
+#endif
+#ifndef NPROFILE_ROLL_INTERVAL
+#  define NPROFILE_ROLL_INTERVAL 100 /**< The milliseconds between writes of a rolling profile. */
+#endif
+
+#define NPROFILE_TYPE_ZONE    0 /**< A timed zone. */
+#define NPROFILE_TYPE_COUNTER 1 /**< A counter value. */
+#define NPROFILE_TYPE_FRAME   2 /**< A frame marker. */
+
+/**
+ * @brief The static description of a profiler zone, counter, or frame marker.
+ */
+typedef struct nProfileSite_t {
+    const char *name; /**< The name shown in the trace. */
+    const char *file; /**< The source file of the site. */
+    int line; /**< The line of the site in @p file. */
+    int type; /**< The NPROFILE_TYPE_* of the site. */
+} nProfileSite_t;
+
+/**
+ * @brief A recorded profiler event.
+ */
+typedef struct nProfileEvent_t {
+    uint64_t time; /**< The nTicks() when the event started. */
+    const nProfileSite_t *site; /**< The site that recorded the event. */
+    int64_t value; /**< The ticks taken by a zone, or the value of a counter or frame. */
+} nProfileEvent_t;
+
+/**
+ * @brief An open zone, closed when it goes out of scope.
+ */
+typedef struct nProfileScope_t {
+    const nProfileSite_t *site; /**< The site of the zone. */
+    uint64_t start; /**< The nTicks() when the zone was opened, or 0 if disabled. */
+} nProfileScope_t;
+
+/**
+ * @brief Whether profiler events are recorded. This is nonzero by default.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+volatile int nProfileEnabled;
+
+/**
+ * @brief Records an event in the invoking thread's buffer.
+ *
+ * Each thread has its own buffer, which only it writes and only the thread
+ * writing the trace reads, so recording does not lock. If the buffer is full,
+ * the event is dropped.
+ *
+ * @param[in] site The site of the event.
+ * @param[in] time The nTicks() when the event started.
+ * @param[in] value The ticks taken by a zone, or the value of a counter.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nProfileRecord(const nProfileSite_t *const site,
+                    const uint64_t time,
+                    const int64_t value);
+
+/**
+ * @brief Records a frame marker, numbering the frames from 1.
+ *
+ * @param[in] site The site of the marker.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nProfileFrame(const nProfileSite_t *const site);
+
+/**
+ * @brief Names the invoking thread in the trace.
+ *
+ * @param[in] nameStr The name of the thread, which is copied. Nothing is done if
+ * it is #NULL.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nProfileThreadName(const char *const nameStr);
+
+/**
+ * @brief Opens a zone. Use #NPROFILE_ZONE instead.
+ *
+ * @param[in] site The site of the zone.
+ * @return The open zone.
+ */
+NIMBLE_INLINE
+nProfileScope_t nProfileZoneBegin(const nProfileSite_t *const site)
+{
+    const nProfileScope_t scope = {
+        site, nProfileEnabled ? nTicks() : 0
+    };
+    return scope;
+}
+
+/**
+ * @brief Closes a zone. Use #NPROFILE_ZONE instead.
+ *
+ * @param[in] scope The zone to close.
+ */
+NIMBLE_INLINE
+void nProfileZoneEnd(const nProfileScope_t *const scope)
+{
+    if (scope->start)
+    {
+        nProfileRecord(scope->site, scope->start,
+         (int64_t) (nTicks() - scope->start));
+    }
+}
+
+/**
+ * @brief Records a counter value. Use #NPROFILE_COUNTER instead.
+ *
+ * @param[in] site The site of the counter.
+ * @param[in] value The value of the counter.
+ */
+NIMBLE_INLINE
+void nProfileCounter(const nProfileSite_t *const site, const int64_t value)
+{
+    if (nProfileEnabled) nProfileRecord(site, nTicks(), value);
+}
+
+#ifdef NIMBLE_PROFILE
+#  define NPROFILE_CONCAT_(a, b) a##b
+#  define NPROFILE_CONCAT(a, b) NPROFILE_CONCAT_(a, b)
+
+/**
+ * @brief Times the rest of the enclosing scope as a zone named @p nameStr.
+ *
+ * Example:
+ * @code
+ * void nPhysicsStep(void)
+ * {
+ *     NPROFILE_ZONE("Physics");
+ *     ...
+ * }
+ * @endcode
+ *
+ * @param[in] nameStr The name of the zone, which must be a string literal.
+ *
+ * @note Zones, counters, and frame markers are only compiled if
+ * #NIMBLE_PROFILE is defined.
+ */
+#  define NPROFILE_ZONE(nameStr)\
+    static const nProfileSite_t NPROFILE_CONCAT(nProfileSite, __LINE__) = {\
+        nameStr, __FILE__, __LINE__, NPROFILE_TYPE_ZONE\
+    };\
+    const nProfileScope_t NPROFILE_CONCAT(nProfileScope, __LINE__)\
+     __attribute__((cleanup(nProfileZoneEnd))) =\
+     nProfileZoneBegin(&NPROFILE_CONCAT(nProfileSite, __LINE__))
+
+/**
+ * @brief Records @p value as the counter named @p nameStr.
+ *
+ * @param[in] nameStr The name of the counter, which must be a string literal.
+ * @param[in] value The integer value of the counter.
+ */
+#  define NPROFILE_COUNTER(nameStr, value) do {\
+    static const nProfileSite_t nProfileSite = {\
+        nameStr, __FILE__, __LINE__, NPROFILE_TYPE_COUNTER\
+    };\
+    nProfileCounter(&nProfileSite, (int64_t) (value));\
+} while (0)
+
+/**
+ * @brief Marks the start of a frame.
+ */
+#  define NPROFILE_FRAME() do {\
+    static const nProfileSite_t nProfileSite = {\
+        "Frame", __FILE__, __LINE__, NPROFILE_TYPE_FRAME\
+    };\
+    nProfileFrame(&nProfileSite);\
+} while (0)
+#else
+#  define NPROFILE_ZONE(nameStr) ((void) 0)
+#  define NPROFILE_COUNTER(nameStr, value) ((void) 0)
+#  define NPROFILE_FRAME() ((void) 0)
+#endif
+
+/**
+ * @brief Writes the events recorded so far to a Chrome trace event JSON file,
+ * which can be opened in Perfetto or chrome://tracing.
+ *
+ * The events written are removed from the buffers, so the next dump starts
+ * after them.
+ *
+ * @param[in] pathStr The path of the file to write, which is replaced.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nProfileDump(const char *const pathStr);
+
+/**
+ * @brief Starts a thread that appends the recorded events to @p pathStr every
+ * #NPROFILE_ROLL_INTERVAL milliseconds until nProfileStopRolling().
+ *
+ * The file uses the JSON array format, which the trace viewers can open even if
+ * the program crashes before it is closed.
+ *
+ * @param[in] pathStr The path of the file to write, which is replaced.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nProfileStartRolling(const char *const pathStr);
+
+/**
+ * @brief Writes the remaining events and stops the thread started by
+ * nProfileStartRolling().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nProfileStopRolling(void);
+
+#endif // NIMBLE_ENGINE_PROFILER_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Profiler.h
@@ -0,0 +1,120 @@
+#include "../NimbleLicense.h"
+/*
+ * Sampler.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Sampler.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the sampling profiler.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_SAMPLER_H
+#define NIMBLE_ENGINE_SAMPLER_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#ifndef NSAMPLER_FREQUENCY
+#  define NSAMPLER_FREQUENCY 99 /**< The default samples per second of each thread. Not a round number, so that it does not run in lockstep with timers. */
+#endif
+#ifndef NSAMPLER_STACK_MAX
+#  define NSAMPLER_STACK_MAX 64 /**< The maximum stack levels recorded in a sample. */
+#endif
+#ifndef NSAMPLER_RING
+#  define NSAMPLER_RING 1024 /**< The number of samples buffered between the signal handler and the sampler thread. Must be a power of 2. */
+#endif
+#ifndef NSAMPLER_SCAN_INTERVAL
+#  define NSAMPLER_SCAN_INTERVAL 1000 /**< The milliseconds between scans for new threads to sample. */
+#endif
+
+/**
+ * @brief Starts sampling the stacks of all threads of the process.
+ *
+ * On Linux, a @c perf_event_open() task clock is opened for each thread, which
+ * signals that thread with @c SIGPROF after each period of CPU time it uses.
+ * Threads created later are found by a scan every #NSAMPLER_SCAN_INTERVAL
+ * milliseconds. If performance events are not permitted, or on other Unix
+ * systems, @c setitimer() is used instead, which signals whichever thread is
+ * running after each period of CPU time used by the process.
+ *
+ * The signal handler walks the interrupted thread's frame pointers with
+ * nErrorStackWalk() into a preallocated ring, and a low priority thread counts
+ * each unique stack.
+ *
+ * @param[in] frequency The samples per second of CPU time, or 0 for
+ * #NSAMPLER_FREQUENCY.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ *
+ * @note The sampler uses the @c SIGPROF handler while running, and is not
+ * supported on Windows.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nSamplerStart(const uint32_t frequency);
+
+/**
+ * @brief Stops sampling. The samples counted so far are kept for
+ * nSamplerWrite().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nSamplerStop(void);
+
+/**
+ * @brief Writes the samples counted so far as folded stacks, which
+ * flamegraph.pl, speedscope, and similar tools take as input.
+ *
+ * Each line is a stack from the outermost function to the innermost,
+ * separated by semicolons, followed by a space and the number of samples of
+ * that stack.
+ *
+ * @param[in] pathStr The path of the file to write, which is replaced.
+ * @param[in] reset Nonzero to clear the counted samples after writing them.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nSamplerWrite(const char *const pathStr,
+                  const int reset);
+
+#endif // NIMBLE_ENGINE_SAMPLER_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Sampler.h
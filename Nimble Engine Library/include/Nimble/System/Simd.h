@@ -0,0 +1,154 @@
+#include "../NimbleLicense.h"
+/*
+ * Simd.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Simd.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines SIMD kernels dispatched at runtime.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_SIMD_H
+#define NIMBLE_ENGINE_SIMD_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#define NSIMD_LEVEL_SCALAR 0 /**< Portable C kernels. */
+#define NSIMD_LEVEL_SSE42  1 /**< x86 kernels using SSE4.2. */
+#define NSIMD_LEVEL_AVX2   2 /**< x86 kernels using AVX2 and FMA. */
+#define NSIMD_LEVEL_AVX512 3 /**< x86 kernels using AVX-512F. */
+#define NSIMD_LEVEL_NEON   1 /**< ARM kernels using NEON. */
+#define NSIMD_LEVEL_MAX    0xff /**< Allows any level supported by the CPU. */
+
+/**
+ * @brief Compiles a function for an instruction set that the rest of the
+ * engine is not built for, such as "avx2,fma".
+ *
+ * @note The function must only be called if #NSIMD has bound a level that
+ * includes the instruction set.
+ */
+#define NSIMD_TARGET(isa) __attribute__((target(isa)))
+
+/**
+ * @brief The kernels bound to the best variant for the CPU.
+ *
+ * Each kernel is compiled for several instruction set levels in the same
+ * binary, and nSimdBind() selects the highest level supported by the CPU for
+ * each kernel. Levels that do not benefit a kernel reuse the variant of the
+ * level below.
+ *
+ * @note All matrices are 4x4 column-major arrays of 16 floats.
+ */
+typedef struct nSimdKernels_t {
+    int level; /**< The highest level bound, such as #NSIMD_LEVEL_AVX2. */
+
+    /**
+     * @brief Continues a CRC-32C (Castagnoli) checksum.
+     *
+     * @param[in] crc The checksum so far, or 0 to start.
+     * @param[in] data The data to checksum.
+     * @param[in] size The size of @p data in bytes.
+     * @return The checksum of all data so far.
+     */
+    uint32_t (*crc32c)(uint32_t crc, const void *data, size_t size);
+
+    /**
+     * @brief Computes the dot product of two float arrays.
+     *
+     * @param[in] a The first array.
+     * @param[in] b The second array.
+     * @param[in] count The number of floats in each array.
+     * @return The sum of each @p a[i] * @p b[i].
+     */
+    float (*dot)(const float *a, const float *b, size_t count);
+
+    /**
+     * @brief Computes @p dst[i] = @p a[i] * @p b[i] + @p c[i].
+     *
+     * @param[out] dst The destination array, which may alias the sources.
+     * @param[in] a The first factors.
+     * @param[in] b The second factors.
+     * @param[in] c The addends.
+     * @param[in] count The number of floats in each array.
+     */
+    void (*mulAdd)(float *dst, const float *a, const float *b, const float *c,
+                   size_t count);
+
+    /**
+     * @brief Multiplies arrays of matrices, computing @p dst[i] = @p a[i] *
+     * @p b[i].
+     *
+     * @param[out] dst The destination matrices, which may alias the sources.
+     * @param[in] a The left matrices.
+     * @param[in] b The right matrices.
+     * @param[in] count The number of matrices in each array.
+     */
+    void (*mat4Mul)(float *dst, const float *a, const float *b, size_t count);
+} nSimdKernels_t;
+
+/**
+ * @brief The kernels bound to the best variant for the CPU.
+ *
+ * @note To set this value, call nSimdBind(), which nEngineInit() does. Until
+ * then the scalar variants are bound.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+nSimdKernels_t NSIMD;
+
+/**
+ * @brief Binds the kernels of #NSIMD to the best variants supported by the CPU.
+ *
+ * @param[in] maxLevel The highest level to bind, such as #NSIMD_LEVEL_MAX, or
+ * #NSIMD_LEVEL_SCALAR to compare against the portable kernels.
+ * @return The level bound is returned.
+ *
+ * @note This calls nSysGetCPUInfo() to detect the CPU's features, and is not
+ * thread safe.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nSimdBind(const int maxLevel);
+
+#endif // NIMBLE_ENGINE_SIMD_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Simd.h
@@ -87,7 +87,8 @@ typedef mtx_t *nMutex_t;
  * Creates a thread starting at @p start() where @p data is passed, whose
  * identity is stored in @p thread with @p attributes attributes.
  *
- * @param[out] thread The thread identity of the created thread.
+ * @param[out] thread The thread identity of the created thread, or #NULL to
+ * detach the thread.
  * @param[in] start The start function for the thread to start in. This function
  * should take a @c void * argument, which @p data is sent to, and should
  * return its return value as a @c void *.
@@ -113,7 +114,7 @@ int nThreadCreate(nThread_t *thread,
 #if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
 #  define nThreadExit(ret) ExitThread((DWORD) ret)
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
-#  define nThreadExit(ret) pthread_exit((void *) &ret)
+#  define nThreadExit(ret) pthread_exit((void *) (intptr_t) (ret))
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
 #  define nThreadExit(ret) thrd_exit(ret)
 #endif
@@ -177,6 +178,20 @@ NIMBLE_EXPORT
 NIMBLE_EXTERN
 int nThreadDetach(nThread_t thread);
 
+/**
+ * @brief Lowers the scheduling priority of the calling thread.
+ *
+ * This is used by background threads, such as the log archiver, that should
+ * only run when the other threads do not need the CPU.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned and
+ * a corresponding error is sent to the error callback set by
+ * nErrorHandlerSetErrorCallback().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nThreadLowerPriority(void);
+
 /**
  * @brief Initializes a #NULL mutex.
  *
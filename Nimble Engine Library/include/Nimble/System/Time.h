@@ -52,58 +52,74 @@ extern "C" {
 
 #if NIMBLE_OS == NIMBLE_WINDOWS
 #include <windows.h>
+#else
+#include <errno.h>
 #endif
 
 #define NTIME_NS_IN_US   1000L /**< Nanoseconds in a microsecond. */
 
 #define NTIME_US_IN_MS   1000L /**< Microseconds in a millisecond. */
-#define NTIME_NS_IN_MS   NTIME_US_IN_MS * NTIME_NS_IN_US /**< Nanoseconds in a millisecond. */
+#define NTIME_NS_IN_MS   (NTIME_US_IN_MS * NTIME_NS_IN_US) /**< Nanoseconds in a millisecond. */
 
 #define NTIME_MS_IN_SEC  1000L /**< Milliseconds in a second. */
-#define NTIME_US_IN_SEC  NTIME_MS_IN_SEC * NTIME_US_IN_MS /**< Microseconds in a second. */
-#define NTIME_NS_IN_SEC  NTIME_MS_IN_SEC * NTIME_NS_IN_MS /**< Nanoseconds in a second. */
+#define NTIME_US_IN_SEC  (NTIME_MS_IN_SEC * NTIME_US_IN_MS) /**< Microseconds in a second. */
+#define NTIME_NS_IN_SEC  (NTIME_MS_IN_SEC * NTIME_NS_IN_MS) /**< Nanoseconds in a second. */
 
 #define NTIME_SEC_IN_MIN 60L /**< Seconds in a minute. */
-#define NTIME_MS_IN_MIN  NTIME_SEC_IN_MIN * NTIME_MS_IN_SEC /**< Milliseconds in a minute. */
-#define NTIME_US_IN_MIN  NTIME_SEC_IN_MIN * NTIME_US_IN_SEC /**< Microseconds in a minute. */
-#define NTIME_NS_IN_MIN  NTIME_SEC_IN_MIN * NTIME_NS_IN_SEC /**< Nanoseconds in a minute. */
+#define NTIME_MS_IN_MIN  (NTIME_SEC_IN_MIN * NTIME_MS_IN_SEC) /**< Milliseconds in a minute. */
+#define NTIME_US_IN_MIN  (NTIME_SEC_IN_MIN * NTIME_US_IN_SEC) /**< Microseconds in a minute. */
+#define NTIME_NS_IN_MIN  (NTIME_SEC_IN_MIN * NTIME_NS_IN_SEC) /**< Nanoseconds in a minute. */
 
 #define NTIME_MIN_IN_HR  60L /**< Minutes in an hour. */
-#define NTIME_SEC_IN_HR  NTIME_MIN_IN_HR * NTIME_SEC_IN_MIN /**< Seconds in an hour. */
-#define NTIME_MS_IN_HR   NTIME_MIN_IN_HR * NTIME_MS_IN_MIN /**< Milliseconds in an hour. */
-#define NTIME_US_IN_HR   NTIME_MIN_IN_HR * NTIME_US_IN_MIN /**< Microseconds in an hour. */
-#define NTIME_NS_IN_HR   NTIME_MIN_IN_HR * NTIME_NS_IN_MIN /**< Nanoseconds in an hour. */
+#define NTIME_SEC_IN_HR  (NTIME_MIN_IN_HR * NTIME_SEC_IN_MIN) /**< Seconds in an hour. */
+#define NTIME_MS_IN_HR   (NTIME_MIN_IN_HR * NTIME_MS_IN_MIN) /**< Milliseconds in an hour. */
+#define NTIME_US_IN_HR   (NTIME_MIN_IN_HR * NTIME_US_IN_MIN) /**< Microseconds in an hour. */
+#define NTIME_NS_IN_HR   (NTIME_MIN_IN_HR * NTIME_NS_IN_MIN) /**< Nanoseconds in an hour. */
 
 #define NTIME_HR_IN_DAY  24L /**< Hours in a day. */
-#define NTIME_MIN_IN_DAY NTIME_HR_IN_DAY * NTIME_MIN_IN_HR /**< Minutes in a day. */
-#define NTIME_SEC_IN_DAY NTIME_HR_IN_DAY * NTIME_SEC_IN_HR /**< Seconds in a day. */
-#define NTIME_MS_IN_DAY  NTIME_HR_IN_DAY * NTIME_MS_IN_HR /**< Milliseconds in a day. */
-#define NTIME_US_IN_DAY  NTIME_HR_IN_DAY * NTIME_US_IN_HR /**< Microseconds in a day. */
-#define NTIME_NS_IN_DAY  NTIME_HR_IN_DAY * NTIME_NS_IN_HR /**< Nanoseconds in a day. */
+#define NTIME_MIN_IN_DAY (NTIME_HR_IN_DAY * NTIME_MIN_IN_HR) /**< Minutes in a day. */
+#define NTIME_SEC_IN_DAY (NTIME_HR_IN_DAY * NTIME_SEC_IN_HR) /**< Seconds in a day. */
+#define NTIME_MS_IN_DAY  (NTIME_HR_IN_DAY * NTIME_MS_IN_HR) /**< Milliseconds in a day. */
+#define NTIME_US_IN_DAY  (NTIME_HR_IN_DAY * NTIME_US_IN_HR) /**< Microseconds in a day. */
+#define NTIME_NS_IN_DAY  (NTIME_HR_IN_DAY * NTIME_NS_IN_HR) /**< Nanoseconds in a day. */
 
 #define NTIME_DAY_IN_YR  365L /**< Days in a year. */
-#define NTIME_HR_IN_YR   NTIME_DAY_IN_YR * NTIME_HR_IN_DAY /**< Hours in a year. */
-#define NTIME_MIN_IN_YR  NTIME_DAY_IN_YR * NTIME_MIN_IN_DAY /**< Minutes in a year. */
-#define NTIME_SEC_IN_YR  NTIME_DAY_IN_YR * NTIME_SEC_IN_DAY /**< Seconds in a year. */
-#define NTIME_MS_IN_YR   NTIME_DAY_IN_YR * NTIME_MS_IN_DAY /**< Milliseconds in a year. */
-#define NTIME_US_IN_YR  NTIME_DAY_IN_YR * NTIME_US_IN_DAY /**< Microseconds in a year. */
-#define NTIME_NS_IN_YR  NTIME_DAY_IN_YR * NTIME_NS_IN_DAY /**< Nanoseconds in a year. */
+#define NTIME_HR_IN_YR   (NTIME_DAY_IN_YR * NTIME_HR_IN_DAY) /**< Hours in a year. */
+#define NTIME_MIN_IN_YR  (NTIME_DAY_IN_YR * NTIME_MIN_IN_DAY) /**< Minutes in a year. */
+#define NTIME_SEC_IN_YR  (NTIME_DAY_IN_YR * NTIME_SEC_IN_DAY) /**< Seconds in a year. */
+#define NTIME_MS_IN_YR   (NTIME_DAY_IN_YR * NTIME_MS_IN_DAY) /**< Milliseconds in a year. */
+#define NTIME_US_IN_YR  (NTIME_DAY_IN_YR * NTIME_US_IN_DAY) /**< Microseconds in a year. */
+#define NTIME_NS_IN_YR  (NTIME_DAY_IN_YR * NTIME_NS_IN_DAY) /**< Nanoseconds in a year. */
 
 #define NTIME_DAY_IN_LYR 366L /**< Days in a leap year. */
-#define NTIME_HR_IN_LYR   NTIME_DAY_IN_LYR * NTIME_HR_IN_DAY /**< Hours in a leap year. */
-#define NTIME_MIN_IN_LYR  NTIME_DAY_IN_LYR * NTIME_MIN_IN_DAY /**< Minutes in a leap year. */
-#define NTIME_SEC_IN_LYR  NTIME_DAY_IN_LYR * NTIME_SEC_IN_DAY /**< Seconds in a leap year. */
-#define NTIME_MS_IN_LYR   NTIME_DAY_IN_LYR * NTIME_MS_IN_DAY /**< Milliseconds in a leap year. */
-#define NTIME_US_IN_LYR  NTIME_DAY_IN_LYR * NTIME_US_IN_DAY /**< Microseconds in a leap year. */
-#define NTIME_NS_IN_LYR  NTIME_DAY_IN_LYR * NTIME_NS_IN_DAY /**< Nanoseconds in a leap year. */
+#define NTIME_HR_IN_LYR   (NTIME_DAY_IN_LYR * NTIME_HR_IN_DAY) /**< Hours in a leap year. */
+#define NTIME_MIN_IN_LYR  (NTIME_DAY_IN_LYR * NTIME_MIN_IN_DAY) /**< Minutes in a leap year. */
+#define NTIME_SEC_IN_LYR  (NTIME_DAY_IN_LYR * NTIME_SEC_IN_DAY) /**< Seconds in a leap year. */
+#define NTIME_MS_IN_LYR   (NTIME_DAY_IN_LYR * NTIME_MS_IN_DAY) /**< Milliseconds in a leap year. */
+#define NTIME_US_IN_LYR  (NTIME_DAY_IN_LYR * NTIME_US_IN_DAY) /**< Microseconds in a leap year. */
+#define NTIME_NS_IN_LYR  (NTIME_DAY_IN_LYR * NTIME_NS_IN_DAY) /**< Nanoseconds in a leap year. */
 
 #define NTIME_DAY_IN_JYR 365.25f /**< Days in a Julian year. */
 #define NTIME_HR_IN_JYR  8766L /**< Hours in a Julian year. */
-#define NTIME_MIN_IN_JYR NTIME_HR_IN_JYR * NTIME_MIN_IN_HR /**< Minutes in a Julian year. */
-#define NTIME_SEC_IN_JYR NTIME_HR_IN_JYR * NTIME_SEC_IN_HR /**< Seconds in a Julian year. */
-#define NTIME_MS_IN_JYR  NTIME_HR_IN_JYR * NTIME_MS_IN_HR /**< Milliseconds in a Julian year. */
-#define NTIME_US_IN_JYR  NTIME_HR_IN_JYR * NTIME_US_IN_HR /**< Microseconds in a Julian year. */
-#define NTIME_NS_IN_JYR  NTIME_HR_IN_JYR * NTIME_NS_IN_HR /**< Nanoseconds in a Julian year. */
+#define NTIME_MIN_IN_JYR (NTIME_HR_IN_JYR * NTIME_MIN_IN_HR) /**< Minutes in a Julian year. */
+#define NTIME_SEC_IN_JYR (NTIME_HR_IN_JYR * NTIME_SEC_IN_HR) /**< Seconds in a Julian year. */
+#define NTIME_MS_IN_JYR  (NTIME_HR_IN_JYR * NTIME_MS_IN_HR) /**< Milliseconds in a Julian year. */
+#define NTIME_US_IN_JYR  (NTIME_HR_IN_JYR * NTIME_US_IN_HR) /**< Microseconds in a Julian year. */
+#define NTIME_NS_IN_JYR  (NTIME_HR_IN_JYR * NTIME_NS_IN_HR) /**< Nanoseconds in a Julian year. */
+
+#ifndef NTIME_SLEEP_SLICE_NS
+#  define NTIME_SLEEP_SLICE_NS 1000000L /**< The nanoseconds nTimeSleepUntil() sleeps for at a time before spinning. */
+#endif
+#ifndef NTIMER_RESOLUTION
+#  define NTIMER_RESOLUTION NTIME_NS_IN_MS /**< The default nanoseconds per tick of a timer wheel. */
+#endif
+#define NTIMER_LEVEL_BITS 8 /**< The log2 of the slots in each level of a timer wheel. */
+#define NTIMER_SLOTS (1 << NTIMER_LEVEL_BITS) /**< The slots in each level of a timer wheel. */
+#define NTIMER_LEVELS 4 /**< The levels of a timer wheel. Timers further than NTIMER_SLOTS^NTIMER_LEVELS ticks away are cascaded until they are near. */
+
+#ifndef NTIME_CALIBRATE_MS
+#  define NTIME_CALIBRATE_MS 20 /**< The milliseconds nTimeCalibrate() measures the CPU's counter for. */
+#endif
 
 typedef struct nTimeSpec {
     time_t secs; /**< Time in seconds after the Unix epoch (1 Jan, 1970). */
@@ -136,6 +152,420 @@ nTime_t nTime(void)
     return time;
 }
 
+/**
+ * @brief The frequency of nTicks() in ticks per second.
+ *
+ * @note This is set by nTimeCalibrate().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint64_t NTIME_TICK_FREQ;
+
+/**
+ * @brief Nonzero if nTicks() reads the CPU counter, which requires the counter
+ * to run at a constant rate on every core; otherwise nTicks() falls back to
+ * nTimeMonotonic().
+ *
+ * @note This is set by nTimeCalibrate().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int NTIME_TICK_COUNTER;
+
+/**
+ * @brief The nanoseconds per tick as a 32.32 fixed point number.
+ *
+ * @note This is set by nTimeCalibrate().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint64_t NTIME_TICK_NS_MULT;
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+/**
+ * @brief The frequency of QueryPerformanceCounter(), used by nTimeMonotonic().
+ *
+ * @note This is set by nTimeCalibrate().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint64_t NTIME_QPC_FREQ;
+#endif
+
+/**
+ * @brief Gets the time of a clock that never jumps, such as with NTP
+ * corrections.
+ *
+ * @return Returns the nanoseconds since an unspecified point, usually boot.
+ *
+ * @note Only differences of these times are meaningful. Use nTime() for the
+ * time of day.
+ */
+NIMBLE_INLINE
+uint64_t nTimeMonotonic(void)
+{
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    const uint64_t freq = NTIME_QPC_FREQ ? NTIME_QPC_FREQ : 10000000ULL;
+    return ((uint64_t) counter.QuadPart / freq) * NTIME_NS_IN_SEC +
+     (((uint64_t) counter.QuadPart % freq) * NTIME_NS_IN_SEC) / freq;
+#else
+    struct timespec time;
+#  ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+#  else
+    clock_gettime(CLOCK_MONOTONIC, &time);
+#  endif
+    return ((uint64_t) time.tv_sec * NTIME_NS_IN_SEC) + (uint64_t) time.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Reads the CPU's counter (@c rdtsc on x86 or @c cntvct_el0 on ARM).
+ *
+ * @return Returns the counter value.
+ *
+ * @note This does not serialize the instruction stream, so it may be reordered
+ * with nearby instructions.
+ */
+NIMBLE_INLINE
+uint64_t nTicksRaw(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r" (ticks));
+    return ticks;
+#else
+    return nTimeMonotonic();
+#endif
+}
+
+/**
+ * @brief Gets a timestamp at a very low cost, for instrumentation and
+ * profiling.
+ *
+ * This reads the CPU's counter if nTimeCalibrate() found that it runs at a
+ * constant rate, which takes a few nanoseconds; otherwise it uses
+ * nTimeMonotonic().
+ *
+ * @return Returns the number of ticks since an unspecified point. Convert
+ * differences of ticks with nTicksToNanos() and the related functions.
+ */
+NIMBLE_INLINE
+uint64_t nTicks(void)
+{
+    return NTIME_TICK_COUNTER ? nTicksRaw() : nTimeMonotonic();
+}
+
+/**
+ * @brief Multiplies two numbers and shifts the product right by 32 bits.
+ *
+ * 32-bit targets without 128-bit integers build the product from 32-bit
+ * halves, which gives the same result.
+ *
+ * @param[in] a The first factor.
+ * @param[in] b The second factor.
+ * @return Returns the lower 64 bits of @p a times @p b shifted right by 32.
+ */
+NIMBLE_INLINE
+uint64_t nTimeMulShift(const uint64_t a, const uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    return (uint64_t) (((unsigned __int128) a * b) >> 32);
+#else
+    const uint64_t ll = (a & 0xffffffffU) * (b & 0xffffffffU);
+    const uint64_t lh = (a & 0xffffffffU) * (b >> 32);
+    const uint64_t hl = (a >> 32) * (b & 0xffffffffU);
+    const uint64_t hh = (a >> 32) * (b >> 32);
+    return (hh << 32) + lh + hl + (ll >> 32);
+#endif
+}
+
+/**
+ * @brief Multiplies two numbers and divides the product without overflowing
+ * in between.
+ *
+ * 32-bit targets without 128-bit integers divide @p a first, which gives the
+ * same result as long as the remainder of @p a times @p b fits in 64 bits, as
+ * it does for the conversions of time here.
+ *
+ * @param[in] a The first factor.
+ * @param[in] b The second factor.
+ * @param[in] c The divisor.
+ * @return Returns @p a times @p b divided by @p c, rounded down.
+ */
+NIMBLE_INLINE
+uint64_t nTimeMulDiv(const uint64_t a, const uint64_t b, const uint64_t c)
+{
+#ifdef __SIZEOF_INT128__
+    return (uint64_t) (((unsigned __int128) a * b) / c);
+#else
+    return ((a / c) * b) + (((a % c) * b) / c);
+#endif
+}
+
+/**
+ * @brief Converts a number of ticks from nTicks() to nanoseconds.
+ *
+ * @param[in] ticks The ticks to convert.
+ * @return Returns the nanoseconds.
+ */
+NIMBLE_INLINE
+uint64_t nTicksToNanos(const uint64_t ticks)
+{
+    return nTimeMulShift(ticks, NTIME_TICK_NS_MULT);
+}
+
+/**
+ * @brief Converts a number of ticks from nTicks() to microseconds.
+ *
+ * @param[in] ticks The ticks to convert.
+ * @return Returns the microseconds.
+ */
+NIMBLE_INLINE
+uint64_t nTicksToMicros(const uint64_t ticks)
+{
+    return nTicksToNanos(ticks) / NTIME_NS_IN_US;
+}
+
+/**
+ * @brief Converts a number of ticks from nTicks() to milliseconds.
+ *
+ * @param[in] ticks The ticks to convert.
+ * @return Returns the milliseconds.
+ */
+NIMBLE_INLINE
+uint64_t nTicksToMillis(const uint64_t ticks)
+{
+    return nTicksToNanos(ticks) / NTIME_NS_IN_MS;
+}
+
+/**
+ * @brief Converts a number of ticks from nTicks() to seconds.
+ *
+ * @param[in] ticks The ticks to convert.
+ * @return Returns the seconds.
+ */
+NIMBLE_INLINE
+double nTicksToSecs(const uint64_t ticks)
+{
+    return (double) ticks / (double) NTIME_TICK_FREQ;
+}
+
+/**
+ * @brief Converts a number of nanoseconds to ticks of nTicks().
+ *
+ * @param[in] nanos The nanoseconds to convert.
+ * @return Returns the ticks.
+ */
+NIMBLE_INLINE
+uint64_t nNanosToTicks(const uint64_t nanos)
+{
+    return nTimeMulDiv(nanos, NTIME_TICK_FREQ, NTIME_NS_IN_SEC);
+}
+
+/**
+ * @brief Measures the frequency of nTicks() and checks if the CPU's counter
+ * can be used.
+ *
+ * The counter is used if it runs at a constant rate regardless of the CPU's
+ * frequency and sleep states (invariant TSC on x86, which is always the case
+ * for the generic timer on ARM). The frequency is measured against
+ * nTimeMonotonic() for #NTIME_CALIBRATE_MS milliseconds unless the CPU reports
+ * it.
+ *
+ * @return #NSUCCESS is always returned.
+ *
+ * @note This is called by nEngineInit(). Until it is, nTicks() returns
+ * nanoseconds.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nTimeCalibrate(void);
+
+/**
+ * @brief Suspends the invoking thread for at least @p nanos nanoseconds.
+ *
+ * @param[in] nanos The number of nanoseconds to sleep for.
+ *
+ * @note On Windows, the time is rounded up to whole milliseconds.
+ */
+NIMBLE_INLINE
+void nTimeNanoSleep(const uint64_t nanos)
+{
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    Sleep((DWORD) ((nanos + NTIME_NS_IN_MS - 1) / NTIME_NS_IN_MS));
+#else
+    struct timespec time = {
+        .tv_sec = nanos / NTIME_NS_IN_SEC,
+        .tv_nsec = nanos % NTIME_NS_IN_SEC
+    };
+    while (nanosleep(&time, &time) && (errno == EINTR));
+#endif
+}
+
+/**
+ * @brief Suspends the invoking thread until nTimeMonotonic() reaches
+ * @p deadline, with sub-microsecond precision.
+ *
+ * The thread sleeps in slices of #NTIME_SLEEP_SLICE_NS while the remaining
+ * time is greater than the expected slice duration, which includes the
+ * oversleep of the scheduler and is learned from previous slices of the
+ * thread, and spins for the rest.
+ *
+ * @param[in] deadline The time of nTimeMonotonic() to wake at.
+ * @return Returns the nanoseconds the thread woke after @p deadline, which is 0
+ * if @p deadline has already passed.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint64_t nTimeSleepUntil(const uint64_t deadline);
+
+/**
+ * @brief A timer scheduled on an #nTimerWheel_t.
+ *
+ * Timers are stored in the wheel without allocating, so the memory of a timer
+ * must stay valid while it is scheduled. It is usually embedded in the object
+ * it belongs to.
+ *
+ * @note Initialize timers with nTimerInit().
+ */
+typedef struct nTimer {
+    struct nTimer *next; /**< The next timer in the same slot. */
+    struct nTimer **pprev; /**< The pointer to this timer in its slot, or #NULL if the timer is not scheduled. */
+    uint64_t expires; /**< The wheel tick the timer expires at. */
+    uint64_t interval; /**< The ticks between repeats, or 0 to not repeat. */
+    void (*callback)(struct nTimer *timer, void *data); /**< Invoked when the timer expires. */
+    void *data; /**< Passed to the callback. */
+} nTimer_t;
+
+/**
+ * @brief A hashed hierarchical timer wheel.
+ *
+ * Each of the #NTIMER_LEVELS levels has #NTIMER_SLOTS slots, and each slot of
+ * a level spans all of the slots of the level below it. Timers are added to
+ * the lowest level their expiry fits in, and moved down a level when the level
+ * below wraps around, so scheduling and cancelling are O(1) regardless of the
+ * number of timers.
+ *
+ * @note A wheel is not thread safe. Drive it from one thread, such as the game
+ * loop, with nTimerWheelAdvance(), and only schedule and cancel its timers from
+ * that thread.
+ */
+typedef struct nTimerWheel {
+    nTimer_t *slots[NTIMER_LEVELS][NTIMER_SLOTS]; /**< The timers of each slot. */
+    uint64_t pending[NTIMER_SLOTS / 64]; /**< A bit for each slot of the lowest level that may hold timers. */
+    uint64_t tick; /**< The next tick to run the timers of. */
+    uint64_t resolution; /**< The nanoseconds per tick. */
+    uint64_t start; /**< The time of nTimeMonotonic() at tick 0. */
+    size_t count; /**< The number of timers scheduled. */
+} nTimerWheel_t;
+
+/**
+ * @brief Initializes @p wheel, starting at the current time.
+ *
+ * @param[out] wheel The wheel to initialize.
+ * @param[in] resolution The nanoseconds per tick, or 0 for
+ * #NTIMER_RESOLUTION. Timers fire at the first tick at or after they expire.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nTimerWheelInit(nTimerWheel_t *const wheel,
+                     const uint64_t resolution);
+
+/**
+ * @brief Initializes @p timer.
+ *
+ * @param[out] timer The timer to initialize.
+ * @param[in] callback The function to invoke when the timer expires. The timer
+ * can be scheduled again or cancelled from it.
+ * @param[in] data The data passed to @p callback.
+ */
+NIMBLE_INLINE
+void nTimerInit(nTimer_t *const timer,
+                void (*const callback)(nTimer_t *timer, void *data),
+                void *const data)
+{
+    timer->next = NULL;
+    timer->pprev = NULL;
+    timer->expires = 0;
+    timer->interval = 0;
+    timer->callback = callback;
+    timer->data = data;
+}
+
+/**
+ * @brief Checks if @p timer is scheduled.
+ *
+ * @param[in] timer The timer to check.
+ * @return Nonzero is returned if the timer is scheduled.
+ */
+NIMBLE_INLINE
+int nTimerPending(const nTimer_t *const timer)
+{
+    return timer->pprev != NULL;
+}
+
+/**
+ * @brief Schedules @p timer to expire after @p delay nanoseconds, replacing its
+ * previous schedule.
+ *
+ * @param[in,out] wheel The wheel to schedule the timer on.
+ * @param[in,out] timer The timer to schedule.
+ * @param[in] delay The nanoseconds from the current tick of the wheel until
+ * the timer expires.
+ * @param[in] interval The nanoseconds between repeats after it expires, or 0 to
+ * only expire once.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nTimerSchedule(nTimerWheel_t *const wheel,
+                    nTimer_t *const timer,
+                    const uint64_t delay,
+                    const uint64_t interval);
+
+/**
+ * @brief Cancels @p timer, including its repeats.
+ *
+ * @param[in,out] wheel The wheel the timer is scheduled on.
+ * @param[in,out] timer The timer to cancel. Nothing is done if it is not
+ * scheduled.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nTimerCancel(nTimerWheel_t *const wheel,
+                  nTimer_t *const timer);
+
+/**
+ * @brief Runs the timers of @p wheel that expire up to @p now.
+ *
+ * @param[in,out] wheel The wheel to advance.
+ * @param[in] now The time of nTimeMonotonic() to advance to.
+ * @return Returns the number of timers that expired.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+size_t nTimerWheelAdvance(nTimerWheel_t *const wheel,
+                          const uint64_t now);
+
+/**
+ * @brief Gets the time of nTimeMonotonic() at which @p wheel next has work,
+ * for threads that sleep between calls to nTimerWheelAdvance().
+ *
+ * This is the first tick with timers that may expire, or the next tick at
+ * which a higher level is cascaded, whichever comes first, so empty ticks are
+ * never woken for.
+ *
+ * @param[in] wheel The wheel to get the next tick of.
+ * @return Returns the time of the next tick with work.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+uint64_t nTimerWheelNextTick(const nTimerWheel_t *const wheel);
+
 #endif // NIMBLE_ENGINE_TIME_H
 
 #ifdef __cplusplus
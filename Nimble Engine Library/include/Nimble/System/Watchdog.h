@@ -0,0 +1,134 @@
+#include "../NimbleLicense.h"
+/*
+ * Watchdog.h
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+/**
+ * @file Watchdog.h
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the watchdog that reports stalled threads.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NIMBLE_ENGINE_WATCHDOG_H
+#define NIMBLE_ENGINE_WATCHDOG_H /**< Header definition */
+
+#include "../Nimble.h"
+
+#include <stdint.h>
+
+#ifndef NWATCHDOG_THREADS_MAX
+#  define NWATCHDOG_THREADS_MAX 64 /**< The maximum number of threads registered with the watchdog at once. */
+#endif
+#ifndef NWATCHDOG_INTERVAL
+#  define NWATCHDOG_INTERVAL 100 /**< The milliseconds between checks of the watchdog thread. */
+#endif
+#ifndef NWATCHDOG_TIMEOUT
+#  define NWATCHDOG_TIMEOUT 2000 /**< The default milliseconds a thread may go without a heartbeat. */
+#endif
+#ifndef NWATCHDOG_STACK_MAX
+#  define NWATCHDOG_STACK_MAX 64 /**< The maximum stack levels captured from a stalled thread. */
+#endif
+#ifndef NWATCHDOG_SIGNAL
+#  define NWATCHDOG_SIGNAL SIGUSR2 /**< The signal sent to a stalled thread to capture its stack. */
+#endif
+#define NWATCHDOG_NAME_MAX 32 /**< The maximum length of a registered thread's name, including the null terminator. */
+
+/**
+ * @brief Starts the watchdog thread, which checks that each registered thread
+ * sends a heartbeat within its timeout.
+ *
+ * When a thread misses its deadline, the watchdog interrupts it to capture
+ * its stack (with #NWATCHDOG_SIGNAL, or by suspending it on Windows), and
+ * throws #NERROR_TIMER with the thread's name, how late it is and its stack,
+ * which is reported through the error callback. Each stall is reported once,
+ * and its length is logged when the thread's heartbeat resumes.
+ *
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned.
+ *
+ * @note This is called by nEngineInit().
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nWatchdogStart(void);
+
+/**
+ * @brief Stops the watchdog thread. Registered threads stay registered.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nWatchdogStop(void);
+
+/**
+ * @brief Registers the invoking thread with the watchdog.
+ *
+ * @param[in] nameStr The name of the thread in reports, such as "Main loop".
+ * @param[in] timeout The milliseconds the thread may go without calling
+ * nWatchdogHeartbeat(), or 0 for #NWATCHDOG_TIMEOUT.
+ * @return #NSUCCESS is returned if successful; otherwise #NERROR_WARN is
+ * returned if the thread is already registered, or #NERROR_OVERFLOW if
+ * #NWATCHDOG_THREADS_MAX threads are registered.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+int nWatchdogRegister(const char *const nameStr,
+                      const uint32_t timeout);
+
+/**
+ * @brief Unregisters the invoking thread from the watchdog. This must be
+ * called before a registered thread exits.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nWatchdogUnregister(void);
+
+/**
+ * @brief Tells the watchdog that the invoking thread is making progress.
+ *
+ * This should be called once per frame or unit of work. It is a single
+ * store, and does nothing if the thread is not registered.
+ */
+NIMBLE_EXPORT
+NIMBLE_EXTERN
+void nWatchdogHeartbeat(void);
+
+#endif // NIMBLE_ENGINE_WATCHDOG_H
+
+#ifdef __cplusplus
+}
+#endif
+
+// Watchdog.h
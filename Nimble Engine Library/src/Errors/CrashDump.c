@@ -0,0 +1,678 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * CrashDump.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE /**< Needed for the registers of ucontext_t. */
+#endif
+#include "../../include/Nimble/Errors/CrashDump.h"
+
+/**
+ * @file CrashDump.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the crash dump writer.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+#include <windows.h>
+#include <dbghelp.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+#if (NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)
+#  define NCRASH_THREADS /**< Capture the stacks of the other threads. */
+#include <sys/syscall.h>
+#endif
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/Output/Logging.h"
+#include "../../include/Nimble/System/Memory.h"
+
+static char crashDir[NCRASH_PATH_MAX] = ".";
+static char crashPath[NCRASH_PATH_MAX] = "";
+static volatile int crashWriting = 0; /* 0, or one of the NCRASH_STATE_* states. */
+static volatile uintptr_t crashWriter = 0; /* The thread writing the dump. */
+
+#define NCRASH_STATE_WRITING 1 /* A thread is writing the dump. */
+#define NCRASH_STATE_WRITTEN 2 /* The dump was written, or failed. */
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+#define NCRASH_REGISTERS_MAX 34 /* The most registers of an NCRASH_ARCH_*. */
+
+/**
+ * @brief The registers and stack of a thread, captured for a crash dump.
+ */
+typedef struct nCrashThread {
+    volatile uint32_t ready; /* Set once the rest is written. */
+    uint32_t registerCount; /* The number of registers in registers. */
+    nCrashStack_t stack; /* The ID, name and number of levels of the stack. */
+    uint64_t registers[NCRASH_REGISTERS_MAX]; /* The NCRASH_ARCH_* registers. */
+    void *addrs[NCRASH_STACK_MAX]; /* The program counter, then return addresses. */
+} nCrashThread_t;
+
+static nCrashThread_t crashSelf; /* The crashed thread. */
+static char *crashMaps = NULL; /* NCRASH_MAPS_SIZE bytes for the memory maps. */
+
+#ifdef NCRASH_THREADS
+static nCrashThread_t *crashThreads = NULL; /* NCRASH_THREADS_MAX other threads. */
+static volatile uint32_t crashThreadCount = 0; /* The slots of crashThreads claimed. */
+static volatile int crashHolding = 0; /* Set while other threads are held. */
+
+/**
+ * @brief An entry read by getdents64(), which glibc only recently wrapped.
+ */
+typedef struct nCrashDirent {
+    uint64_t ino;
+    int64_t off;
+    unsigned short reclen;
+    unsigned char type;
+    char name[];
+} nCrashDirent_t;
+#endif
+
+/* Gets the NCRASH_ARCH_* of the registers of context. */
+static uint32_t nCrashArch(void)
+{
+#if ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__x86_64__)
+    return NCRASH_ARCH_X86_64;
+#elif ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__aarch64__)
+    return NCRASH_ARCH_AARCH64;
+#else
+    return NCRASH_ARCH_UNKNOWN;
+#endif
+}
+
+/* Copies the registers of context in the order of nCrashArch(), returning the
+ * number copied. */
+static uint32_t nCrashRegisters(const void *const context,
+ uint64_t *const registers)
+{
+    if (!context) return 0;
+    const ucontext_t *const uc = context;
+#if ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__x86_64__)
+    static const int order[] = {
+        REG_RAX, REG_RBX, REG_RCX, REG_RDX, REG_RSI, REG_RDI, REG_RBP, REG_RSP,
+        REG_R8, REG_R9, REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15,
+        REG_RIP, REG_EFL
+    };
+    for (uint32_t i = 0; i < sizeof(order) / sizeof(order[0]); i++)
+    {
+        registers[i] = (uint64_t) uc->uc_mcontext.gregs[order[i]];
+    }
+    return sizeof(order) / sizeof(order[0]);
+#elif ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__aarch64__)
+    for (uint32_t i = 0; i < 31; i++) registers[i] = uc->uc_mcontext.regs[i];
+    registers[31] = uc->uc_mcontext.sp;
+    registers[32] = uc->uc_mcontext.pc;
+    registers[33] = uc->uc_mcontext.pstate;
+    return 34;
+#else
+    (void) uc;
+    (void) registers;
+    return 0;
+#endif
+}
+
+/* Writes the decimal digits of value to str, returning their number. */
+static size_t nCrashFormatUInt(char *const str, uint64_t value)
+{
+    char digits[20];
+    size_t len = 0;
+    do
+    {
+        digits[len++] = (char) ('0' + (value % 10));
+        value /= 10;
+    } while (value);
+    for (size_t i = 0; i < len; i++) str[i] = digits[len - 1 - i];
+    return len;
+}
+
+/* Appends srcStr to the null terminated dst of size bytes, truncating it. */
+static void nCrashAppend(char *const dst, const size_t size,
+ const char *const srcStr, const size_t len)
+{
+    const size_t start = strlen(dst);
+    const size_t copy = (start + len < size) ? len : size - start - 1;
+    memcpy(dst + start, srcStr, copy);
+    dst[start + copy] = '\0';
+}
+
+static void nCrashAppendUInt(char *const dst, const size_t size,
+ const uint64_t value)
+{
+    char str[20];
+    nCrashAppend(dst, size, str, nCrashFormatUInt(str, value));
+}
+
+/* Gets the ID of the invoking thread. */
+static uint32_t nCrashThreadID(void)
+{
+#ifdef NCRASH_THREADS
+    return (uint32_t) syscall(SYS_gettid);
+#else
+    return (uint32_t) getpid();
+#endif
+}
+
+/* Reads the name of thread tid. */
+static void nCrashThreadName(const uint32_t tid, char *const name)
+{
+    memset(name, 0, sizeof(((nCrashStack_t *) NULL)->name));
+#ifdef NCRASH_THREADS
+    char pathStr[64] = "/proc/self/task/";
+    nCrashAppendUInt(pathStr, sizeof(pathStr), tid);
+    nCrashAppend(pathStr, sizeof(pathStr), "/comm", 5);
+    const int fd = open(pathStr, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    const ssize_t len = read(fd, name, sizeof(((nCrashStack_t *) NULL)->name));
+    close(fd);
+    for (ssize_t i = 0; i < len; i++)
+    {
+        if (name[i] == '\n') name[i] = '\0';
+    }
+#else
+    (void) tid;
+#endif
+}
+
+/* Captures the registers and stack of the invoking thread from context. */
+static void nCrashCapture(nCrashThread_t *const thread,
+ const void *const context)
+{
+    thread->stack.tid = nCrashThreadID();
+    nCrashThreadName(thread->stack.tid, thread->stack.name);
+    thread->registerCount = nCrashRegisters(context, thread->registers);
+    thread->stack.levels = context ? (uint32_t) nErrorStackWalkContext(context,
+     NULL, thread->addrs, NCRASH_STACK_MAX) : (uint32_t) nErrorStackWalk(NULL,
+     NULL, NULL, thread->addrs, NCRASH_STACK_MAX);
+    __atomic_store_n(&thread->ready, 1, __ATOMIC_RELEASE);
+}
+
+/* Writes len bytes at data to fd, retrying partial writes. */
+static int nCrashWriteAll(const int fd, const void *const data, size_t len)
+{
+    const uint8_t *ptr = data;
+    while (len)
+    {
+        const ssize_t written = write(fd, ptr, len);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        ptr += written;
+        len -= (size_t) written;
+    }
+    return 0;
+}
+
+static int nCrashSection(const int fd, const uint32_t kind,
+ const uint32_t len)
+{
+    const nCrashSection_t section = {.kind = kind, .len = len};
+    return nCrashWriteAll(fd, &section, sizeof(section));
+}
+
+/* Writes the registers and stack sections of a captured thread. */
+static void nCrashWriteThread(const int fd, const nCrashThread_t *const thread)
+{
+    if (thread->registerCount)
+    {
+        const nCrashRegisters_t header = {
+            .tid = thread->stack.tid,
+            .count = thread->registerCount
+        };
+        const uint32_t len = thread->registerCount * sizeof(uint64_t);
+        if (nCrashSection(fd, NCRASH_SECTION_REGISTERS, sizeof(header) + len) ||
+         nCrashWriteAll(fd, &header, sizeof(header)) ||
+         nCrashWriteAll(fd, thread->registers, len)) return;
+    }
+
+    uint64_t addrs[NCRASH_STACK_MAX];
+    for (uint32_t i = 0; i < thread->stack.levels; i++)
+    {
+        addrs[i] = (uint64_t) (uintptr_t) thread->addrs[i];
+    }
+    const uint32_t len = thread->stack.levels * sizeof(uint64_t);
+    if (nCrashSection(fd, NCRASH_SECTION_STACK, sizeof(nCrashStack_t) + len) ||
+     nCrashWriteAll(fd, &thread->stack, sizeof(nCrashStack_t))) return;
+    nCrashWriteAll(fd, addrs, len);
+}
+
+/* Reads /proc/self/maps into crashMaps, returning its length. */
+static size_t nCrashReadMaps(void)
+{
+    if (!crashMaps) return 0;
+    const int fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    size_t len = 0;
+    while (len < NCRASH_MAPS_SIZE)
+    {
+        const ssize_t got = read(fd, crashMaps + len, NCRASH_MAPS_SIZE - len);
+        if (got < 0)
+        {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (!got) break;
+        len += (size_t) got;
+    }
+    close(fd);
+    return len;
+}
+
+/* Parses a hexadecimal number at *str, advancing it. */
+static uint64_t nCrashParseHex(const char **str, const char *const end)
+{
+    uint64_t value = 0;
+    for (; *str < end; (*str)++)
+    {
+        const char c = **str;
+        if ((c >= '0') && (c <= '9')) value = (value << 4) | (uint64_t) (c - '0');
+        else if ((c >= 'a') && (c <= 'f')) value = (value << 4) |
+         (uint64_t) (c - 'a' + 10);
+        else break;
+    }
+    return value;
+}
+
+/* Finds the end of the readable mapping containing addr, or 0 if there is
+ * none. */
+static uint64_t nCrashMappingEnd(const size_t mapsLen, const uint64_t addr)
+{
+    const char *line = crashMaps;
+    const char *const end = crashMaps + mapsLen;
+    while (line < end)
+    {
+        const char *ptr = line;
+        const uint64_t start = nCrashParseHex(&ptr, end);
+        uint64_t stop = 0;
+        if ((ptr < end) && (*ptr == '-'))
+        {
+            ptr++;
+            stop = nCrashParseHex(&ptr, end);
+        }
+        if ((addr >= start) && (addr < stop) && (ptr + 1 < end) &&
+         (ptr[1] == 'r')) return stop;
+
+        while ((line < end) && (*line != '\n')) line++;
+        line++;
+    }
+    return 0;
+}
+
+/* Writes the memory around the stack pointer of the crashed thread, clamped
+ * to the stack's mapping. */
+static void nCrashWriteStackMemory(const int fd, const size_t mapsLen)
+{
+    uint64_t sp = 0;
+#if ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__x86_64__)
+    if (crashSelf.registerCount) sp = crashSelf.registers[7];
+#elif ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__aarch64__)
+    if (crashSelf.registerCount) sp = crashSelf.registers[31];
+#endif
+    if (!sp || !mapsLen) return;
+
+    const uint64_t stop = nCrashMappingEnd(mapsLen, sp);
+    if (!stop) return;
+    const nCrashMemory_t header = {
+        .addr = sp,
+        .len = ((stop - sp) < NCRASH_STACK_BYTES) ? stop - sp :
+         NCRASH_STACK_BYTES
+    };
+    if (nCrashSection(fd, NCRASH_SECTION_MEMORY, (uint32_t) (sizeof(header) +
+     header.len)) || nCrashWriteAll(fd, &header, sizeof(header))) return;
+    nCrashWriteAll(fd, (const void *) (uintptr_t) sp, (size_t) header.len);
+}
+
+#ifdef NCRASH_THREADS
+/* Captures the stack of a thread signaled by nCrashSignalThreads(), then holds
+ * the thread until the dump is written. */
+static void nCrashThreadHandler(int sig, siginfo_t *info, void *context)
+{
+    (void) sig;
+    (void) info;
+    const int savedErrno = errno;
+    if (__atomic_load_n(&crashHolding, __ATOMIC_ACQUIRE))
+    {
+        const uint32_t index = __atomic_fetch_add(&crashThreadCount, 1,
+         __ATOMIC_ACQ_REL);
+        if (index < NCRASH_THREADS_MAX)
+        {
+            nCrashCapture(&crashThreads[index], context);
+        }
+        const struct timespec wait = {0, NTIME_NS_IN_MS};
+        while (__atomic_load_n(&crashHolding, __ATOMIC_ACQUIRE))
+        {
+            nanosleep(&wait, NULL);
+        }
+    }
+    errno = savedErrno;
+}
+
+/* Signals each other thread of the process to capture its stack, returning
+ * the number signaled. */
+static uint32_t nCrashSignalThreads(const uint32_t selfTid)
+{
+    const int fd = open("/proc/self/task", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    const pid_t pid = getpid();
+    uint32_t count = 0;
+    char buffer[1024] __attribute__((aligned(8)));
+    for (;;)
+    {
+        const long len = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (len <= 0) break;
+        for (long pos = 0; pos < len;)
+        {
+            const nCrashDirent_t *const entry = (const nCrashDirent_t *)
+             (buffer + pos);
+            pos += entry->reclen;
+            uint32_t tid = 0;
+            for (const char *c = entry->name; (*c >= '0') && (*c <= '9'); c++)
+            {
+                tid = (tid * 10) + (uint32_t) (*c - '0');
+            }
+            if (!tid || (tid == selfTid) || (count >= NCRASH_THREADS_MAX))
+            {
+                continue;
+            }
+            if (!syscall(SYS_tgkill, pid, tid, NCRASH_THREAD_SIGNAL)) count++;
+        }
+    }
+    close(fd);
+    return count;
+}
+#endif
+#endif
+
+int nCrashDumpInit(const char *const dirStr)
+{
+    if (dirStr)
+    {
+        const size_t len = strlen(dirStr);
+#define einfoStr "dirStr argument was too long in nCrashDumpInit()."
+        if (nErrorAssert(
+         len + 64 < NCRASH_PATH_MAX,
+         NERROR_OVERFLOW,
+         einfoStr,
+         NCONST_STR_LEN(einfoStr)
+        )) return NERROR_OVERFLOW;
+#undef einfoStr
+        memcpy(crashDir, dirStr, len + 1);
+    }
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+    /* Touch the buffers now so that writing a dump does not fault pages in. */
+    if (!crashMaps)
+    {
+        crashMaps = nAlloc(NCRASH_MAPS_SIZE);
+        memset(crashMaps, 0, NCRASH_MAPS_SIZE);
+    }
+#  ifdef NCRASH_THREADS
+    if (!crashThreads)
+    {
+        crashThreads = nAlloc(NCRASH_THREADS_MAX * sizeof(nCrashThread_t));
+        memset(crashThreads, 0, NCRASH_THREADS_MAX * sizeof(nCrashThread_t));
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = nCrashThreadHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+    sigemptyset(&sa.sa_mask);
+#    define einfoStr "sigaction() failed in nCrashDumpInit()."
+    if (nErrorAssert(
+     !sigaction(NCRASH_THREAD_SIGNAL, &sa, NULL),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_INTERNAL_FAILURE;
+#    undef einfoStr
+#  endif
+#endif
+    return NSUCCESS;
+}
+
+/* Gets an ID of the invoking thread to tell the writer of the dump apart. */
+static uintptr_t nCrashWriterID(void)
+{
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    return (uintptr_t) GetCurrentThreadId();
+#elif defined(NCRASH_THREADS)
+    return (uintptr_t) nCrashThreadID();
+#else
+    return (uintptr_t) pthread_self();
+#endif
+}
+
+/* Claims the dump for the invoking thread, returning nonzero if it should
+ * write it. A thread that crashes while another is writing the dump waits
+ * until it is written, so that it does not end the process with the dump cut
+ * short; the writer itself, crashing again, does not wait on itself. */
+static int nCrashClaim(void)
+{
+    int expected = 0;
+    if (__atomic_compare_exchange_n(&crashWriting, &expected,
+     NCRASH_STATE_WRITING, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&crashWriter, nCrashWriterID(), __ATOMIC_RELEASE);
+        return 1;
+    }
+
+    const uintptr_t self = nCrashWriterID();
+    while ((__atomic_load_n(&crashWriting, __ATOMIC_ACQUIRE) ==
+     NCRASH_STATE_WRITING) &&
+     (__atomic_load_n(&crashWriter, __ATOMIC_ACQUIRE) != self))
+    {
+#if NIMBLE_OS == NIMBLE_WINDOWS
+        Sleep(1);
+#else
+        const struct timespec wait = {0, NTIME_NS_IN_MS};
+        nanosleep(&wait, NULL);
+#endif
+    }
+    return 0;
+}
+
+/* Marks the dump as finished, releasing the threads waiting on it. */
+static void nCrashRelease(void)
+{
+    __atomic_store_n(&crashWriting, NCRASH_STATE_WRITTEN, __ATOMIC_RELEASE);
+}
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+int nCrashDumpWrite(const int signum, const void *const info,
+ const void *const context)
+{
+    (void) signum;
+    (void) context;
+    if (!nCrashClaim()) return NERROR_WARN;
+
+    snprintf(crashPath, NCRASH_PATH_MAX, "%s\\crash-%llu-%lu.dmp", crashDir,
+     (unsigned long long) time(NULL), (unsigned long) GetCurrentProcessId());
+    HANDLE file = CreateFileA(crashPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+     FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        crashPath[0] = '\0';
+        nCrashRelease();
+        return NERROR_INTERNAL_FAILURE;
+    }
+
+    MINIDUMP_EXCEPTION_INFORMATION exception = {
+        .ThreadId = GetCurrentThreadId(),
+        .ExceptionPointers = (EXCEPTION_POINTERS *) info,
+        .ClientPointers = FALSE
+    };
+    const BOOL written = MiniDumpWriteDump(GetCurrentProcess(),
+     GetCurrentProcessId(), file, MiniDumpWithThreadInfo |
+     MiniDumpWithIndirectlyReferencedMemory | MiniDumpScanMemory,
+     info ? &exception : NULL, NULL, NULL);
+    CloseHandle(file);
+    nCrashRelease();
+    return written ? NSUCCESS : NERROR_INTERNAL_FAILURE;
+}
+#else
+int nCrashDumpWrite(const int signum, const void *const info,
+ const void *const context)
+{
+    if (!nCrashClaim()) return NERROR_WARN;
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    const pid_t pid = getpid();
+    crashPath[0] = '\0';
+    nCrashAppend(crashPath, NCRASH_PATH_MAX, crashDir, strlen(crashDir));
+    nCrashAppend(crashPath, NCRASH_PATH_MAX, "/crash-", 7);
+    nCrashAppendUInt(crashPath, NCRASH_PATH_MAX, (uint64_t) now.tv_sec);
+    nCrashAppend(crashPath, NCRASH_PATH_MAX, "-", 1);
+    nCrashAppendUInt(crashPath, NCRASH_PATH_MAX, (uint64_t) pid);
+    nCrashAppend(crashPath, NCRASH_PATH_MAX, ".ncd", 4);
+
+    const int fd = open(crashPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+     0600);
+    if (fd < 0)
+    {
+        crashPath[0] = '\0';
+        nCrashRelease();
+        return NERROR_INTERNAL_FAILURE;
+    }
+
+    /* The crashed thread comes first, as it matters most. */
+    nCrashCapture(&crashSelf, context);
+    const nCrashDumpHeader_t header = {
+        .magic = NCRASH_DUMP_MAGIC,
+        .version = NCRASH_DUMP_VERSION,
+        .order = NCRASH_DUMP_ORDER
+    };
+    const siginfo_t *const sigInfo = info;
+    const nCrashInfo_t crashInfo = {
+        .time = ((uint64_t) now.tv_sec * NTIME_NS_IN_SEC) +
+         (uint64_t) now.tv_nsec,
+        .addr = sigInfo ? (uint64_t) (uintptr_t) sigInfo->si_addr : 0,
+        .signal = signum,
+        .code = sigInfo ? sigInfo->si_code : 0,
+        .pid = (uint32_t) pid,
+        .tid = crashSelf.stack.tid,
+        .arch = crashSelf.registerCount ? nCrashArch() : NCRASH_ARCH_UNKNOWN,
+        .reserved = 0
+    };
+    nCrashWriteAll(fd, &header, sizeof(header));
+    nCrashSection(fd, NCRASH_SECTION_INFO, sizeof(crashInfo));
+    nCrashWriteAll(fd, &crashInfo, sizeof(crashInfo));
+    nCrashWriteThread(fd, &crashSelf);
+
+#ifdef NCRASH_THREADS
+    /* Hold the other threads while the dump is written, so that they do not
+     * change the log rings or crash as well. */
+    uint32_t signaled = 0;
+    if (crashThreads)
+    {
+        __atomic_store_n(&crashHolding, 1, __ATOMIC_RELEASE);
+        signaled = nCrashSignalThreads(crashSelf.stack.tid);
+        const struct timespec wait = {0, NTIME_NS_IN_MS};
+        for (uint32_t ms = 0; ms < NCRASH_THREAD_WAIT; ms++)
+        {
+            uint32_t ready = 0;
+            for (uint32_t i = 0; i < signaled; i++)
+            {
+                ready += __atomic_load_n(&crashThreads[i].ready,
+                 __ATOMIC_ACQUIRE);
+            }
+            if (ready >= signaled) break;
+            nanosleep(&wait, NULL);
+        }
+        for (uint32_t i = 0; i < signaled; i++)
+        {
+            if (__atomic_load_n(&crashThreads[i].ready, __ATOMIC_ACQUIRE))
+            {
+                nCrashWriteThread(fd, &crashThreads[i]);
+            }
+        }
+    }
+#endif
+
+    const size_t mapsLen = nCrashReadMaps();
+    nCrashWriteStackMemory(fd, mapsLen);
+    if (mapsLen && !nCrashSection(fd, NCRASH_SECTION_MAPS, (uint32_t) mapsLen))
+    {
+        nCrashWriteAll(fd, crashMaps, mapsLen);
+    }
+
+    /* The length of the log is patched in once it is written. */
+    const off_t logStart = lseek(fd, 0, SEEK_CUR);
+    if ((logStart >= 0) && !nCrashSection(fd, NCRASH_SECTION_LOG, 0))
+    {
+        nLogCrashWrite(fd);
+        const off_t logEnd = lseek(fd, 0, SEEK_CUR);
+        if ((logEnd > logStart) && (lseek(fd, logStart, SEEK_SET) == logStart))
+        {
+            nCrashSection(fd, NCRASH_SECTION_LOG, (uint32_t) (logEnd - logStart -
+             (off_t) sizeof(nCrashSection_t)));
+            lseek(fd, logEnd, SEEK_SET);
+        }
+    }
+    close(fd);
+
+#ifdef NCRASH_THREADS
+    __atomic_store_n(&crashHolding, 0, __ATOMIC_RELEASE);
+#endif
+    nCrashRelease();
+    return NSUCCESS;
+}
+#endif
+
+const char *nCrashDumpPath(void)
+{
+    return crashPath;
+}
+
+// CrashDump.c
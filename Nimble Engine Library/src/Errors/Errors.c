@@ -8,6 +8,9 @@
  *
  */
 
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE /**< Needed for the registers of ucontext_t and pthread_getattr_np(). */
+#endif
 #include "../../include/Nimble/Errors/Errors.h"
 
 /**
@@ -53,16 +56,24 @@
 #include <windows.h>
 #else
 #include <execinfo.h>
+#include <pthread.h>
+#include <ucontext.h>
 #include <unistd.h>
+#  if NIMBLE_OS == NIMBLE_BSD
+#include <pthread_np.h>
+#  endif
 #endif
 
 #include "../../../include/Nimble/Errors/Crash.h"
+#include "../../include/Nimble/Errors/Symbols.h"
+#include "../../include/Nimble/Output/Logging.h"
 #include "../../../include/Nimble/Output/Files.h"
 #include "../../../include/Nimble/System/Memory.h"
 #include "../../../include/Nimble/System/Time.h"
 #include "../../../include/Nimble/System/Threads.h"
 
 static __thread _Bool stacktraceAttempted = 0;
+static __thread const void *errorStackTop = NULL;
 nMutex_t nStacktraceMutex = NULL;
 
 /**
@@ -85,11 +96,197 @@ void (*volatile errorCallback)(const nErrorInfo_t errorInfo) = &nErrorHandlerDef
 
 static void nErrorHandlerDefault(const nErrorInfo_t errorInfo)
 {
-    /** @todo Make default callback. */
+    /* Leave formatting and writing to the logging thread, so the invoking
+     * thread is not stalled by console or disk I/O. */
+    if (nLogRunning())
+    {
+        nLog(NLOG_ERROR, "%s: %s === %s === %s\n%s", errorInfo.errorStr,
+         errorInfo.descStr, errorInfo.sysDescStr, errorInfo.infoStr,
+         errorInfo.stackStr);
+        return;
+    }
     printf("%s: %s === %s === %s\n%s", errorInfo.errorStr, errorInfo.descStr, errorInfo.sysDescStr,
      errorInfo.infoStr, errorInfo.stackStr);
 }
 
+#if NERRORS_DEDUP_WINDOW
+/**
+ * @brief An error recently sent to the error callback.
+ */
+typedef struct nErrorRecent {
+    uint64_t hash; /* Hash of the error, info pointer and caller. 0 if unused. */
+    uint64_t reportTime; /* When the error was last reported, in nanoseconds. */
+    uint64_t repeats; /* The times the error was suppressed since reportTime. */
+    int error; /* The error value thrown. */
+    size_t infoLen; /* The length of infoStr. */
+    char infoStr[NERRORS_DEDUP_INFO_MAX + 1]; /* The info, truncated. */
+} nErrorRecent_t;
+
+static nErrorRecent_t errorsRecent[NERRORS_DEDUP_SIZE];
+static volatile int errorsRecentLock = 0;
+
+/* A spinlock is used rather than a #nMutex_t, as the mutex functions throw
+ * errors themselves. The lock is never held while calling out. */
+NIMBLE_INLINE
+void nErrorRecentLock(void)
+{
+    while (__atomic_exchange_n(&errorsRecentLock, 1, __ATOMIC_ACQUIRE))
+    {
+        while (__atomic_load_n(&errorsRecentLock, __ATOMIC_RELAXED));
+    }
+}
+
+NIMBLE_INLINE
+void nErrorRecentUnlock(void)
+{
+    __atomic_store_n(&errorsRecentLock, 0, __ATOMIC_RELEASE);
+}
+
+NIMBLE_INLINE
+uint64_t nErrorRecentMix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+NIMBLE_INLINE
+uint64_t nErrorRecentNow(void)
+{
+    const nTime_t now = nTime();
+    return ((uint64_t) now.secs * NTIME_NS_IN_SEC) + now.nanos;
+}
+
+/**
+ * @brief Sends the summary of a suppressed error to the error callback.
+ * @param[in] recent A copy of the suppressed error.
+ * @param[in] now The current time, in nanoseconds.
+ */
+static void nErrorRecentReport(const nErrorRecent_t *const recent,
+ const uint64_t now)
+{
+    nErrorInfo_t errorInfo = {0};
+    errorInfo.error = recent->error;
+    errorInfo.time = nTime();
+    errorInfo.errorStr = nErrorStr(recent->error);
+    errorInfo.errorLen = nErrorStrLen(recent->error);
+    errorInfo.descStr = nErrorDesc(recent->error);
+    errorInfo.descLen = nErrorDescLen(recent->error);
+
+#define noSysDescStr "No system error description."
+    errorInfo.sysDescStr = nStringDuplicate(noSysDescStr,
+     NCONST_STR_LEN(noSysDescStr));
+    errorInfo.sysDescLen = NCONST_STR_LEN(noSysDescStr);
+#undef noSysDescStr
+
+#define repeatsStr " [Suppressed %" PRIu64 " times in %" PRIu64 " ms.]"
+    const size_t len = recent->infoLen + NCONST_STR_LEN(repeatsStr) + 40;
+    errorInfo.infoStr = nAlloc(len);
+    errorInfo.infoLen = snprintf(errorInfo.infoStr, len, "%s" repeatsStr,
+     recent->infoStr, recent->repeats,
+     (now - recent->reportTime) / NTIME_NS_IN_MS);
+#undef repeatsStr
+
+#define noStackStr "No stacktrace."
+    errorInfo.stackStr = nStringDuplicate(noStackStr,
+     NCONST_STR_LEN(noStackStr));
+    errorInfo.stackLen = NCONST_STR_LEN(noStackStr);
+#undef noStackStr
+
+    errorCallback(errorInfo);
+    nErrorInfoFree(&errorInfo);
+}
+
+/**
+ * @brief Checks if an error was reported within #NERRORS_DEDUP_WINDOW.
+ *
+ * @param[in] error The error thrown.
+ * @param[in] info The info of the error.
+ * @param[in] infoLen The length of @p info.
+ * @param[in] stack The return addresses of the caller of nErrorThrow().
+ * @param[in] levels The number of addresses in @p stack.
+ * @param[out] repeats The times the error was suppressed before this, if it is
+ * to be reported.
+ * @param[out] evicted The error this one replaced, whose repeats are nonzero if
+ * it must be reported with nErrorRecentReport().
+ * @return Nonzero is returned if the error should be suppressed.
+ */
+static int nErrorRecentCheck(const int error, const char *const info,
+ const size_t infoLen, void *const *const stack, const int levels,
+ uint64_t *const repeats, nErrorRecent_t *const evicted)
+{
+    uint64_t hash = nErrorRecentMix(((uint64_t) error << 32) ^
+     (uintptr_t) info);
+    for (int i = 0; i < levels; i++)
+    {
+        hash = nErrorRecentMix(hash ^ (uintptr_t) stack[i]);
+    }
+    if (!hash) hash = 1;
+
+    const uint64_t now = nErrorRecentNow();
+    const uint64_t window = (uint64_t) NERRORS_DEDUP_WINDOW * NTIME_NS_IN_MS;
+    nErrorRecent_t *recent = &errorsRecent[hash & (NERRORS_DEDUP_SIZE - 1)];
+    int suppress = 0;
+    *repeats = 0;
+    evicted->repeats = 0;
+
+    nErrorRecentLock();
+    if (recent->hash == hash)
+    {
+        if (now - recent->reportTime < window)
+        {
+            recent->repeats++;
+            suppress = 1;
+        }
+        else
+        {
+            *repeats = recent->repeats;
+            recent->repeats = 0;
+            recent->reportTime = now;
+        }
+    }
+    else
+    {
+        if (recent->repeats) *evicted = *recent;
+        recent->hash = hash;
+        recent->reportTime = now;
+        recent->repeats = 0;
+        recent->error = error;
+        recent->infoLen = (infoLen > NERRORS_DEDUP_INFO_MAX) ?
+         NERRORS_DEDUP_INFO_MAX : infoLen;
+        if (info) memcpy(recent->infoStr, info, recent->infoLen);
+        recent->infoStr[recent->infoLen] = '\0';
+    }
+    nErrorRecentUnlock();
+    return suppress;
+}
+#endif
+
+void nErrorFlushRepeats(void)
+{
+#if NERRORS_DEDUP_WINDOW
+    for (int i = 0; i < NERRORS_DEDUP_SIZE; i++)
+    {
+        nErrorRecent_t recent;
+        recent.repeats = 0;
+
+        nErrorRecentLock();
+        if (errorsRecent[i].repeats)
+        {
+            recent = errorsRecent[i];
+            errorsRecent[i].repeats = 0;
+            errorsRecent[i].reportTime = nErrorRecentNow();
+        }
+        nErrorRecentUnlock();
+
+        if (recent.repeats) nErrorRecentReport(&recent, nErrorRecentNow());
+    }
+#endif
+}
+
 int nErrorThrow(const int error, const char *const info, size_t infoLen, const int setError)
 {
 #ifndef NIMBLE_NO_ARG_CHECK
@@ -103,7 +300,12 @@ int nErrorThrow(const int error, const char *const info, size_t infoLen, const i
 #  undef einfoStr
 #endif
 
-    const nTime_t errorTime = nTime();
+    if (info && (infoLen <= 0))
+    {
+        infoLen = strlen(info);
+    }
+
+    /* Read the system error before anything below can change it. */
     char *sysDescStr = NULL;
     size_t sysDescLen = 0;
     int err = error;
@@ -114,7 +316,34 @@ int nErrorThrow(const int error, const char *const info, size_t infoLen, const i
             err = error;
         }
     }
-    
+
+#if NERRORS_DEDUP_WINDOW
+    /* Identify the error by where it was thrown from, skipping this function.
+     * This is far cheaper than a full stack trace. Repeats are only counted,
+     * skipping the stack trace, allocations and callback. */
+    void *stack[NERRORS_DEDUP_FRAMES + 1];
+#  if NIMBLE_OS == NIMBLE_WINDOWS
+    const int levels = CaptureStackBackTrace(1, NERRORS_DEDUP_FRAMES, stack,
+     NULL);
+#  else
+    const int levels = backtrace(stack, NERRORS_DEDUP_FRAMES + 1) - 1;
+#  endif
+    uint64_t repeats;
+    nErrorRecent_t evicted;
+    if (nErrorRecentCheck(err, info, infoLen,
+#  if NIMBLE_OS == NIMBLE_WINDOWS
+     stack,
+#  else
+     stack + 1,
+#  endif
+     levels, &repeats, &evicted))
+    {
+        if (sysDescStr) nFree((void **) &sysDescStr);
+        return err;
+    }
+#endif
+
+    const nTime_t errorTime = nTime();
     nErrorInfo_t errorInfo;
 #if NIMBLE_OS == NIMBLE_WINDOWS
     CONTEXT context = {0};
@@ -123,10 +352,32 @@ int nErrorThrow(const int error, const char *const info, size_t infoLen, const i
 #else
     nErrorInfoSet(&errorInfo, err, errorTime, info, infoLen, sysDescStr, sysDescLen);
 #endif
+    nFree((void **) &sysDescStr);
+
+#if NERRORS_DEDUP_WINDOW
+    if (repeats)
+    {
+        /* Note how many times the error was suppressed since its last report. */
+#  define repeatsStr " [Suppressed %" PRIu64 " times since last reported.]"
+        const size_t len = errorInfo.infoLen + NCONST_STR_LEN(repeatsStr) + 20;
+        char *infoStr = nAlloc(len);
+        errorInfo.infoLen = snprintf(infoStr, len, "%s" repeatsStr,
+         errorInfo.infoStr, repeats);
+#  undef repeatsStr
+        nFree((void **) &errorInfo.infoStr);
+        errorInfo.infoStr = infoStr;
+    }
+#endif
     
     /* Call the user-defined error callback function. */
     errorCallback(errorInfo);
     nErrorInfoFree(&errorInfo);
+
+#if NERRORS_DEDUP_WINDOW
+    /* The error this one replaced is reported after it, so that reporting it
+     * cannot change the system error read for this one. */
+    if (evicted.repeats) nErrorRecentReport(&evicted, nErrorRecentNow());
+#endif
     return err;
 }
 
@@ -259,7 +510,7 @@ void nErrorInfoSet(nErrorInfo_t *restrict errorInfo, const int error,
     else
     {
 #define noSysDescStr "No system error description."
-        errorInfo->infoStr = nStringDuplicate(noSysDescStr,
+        errorInfo->sysDescStr = nStringDuplicate(noSysDescStr,
          NCONST_STR_LEN(noSysDescStr));
         errorInfo->sysDescLen = NCONST_STR_LEN(noSysDescStr);
 #undef noSysDescStr
@@ -321,6 +572,141 @@ void nErrorSetCallback(void (*const callback) (const nErrorInfo_t errorInfo))
     }
 }
 
+/**
+ * @brief The start of a stack frame built with frame pointers.
+ */
+typedef struct nErrorFrame {
+    const struct nErrorFrame *next; /* The frame of the caller. */
+    void *ip; /* The return address into the caller. */
+} nErrorFrame_t;
+
+/* The alignment of a frame pointer. The 64-bit ABIs keep frames 16-byte
+ * aligned. */
+#if UINTPTR_MAX > 0xffffffff
+#  define NERRORS_FRAME_ALIGN 16
+#else
+#  define NERRORS_FRAME_ALIGN sizeof(void *)
+#endif
+
+void nErrorStackRegister(void)
+{
+    const void *top = NULL;
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    top = ((const NT_TIB *) NtCurrentTeb())->StackBase;
+#elif NIMBLE_OS == NIMBLE_MACOS
+    top = pthread_get_stackaddr_np(pthread_self());
+#else
+    pthread_attr_t attr;
+#  if NIMBLE_OS == NIMBLE_BSD
+    pthread_attr_init(&attr);
+    if (!pthread_attr_get_np(pthread_self(), &attr))
+#  else
+    if (!pthread_getattr_np(pthread_self(), &attr))
+#  endif
+    {
+        void *addr;
+        size_t size;
+        if (!pthread_attr_getstack(&attr, &addr, &size))
+        {
+            top = (const char *) addr + size;
+        }
+        pthread_attr_destroy(&attr);
+    }
+#endif
+    errorStackTop = top;
+}
+
+const void *nErrorStackTop(void)
+{
+    return errorStackTop;
+}
+
+int nErrorStackWalk(const void *framePtr, const void *const stackPtr,
+ const void *stackTop, void **const stack, const int maxLevels)
+{
+    const nErrorFrame_t *frame = framePtr ? framePtr :
+     __builtin_frame_address(0);
+    if ((uintptr_t) frame < (uintptr_t) stackPtr) return 0;
+
+    /* A frame pointer from elsewhere may be anything, so it is only followed
+     * within a known stack. The caller's own frames may be on a signal stack
+     * instead, which the thread's stack top does not bound. */
+    if (!stackTop) stackTop = errorStackTop;
+    if (framePtr && !stackTop) return 0;
+    uintptr_t top = stackTop ? (uintptr_t) stackTop : UINTPTR_MAX;
+    if (!framePtr && ((uintptr_t) frame >= top)) top = UINTPTR_MAX;
+
+    int levels = 0;
+    while (frame && (levels < maxLevels))
+    {
+        if ((uintptr_t) frame & (NERRORS_FRAME_ALIGN - 1)) break;
+        if (((uintptr_t) frame > top) ||
+         (top - (uintptr_t) frame < sizeof(nErrorFrame_t))) break;
+        if (!frame->ip) break;
+        stack[levels++] = frame->ip;
+
+        const nErrorFrame_t *next = frame->next;
+        if ((next <= frame) ||
+         ((uintptr_t) next - (uintptr_t) frame > NERRORS_FRAME_MAX)) break;
+        frame = next;
+    }
+    return levels;
+}
+
+int nErrorStackWalkContext(const void *const context,
+ const void *const stackTop, void **const stack, const int maxLevels)
+{
+    const void *pc = NULL, *fp = NULL, *sp = NULL;
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    const CONTEXT *const c = context;
+#  if defined(_M_X64) || defined(__x86_64__)
+    pc = (const void *) c->Rip;
+    fp = (const void *) c->Rbp;
+    sp = (const void *) c->Rsp;
+#  elif defined(_M_ARM64) || defined(__aarch64__)
+    pc = (const void *) c->Pc;
+    fp = (const void *) c->Fp;
+    sp = (const void *) c->Sp;
+#  else
+    (void) c;
+#  endif
+#else
+    const ucontext_t *const uc = context;
+#  if ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__x86_64__)
+    pc = (const void *) uc->uc_mcontext.gregs[REG_RIP];
+    fp = (const void *) uc->uc_mcontext.gregs[REG_RBP];
+    sp = (const void *) uc->uc_mcontext.gregs[REG_RSP];
+#  elif ((NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)) &&\
+ defined(__aarch64__)
+    pc = (const void *) uc->uc_mcontext.pc;
+    fp = (const void *) uc->uc_mcontext.regs[29];
+    sp = (const void *) uc->uc_mcontext.sp;
+#  elif (NIMBLE_OS == NIMBLE_MACOS) && defined(__x86_64__)
+    pc = (const void *) uc->uc_mcontext->__ss.__rip;
+    fp = (const void *) uc->uc_mcontext->__ss.__rbp;
+    sp = (const void *) uc->uc_mcontext->__ss.__rsp;
+#  elif (NIMBLE_OS == NIMBLE_MACOS) && defined(__aarch64__)
+    pc = (const void *) uc->uc_mcontext->__ss.__pc;
+    fp = (const void *) uc->uc_mcontext->__ss.__fp;
+    sp = (const void *) uc->uc_mcontext->__ss.__sp;
+#  elif (NIMBLE_OS == NIMBLE_BSD) && defined(__x86_64__)
+    pc = (const void *) uc->uc_mcontext.mc_rip;
+    fp = (const void *) uc->uc_mcontext.mc_rbp;
+    sp = (const void *) uc->uc_mcontext.mc_rsp;
+#  else
+    (void) uc;
+#  endif
+#endif
+
+    /* Without the interrupted registers, the walk starts here and includes
+     * the signal frame. */
+    if (!pc) return nErrorStackWalk(NULL, NULL, stackTop, stack, maxLevels);
+    if (maxLevels < 1) return 0;
+    stack[0] = (void *) pc;
+    return 1 + nErrorStackWalk(fp, sp, stackTop, stack + 1, maxLevels - 1);
+}
+
 #if 0
 struct frameInfo {
     char *func;  /* Function name */
@@ -525,14 +911,12 @@ char *nErrorStacktrace(size_t *restrict stackLen, int *restrict stackLevels)
         /** @todo addr2line frame.AddrPC.Offset */
     }
 #else
-    void **stack = nAlloc(sizeof(void **) * maxLevels);
-    int levels = backtrace(stack, maxLevels);
-    char **symbolStrs = backtrace_symbols(stack, levels);
-
-    for (int i = 0; i < levels; i++)
-    {
-        /** @todo addr2line stack[i] */
-    }
+    /* Take an extra level for this function, which is skipped. */
+    void **stack = nAlloc(sizeof(void *) * (maxLevels + 1));
+    int levels = backtrace(stack, maxLevels + 1) - 1;
+    if (levels > 0) stackStr = nErrorStackString(stack + 1, levels, &len);
+    else levels = 0;
+    nFree((void **) &stack);
 #endif
 
 #if 0
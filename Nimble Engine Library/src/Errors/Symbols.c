@@ -0,0 +1,1117 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Symbols.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE /**< Needed for dl_iterate_phdr() and dladdr(). */
+#endif
+#include "../../include/Nimble/Errors/Symbols.h"
+
+/**
+ * @file Symbols.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines stack symbolization functions.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__ELF__)
+#  define NSYMBOLS_ELF /**< Symbolize with the in-process ELF/DWARF reader. */
+#include <elf.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <link.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif NIMBLE_OS != NIMBLE_WINDOWS
+#include <dlfcn.h>
+#endif
+
+#include "../../include/Nimble/Output/Files.h"
+#include "../../include/Nimble/System/Memory.h"
+
+/**
+ * @brief Set while the invoking thread is symbolizing, so that an error thrown
+ * while loading symbols cannot deadlock on the module being loaded.
+ */
+static __thread _Bool symbolizing = 0;
+
+/**
+ * @brief The cache of resolved addresses, indexed by a hash of the address.
+ * Entries are immutable once published, so they can be read without locking.
+ */
+static nErrorSymbol_t *volatile symbolCache[NERRORS_SYMBOL_CACHE_SIZE] = {0};
+
+NIMBLE_INLINE
+size_t nSymbolCacheIndex(const void *const addr)
+{
+    return (size_t) ((((uintptr_t) addr) * 0x9E3779B97F4A7C15ULL) >> 32) &
+     (NERRORS_SYMBOL_CACHE_SIZE - 1);
+}
+
+#ifdef NSYMBOLS_ELF
+#  define NSYMBOLS_STATE_UNLOADED 0
+#  define NSYMBOLS_STATE_LOADING  1
+#  define NSYMBOLS_STATE_LOADED   2
+
+#  define NSYMBOLS_DEBUG_DIR "/usr/lib/debug"
+
+/* DWARF constants used by the line program. */
+#  define DW_LNS_copy               0x01
+#  define DW_LNS_advance_pc         0x02
+#  define DW_LNS_advance_line       0x03
+#  define DW_LNS_set_file           0x04
+#  define DW_LNS_const_add_pc       0x08
+#  define DW_LNS_fixed_advance_pc   0x09
+#  define DW_LNE_end_sequence       0x01
+#  define DW_LNE_set_address        0x02
+#  define DW_LNE_define_file        0x03
+#  define DW_LNCT_path              0x01
+#  define DW_LNCT_directory_index   0x02
+#  define DW_FORM_block             0x09
+#  define DW_FORM_data1             0x0b
+#  define DW_FORM_data2             0x05
+#  define DW_FORM_data4             0x06
+#  define DW_FORM_data8             0x07
+#  define DW_FORM_data16            0x1e
+#  define DW_FORM_line_strp         0x1f
+#  define DW_FORM_string            0x08
+#  define DW_FORM_strp              0x0e
+#  define DW_FORM_udata             0x0f
+
+typedef struct nSymbolFunc {
+    uintptr_t addr; /* Start address relative to the load bias. */
+    size_t size; /* Size of the function, or 0 if unknown. */
+    const char *nameStr; /* Name in the mapped string table. */
+} nSymbolFunc_t;
+
+typedef struct nSymbolLine {
+    uintptr_t addr; /* Address relative to the load bias. */
+    uint32_t file; /* Index into the module's file table. */
+    uint32_t line; /* Line number, or 0 for the end of a sequence. */
+} nSymbolLine_t;
+
+typedef struct nSymbolFile {
+    const char *dirStr; /* Directory, or NULL. */
+    const char *nameStr; /* File name. */
+} nSymbolFile_t;
+
+typedef struct nSymbolModule {
+    uintptr_t bias; /* Load bias (difference from the file's addresses). */
+    uintptr_t start; /* Lowest mapped address. */
+    uintptr_t end; /* Highest mapped address. */
+    char *pathStr; /* Path to the object file. */
+    volatile int state; /* NSYMBOLS_STATE_* */
+
+    nSymbolFunc_t *funcs;
+    size_t funcCount;
+    nSymbolLine_t *lines;
+    size_t lineCount;
+    nSymbolFile_t *files;
+    size_t fileCount;
+} nSymbolModule_t;
+
+typedef struct nElfSection {
+    const uint8_t *data;
+    size_t size;
+} nElfSection_t;
+
+typedef struct nElfSections {
+    nElfSection_t symtab, strtab, dynsym, dynstr;
+    nElfSection_t line, lineStr, str;
+    nElfSection_t buildId, debugLink;
+} nElfSections_t;
+
+typedef struct nDwarfReader {
+    const uint8_t *ptr;
+    const uint8_t *end;
+    _Bool error;
+} nDwarfReader_t;
+
+static nSymbolModule_t symbolModules[NERRORS_SYMBOL_MODULES_MAX];
+static volatile int symbolModuleCount = 0;
+static volatile int symbolScanning = 0;
+
+
+/* Maps the whole file at pathStr read-only. Raw system calls are used rather
+ * than nFileOpen(), which would report failures through the error callback. */
+static const uint8_t *nSymbolMapFile(const char *const pathStr, size_t *len)
+{
+    int fd = open(pathStr, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        nErrorClear();
+        return NULL;
+    }
+
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (!fstat(fd, &st) && (st.st_size > (off_t) sizeof(Elf64_Ehdr)))
+    {
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        nErrorClear();
+        return NULL;
+    }
+
+    *len = st.st_size;
+    return map;
+}
+
+static int nSymbolElfSections(const uint8_t *const map, const size_t len,
+ nElfSections_t *const sections)
+{
+    memset(sections, 0, sizeof(nElfSections_t));
+
+    const Elf64_Ehdr *ehdr = (const Elf64_Ehdr *) map;
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) ||
+     (ehdr->e_ident[EI_CLASS] != ELFCLASS64) ||
+     (ehdr->e_shentsize != sizeof(Elf64_Shdr)) ||
+     (ehdr->e_shoff >= len) ||
+     ((len - ehdr->e_shoff) / sizeof(Elf64_Shdr) < ehdr->e_shnum) ||
+     (ehdr->e_shstrndx >= ehdr->e_shnum))
+    {
+        return -1;
+    }
+
+    const Elf64_Shdr *shdrs = (const Elf64_Shdr *) (map + ehdr->e_shoff);
+    const Elf64_Shdr *shstr = &shdrs[ehdr->e_shstrndx];
+    if ((shstr->sh_offset >= len) || (shstr->sh_size > len - shstr->sh_offset))
+    {
+        return -1;
+    }
+    const char *namesStr = (const char *) map + shstr->sh_offset;
+
+    for (int i = 0; i < ehdr->e_shnum; i++)
+    {
+        const Elf64_Shdr *shdr = &shdrs[i];
+        if ((shdr->sh_type == SHT_NOBITS) || (shdr->sh_name >= shstr->sh_size) ||
+         (shdr->sh_offset >= len) || (shdr->sh_size > len - shdr->sh_offset) ||
+         (shdr->sh_flags & SHF_COMPRESSED))
+        {
+            continue;
+        }
+
+        const char *nameStr = namesStr + shdr->sh_name;
+        const nElfSection_t section = {map + shdr->sh_offset, shdr->sh_size};
+        if ((shdr->sh_type == SHT_SYMTAB) || (shdr->sh_type == SHT_DYNSYM))
+        {
+            /* The linked section of a symbol table is its string table. */
+            if (shdr->sh_link >= ehdr->e_shnum) continue;
+            const Elf64_Shdr *link = &shdrs[shdr->sh_link];
+            if ((link->sh_offset >= len) || (link->sh_size > len - link->sh_offset))
+            {
+                continue;
+            }
+            const nElfSection_t linked = {map + link->sh_offset, link->sh_size};
+            if (shdr->sh_type == SHT_SYMTAB)
+            {
+                sections->symtab = section;
+                sections->strtab = linked;
+            }
+            else
+            {
+                sections->dynsym = section;
+                sections->dynstr = linked;
+            }
+        }
+        else if (!strcmp(nameStr, ".debug_line")) sections->line = section;
+        else if (!strcmp(nameStr, ".debug_line_str")) sections->lineStr = section;
+        else if (!strcmp(nameStr, ".debug_str")) sections->str = section;
+        else if (!strcmp(nameStr, ".note.gnu.build-id")) sections->buildId = section;
+        else if (!strcmp(nameStr, ".gnu_debuglink")) sections->debugLink = section;
+    }
+
+    return NSUCCESS;
+}
+
+/* Finds the separate debug file of a stripped object, first by build ID, then
+ * by debug link. */
+static const uint8_t *nSymbolMapDebugFile(const nSymbolModule_t *const module,
+ const nElfSections_t *const sections, size_t *len)
+{
+    char pathStr[PATH_MAX + 1];
+    const uint8_t *map = NULL;
+
+    if (sections->buildId.size > sizeof(Elf64_Nhdr))
+    {
+        const Elf64_Nhdr *note = (const Elf64_Nhdr *) sections->buildId.data;
+        const size_t nameSize = (note->n_namesz + 3) & ~3;
+        if ((note->n_type == NT_GNU_BUILD_ID) && (note->n_descsz > 1) &&
+         (note->n_descsz <= 64) && (sizeof(Elf64_Nhdr) + nameSize +
+         note->n_descsz <= sections->buildId.size))
+        {
+            const uint8_t *id = sections->buildId.data + sizeof(Elf64_Nhdr) +
+             nameSize;
+            int l = snprintf(pathStr, sizeof(pathStr),
+             NSYMBOLS_DEBUG_DIR "/.build-id/%02x/", id[0]);
+            for (uint32_t i = 1; i < note->n_descsz; i++)
+            {
+                l += snprintf(pathStr + l, sizeof(pathStr) - l, "%02x", id[i]);
+            }
+            snprintf(pathStr + l, sizeof(pathStr) - l, ".debug");
+            if ((map = nSymbolMapFile(pathStr, len))) return map;
+        }
+    }
+
+    if (sections->debugLink.size && memchr(sections->debugLink.data, '\0',
+     sections->debugLink.size))
+    {
+        const char *linkStr = (const char *) sections->debugLink.data;
+        const char *sepStr = strrchr(module->pathStr, '/');
+        const int dirLen = sepStr ? (int) (sepStr - module->pathStr) : 0;
+        const char *const formats[] = {
+            "%.*s/%s",
+            "%.*s/.debug/%s",
+            NSYMBOLS_DEBUG_DIR "%.*s/%s"
+        };
+        for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+        {
+            snprintf(pathStr, sizeof(pathStr), formats[i], dirLen,
+             module->pathStr, linkStr);
+            if (strcmp(pathStr, module->pathStr) &&
+             (map = nSymbolMapFile(pathStr, len)))
+            {
+                return map;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static int nSymbolFuncCompare(const void *a, const void *b)
+{
+    const nSymbolFunc_t *fa = a, *fb = b;
+    if (fa->addr != fb->addr) return (fa->addr < fb->addr) ? -1 : 1;
+    /* Prefer sized symbols over aliases without a size. */
+    return (fa->size < fb->size) - (fa->size > fb->size);
+}
+
+static int nSymbolLineCompare(const void *a, const void *b)
+{
+    const nSymbolLine_t *la = a, *lb = b;
+    if (la->addr != lb->addr) return (la->addr < lb->addr) ? -1 : 1;
+    /* Sort the end of a sequence before a sequence starting at the same
+     * address, so the lookup finds the start. */
+    return (la->line != 0) - (lb->line != 0);
+}
+
+static void nSymbolLoadFuncs(nSymbolModule_t *const module,
+ const nElfSection_t *const symtab, const nElfSection_t *const strtab)
+{
+    const Elf64_Sym *syms = (const Elf64_Sym *) symtab->data;
+    const size_t count = symtab->size / sizeof(Elf64_Sym);
+    if (!count || !strtab->size) return;
+
+    nSymbolFunc_t *funcs = nAlloc(sizeof(nSymbolFunc_t) * count);
+    size_t funcCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const int type = ELF64_ST_TYPE(syms[i].st_info);
+        if (((type != STT_FUNC) && (type != STT_GNU_IFUNC)) ||
+         (syms[i].st_shndx == SHN_UNDEF) || !syms[i].st_value ||
+         (syms[i].st_name >= strtab->size))
+        {
+            continue;
+        }
+        funcs[funcCount].addr = syms[i].st_value;
+        funcs[funcCount].size = syms[i].st_size;
+        funcs[funcCount].nameStr = (const char *) strtab->data + syms[i].st_name;
+        funcCount++;
+    }
+
+    if (!funcCount)
+    {
+        nFree((void **) &funcs);
+        return;
+    }
+    qsort(funcs, funcCount, sizeof(nSymbolFunc_t), nSymbolFuncCompare);
+    module->funcs = funcs;
+    module->funcCount = funcCount;
+}
+
+NIMBLE_INLINE
+uint64_t nDwarfRead(nDwarfReader_t *const reader, const size_t size)
+{
+    if ((size_t) (reader->end - reader->ptr) < size)
+    {
+        reader->error = 1;
+        reader->ptr = reader->end;
+        return 0;
+    }
+    uint64_t val = 0;
+    switch (size)
+    {
+        case 1: val = *reader->ptr; break;
+        case 2: { uint16_t v; memcpy(&v, reader->ptr, 2); val = v; } break;
+        case 4: { uint32_t v; memcpy(&v, reader->ptr, 4); val = v; } break;
+        case 8: memcpy(&val, reader->ptr, 8); break;
+        default: break; /* Skipped. */
+    }
+    reader->ptr += size;
+    return val;
+}
+
+NIMBLE_INLINE
+uint64_t nDwarfUleb(nDwarfReader_t *const reader)
+{
+    uint64_t val = 0;
+    int shift = 0;
+    while (reader->ptr < reader->end)
+    {
+        const uint8_t byte = *reader->ptr++;
+        if (shift < 64) val |= ((uint64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+        if (!(byte & 0x80)) return val;
+    }
+    reader->error = 1;
+    return val;
+}
+
+NIMBLE_INLINE
+int64_t nDwarfSleb(nDwarfReader_t *const reader)
+{
+    int64_t val = 0;
+    int shift = 0;
+    uint8_t byte = 0;
+    while (reader->ptr < reader->end)
+    {
+        byte = *reader->ptr++;
+        if (shift < 64) val |= ((int64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+        if (!(byte & 0x80))
+        {
+            if ((shift < 64) && (byte & 0x40)) val |= -(((int64_t) 1) << shift);
+            return val;
+        }
+    }
+    reader->error = 1;
+    return val;
+}
+
+NIMBLE_INLINE
+const char *nDwarfString(nDwarfReader_t *const reader)
+{
+    const char *str = (const char *) reader->ptr;
+    const uint8_t *nul = memchr(reader->ptr, '\0', reader->end - reader->ptr);
+    if (!nul)
+    {
+        reader->error = 1;
+        reader->ptr = reader->end;
+        return NULL;
+    }
+    reader->ptr = nul + 1;
+    return str;
+}
+
+NIMBLE_INLINE
+const char *nDwarfStringAt(const nElfSection_t *const section,
+ const uint64_t offset)
+{
+    if ((offset >= section->size) ||
+     !memchr(section->data + offset, '\0', section->size - offset))
+    {
+        return NULL;
+    }
+    return (const char *) section->data + offset;
+}
+
+/* Reads an attribute of a DWARF 5 directory or file entry. Strings are set in
+ * str and constants in num. Returns -1 for forms that cannot be read without
+ * the rest of the debug info. */
+static int nDwarfForm(nDwarfReader_t *const reader, const uint64_t form,
+ const int offsetSize, const nElfSections_t *const sections, const char **str,
+ uint64_t *num)
+{
+    *str = NULL;
+    *num = 0;
+    switch (form)
+    {
+        case DW_FORM_string:
+            *str = nDwarfString(reader);
+            return NSUCCESS;
+        case DW_FORM_line_strp:
+            *str = nDwarfStringAt(&sections->lineStr,
+             nDwarfRead(reader, offsetSize));
+            return NSUCCESS;
+        case DW_FORM_strp:
+            *str = nDwarfStringAt(&sections->str, nDwarfRead(reader, offsetSize));
+            return NSUCCESS;
+        case DW_FORM_udata:
+            *num = nDwarfUleb(reader);
+            return NSUCCESS;
+        case DW_FORM_data1:
+            *num = nDwarfRead(reader, 1);
+            return NSUCCESS;
+        case DW_FORM_data2:
+            *num = nDwarfRead(reader, 2);
+            return NSUCCESS;
+        case DW_FORM_data4:
+            *num = nDwarfRead(reader, 4);
+            return NSUCCESS;
+        case DW_FORM_data8:
+            *num = nDwarfRead(reader, 8);
+            return NSUCCESS;
+        case DW_FORM_data16:
+            nDwarfRead(reader, 16);
+            return NSUCCESS;
+        case DW_FORM_block:
+            nDwarfRead(reader, nDwarfUleb(reader));
+            return NSUCCESS;
+        default:
+            return -1;
+    }
+}
+
+static void nSymbolAddFile(nSymbolModule_t *const module, size_t *const fileCap,
+ const char *dirStr, const char *const nameStr)
+{
+    if (module->fileCount == *fileCap)
+    {
+        *fileCap = *fileCap ? *fileCap * 2 : 64;
+        module->files = nRealloc(module->files, sizeof(nSymbolFile_t) * *fileCap);
+    }
+    if (nameStr && (nameStr[0] == '/')) dirStr = NULL;
+    module->files[module->fileCount].dirStr = dirStr;
+    module->files[module->fileCount].nameStr = nameStr ? nameStr : "??";
+    module->fileCount++;
+}
+
+NIMBLE_INLINE
+void nSymbolAddLine(nSymbolModule_t *const module, size_t *const lineCap,
+ const uintptr_t addr, const uint32_t file, const uint32_t line)
+{
+    if (module->lineCount == *lineCap)
+    {
+        *lineCap = *lineCap ? *lineCap * 2 : 1024;
+        module->lines = nRealloc(module->lines, sizeof(nSymbolLine_t) * *lineCap);
+    }
+    module->lines[module->lineCount].addr = addr;
+    module->lines[module->lineCount].file = file;
+    module->lines[module->lineCount].line = line;
+    module->lineCount++;
+}
+
+/* Reads the directory and file tables of a DWARF 5 line program header. */
+static int nDwarfEntries(nDwarfReader_t *const reader, const int offsetSize,
+ const nElfSections_t *const sections, nSymbolModule_t *const module,
+ size_t *const fileCap, const char ***dirs, size_t *const dirCount)
+{
+    for (int table = 0; table < 2; table++)
+    {
+        uint64_t formats[16][2];
+        const int formatCount = nDwarfRead(reader, 1);
+        if (formatCount > 16) return -1;
+        for (int i = 0; i < formatCount; i++)
+        {
+            formats[i][0] = nDwarfUleb(reader);
+            formats[i][1] = nDwarfUleb(reader);
+        }
+
+        const uint64_t count = nDwarfUleb(reader);
+        if (reader->error || (count > (uint64_t) (reader->end - reader->ptr)))
+        {
+            return -1;
+        }
+        if (!table)
+        {
+            *dirs = nAlloc(sizeof(const char *) * (count + 1));
+            *dirCount = count;
+        }
+
+        for (uint64_t e = 0; e < count; e++)
+        {
+            const char *pathStr = NULL;
+            uint64_t dirIndex = 0;
+            for (int i = 0; i < formatCount; i++)
+            {
+                const char *str;
+                uint64_t num;
+                if (nDwarfForm(reader, formats[i][1], offsetSize, sections, &str,
+                 &num))
+                {
+                    return -1;
+                }
+                if (formats[i][0] == DW_LNCT_path) pathStr = str;
+                else if (formats[i][0] == DW_LNCT_directory_index) dirIndex = num;
+            }
+            if (reader->error) return -1;
+
+            if (!table)
+            {
+                (*dirs)[e] = pathStr;
+            }
+            else
+            {
+                nSymbolAddFile(module, fileCap,
+                 (dirIndex < *dirCount) ? (*dirs)[dirIndex] : NULL, pathStr);
+            }
+        }
+    }
+    return NSUCCESS;
+}
+
+static void nSymbolLoadLines(nSymbolModule_t *const module,
+ const nElfSections_t *const sections)
+{
+    nDwarfReader_t unit = {sections->line.data,
+     sections->line.data + sections->line.size, 0};
+    size_t fileCap = 0, lineCap = 0;
+
+    while (!unit.error && (unit.ptr < unit.end))
+    {
+        /* Unit header. */
+        int offsetSize = 4;
+        uint64_t unitLen = nDwarfRead(&unit, 4);
+        if (unitLen == 0xffffffff)
+        {
+            offsetSize = 8;
+            unitLen = nDwarfRead(&unit, 8);
+        }
+        if (unit.error || (unitLen > (uint64_t) (unit.end - unit.ptr))) break;
+        nDwarfReader_t reader = {unit.ptr, unit.ptr + unitLen, 0};
+        unit.ptr += unitLen;
+
+        const int version = nDwarfRead(&reader, 2);
+        if ((version < 2) || (version > 5)) continue;
+        if (version >= 5)
+        {
+            if (nDwarfRead(&reader, 1) != sizeof(uintptr_t)) continue;
+            nDwarfRead(&reader, 1); /* Segment selector size. */
+        }
+        const uint64_t headerLen = nDwarfRead(&reader, offsetSize);
+        if (headerLen > (uint64_t) (reader.end - reader.ptr)) continue;
+        const uint8_t *program = reader.ptr + headerLen;
+
+        const uint8_t minInst = nDwarfRead(&reader, 1);
+        if (version >= 4) nDwarfRead(&reader, 1); /* Max ops per instruction. */
+        nDwarfRead(&reader, 1); /* Default is_stmt. */
+        const int8_t lineBase = (int8_t) nDwarfRead(&reader, 1);
+        const uint8_t lineRange = nDwarfRead(&reader, 1);
+        const uint8_t opcodeBase = nDwarfRead(&reader, 1);
+        const uint8_t *opcodeLens = reader.ptr;
+        if (!lineRange || !opcodeBase) continue;
+        nDwarfRead(&reader, opcodeBase - 1);
+
+        /* Directory and file tables. Unit file indices are mapped to indices in
+         * the module's file table by adding fileBase. */
+        const size_t fileBase = module->fileCount;
+        const char **dirs = NULL;
+        size_t dirCount = 0;
+        int fileFirst = 0;
+        if (version >= 5)
+        {
+            if (nDwarfEntries(&reader, offsetSize, sections, module, &fileCap,
+             &dirs, &dirCount))
+            {
+                nFree((void **) &dirs);
+                module->fileCount = fileBase;
+                continue;
+            }
+        }
+        else
+        {
+            /* Directory 0 is the compilation directory, which is not in the
+             * line table. File indices start at 1. */
+            size_t dirCap = 16;
+            dirs = nAlloc(sizeof(const char *) * dirCap);
+            dirs[dirCount++] = NULL;
+            const char *str;
+            while ((str = nDwarfString(&reader)) && str[0])
+            {
+                if (dirCount == dirCap)
+                {
+                    dirCap *= 2;
+                    dirs = nRealloc(dirs, sizeof(const char *) * dirCap);
+                }
+                dirs[dirCount++] = str;
+            }
+            while ((str = nDwarfString(&reader)) && str[0])
+            {
+                const uint64_t dirIndex = nDwarfUleb(&reader);
+                nDwarfUleb(&reader); /* Modification time. */
+                nDwarfUleb(&reader); /* File size. */
+                nSymbolAddFile(module, &fileCap,
+                 (dirIndex < dirCount) ? dirs[dirIndex] : NULL, str);
+            }
+            fileFirst = 1;
+        }
+        nFree((void **) &dirs);
+        if (reader.error || (program > reader.end)) continue;
+        const size_t unitFiles = module->fileCount - fileBase;
+
+        /* Line number program. */
+        reader.ptr = program;
+        uintptr_t addr = 0;
+        uint64_t file = 1;
+        int64_t line = 1;
+        size_t sequenceStart = module->lineCount;
+        _Bool sequenceValid = 1;
+
+#  define nSymbolRow(endSequence) do {\
+            const uint64_t index = file - fileFirst;\
+            nSymbolAddLine(module, &lineCap, addr,\
+             (index < unitFiles) ? (uint32_t) (fileBase + index) : UINT32_MAX,\
+             (endSequence) ? 0 : (uint32_t) ((line > 0) ? line : 1));\
+        } while (0)
+
+        while (!reader.error && (reader.ptr < reader.end))
+        {
+            const uint8_t op = nDwarfRead(&reader, 1);
+            if (op >= opcodeBase)
+            {
+                const uint8_t adjusted = op - opcodeBase;
+                addr += (adjusted / lineRange) * minInst;
+                line += lineBase + (adjusted % lineRange);
+                nSymbolRow(0);
+                continue;
+            }
+
+            switch (op)
+            {
+                case 0:
+                {
+                    const uint64_t len = nDwarfUleb(&reader);
+                    if (!len || (len > (uint64_t) (reader.end - reader.ptr)))
+                    {
+                        reader.error = 1;
+                        break;
+                    }
+                    const uint8_t *next = reader.ptr + len;
+                    switch (nDwarfRead(&reader, 1))
+                    {
+                        case DW_LNE_end_sequence:
+                            nSymbolRow(1);
+                            /* Drop sequences of discarded code, which the
+                             * linker moves to address 0 or -1. */
+                            if (!sequenceValid) module->lineCount = sequenceStart;
+                            sequenceStart = module->lineCount;
+                            sequenceValid = 1;
+                            addr = 0;
+                            file = 1;
+                            line = 1;
+                            break;
+                        case DW_LNE_set_address:
+                            addr = nDwarfRead(&reader, len - 1);
+                            if (module->lineCount == sequenceStart)
+                            {
+                                sequenceValid = addr && (addr != UINTPTR_MAX);
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                    reader.ptr = next;
+                    break;
+                }
+                case DW_LNS_copy:
+                    nSymbolRow(0);
+                    break;
+                case DW_LNS_advance_pc:
+                    addr += nDwarfUleb(&reader) * minInst;
+                    break;
+                case DW_LNS_advance_line:
+                    line += nDwarfSleb(&reader);
+                    break;
+                case DW_LNS_set_file:
+                    file = nDwarfUleb(&reader);
+                    break;
+                case DW_LNS_const_add_pc:
+                    addr += ((255 - opcodeBase) / lineRange) * minInst;
+                    break;
+                case DW_LNS_fixed_advance_pc:
+                    addr += nDwarfRead(&reader, 2);
+                    break;
+                default:
+                    /* Skip the operands of other standard opcodes. */
+                    for (int i = 0; i < opcodeLens[op - 1]; i++)
+                    {
+                        nDwarfUleb(&reader);
+                    }
+                    break;
+            }
+        }
+#  undef nSymbolRow
+
+        /* Drop an unterminated sequence. */
+        module->lineCount = sequenceStart;
+    }
+
+    if (module->lineCount)
+    {
+        qsort(module->lines, module->lineCount, sizeof(nSymbolLine_t),
+         nSymbolLineCompare);
+    }
+    else
+    {
+        nFree((void **) &module->lines);
+    }
+}
+
+static void nSymbolModuleLoad(nSymbolModule_t *const module)
+{
+    int expected = NSYMBOLS_STATE_UNLOADED;
+    if (!__atomic_compare_exchange_n(&module->state, &expected,
+     NSYMBOLS_STATE_LOADING, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+    {
+        /* Another thread is loading the module. */
+        while (__atomic_load_n(&module->state, __ATOMIC_ACQUIRE) !=
+         NSYMBOLS_STATE_LOADED)
+        {
+            sched_yield();
+        }
+        return;
+    }
+
+    /* The mappings are kept for the life of the process, as the tables point
+     * into them. */
+    size_t len = 0, debugLen = 0;
+    const uint8_t *map = nSymbolMapFile(module->pathStr, &len);
+    nElfSections_t sections, debugSections;
+    if (map && !nSymbolElfSections(map, len, &sections))
+    {
+        if (!sections.symtab.size || !sections.line.size)
+        {
+            const uint8_t *debugMap = nSymbolMapDebugFile(module, &sections,
+             &debugLen);
+            if (debugMap && !nSymbolElfSections(debugMap, debugLen,
+             &debugSections))
+            {
+                if (!sections.symtab.size && debugSections.symtab.size)
+                {
+                    sections.symtab = debugSections.symtab;
+                    sections.strtab = debugSections.strtab;
+                }
+                if (!sections.line.size && debugSections.line.size)
+                {
+                    sections.line = debugSections.line;
+                    sections.lineStr = debugSections.lineStr;
+                    sections.str = debugSections.str;
+                }
+            }
+        }
+
+        if (sections.symtab.size)
+        {
+            nSymbolLoadFuncs(module, &sections.symtab, &sections.strtab);
+        }
+        else
+        {
+            nSymbolLoadFuncs(module, &sections.dynsym, &sections.dynstr);
+        }
+        if (sections.line.size)
+        {
+            nSymbolLoadLines(module, &sections);
+        }
+    }
+
+    __atomic_store_n(&module->state, NSYMBOLS_STATE_LOADED, __ATOMIC_RELEASE);
+}
+
+static int nSymbolScanCallback(struct dl_phdr_info *info, size_t size,
+ void *data)
+{
+    (void) size;
+    (void) data;
+
+    uintptr_t start = UINTPTR_MAX, end = 0;
+    for (int i = 0; i < info->dlpi_phnum; i++)
+    {
+        const ElfW(Phdr) *phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type != PT_LOAD) continue;
+        const uintptr_t segStart = info->dlpi_addr + phdr->p_vaddr;
+        if (segStart < start) start = segStart;
+        if (segStart + phdr->p_memsz > end) end = segStart + phdr->p_memsz;
+    }
+    if (start >= end) return 0;
+
+    const int count = __atomic_load_n(&symbolModuleCount, __ATOMIC_ACQUIRE);
+    for (int i = 0; i < count; i++)
+    {
+        if ((symbolModules[i].start == start) && (symbolModules[i].end == end))
+        {
+            return 0;
+        }
+    }
+    if (count >= NERRORS_SYMBOL_MODULES_MAX) return 1;
+
+    /* The main executable has no name. */
+    const char *pathStr = info->dlpi_name;
+    char exeStr[PATH_MAX + 1];
+    if (!pathStr || !pathStr[0])
+    {
+#  if (NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)
+        const ssize_t exeLen = readlink("/proc/self/exe", exeStr, PATH_MAX);
+        if (exeLen > 0)
+        {
+            exeStr[exeLen] = '\0';
+            pathStr = exeStr;
+        }
+        else
+        {
+            nErrorClear();
+            pathStr = "/proc/self/exe";
+        }
+#  else
+        pathStr = NEXEC[0] ? NEXEC : NULL;
+        (void) exeStr;
+#  endif
+    }
+    if (!pathStr) return 0;
+
+    nSymbolModule_t *module = &symbolModules[count];
+    memset(module, 0, sizeof(nSymbolModule_t));
+    module->bias = info->dlpi_addr;
+    module->start = start;
+    module->end = end;
+    module->pathStr = nStringDuplicate(pathStr, strlen(pathStr));
+    __atomic_store_n(&symbolModuleCount, count + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/* Finds the module containing addr, rescanning the loaded objects once if it
+ * is not yet known (such as after dlopen()). */
+static nSymbolModule_t *nSymbolModuleFind(const uintptr_t addr)
+{
+    for (int scan = 0; scan < 2; scan++)
+    {
+        const int count = __atomic_load_n(&symbolModuleCount, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < count; i++)
+        {
+            if ((addr >= symbolModules[i].start) && (addr < symbolModules[i].end))
+            {
+                return &symbolModules[i];
+            }
+        }
+        if (scan) break;
+
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&symbolScanning, &expected, 1, 0,
+         __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            dl_iterate_phdr(nSymbolScanCallback, NULL);
+            __atomic_store_n(&symbolScanning, 0, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            while (__atomic_load_n(&symbolScanning, __ATOMIC_ACQUIRE))
+            {
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+static void nSymbolModuleLookup(const nSymbolModule_t *const module,
+ const uintptr_t pc, nErrorSymbol_t *const symbol)
+{
+    /* Find the last function starting at or before pc. */
+    size_t lo = 0, hi = module->funcCount;
+    while (lo < hi)
+    {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (module->funcs[mid].addr <= pc) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo)
+    {
+        const nSymbolFunc_t *func = &module->funcs[lo - 1];
+        if (!func->size || (pc < func->addr + func->size))
+        {
+            symbol->funcStr = func->nameStr;
+            symbol->funcOffset = pc - func->addr;
+        }
+    }
+
+    /* Find the last line row at or before pc. */
+    lo = 0;
+    hi = module->lineCount;
+    while (lo < hi)
+    {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (module->lines[mid].addr <= pc) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo)
+    {
+        const nSymbolLine_t *row = &module->lines[lo - 1];
+        if (row->line && (row->file < module->fileCount))
+        {
+            symbol->fileStr = module->files[row->file].nameStr;
+            symbol->dirStr = module->files[row->file].dirStr;
+            symbol->line = row->line;
+        }
+    }
+}
+#endif
+
+/* Resolves addr without the cache. */
+static int nSymbolResolve(const void *const addr, nErrorSymbol_t *const symbol)
+{
+    memset(symbol, 0, sizeof(nErrorSymbol_t));
+    symbol->addr = addr;
+
+#ifdef NSYMBOLS_ELF
+    nSymbolModule_t *module = nSymbolModuleFind((uintptr_t) addr);
+    if (!module) return -1;
+    if (__atomic_load_n(&module->state, __ATOMIC_ACQUIRE) !=
+     NSYMBOLS_STATE_LOADED)
+    {
+        nSymbolModuleLoad(module);
+    }
+    symbol->moduleStr = module->pathStr;
+    nSymbolModuleLookup(module, (uintptr_t) addr - module->bias, symbol);
+    return NSUCCESS;
+#elif NIMBLE_OS != NIMBLE_WINDOWS
+    /* Without an ELF reader, dladdr() can still name exported functions. */
+    Dl_info info;
+    if (!dladdr(addr, &info)) return -1;
+    symbol->moduleStr = info.dli_fname;
+    if (info.dli_sname)
+    {
+        symbol->funcStr = info.dli_sname;
+        symbol->funcOffset = (uintptr_t) addr - (uintptr_t) info.dli_saddr;
+    }
+    return NSUCCESS;
+#else
+    return -1;
+#endif
+}
+
+int nErrorSymbolize(const void *const addr, nErrorSymbol_t *const symbol)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+    if (!symbol) return -1;
+#endif
+
+    const size_t index = nSymbolCacheIndex(addr);
+    const nErrorSymbol_t *cached = __atomic_load_n(&symbolCache[index],
+     __ATOMIC_ACQUIRE);
+    if (cached && (cached->addr == addr))
+    {
+        *symbol = *cached;
+        return NSUCCESS;
+    }
+
+    if (symbolizing)
+    {
+        memset(symbol, 0, sizeof(nErrorSymbol_t));
+        symbol->addr = addr;
+        return -1;
+    }
+    symbolizing = 1;
+    const int err = nSymbolResolve(addr, symbol);
+    if (!err && !cached)
+    {
+        /* Publish the result if the slot is free. Entries are never replaced,
+         * as other threads may be reading them. */
+        nErrorSymbol_t *entry = nAlloc(sizeof(nErrorSymbol_t));
+        *entry = *symbol;
+        nErrorSymbol_t *expected = NULL;
+        if (!__atomic_compare_exchange_n(&symbolCache[index], &expected, entry,
+         0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            nFree((void **) &entry);
+        }
+    }
+    symbolizing = 0;
+    return err;
+}
+
+char *nErrorStackString(void *const *const stack, const int levels,
+ size_t *stackLen)
+{
+    size_t cap = 128 * ((levels > 0) ? levels : 1);
+    size_t len = 0;
+    char *stackStr = nAlloc(cap);
+    stackStr[0] = '\0';
+
+    for (int i = 0; i < levels; i++)
+    {
+        /* Return addresses point after the call, so look up the call itself. */
+        nErrorSymbol_t symbol;
+        const int found = !nErrorSymbolize((const char *) stack[i] - 1, &symbol);
+
+        for (;;)
+        {
+            const size_t space = cap - len;
+            int l = snprintf(stackStr + len, space, "#%d 0x%0*" PRIxPTR, i,
+             (int) (sizeof(uintptr_t) * 2), (uintptr_t) stack[i]);
+            if (found && symbol.funcStr && ((size_t) l < space))
+            {
+                l += snprintf(stackStr + len + l, space - l, " in %s+0x%zx",
+                 symbol.funcStr, symbol.funcOffset + 1);
+            }
+            if (found && symbol.fileStr && ((size_t) l < space))
+            {
+                l += snprintf(stackStr + len + l, space - l, " at %s%s%s:%d",
+                 symbol.dirStr ? symbol.dirStr : "", symbol.dirStr ? "/" : "",
+                 symbol.fileStr, symbol.line);
+            }
+            if (found && symbol.moduleStr && ((size_t) l < space))
+            {
+                const char *nameStr = strrchr(symbol.moduleStr, NFILE_DIR_SEP);
+                l += snprintf(stackStr + len + l, space - l, " (%s)",
+                 nameStr ? nameStr + 1 : symbol.moduleStr);
+            }
+            if ((size_t) l + 1 < space)
+            {
+                stackStr[len + l] = '\n';
+                len += l + 1;
+                stackStr[len] = '\0';
+                break;
+            }
+
+            /* Grow and format this level again. */
+            stackStr[len] = '\0';
+            cap = (cap * 2) + l + 2;
+            stackStr = nRealloc(stackStr, cap);
+        }
+    }
+
+    if (stackLen) *stackLen = len;
+    return stackStr;
+}
+
+// Symbols.c
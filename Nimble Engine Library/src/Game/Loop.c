@@ -0,0 +1,213 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Loop.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Game/Loop.h"
+
+/**
+ * @file Loop.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the game loop.
+ */
+
+#include <string.h>
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/Profiler.h"
+#include "../../include/Nimble/System/Time.h"
+#include "../../include/Nimble/System/Watchdog.h"
+
+int nLoopInit(nLoop_t *const loop, const uint32_t tickRate,
+ const uint32_t frameRate, void (*const update)(const double dt, void *data),
+ void (*const render)(const double alpha, void *data), void *const data)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "Loop argument was NULL in nLoopInit()."
+    if (nErrorAssert(
+     loop != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#  define einfoStr "Update argument was NULL in nLoopInit()."
+    if (nErrorAssert(
+     update != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#  define einfoStr "TickRate argument was 0 in nLoopInit()."
+    if (nErrorAssert(
+     tickRate > 0,
+     NERROR_INV_ARG,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_INV_ARG;
+#  undef einfoStr
+#endif
+
+    memset(loop, 0, sizeof(nLoop_t));
+    loop->tickNanos = NTIME_NS_IN_SEC / tickRate;
+    loop->frameNanos = frameRate ? NTIME_NS_IN_SEC / frameRate : 0;
+    loop->maxTicks = NLOOP_MAX_TICKS;
+    loop->update = update;
+    loop->render = render;
+    loop->data = data;
+    return NSUCCESS;
+}
+
+uint32_t nLoopStep(nLoop_t *const loop)
+{
+    NPROFILE_FRAME();
+    nWatchdogHeartbeat();
+    const uint64_t now = nTimeMonotonic();
+    const uint64_t frame = loop->lastTime ? now - loop->lastTime : 0;
+    loop->lastTime = now;
+    loop->stats.lastFrameNanos = frame;
+    loop->accumulator += frame;
+
+    /* Drop the time that can not be caught up on, rather than running ever
+     * more updates each frame. */
+    const uint64_t maxTime = loop->tickNanos * loop->maxTicks;
+    if (loop->accumulator > maxTime)
+    {
+        loop->stats.missedTicks += (loop->accumulator - maxTime) /
+         loop->tickNanos;
+        loop->accumulator = maxTime;
+    }
+
+    const double dt = (double) loop->tickNanos / NTIME_NS_IN_SEC;
+    uint32_t ticks = 0;
+    while (loop->accumulator >= loop->tickNanos)
+    {
+        NPROFILE_ZONE("Update");
+        const uint64_t start = nTicks();
+        loop->update(dt, loop->data);
+        const uint64_t updateNanos = nTicksToNanos(nTicks() - start);
+        if (updateNanos > loop->stats.maxUpdateNanos)
+        {
+            loop->stats.maxUpdateNanos = updateNanos;
+        }
+        loop->accumulator -= loop->tickNanos;
+        ticks++;
+    }
+    loop->stats.ticks += ticks;
+
+    if (loop->render)
+    {
+        NPROFILE_ZONE("Render");
+        loop->render((double) loop->accumulator / (double) loop->tickNanos,
+         loop->data);
+    }
+    loop->stats.frames++;
+    return ticks;
+}
+
+/* Sleeps until the deadline of the next frame of loop. */
+static void nLoopPace(nLoop_t *const loop)
+{
+    NPROFILE_ZONE("Pace");
+    uint64_t deadline;
+    if (loop->frameNanos)
+    {
+        loop->nextFrame = loop->nextFrame ? loop->nextFrame + loop->frameNanos :
+         loop->lastTime + loop->frameNanos;
+        deadline = loop->nextFrame;
+    }
+    else if (!loop->render)
+    {
+        /* Wake when the next tick is due. */
+        deadline = loop->lastTime + (loop->tickNanos - loop->accumulator);
+    }
+    else
+    {
+        return;
+    }
+
+    const uint64_t now = nTimeMonotonic();
+    if (now > deadline)
+    {
+        loop->stats.lateFrames++;
+        /* Restart the pacing rather than running frames back to back. */
+        if (loop->frameNanos) loop->nextFrame = now;
+        return;
+    }
+    const uint64_t late = nTimeSleepUntil(deadline);
+    loop->stats.totalWakeNanos += late;
+    if (late > loop->stats.maxWakeNanos) loop->stats.maxWakeNanos = late;
+}
+
+int nLoopRun(nLoop_t *const loop)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "Loop argument was NULL in nLoopRun()."
+    if (nErrorAssert(
+     loop != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    __atomic_store_n(&loop->running, 1, __ATOMIC_RELEASE);
+    loop->lastTime = 0;
+    loop->nextFrame = 0;
+    loop->accumulator = 0;
+
+    /* Report the loop if a frame hangs, unless the thread was already
+     * registered by the application. */
+    const int registered = !nWatchdogRegister("Loop", 0);
+    while (__atomic_load_n(&loop->running, __ATOMIC_ACQUIRE))
+    {
+        nLoopStep(loop);
+        nLoopPace(loop);
+    }
+    if (registered) nWatchdogUnregister();
+    return NSUCCESS;
+}
+
+void nLoopStop(nLoop_t *const loop)
+{
+    __atomic_store_n(&loop->running, 0, __ATOMIC_RELEASE);
+}
+
+void nLoopResetStats(nLoop_t *const loop)
+{
+    memset(&loop->stats, 0, sizeof(nLoopStats_t));
+}
+
+// Loop.c
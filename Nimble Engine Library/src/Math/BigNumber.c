@@ -0,0 +1,1054 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * BigNumber.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/BigNumber.h"
+
+/**
+ * @file BigNumber.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines arbitrary precision integer math.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/CPUInfo.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Simd.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#endif
+
+#if defined(__SIZEOF_INT128__)
+typedef unsigned __int128 nBigWide_t;
+#  define NBIG_WIDE /**< Double limb products and quotients use 128-bit integers. */
+#endif
+
+#define NBIG_DEC_CHUNK 10000000000000000000ULL /**< The largest power of ten in a limb. */
+#define NBIG_DEC_CHUNK_DIGITS 19 /**< The number of digits in #NBIG_DEC_CHUNK. */
+#define NBIG_POW_WINDOW 4 /**< The number of exponent bits nBigModPow() handles at once. */
+
+/**
+ * @brief Adds a limb array times a limb to another, returning the carry limb.
+ */
+typedef nLimb_t (*nBigAddMul1_t)(nLimb_t *r, const nLimb_t *a,
+ const size_t n, const nLimb_t b);
+
+
+/* Limb primitives
+ * These work on magnitudes as little endian limb arrays, which the functions
+ * on nBig_t size and allocate. */
+
+/* Computes a * b, returning the low limb and setting hi to the high limb. */
+static inline nLimb_t nBigMulWide(const nLimb_t a, const nLimb_t b,
+ nLimb_t *const hi)
+{
+#ifdef NBIG_WIDE
+    const nBigWide_t p = (nBigWide_t) a * b;
+    *hi = (nLimb_t) (p >> NBIG_LIMB_BITS);
+    return (nLimb_t) p;
+#else
+    const uint64_t aLo = (uint32_t) a, aHi = a >> 32;
+    const uint64_t bLo = (uint32_t) b, bHi = b >> 32;
+    const uint64_t ll = aLo * bLo, lh = aLo * bHi;
+    const uint64_t hl = aHi * bLo, hh = aHi * bHi;
+    const uint64_t mid = (ll >> 32) + (uint32_t) lh + (uint32_t) hl;
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t) ll;
+#endif
+}
+
+/* Divides hi:lo by d, which must be greater than hi, returning the quotient
+ * and setting rem to the remainder. */
+static inline nLimb_t nBigDivWide(const nLimb_t hi, const nLimb_t lo,
+ const nLimb_t d, nLimb_t *const rem)
+{
+#ifdef NBIG_WIDE
+    const nBigWide_t n = ((nBigWide_t) hi << NBIG_LIMB_BITS) | lo;
+    *rem = (nLimb_t) (n % d);
+    return (nLimb_t) (n / d);
+#else
+    nLimb_t r = hi, q = 0;
+    for (int i = NBIG_LIMB_BITS - 1; i >= 0; i--)
+    {
+        const nLimb_t top = r >> (NBIG_LIMB_BITS - 1);
+        r = (r << 1) | ((lo >> i) & 1);
+        q <<= 1;
+        if (top || (r >= d))
+        {
+            r -= d;
+            q |= 1;
+        }
+    }
+    *rem = r;
+    return q;
+#endif
+}
+
+/* Strips the leading zero limbs of n limbs. */
+static inline size_t nBigTrim(const nLimb_t *const a, size_t n)
+{
+    while (n && !a[n - 1]) n--;
+    return n;
+}
+
+static int nBigCompareLimbs(const nLimb_t *const a, const nLimb_t *const b,
+ size_t n)
+{
+    while (n--)
+    {
+        if (a[n] != b[n]) return (a[n] > b[n]) ? 1 : -1;
+    }
+    return 0;
+}
+
+/* Computes r = a + b, where an >= bn, returning the carry. r may be a or b. */
+static nLimb_t nBigAddLimbs(nLimb_t *r, const nLimb_t *a, const size_t an,
+ const nLimb_t *b, const size_t bn)
+{
+    nLimb_t carry = 0;
+    size_t i = 0;
+    for (; i < bn; i++)
+    {
+        nLimb_t s;
+        const nLimb_t c1 = __builtin_add_overflow(a[i], b[i], &s);
+        const nLimb_t c2 = __builtin_add_overflow(s, carry, &r[i]);
+        carry = c1 | c2;
+    }
+    for (; i < an; i++)
+    {
+        carry = __builtin_add_overflow(a[i], carry, &r[i]);
+    }
+    return carry;
+}
+
+/* Computes r = a - b, where an >= bn, returning the borrow. r may be a or
+ * b. */
+static nLimb_t nBigSubLimbs(nLimb_t *r, const nLimb_t *a, const size_t an,
+ const nLimb_t *b, const size_t bn)
+{
+    nLimb_t borrow = 0;
+    size_t i = 0;
+    for (; i < bn; i++)
+    {
+        nLimb_t d;
+        const nLimb_t b1 = __builtin_sub_overflow(a[i], b[i], &d);
+        const nLimb_t b2 = __builtin_sub_overflow(d, borrow, &r[i]);
+        borrow = b1 | b2;
+    }
+    for (; i < an; i++)
+    {
+        borrow = __builtin_sub_overflow(a[i], borrow, &r[i]);
+    }
+    return borrow;
+}
+
+static nLimb_t nBigAddMul1Scalar(nLimb_t *r, const nLimb_t *a, const size_t n,
+ const nLimb_t b)
+{
+    nLimb_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+#ifdef NBIG_WIDE
+        const nBigWide_t t = ((nBigWide_t) a[i] * b) + r[i] + carry;
+        r[i] = (nLimb_t) t;
+        carry = (nLimb_t) (t >> NBIG_LIMB_BITS);
+#else
+        nLimb_t hi;
+        nLimb_t lo = nBigMulWide(a[i], b, &hi);
+        hi += __builtin_add_overflow(lo, carry, &lo);
+        hi += __builtin_add_overflow(lo, r[i], &r[i]);
+        carry = hi;
+#endif
+    }
+    return carry;
+}
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+/* MULX leaves the flags alone, so ADCX and ADOX can add the low halves of the
+ * products and the limbs of r in two independent carry chains. The high limb
+ * of the result cannot overflow, so the chains are summed at the end. */
+NSIMD_TARGET("bmi2,adx")
+static nLimb_t nBigAddMul1ADX(nLimb_t *r, const nLimb_t *a, const size_t n,
+ const nLimb_t b)
+{
+    unsigned char c1 = 0, c2 = 0;
+    unsigned long long hiPrev = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned long long hi, sum, out;
+        const unsigned long long lo = _mulx_u64(a[i], b, &hi);
+        c1 = _addcarryx_u64(c1, lo, hiPrev, &sum);
+        c2 = _addcarryx_u64(c2, r[i], sum, &out);
+        r[i] = out;
+        hiPrev = hi;
+    }
+    return hiPrev + c1 + c2;
+}
+#endif
+
+/* Gets the multiply-add kernel. MULX and ADX are used with the AVX2 level, as
+ * every CPU with AVX2 has BMI2, and nSimdBind() can then force them off. */
+static nBigAddMul1_t nBigAddMul1Kernel(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    if ((NSIMD.level >= NSIMD_LEVEL_AVX2) &&
+     nCPUHasFeatures(NCPU_FEATURE_BMI2 | NCPU_FEATURE_ADX))
+    {
+        return nBigAddMul1ADX;
+    }
+#endif
+    return nBigAddMul1Scalar;
+}
+
+/* Computes r -= a * b, returning the borrow limb. */
+static nLimb_t nBigSubMul1(nLimb_t *r, const nLimb_t *a, const size_t n,
+ const nLimb_t b)
+{
+    nLimb_t borrow = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        nLimb_t hi;
+        nLimb_t lo = nBigMulWide(a[i], b, &hi);
+        hi += __builtin_add_overflow(lo, borrow, &lo);
+        hi += __builtin_sub_overflow(r[i], lo, &r[i]);
+        borrow = hi;
+    }
+    return borrow;
+}
+
+/* Divides n limbs by one limb, returning the remainder. q may be a. */
+static nLimb_t nBigDivLimb(nLimb_t *q, const nLimb_t *a, size_t n,
+ const nLimb_t d)
+{
+    nLimb_t rem = 0;
+    while (n--) q[n] = nBigDivWide(rem, a[n], d, &rem);
+    return rem;
+}
+
+/* Computes r = a * b by schoolbook multiplication, where r has an + bn limbs
+ * and is neither a nor b. */
+static void nBigMulBasecase(nLimb_t *r, const nLimb_t *a, const size_t an,
+ const nLimb_t *b, const size_t bn, const nBigAddMul1_t addMul1)
+{
+    memset(r, 0, an * sizeof(nLimb_t));
+    for (size_t j = 0; j < bn; j++)
+    {
+        r[an + j] = addMul1(r + j, a, an, b[j]);
+    }
+}
+
+/* Gets the number of scratch limbs nBigKaratsuba() needs for n limbs. */
+static size_t nBigKaratsubaScratch(size_t n)
+{
+    size_t scratch = 0;
+    while (n >= NBIG_KARATSUBA_THRESHOLD)
+    {
+        const size_t high = n - (n / 2);
+        scratch += 4 * (high + 1);
+        n = high + 1;
+    }
+    return scratch;
+}
+
+/* Computes r = a * b, where a and b have n limbs and r has 2n limbs.
+ * a = a1 * B^h + a0 and b = b1 * B^h + b0 are multiplied as
+ * a1 * b1 * B^2h + ((a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1) * B^h + a0 * b0,
+ * for three half size products rather than four. */
+static void nBigKaratsuba(nLimb_t *r, const nLimb_t *a, const nLimb_t *b,
+ const size_t n, nLimb_t *scratch, const nBigAddMul1_t addMul1)
+{
+    if (n < NBIG_KARATSUBA_THRESHOLD)
+    {
+        nBigMulBasecase(r, a, n, b, n, addMul1);
+        return;
+    }
+
+    const size_t low = n / 2, high = n - low;
+    nLimb_t *const sa = scratch;
+    nLimb_t *const sb = sa + high + 1;
+    nLimb_t *const mid = sb + high + 1;
+    nLimb_t *const next = mid + (2 * (high + 1));
+
+    sa[high] = nBigAddLimbs(sa, a + low, high, a, low);
+    sb[high] = nBigAddLimbs(sb, b + low, high, b, low);
+    nBigKaratsuba(mid, sa, sb, high + 1, next, addMul1);
+    nBigKaratsuba(r, a, b, low, next, addMul1);
+    nBigKaratsuba(r + (2 * low), a + low, b + low, high, next, addMul1);
+
+    nBigSubLimbs(mid, mid, 2 * (high + 1), r, 2 * low);
+    nBigSubLimbs(mid, mid, 2 * (high + 1), r + (2 * low), 2 * high);
+    nBigAddLimbs(r + low, r + low, (2 * n) - low, mid,
+     nBigTrim(mid, 2 * (high + 1)));
+}
+
+static int nBigMulLimbs(nLimb_t *r, const nLimb_t *a, const size_t an,
+ const nLimb_t *b, const size_t bn);
+
+
+/* Number primitives */
+
+static void nBigNormalize(nBig_t *const a)
+{
+    a->size = nBigTrim(nBigLimbs(a), a->size);
+    if (!a->size) a->negative = 0;
+}
+
+/* Moves src into dst, leaving src zero. */
+static void nBigMove(nBig_t *const dst, nBig_t *const src)
+{
+    if (dst == src) return;
+    nBigFree(dst);
+    *dst = *src;
+    nBigInit(src);
+}
+
+/* Sets a number to a copy of n limbs. */
+static int nBigSetLimbs(nBig_t *const dst, const nLimb_t *const a,
+ const size_t n, const int negative)
+{
+    const int err = nBigReserve(dst, n);
+    if (err) return err;
+    memmove(nBigLimbs(dst), a, n * sizeof(nLimb_t));
+    dst->size = n;
+    dst->negative = negative;
+    nBigNormalize(dst);
+    return NSUCCESS;
+}
+
+/* Computes dst = a + b for signs aNeg and bNeg. */
+static int nBigAddSigned(nBig_t *const dst, const nBig_t *const a,
+ const int aNeg, const nBig_t *const b, const int bNeg)
+{
+    const size_t an = a->size, bn = b->size;
+    const int err = nBigReserve(dst, ((an > bn) ? an : bn) + 1);
+    if (err) return err;
+
+    /* Reserving may have moved the limbs of dst, which may be a or b. */
+    nLimb_t *const r = nBigLimbs(dst);
+    const nLimb_t *const al = nBigLimbs(a), *const bl = nBigLimbs(b);
+    if (aNeg == bNeg)
+    {
+        if (an >= bn) r[an] = nBigAddLimbs(r, al, an, bl, bn);
+        else r[bn] = nBigAddLimbs(r, bl, bn, al, an);
+        dst->size = ((an > bn) ? an : bn) + 1;
+        dst->negative = aNeg;
+    }
+    else
+    {
+        const int cmp = (an != bn) ? ((an > bn) ? 1 : -1) :
+         nBigCompareLimbs(al, bl, an);
+        if (cmp >= 0)
+        {
+            nBigSubLimbs(r, al, an, bl, bn);
+            dst->size = an;
+            dst->negative = aNeg;
+        }
+        else
+        {
+            nBigSubLimbs(r, bl, bn, al, an);
+            dst->size = bn;
+            dst->negative = bNeg;
+        }
+    }
+    nBigNormalize(dst);
+    return NSUCCESS;
+}
+
+/* Computes a = a * mul + add on the magnitude of a. */
+static int nBigMulAddLimb(nBig_t *const a, const nLimb_t mul,
+ const nLimb_t add)
+{
+    const int err = nBigReserve(a, a->size + 1);
+    if (err) return err;
+
+    nLimb_t *const l = nBigLimbs(a);
+    nLimb_t carry = add;
+    for (size_t i = 0; i < a->size; i++)
+    {
+        nLimb_t hi;
+        nLimb_t lo = nBigMulWide(l[i], mul, &hi);
+        hi += __builtin_add_overflow(lo, carry, &l[i]);
+        carry = hi;
+    }
+    l[a->size++] = carry;
+    nBigNormalize(a);
+    return NSUCCESS;
+}
+
+/* Computes r = a * b by Toom-3 multiplication, where a and b have n limbs
+ * and r has 2n limbs. a and b are split into three parts of k limbs, the
+ * coefficients of polynomials in B^k, whose product is interpolated from its
+ * values at 0, 1, -1, -2 and infinity, for five third size products rather
+ * than nine. */
+static int nBigToom3(nLimb_t *r, const nLimb_t *a, const nLimb_t *b,
+ const size_t n)
+{
+    const size_t k = (n + 2) / 3;
+    enum {A0, A1, A2, B0, B1, B2, P, Q, V0, V1, VM1, VM2, VINF, T, COUNT};
+    nBig_t v[COUNT];
+    for (int i = 0; i < COUNT; i++) nBigInit(&v[i]);
+
+    int err = NSUCCESS;
+#define NBIG_TRY(call) if ((err = (call))) goto cleanup
+    NBIG_TRY(nBigSetLimbs(&v[A0], a, k, 0));
+    NBIG_TRY(nBigSetLimbs(&v[A1], a + k, k, 0));
+    NBIG_TRY(nBigSetLimbs(&v[A2], a + (2 * k), n - (2 * k), 0));
+    NBIG_TRY(nBigSetLimbs(&v[B0], b, k, 0));
+    NBIG_TRY(nBigSetLimbs(&v[B1], b + k, k, 0));
+    NBIG_TRY(nBigSetLimbs(&v[B2], b + (2 * k), n - (2 * k), 0));
+
+    /* Evaluates at 0, 1, -1, -2 and infinity. */
+    NBIG_TRY(nBigMul(&v[V0], &v[A0], &v[B0]));
+    NBIG_TRY(nBigMul(&v[VINF], &v[A2], &v[B2]));
+    NBIG_TRY(nBigAdd(&v[P], &v[A0], &v[A2]));
+    NBIG_TRY(nBigAdd(&v[Q], &v[B0], &v[B2]));
+    NBIG_TRY(nBigAdd(&v[T], &v[P], &v[A1]));
+    NBIG_TRY(nBigSub(&v[P], &v[P], &v[A1]));
+    NBIG_TRY(nBigAdd(&v[V1], &v[Q], &v[B1]));
+    NBIG_TRY(nBigSub(&v[Q], &v[Q], &v[B1]));
+    NBIG_TRY(nBigMul(&v[V1], &v[T], &v[V1]));
+    NBIG_TRY(nBigMul(&v[VM1], &v[P], &v[Q]));
+    NBIG_TRY(nBigAdd(&v[P], &v[P], &v[A2]));
+    NBIG_TRY(nBigShiftLeft(&v[P], &v[P], 1));
+    NBIG_TRY(nBigSub(&v[P], &v[P], &v[A0]));
+    NBIG_TRY(nBigAdd(&v[Q], &v[Q], &v[B2]));
+    NBIG_TRY(nBigShiftLeft(&v[Q], &v[Q], 1));
+    NBIG_TRY(nBigSub(&v[Q], &v[Q], &v[B0]));
+    NBIG_TRY(nBigMul(&v[VM2], &v[P], &v[Q]));
+
+    /* Interpolates the coefficients r0 to r4, reusing the parts as r1 to
+     * r3. The divisions are exact. */
+    nBig_t *const r1 = &v[A0], *const r2 = &v[A1], *const r3 = &v[A2];
+    NBIG_TRY(nBigSub(r3, &v[VM2], &v[V1]));
+    nBigDivLimb(nBigLimbs(r3), nBigLimbs(r3), r3->size, 3);
+    nBigNormalize(r3);
+    NBIG_TRY(nBigSub(r1, &v[V1], &v[VM1]));
+    NBIG_TRY(nBigShiftRight(r1, r1, 1));
+    NBIG_TRY(nBigSub(r2, &v[VM1], &v[V0]));
+    NBIG_TRY(nBigSub(r3, r2, r3));
+    NBIG_TRY(nBigShiftRight(r3, r3, 1));
+    NBIG_TRY(nBigShiftLeft(&v[T], &v[VINF], 1));
+    NBIG_TRY(nBigAdd(r3, r3, &v[T]));
+    NBIG_TRY(nBigAdd(r2, r2, r1));
+    NBIG_TRY(nBigSub(r2, r2, &v[VINF]));
+    NBIG_TRY(nBigSub(r1, r1, r3));
+#undef NBIG_TRY
+
+    /* The coefficients of a product of polynomials with positive
+     * coefficients are positive, so they add into the result. */
+    memset(r, 0, 2 * n * sizeof(nLimb_t));
+    const nBig_t *const coeffs[5] = {&v[V0], r1, r2, r3, &v[VINF]};
+    for (size_t i = 0; i < 5; i++)
+    {
+        const size_t offset = i * k;
+        const size_t size = coeffs[i]->size;
+        if (!size) continue;
+        nBigAddLimbs(r + offset, r + offset, (2 * n) - offset,
+         nBigLimbs(coeffs[i]), size);
+    }
+
+cleanup:
+    for (int i = 0; i < COUNT; i++) nBigFree(&v[i]);
+    return err;
+}
+
+/* Computes r = a * b, where a and b have n limbs and r has 2n limbs. */
+static int nBigMulBalanced(nLimb_t *r, const nLimb_t *a, const nLimb_t *b,
+ const size_t n)
+{
+    if (n >= NBIG_TOOM3_THRESHOLD) return nBigToom3(r, a, b, n);
+
+    nLimb_t *scratch = nAlloc(nBigKaratsubaScratch(n) * sizeof(nLimb_t));
+    if (!scratch) return NERROR_NO_MEMORY;
+    nBigKaratsuba(r, a, b, n, scratch, nBigAddMul1Kernel());
+    nFree((void **) &scratch);
+    return NSUCCESS;
+}
+
+/* Computes r = a * b, where an >= bn >= 1 and r has an + bn limbs and is
+ * neither a nor b. Unbalanced factors are multiplied in blocks of bn limbs of
+ * a, so that each block uses the balanced algorithms. */
+static int nBigMulLimbs(nLimb_t *r, const nLimb_t *a, const size_t an,
+ const nLimb_t *b, const size_t bn)
+{
+    if (bn < NBIG_KARATSUBA_THRESHOLD)
+    {
+        nBigMulBasecase(r, a, an, b, bn, nBigAddMul1Kernel());
+        return NSUCCESS;
+    }
+    if (an == bn) return nBigMulBalanced(r, a, b, bn);
+
+    nLimb_t *block = nAlloc(2 * bn * sizeof(nLimb_t));
+    if (!block) return NERROR_NO_MEMORY;
+    memset(r, 0, (an + bn) * sizeof(nLimb_t));
+    int err = NSUCCESS;
+    for (size_t i = 0; i < an; i += bn)
+    {
+        const size_t size = ((an - i) < bn) ? an - i : bn;
+        err = (size == bn) ? nBigMulBalanced(block, a + i, b, bn) :
+         nBigMulLimbs(block, b, bn, a + i, size);
+        if (err) break;
+        nBigAddLimbs(r + i, r + i, an + bn - i, block, size + bn);
+    }
+    nFree((void **) &block);
+    return err;
+}
+
+
+/* Public functions */
+
+void nBigFree(nBig_t *const a)
+{
+    if (a->heap) nFree((void **) &a->heap);
+    nBigInit(a);
+}
+
+int nBigReserve(nBig_t *const a, const size_t limbs)
+{
+    if (limbs <= a->capacity) return NSUCCESS;
+
+    const size_t capacity = (limbs > 2 * a->capacity) ? limbs :
+     2 * a->capacity;
+    nLimb_t *heap = nAlloc(capacity * sizeof(nLimb_t));
+    if (!heap) return NERROR_NO_MEMORY;
+
+    memcpy(heap, nBigLimbs(a), a->size * sizeof(nLimb_t));
+    if (a->heap) nFree((void **) &a->heap);
+    a->heap = heap;
+    a->capacity = capacity;
+    return NSUCCESS;
+}
+
+void nBigSetInt(nBig_t *const a, const int64_t value)
+{
+    nBigSetUint(a, (value < 0) ? -(uint64_t) value : (uint64_t) value);
+    a->negative = (value < 0);
+}
+
+void nBigSetUint(nBig_t *const a, const uint64_t value)
+{
+    nBigLimbs(a)[0] = value;
+    a->size = (value != 0);
+    a->negative = 0;
+}
+
+int nBigCopy(nBig_t *const dst, const nBig_t *const src)
+{
+    if (dst == src) return NSUCCESS;
+    return nBigSetLimbs(dst, nBigLimbs(src), src->size, src->negative);
+}
+
+int nBigCompare(const nBig_t *const a, const nBig_t *const b)
+{
+    if (a->negative != b->negative) return a->negative ? -1 : 1;
+
+    int cmp = (a->size != b->size) ? ((a->size > b->size) ? 1 : -1) :
+     nBigCompareLimbs(nBigLimbs(a), nBigLimbs(b), a->size);
+    return a->negative ? -cmp : cmp;
+}
+
+int nBigAdd(nBig_t *const dst, const nBig_t *const a, const nBig_t *const b)
+{
+    return nBigAddSigned(dst, a, a->negative, b, b->negative);
+}
+
+int nBigSub(nBig_t *const dst, const nBig_t *const a, const nBig_t *const b)
+{
+    return nBigAddSigned(dst, a, a->negative, b, !b->negative);
+}
+
+int nBigMul(nBig_t *const dst, const nBig_t *const a, const nBig_t *const b)
+{
+    if (!a->size || !b->size)
+    {
+        nBigSetUint(dst, 0);
+        return NSUCCESS;
+    }
+
+    /* The product is built in a new number if dst is a source. */
+    nBig_t tmp = NBIG_INIT;
+    nBig_t *const r = ((dst == a) || (dst == b)) ? &tmp : dst;
+    const size_t an = a->size, bn = b->size;
+    int err = nBigReserve(r, an + bn);
+    if (!err)
+    {
+        err = (an >= bn) ?
+         nBigMulLimbs(nBigLimbs(r), nBigLimbs(a), an, nBigLimbs(b), bn) :
+         nBigMulLimbs(nBigLimbs(r), nBigLimbs(b), bn, nBigLimbs(a), an);
+    }
+    if (err)
+    {
+        nBigFree(&tmp);
+        return err;
+    }
+
+    r->size = an + bn;
+    r->negative = a->negative ^ b->negative;
+    nBigNormalize(r);
+    nBigMove(dst, r);
+    return NSUCCESS;
+}
+
+int nBigDivMod(nBig_t *const quotient, nBig_t *const remainder,
+               const nBig_t *const a, const nBig_t *const b)
+{
+    if (!b->size) return NERROR_DOMAIN;
+
+    const size_t an = a->size, bn = b->size;
+    const int qNeg = a->negative ^ b->negative, rNeg = a->negative;
+    if ((an < bn) || ((an == bn) &&
+     (nBigCompareLimbs(nBigLimbs(a), nBigLimbs(b), an) < 0)))
+    {
+        if (remainder)
+        {
+            const int err = nBigCopy(remainder, a);
+            if (err) return err;
+        }
+        if (quotient) nBigSetUint(quotient, 0);
+        return NSUCCESS;
+    }
+
+    nBig_t q = NBIG_INIT, u = NBIG_INIT, v = NBIG_INIT;
+    int err = nBigReserve(&q, an - bn + 1);
+    if (!err) err = nBigReserve(&u, an + 1);
+    if (!err) err = nBigReserve(&v, bn);
+    if (err) goto cleanup;
+
+    nLimb_t *const ql = nBigLimbs(&q), *const ul = nBigLimbs(&u);
+    nLimb_t *const vl = nBigLimbs(&v);
+    if (bn == 1)
+    {
+        ul[0] = nBigDivLimb(ql, nBigLimbs(a), an, nBigLimbs(b)[0]);
+        u.size = 1;
+    }
+    else
+    {
+        /* Knuth's algorithm D: the divisor is shifted so its top bit is set,
+         * which makes each quotient limb estimated from the top two limbs of
+         * the remainder at most 2 too large. */
+        const unsigned shift = (unsigned) __builtin_clzll(nBigLimbs(b)[bn - 1]);
+        const nLimb_t *const al = nBigLimbs(a), *const bl = nBigLimbs(b);
+        for (size_t i = bn - 1; i > 0; i--)
+        {
+            vl[i] = (bl[i] << shift) |
+             (shift ? bl[i - 1] >> (NBIG_LIMB_BITS - shift) : 0);
+        }
+        vl[0] = bl[0] << shift;
+        ul[an] = shift ? al[an - 1] >> (NBIG_LIMB_BITS - shift) : 0;
+        for (size_t i = an - 1; i > 0; i--)
+        {
+            ul[i] = (al[i] << shift) |
+             (shift ? al[i - 1] >> (NBIG_LIMB_BITS - shift) : 0);
+        }
+        ul[0] = al[0] << shift;
+
+        const nLimb_t vTop = vl[bn - 1], vNext = vl[bn - 2];
+        for (size_t j = an - bn + 1; j-- > 0;)
+        {
+            nLimb_t qHat, rHat;
+            bool rHatOverflow = false;
+            if (ul[j + bn] >= vTop)
+            {
+                qHat = ~(nLimb_t) 0;
+                rHatOverflow = __builtin_add_overflow(ul[j + bn - 1], vTop,
+                 &rHat);
+            }
+            else
+            {
+                qHat = nBigDivWide(ul[j + bn], ul[j + bn - 1], vTop, &rHat);
+            }
+            while (!rHatOverflow)
+            {
+                nLimb_t hi;
+                const nLimb_t lo = nBigMulWide(qHat, vNext, &hi);
+                if ((hi < rHat) || ((hi == rHat) && (lo <= ul[j + bn - 2])))
+                {
+                    break;
+                }
+                qHat--;
+                rHatOverflow = __builtin_add_overflow(rHat, vTop, &rHat);
+            }
+
+            const nLimb_t borrow = nBigSubMul1(ul + j, vl, bn, qHat);
+            const bool negative = ul[j + bn] < borrow;
+            ul[j + bn] -= borrow;
+            if (negative)
+            {
+                qHat--;
+                ul[j + bn] += nBigAddLimbs(ul + j, ul + j, bn, vl, bn);
+            }
+            ql[j] = qHat;
+        }
+
+        for (size_t i = 0; i < bn - 1; i++)
+        {
+            ul[i] = (ul[i] >> shift) |
+             (shift ? ul[i + 1] << (NBIG_LIMB_BITS - shift) : 0);
+        }
+        ul[bn - 1] >>= shift;
+        u.size = bn;
+    }
+
+    q.size = an - bn + 1;
+    q.negative = qNeg;
+    nBigNormalize(&q);
+    u.negative = rNeg;
+    nBigNormalize(&u);
+    if (quotient) nBigMove(quotient, &q);
+    if (remainder) nBigMove(remainder, &u);
+
+cleanup:
+    nBigFree(&q);
+    nBigFree(&u);
+    nBigFree(&v);
+    return err;
+}
+
+int nBigShiftLeft(nBig_t *const dst, const nBig_t *const a, const size_t bits)
+{
+    const size_t an = a->size;
+    if (!an)
+    {
+        nBigSetUint(dst, 0);
+        return NSUCCESS;
+    }
+
+    const size_t limbShift = bits / NBIG_LIMB_BITS;
+    const unsigned bitShift = bits % NBIG_LIMB_BITS;
+    const int negative = a->negative;
+    const int err = nBigReserve(dst, an + limbShift + 1);
+    if (err) return err;
+
+    /* Shifts from the top down, so dst may be a. */
+    nLimb_t *const r = nBigLimbs(dst);
+    const nLimb_t *const al = nBigLimbs(a);
+    r[an + limbShift] = bitShift ?
+     al[an - 1] >> (NBIG_LIMB_BITS - bitShift) : 0;
+    for (size_t i = an - 1; i > 0; i--)
+    {
+        r[i + limbShift] = (al[i] << bitShift) |
+         (bitShift ? al[i - 1] >> (NBIG_LIMB_BITS - bitShift) : 0);
+    }
+    r[limbShift] = al[0] << bitShift;
+    memset(r, 0, limbShift * sizeof(nLimb_t));
+    dst->size = an + limbShift + 1;
+    dst->negative = negative;
+    nBigNormalize(dst);
+    return NSUCCESS;
+}
+
+int nBigShiftRight(nBig_t *const dst, const nBig_t *const a, const size_t bits)
+{
+    const size_t an = a->size;
+    const size_t limbShift = bits / NBIG_LIMB_BITS;
+    const unsigned bitShift = bits % NBIG_LIMB_BITS;
+    if (limbShift >= an)
+    {
+        nBigSetUint(dst, 0);
+        return NSUCCESS;
+    }
+
+    const size_t size = an - limbShift;
+    const int negative = a->negative;
+    const int err = nBigReserve(dst, size);
+    if (err) return err;
+
+    /* Shifts from the bottom up, so dst may be a. */
+    nLimb_t *const r = nBigLimbs(dst);
+    const nLimb_t *const al = nBigLimbs(a);
+    for (size_t i = 0; i + 1 < size; i++)
+    {
+        r[i] = (al[i + limbShift] >> bitShift) | (bitShift ?
+         al[i + limbShift + 1] << (NBIG_LIMB_BITS - bitShift) : 0);
+    }
+    r[size - 1] = al[an - 1] >> bitShift;
+    dst->size = size;
+    dst->negative = negative;
+    nBigNormalize(dst);
+    return NSUCCESS;
+}
+
+int nBigMulFixed(nBig_t *const dst, const nBig_t *const a,
+                 const nBig_t *const b, const size_t fracBits)
+{
+    const int err = nBigMul(dst, a, b);
+    if (err) return err;
+    return nBigShiftRight(dst, dst, fracBits);
+}
+
+/* Computes r = a * b / R mod m in Montgomery form, where R = B^n, a and b
+ * have n limbs and are less than m, and t has 2n + 1 limbs. Each step adds the
+ * multiple of m that clears the lowest limb of t, so t is divided by R by
+ * dropping limbs rather than dividing. */
+static int nBigMontMul(nLimb_t *r, const nLimb_t *a, const nLimb_t *b,
+ const nLimb_t *m, const size_t n, const nLimb_t mInv, nLimb_t *t,
+ const nBigAddMul1_t addMul1)
+{
+    const int err = nBigMulLimbs(t, a, n, b, n);
+    if (err) return err;
+
+    t[2 * n] = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        const nLimb_t carry = addMul1(t + i, m, n, t[i] * mInv);
+        nBigAddLimbs(t + i + n, t + i + n, n + 1 - i, &carry, 1);
+    }
+    if (t[2 * n] || (nBigCompareLimbs(t + n, m, n) >= 0))
+    {
+        nBigSubLimbs(r, t + n, n, m, n);
+    }
+    else
+    {
+        memcpy(r, t + n, n * sizeof(nLimb_t));
+    }
+    return NSUCCESS;
+}
+
+/* Computes dst = base ^ exponent mod an odd modulus, where base is reduced,
+ * using windows of NBIG_POW_WINDOW exponent bits. */
+static int nBigModPowMont(nBig_t *const dst, const nBig_t *const base,
+ const nBig_t *const exponent, const nBig_t *const modulus)
+{
+    const size_t n = modulus->size;
+    const nLimb_t *const m = nBigLimbs(modulus);
+    const size_t tableSize = (size_t) 1 << NBIG_POW_WINDOW;
+
+    /* -1 / m mod B by Newton's method, which doubles the correct bits of the
+     * inverse each step, starting from 3 as m * m = 1 mod 8. */
+    nLimb_t inv = m[0];
+    for (int i = 0; i < 5; i++) inv *= 2 - (m[0] * inv);
+    const nLimb_t mInv = -inv;
+
+    /* R^2 mod m converts numbers into Montgomery form. */
+    nBig_t r2 = NBIG_INIT;
+    nBigSetUint(&r2, 1);
+    int err = nBigShiftLeft(&r2, &r2, 2 * n * NBIG_LIMB_BITS);
+    if (!err) err = nBigDivMod(NULL, &r2, &r2, modulus);
+    if (!err) err = nBigReserve(dst, n);
+    nLimb_t *work = err ? NULL :
+     nAlloc(((tableSize + 5) * n + 1) * sizeof(nLimb_t));
+    if (!work)
+    {
+        nBigFree(&r2);
+        return err ? err : NERROR_NO_MEMORY;
+    }
+
+    nLimb_t *const table = work;
+    nLimb_t *const x = table + (tableSize * n);
+    nLimb_t *const tmp = x + n;
+    nLimb_t *const t = tmp + n;
+    const nBigAddMul1_t addMul1 = nBigAddMul1Kernel();
+#define NBIG_PAD(dstLimbs, num) do {\
+    memset((dstLimbs), 0, n * sizeof(nLimb_t));\
+    memcpy((dstLimbs), nBigLimbs(num), (num)->size * sizeof(nLimb_t));\
+} while (0)
+#define NBIG_MONT(r, a, b) if ((err = nBigMontMul((r), (a), (b), m, n, mInv,\
+ t, addMul1))) goto cleanup
+
+    /* table[i] is base^i in Montgomery form. */
+    NBIG_PAD(x, &r2);
+    memset(tmp, 0, n * sizeof(nLimb_t));
+    tmp[0] = 1;
+    NBIG_MONT(table, tmp, x);
+    NBIG_PAD(tmp, base);
+    NBIG_MONT(table + n, tmp, x);
+    for (size_t i = 2; i < tableSize; i++)
+    {
+        NBIG_MONT(table + (i * n), table + ((i - 1) * n), table + n);
+    }
+
+    /* Squares once per bit and multiplies once per window, from the top. */
+    memcpy(x, table, n * sizeof(nLimb_t));
+    const nLimb_t *const e = nBigLimbs(exponent);
+    const size_t bits = exponent->size * NBIG_LIMB_BITS;
+    for (size_t w = (bits + NBIG_POW_WINDOW - 1) / NBIG_POW_WINDOW; w-- > 0;)
+    {
+        const size_t bit = w * NBIG_POW_WINDOW;
+        const size_t window = (size_t) (e[bit / NBIG_LIMB_BITS] >>
+         (bit % NBIG_LIMB_BITS)) & (tableSize - 1);
+        for (int i = 0; i < NBIG_POW_WINDOW; i++) NBIG_MONT(x, x, x);
+        if (window) NBIG_MONT(x, x, table + (window * n));
+    }
+
+    /* Multiplying by 1 leaves Montgomery form. */
+    memset(tmp, 0, n * sizeof(nLimb_t));
+    tmp[0] = 1;
+    NBIG_MONT(nBigLimbs(dst), x, tmp);
+    dst->size = n;
+    dst->negative = 0;
+    nBigNormalize(dst);
+#undef NBIG_MONT
+#undef NBIG_PAD
+
+cleanup:
+    nFree((void **) &work);
+    nBigFree(&r2);
+    return err;
+}
+
+int nBigModPow(nBig_t *const dst, const nBig_t *const base,
+               const nBig_t *const exponent, const nBig_t *const modulus)
+{
+    if (!modulus->size || modulus->negative || exponent->negative)
+    {
+        return NERROR_DOMAIN;
+    }
+
+    nBig_t b = NBIG_INIT, m = NBIG_INIT;
+    int err = nBigCopy(&m, modulus);
+    if (!err) err = nBigDivMod(NULL, &b, base, &m);
+    if (!err && b.negative) err = nBigAdd(&b, &b, &m);
+    if (err) goto cleanup;
+
+    if ((m.size == 1) && (nBigLimbs(&m)[0] == 1))
+    {
+        nBigSetUint(dst, 0);
+    }
+    else if (nBigLimbs(&m)[0] & 1)
+    {
+        err = nBigModPowMont(dst, &b, exponent, &m);
+    }
+    else
+    {
+        /* Even moduli have no inverse mod B, so they reduce by dividing. */
+        nBig_t x = NBIG_INIT;
+        nBigSetUint(&x, 1);
+        const nLimb_t *const e = nBigLimbs(exponent);
+        for (size_t bit = exponent->size * NBIG_LIMB_BITS; bit-- > 0;)
+        {
+            if ((err = nBigMul(&x, &x, &x))) break;
+            if ((err = nBigDivMod(NULL, &x, &x, &m))) break;
+            if (!((e[bit / NBIG_LIMB_BITS] >> (bit % NBIG_LIMB_BITS)) & 1))
+            {
+                continue;
+            }
+            if ((err = nBigMul(&x, &x, &b))) break;
+            if ((err = nBigDivMod(NULL, &x, &x, &m))) break;
+        }
+        if (!err) nBigMove(dst, &x);
+        nBigFree(&x);
+    }
+
+cleanup:
+    nBigFree(&b);
+    nBigFree(&m);
+    return err;
+}
+
+int nBigFromString(nBig_t *const dst, const char *const str, const size_t len)
+{
+    size_t i = 0;
+    const int negative = (len > 0) && (str[0] == '-');
+    if (negative) i++;
+    if (i >= len) return NERROR_INV_ARG;
+
+    nBig_t r = NBIG_INIT;
+    while (i < len)
+    {
+        /* Adds up to a limb of digits at a time. */
+        nLimb_t chunk = 0, scale = 1;
+        for (int d = 0; (d < NBIG_DEC_CHUNK_DIGITS) && (i < len); d++, i++)
+        {
+            if ((str[i] < '0') || (str[i] > '9'))
+            {
+                nBigFree(&r);
+                return NERROR_INV_ARG;
+            }
+            chunk = (chunk * 10) + (nLimb_t) (str[i] - '0');
+            scale *= 10;
+        }
+        const int err = nBigMulAddLimb(&r, scale, chunk);
+        if (err)
+        {
+            nBigFree(&r);
+            return err;
+        }
+    }
+    r.negative = negative;
+    nBigNormalize(&r);
+    nBigMove(dst, &r);
+    return NSUCCESS;
+}
+
+ssize_t nBigToString(char *const dst, const size_t size, const nBig_t *const a)
+{
+    /* Each division by NBIG_DEC_CHUNK removes at least 63 bits. */
+    const size_t maxChunks = ((a->size * NBIG_LIMB_BITS) / 63) + 1;
+    nLimb_t *work = nAlloc((a->size + maxChunks + 1) * sizeof(nLimb_t));
+    if (!work) return -1;
+
+    nLimb_t *const q = work;
+    nLimb_t *const chunks = q + a->size;
+    memcpy(q, nBigLimbs(a), a->size * sizeof(nLimb_t));
+    size_t n = a->size, count = 0;
+    do {
+        chunks[count++] = nBigDivLimb(q, q, n, NBIG_DEC_CHUNK);
+        n = nBigTrim(q, n);
+    } while (n);
+
+    /* The top chunk has no leading zeros, and the rest are padded. */
+    char digits[NBIG_DEC_CHUNK_DIGITS];
+    size_t len = 0;
+    if (a->negative)
+    {
+        if (len + 1 < size) dst[len] = '-';
+        len++;
+    }
+    for (size_t c = count; c-- > 0;)
+    {
+        int d = NBIG_DEC_CHUNK_DIGITS;
+        for (nLimb_t v = chunks[c]; d > 0; v /= 10)
+        {
+            digits[--d] = (char) ('0' + (v % 10));
+        }
+        if (c == count - 1)
+        {
+            while ((d < NBIG_DEC_CHUNK_DIGITS - 1) && (digits[d] == '0')) d++;
+        }
+        for (; d < NBIG_DEC_CHUNK_DIGITS; d++, len++)
+        {
+            if (len + 1 < size) dst[len] = digits[d];
+        }
+    }
+    if (size) dst[(len < size) ? len : size - 1] = '\0';
+
+    nFree((void **) &work);
+    return (ssize_t) len;
+}
+
+// BigNumber.c
@@ -0,0 +1,633 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * FixedPoint.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/FixedPoint.h"
+
+/**
+ * @file FixedPoint.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines deterministic fixed point math.
+ */
+
+#include "../../include/Nimble/System/Simd.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+#  include <arm_neon.h>
+#endif
+
+#define NFIX16_TURNS_PER_RADIAN 683565276LL /**< 2^32 / (2 * Pi), which converts Q16.16 radians to 2^-24 turns. */
+#define NFIX_CORDIC_STEPS 40 /**< The number of CORDIC rotations, one per fractional bit. */
+#define NFIX_CORDIC_GAIN 667681663043LL /**< The product of the cosines of the CORDIC angles, with 40 fractional bits. */
+
+/* The tables are integers generated offline, as computing them at startup with
+ * the C library could differ between platforms. */
+
+/* The sine of each 1/1024 turn of the first quarter, as Q16.16 numbers. */
+static const int32_t NFIX16_SIN_TABLE[257] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+    3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+    6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+    12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+    15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+    22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+    25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+    30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+    33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+    39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+    41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+    46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+    48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+    52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+    54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+    57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+    59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+    61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+    62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+    64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+    64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+    65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+    65536,
+};
+
+/* atan(2^-i) with 40 fractional bits. */
+static const int64_t NFIX_CORDIC_ANGLES[NFIX_CORDIC_STEPS] = {
+    863554413089LL, 509785937287LL, 269356888665LL,
+    136729762476LL, 68630207382LL, 34348560106LL,
+    17178471287LL, 8589759836LL, 4294945451LL,
+    2147480917LL, 1073741483LL, 536870869LL,
+    268435451LL, 134217727LL, 67108864LL,
+    33554432LL, 16777216LL, 8388608LL,
+    4194304LL, 2097152LL, 1048576LL,
+    524288LL, 262144LL, 131072LL,
+    65536LL, 32768LL, 16384LL,
+    8192LL, 4096LL, 2048LL,
+    1024LL, 512LL, 256LL,
+    128LL, 64LL, 32LL,
+    16LL, 8LL, 4LL,
+    2LL,
+};
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nFixKernels {
+    void (*transform)(const nFix16Mat4_t *const a, const nFix16Vec3_t *in,
+     nFix16Vec3_t *out, const size_t count);
+} nFixKernels_t;
+
+/* Gets floor(sqrt(a * 2^fracBits)) one bit at a time, bringing down two bits
+ * of a * 2^fracBits per step as in long division. The remainder stays under
+ * four times the root, so it fits in 64 bits for roots of up to 61 bits. */
+static uint64_t nFixSqrtBits(const uint64_t a, const unsigned fracBits)
+{
+    if (!a) return 0;
+
+    const unsigned bits = (64 - (unsigned) __builtin_clzll(a)) + fracBits;
+    uint64_t root = 0, rem = 0;
+    for (unsigned pair = (bits + 1) / 2; pair-- > 0;)
+    {
+        for (unsigned bit = (2 * pair) + 2; bit-- > 2 * pair;)
+        {
+            rem = (rem << 1) | ((bit >= fracBits) ?
+             (a >> (bit - fracBits)) & 1 : 0);
+        }
+        const uint64_t trial = (root << 2) | 1;
+        root <<= 1;
+        if (rem >= trial)
+        {
+            rem -= trial;
+            root |= 1;
+        }
+    }
+    return root;
+}
+
+nFix16_t nFix16Sqrt(const nFix16_t a)
+{
+    return (a > 0) ? (nFix16_t) nFixSqrtBits((uint64_t) a, 16) : 0;
+}
+
+/* Gets the sine of an angle in 2^-24 turns, mirroring the quarter wave
+ * table into the other quadrants. Wrapping the angle at 256 turns keeps its
+ * sine. */
+static nFix16_t nFix16SinTurns(const uint32_t turns)
+{
+    const uint32_t quadrant = (turns >> 22) & 3;
+    const uint32_t pos = (quadrant & 1) ? 0x400000 - (turns & 0x3fffff) :
+     turns & 0x3fffff;
+    const uint32_t i = pos >> 14, frac = pos & 0x3fff;
+    int32_t value = NFIX16_SIN_TABLE[i];
+    if (frac)
+    {
+        value += (((NFIX16_SIN_TABLE[i + 1] - value) * (int32_t) frac) +
+         0x2000) >> 14;
+    }
+    return (quadrant & 2) ? -value : value;
+}
+
+static uint32_t nFix16Turns(const nFix16_t a)
+{
+    return (uint32_t) (((int64_t) a * NFIX16_TURNS_PER_RADIAN) >> 24);
+}
+
+nFix16_t nFix16Sin(const nFix16_t a)
+{
+    return nFix16SinTurns(nFix16Turns(a));
+}
+
+nFix16_t nFix16Cos(const nFix16_t a)
+{
+    return nFix16SinTurns(nFix16Turns(a) + 0x400000);
+}
+
+nFix16_t nFix16Atan2(const nFix16_t y, const nFix16_t x)
+{
+    return nFix32ToFix16(nFix32Atan2(nFix32FromFix16(y), nFix32FromFix16(x)));
+}
+
+nFix32_t nFix32Div(const nFix32_t a, const nFix32_t b)
+{
+    if (!b) return (a >= 0) ? NFIX32_MAX : NFIX32_MIN;
+
+#ifdef __SIZEOF_INT128__
+    const __int128 q = ((__int128) a * ((__int128) 1 << 32)) / b;
+    return (q > INT64_MAX) ? NFIX32_MAX : (q < INT64_MIN) ? NFIX32_MIN :
+     (nFix32_t) q;
+#else
+    /* Long division of |a| * 2^32 by |b|, one quotient bit at a time. */
+    const int negative = (a < 0) != (b < 0);
+    const uint64_t ua = (a < 0) ? 0 - (uint64_t) a : (uint64_t) a;
+    const uint64_t ub = (b < 0) ? 0 - (uint64_t) b : (uint64_t) b;
+    uint64_t q = 0, rem = 0;
+    int overflow = 0;
+    for (unsigned bit = 96; bit-- > 0;)
+    {
+        rem = (rem << 1) | ((bit >= 32) ? (ua >> (bit - 32)) & 1 : 0);
+        if (rem < ub) continue;
+        rem -= ub;
+        if (bit >= 64) overflow = 1;
+        else q |= (uint64_t) 1 << bit;
+    }
+    if (overflow || (q > (uint64_t) INT64_MAX + negative))
+    {
+        return negative ? NFIX32_MIN : NFIX32_MAX;
+    }
+    return negative ? (nFix32_t) (0 - q) : (nFix32_t) q;
+#endif
+}
+
+nFix32_t nFix32Sqrt(const nFix32_t a)
+{
+    return (a > 0) ? (nFix32_t) nFixSqrtBits((uint64_t) a, 32) : 0;
+}
+
+void nFix32SinCos(const nFix32_t a, nFix32_t *const sin, nFix32_t *const cos)
+{
+    /* Reduces the angle to -Pi/2 to Pi/2, where CORDIC converges. Reflecting
+     * an angle past Pi/2 keeps its sine and negates its cosine. */
+    nFix32_t r = a % NFIX32_TWO_PI;
+    if (r > NFIX32_PI) r -= NFIX32_TWO_PI;
+    else if (r < -NFIX32_PI) r += NFIX32_TWO_PI;
+    int reflected = 1;
+    if (r > NFIX32_HALF_PI) r = NFIX32_PI - r;
+    else if (r < -NFIX32_HALF_PI) r = -NFIX32_PI - r;
+    else reflected = 0;
+
+    /* Rotates (gain, 0) toward the angle, so the gain of the rotations leaves
+     * a unit vector. */
+    int64_t x = NFIX_CORDIC_GAIN, y = 0, z = r * 256;
+    for (int i = 0; i < NFIX_CORDIC_STEPS; i++)
+    {
+        const int64_t dx = x >> i, dy = y >> i;
+        if (z >= 0)
+        {
+            x -= dy;
+            y += dx;
+            z -= NFIX_CORDIC_ANGLES[i];
+        }
+        else
+        {
+            x += dy;
+            y -= dx;
+            z += NFIX_CORDIC_ANGLES[i];
+        }
+    }
+    if (sin) *sin = (y + 128) >> 8;
+    if (cos) *cos = reflected ? -((x + 128) >> 8) : (x + 128) >> 8;
+}
+
+nFix32_t nFix32Sin(const nFix32_t a)
+{
+    nFix32_t s;
+    nFix32SinCos(a, &s, NULL);
+    return s;
+}
+
+nFix32_t nFix32Cos(const nFix32_t a)
+{
+    nFix32_t c;
+    nFix32SinCos(a, NULL, &c);
+    return c;
+}
+
+nFix32_t nFix32Atan2(const nFix32_t y, const nFix32_t x)
+{
+    if (!x && !y) return 0;
+
+    /* Scales the larger coordinate to 39 bits, which keeps small points
+     * precise and leaves room for the gain of the rotations. */
+    uint64_t ux = (x < 0) ? 0 - (uint64_t) x : (uint64_t) x;
+    uint64_t uy = (y < 0) ? 0 - (uint64_t) y : (uint64_t) y;
+    const unsigned bits = 64 - (unsigned) __builtin_clzll((ux > uy) ? ux : uy);
+    if (bits > 39)
+    {
+        ux >>= bits - 39;
+        uy >>= bits - 39;
+    }
+    else
+    {
+        ux <<= 39 - bits;
+        uy <<= 39 - bits;
+    }
+
+    /* Rotates the point in the first quadrant onto the X axis. */
+    int64_t px = (int64_t) ux, py = (int64_t) uy, z = 0;
+    for (int i = 0; i < NFIX_CORDIC_STEPS; i++)
+    {
+        const int64_t dx = px >> i, dy = py >> i;
+        if (py > 0)
+        {
+            px += dy;
+            py -= dx;
+            z += NFIX_CORDIC_ANGLES[i];
+        }
+        else
+        {
+            px -= dy;
+            py += dx;
+            z -= NFIX_CORDIC_ANGLES[i];
+        }
+    }
+
+    nFix32_t angle = (z + 128) >> 8;
+    if (x < 0) angle = NFIX32_PI - angle;
+    return (y < 0) ? -angle : angle;
+}
+
+nFix16_t nFix16Vec3Length(const nFix16Vec3_t a)
+{
+    const uint64_t lenSq = (uint64_t) ((int64_t) a.x * a.x) +
+     (uint64_t) ((int64_t) a.y * a.y) + (uint64_t) ((int64_t) a.z * a.z);
+    const uint64_t len = nFixSqrtBits(lenSq, 0);
+    return (len > INT32_MAX) ? NFIX16_MAX : (nFix16_t) len;
+}
+
+nFix16Vec3_t nFix16Vec3Normalize(const nFix16Vec3_t a)
+{
+    const nFix16_t len = nFix16Vec3Length(a);
+    if (!len) return nFix16Vec3Set(0, 0, 0);
+    return nFix16Vec3Set(nFix16Div(a.x, len), nFix16Div(a.y, len),
+     nFix16Div(a.z, len));
+}
+
+nFix16Mat4_t nFix16Mat4Mul(const nFix16Mat4_t *const a,
+                           const nFix16Mat4_t *const b)
+{
+    nFix16Mat4_t r;
+    for (int c = 0; c < 4; c++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            uint64_t sum = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                sum += (uint64_t) ((int64_t) a->m[(k * 4) + row] *
+                 b->m[(c * 4) + k]);
+            }
+            r.m[(c * 4) + row] = nFix16Round((int64_t) sum);
+        }
+    }
+    return r;
+}
+
+nFix16Quat_t nFix16QuatMul(const nFix16Quat_t a, const nFix16Quat_t b)
+{
+#define NFIX_P(u, v) (uint64_t) ((int64_t) (u) * (v))
+    return nFix16QuatSet(
+     nFix16Round((int64_t) (NFIX_P(a.w, b.x) + NFIX_P(a.x, b.w) +
+      NFIX_P(a.y, b.z) - NFIX_P(a.z, b.y))),
+     nFix16Round((int64_t) (NFIX_P(a.w, b.y) - NFIX_P(a.x, b.z) +
+      NFIX_P(a.y, b.w) + NFIX_P(a.z, b.x))),
+     nFix16Round((int64_t) (NFIX_P(a.w, b.z) + NFIX_P(a.x, b.y) -
+      NFIX_P(a.y, b.x) + NFIX_P(a.z, b.w))),
+     nFix16Round((int64_t) (NFIX_P(a.w, b.w) - NFIX_P(a.x, b.x) -
+      NFIX_P(a.y, b.y) - NFIX_P(a.z, b.z))));
+#undef NFIX_P
+}
+
+nFix16Quat_t nFix16QuatFromAxisAngle(const nFix16Vec3_t axis,
+                                     const nFix16_t angle)
+{
+    const nFix16_t s = nFix16Sin(angle >> 1), c = nFix16Cos(angle >> 1);
+    return nFix16QuatSet(nFix16Mul(axis.x, s), nFix16Mul(axis.y, s),
+     nFix16Mul(axis.z, s), c);
+}
+
+nFix16Quat_t nFix16QuatNormalize(const nFix16Quat_t q)
+{
+    const uint64_t lenSq = (uint64_t) ((int64_t) q.x * q.x) +
+     (uint64_t) ((int64_t) q.y * q.y) + (uint64_t) ((int64_t) q.z * q.z) +
+     (uint64_t) ((int64_t) q.w * q.w);
+    const uint64_t len = nFixSqrtBits(lenSq, 0);
+    if (!len) return nFix16QuatIdentity();
+
+    const nFix16_t l = (len > INT32_MAX) ? NFIX16_MAX : (nFix16_t) len;
+    return nFix16QuatSet(nFix16Div(q.x, l), nFix16Div(q.y, l),
+     nFix16Div(q.z, l), nFix16Div(q.w, l));
+}
+
+nFix16Vec3_t nFix16QuatRotate(const nFix16Quat_t q, const nFix16Vec3_t v)
+{
+    /* v + w * t + u x t, where u is the imaginary part and t = 2 * u x v. */
+    const nFix16Vec3_t u = nFix16Vec3Set(q.x, q.y, q.z);
+    nFix16Vec3_t t = nFix16Vec3Cross(u, v);
+    t = nFix16Vec3Add(t, t);
+    return nFix16Vec3Add(nFix16Vec3Add(v, nFix16Vec3Scale(t, q.w)),
+     nFix16Vec3Cross(u, t));
+}
+
+nFix16Quat_t nFix16QuatNlerp(const nFix16Quat_t a, const nFix16Quat_t b,
+                             const nFix16_t t)
+{
+    const int64_t d = (int64_t) ((uint64_t) ((int64_t) a.x * b.x) +
+     (uint64_t) ((int64_t) a.y * b.y) + (uint64_t) ((int64_t) a.z * b.z) +
+     (uint64_t) ((int64_t) a.w * b.w));
+    const nFix16Quat_t bNear = (d < 0) ? nFix16QuatSet(-b.x, -b.y, -b.z, -b.w) :
+     b;
+    return nFix16QuatNormalize(nFix16QuatSet(
+     nFix16Add(a.x, nFix16Mul(nFix16Sub(bNear.x, a.x), t)),
+     nFix16Add(a.y, nFix16Mul(nFix16Sub(bNear.y, a.y), t)),
+     nFix16Add(a.z, nFix16Mul(nFix16Sub(bNear.z, a.z), t)),
+     nFix16Add(a.w, nFix16Mul(nFix16Sub(bNear.w, a.w), t))));
+}
+
+static void nFixTransformScalar(const nFix16Mat4_t *const a,
+ const nFix16Vec3_t *in, nFix16Vec3_t *out, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = nFix16Mat4TransformPoint(a, in[i]);
+    }
+}
+
+static const nFixKernels_t NFIX_SCALAR = {
+    .transform = nFixTransformScalar,
+};
+
+/* The transform kernels multiply 32-bit lanes into 64-bit sums, which only
+ * the even lanes can do on x86, so the odd rows of the matrix are shifted
+ * into even lanes and multiplied separately. Only the low 32 bits of each sum
+ * shifted right by 16 are kept, which a logical shift gets the same as the
+ * arithmetic shift of nFix16Round(). */
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static void nFixTransformSSE42(const nFix16Mat4_t *const a,
+ const nFix16Vec3_t *in, nFix16Vec3_t *out, const size_t count)
+{
+    const __m128i c0 = _mm_load_si128((const __m128i *) a->m);
+    const __m128i c1 = _mm_load_si128((const __m128i *) (a->m + 4));
+    const __m128i c2 = _mm_load_si128((const __m128i *) (a->m + 8));
+    const __m128i c3 = _mm_load_si128((const __m128i *) (a->m + 12));
+    const __m128i c0Odd = _mm_srli_epi64(c0, 32);
+    const __m128i c1Odd = _mm_srli_epi64(c1, 32);
+    const __m128i c2Odd = _mm_srli_epi64(c2, 32);
+    const __m128i one = _mm_set1_epi32(NFIX16_ONE);
+    const __m128i half = _mm_set1_epi64x(0x8000);
+    const __m128i tEven = _mm_add_epi64(_mm_mul_epi32(c3, one), half);
+    const __m128i tOdd = _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(c3, 32),
+     one), half);
+    const __m128i zero = _mm_setzero_si128();
+    for (size_t i = 0; i < count; i++)
+    {
+        const __m128i v = _mm_load_si128((const __m128i *) &in[i]);
+        const __m128i vx = _mm_shuffle_epi32(v, 0x00);
+        const __m128i vy = _mm_shuffle_epi32(v, 0x55);
+        const __m128i vz = _mm_shuffle_epi32(v, 0xaa);
+        __m128i even = _mm_add_epi64(tEven, _mm_mul_epi32(c0, vx));
+        even = _mm_add_epi64(even, _mm_mul_epi32(c1, vy));
+        even = _mm_add_epi64(even, _mm_mul_epi32(c2, vz));
+        __m128i odd = _mm_add_epi64(tOdd, _mm_mul_epi32(c0Odd, vx));
+        odd = _mm_add_epi64(odd, _mm_mul_epi32(c1Odd, vy));
+        odd = _mm_add_epi64(odd, _mm_mul_epi32(c2Odd, vz));
+        __m128i r = _mm_blend_epi16(_mm_srli_epi64(even, 16),
+         _mm_slli_epi64(_mm_srli_epi64(odd, 16), 32), 0xcc);
+        r = _mm_blend_epi16(r, zero, 0xc0);
+        _mm_store_si128((__m128i *) &out[i], r);
+    }
+}
+
+static const nFixKernels_t NFIX_SSE42 = {
+    .transform = nFixTransformSSE42,
+};
+
+NSIMD_TARGET("avx2,fma")
+static void nFixTransformAVX2(const nFix16Mat4_t *const a,
+ const nFix16Vec3_t *in, nFix16Vec3_t *out, const size_t count)
+{
+    const __m256i c0 = _mm256_broadcastsi128_si256(
+     _mm_load_si128((const __m128i *) a->m));
+    const __m256i c1 = _mm256_broadcastsi128_si256(
+     _mm_load_si128((const __m128i *) (a->m + 4)));
+    const __m256i c2 = _mm256_broadcastsi128_si256(
+     _mm_load_si128((const __m128i *) (a->m + 8)));
+    const __m256i c3 = _mm256_broadcastsi128_si256(
+     _mm_load_si128((const __m128i *) (a->m + 12)));
+    const __m256i c0Odd = _mm256_srli_epi64(c0, 32);
+    const __m256i c1Odd = _mm256_srli_epi64(c1, 32);
+    const __m256i c2Odd = _mm256_srli_epi64(c2, 32);
+    const __m256i one = _mm256_set1_epi32(NFIX16_ONE);
+    const __m256i half = _mm256_set1_epi64x(0x8000);
+    const __m256i tEven = _mm256_add_epi64(_mm256_mul_epi32(c3, one), half);
+    const __m256i tOdd = _mm256_add_epi64(_mm256_mul_epi32(
+     _mm256_srli_epi64(c3, 32), one), half);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i *) &in[i]);
+        const __m256i vx = _mm256_shuffle_epi32(v, 0x00);
+        const __m256i vy = _mm256_shuffle_epi32(v, 0x55);
+        const __m256i vz = _mm256_shuffle_epi32(v, 0xaa);
+        __m256i even = _mm256_add_epi64(tEven, _mm256_mul_epi32(c0, vx));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(c1, vy));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(c2, vz));
+        __m256i odd = _mm256_add_epi64(tOdd, _mm256_mul_epi32(c0Odd, vx));
+        odd = _mm256_add_epi64(odd, _mm256_mul_epi32(c1Odd, vy));
+        odd = _mm256_add_epi64(odd, _mm256_mul_epi32(c2Odd, vz));
+        __m256i r = _mm256_blend_epi16(_mm256_srli_epi64(even, 16),
+         _mm256_slli_epi64(_mm256_srli_epi64(odd, 16), 32), 0xcc);
+        r = _mm256_blend_epi16(r, zero, 0xc0);
+        _mm256_storeu_si256((__m256i *) &out[i], r);
+    }
+    nFixTransformSSE42(a, in + i, out + i, count - i);
+}
+
+static const nFixKernels_t NFIX_AVX2 = {
+    .transform = nFixTransformAVX2,
+};
+
+/* Masks the lanes of the points from i on, 4 lanes each. */
+#define NFIX_MASK(count, i) (((count) - (i) >= 4) ? (__mmask16) 0xffff :\
+ (__mmask16) ((1U << (((count) - (i)) * 4)) - 1))
+
+NSIMD_TARGET("avx512f")
+static void nFixTransformAVX512(const nFix16Mat4_t *const a,
+ const nFix16Vec3_t *in, nFix16Vec3_t *out, const size_t count)
+{
+    const __m512i c0 = _mm512_broadcast_i32x4(
+     _mm_load_si128((const __m128i *) a->m));
+    const __m512i c1 = _mm512_broadcast_i32x4(
+     _mm_load_si128((const __m128i *) (a->m + 4)));
+    const __m512i c2 = _mm512_broadcast_i32x4(
+     _mm_load_si128((const __m128i *) (a->m + 8)));
+    const __m512i c3 = _mm512_broadcast_i32x4(
+     _mm_load_si128((const __m128i *) (a->m + 12)));
+    const __m512i c0Odd = _mm512_srli_epi64(c0, 32);
+    const __m512i c1Odd = _mm512_srli_epi64(c1, 32);
+    const __m512i c2Odd = _mm512_srli_epi64(c2, 32);
+    const __m512i one = _mm512_set1_epi32(NFIX16_ONE);
+    const __m512i half = _mm512_set1_epi64(0x8000);
+    const __m512i tEven = _mm512_add_epi64(_mm512_mul_epi32(c3, one), half);
+    const __m512i tOdd = _mm512_add_epi64(_mm512_mul_epi32(
+     _mm512_srli_epi64(c3, 32), one), half);
+    for (size_t i = 0; i < count; i += 4)
+    {
+        const __mmask16 mask = NFIX_MASK(count, i);
+        const __m512i v = _mm512_maskz_loadu_epi32(mask, &in[i]);
+        const __m512i vx = _mm512_shuffle_epi32(v, _MM_PERM_AAAA);
+        const __m512i vy = _mm512_shuffle_epi32(v, _MM_PERM_BBBB);
+        const __m512i vz = _mm512_shuffle_epi32(v, _MM_PERM_CCCC);
+        __m512i even = _mm512_add_epi64(tEven, _mm512_mul_epi32(c0, vx));
+        even = _mm512_add_epi64(even, _mm512_mul_epi32(c1, vy));
+        even = _mm512_add_epi64(even, _mm512_mul_epi32(c2, vz));
+        __m512i odd = _mm512_add_epi64(tOdd, _mm512_mul_epi32(c0Odd, vx));
+        odd = _mm512_add_epi64(odd, _mm512_mul_epi32(c1Odd, vy));
+        odd = _mm512_add_epi64(odd, _mm512_mul_epi32(c2Odd, vz));
+        __m512i r = _mm512_mask_blend_epi32(0xaaaa,
+         _mm512_srli_epi64(even, 16),
+         _mm512_slli_epi64(_mm512_srli_epi64(odd, 16), 32));
+        r = _mm512_maskz_mov_epi32(0x7777, r);
+        _mm512_mask_storeu_epi32(&out[i], mask, r);
+    }
+}
+
+static const nFixKernels_t NFIX_AVX512 = {
+    .transform = nFixTransformAVX512,
+};
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+/* NEON multiplies into 64-bit lanes directly, and narrowing by 16 keeps the
+ * low 32 bits of the rounded sums. */
+static void nFixTransformNEON(const nFix16Mat4_t *const a,
+ const nFix16Vec3_t *in, nFix16Vec3_t *out, const size_t count)
+{
+    const int32x4_t c0 = vld1q_s32(a->m), c1 = vld1q_s32(a->m + 4);
+    const int32x4_t c2 = vld1q_s32(a->m + 8), c3 = vld1q_s32(a->m + 12);
+    const int64x2_t half = vdupq_n_s64(0x8000);
+    const int64x2_t tLow = vaddq_s64(vshll_n_s32(vget_low_s32(c3), 16), half);
+    const int64x2_t tHigh = vaddq_s64(vshll_n_s32(vget_high_s32(c3), 16),
+     half);
+    for (size_t i = 0; i < count; i++)
+    {
+        const int32x4_t v = vld1q_s32(&in[i].x);
+        int64x2_t low = vmlal_laneq_s32(tLow, vget_low_s32(c0), v, 0);
+        low = vmlal_laneq_s32(low, vget_low_s32(c1), v, 1);
+        low = vmlal_laneq_s32(low, vget_low_s32(c2), v, 2);
+        int64x2_t high = vmlal_laneq_s32(tHigh, vget_high_s32(c0), v, 0);
+        high = vmlal_laneq_s32(high, vget_high_s32(c1), v, 1);
+        high = vmlal_laneq_s32(high, vget_high_s32(c2), v, 2);
+        const int32x4_t r = vcombine_s32(vshrn_n_s64(low, 16),
+         vshrn_n_s64(high, 16));
+        vst1q_s32(&out[i].x, vsetq_lane_s32(0, r, 3));
+    }
+}
+
+static const nFixKernels_t NFIX_NEON = {
+    .transform = nFixTransformNEON,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(), which has already
+ * checked that the CPU supports it. */
+static const nFixKernels_t *nFixKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NFIX_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NFIX_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NFIX_SSE42;
+        default:
+            return &NFIX_SCALAR;
+    }
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    return (NSIMD.level >= NSIMD_LEVEL_NEON) ? &NFIX_NEON : &NFIX_SCALAR;
+#else
+    return &NFIX_SCALAR;
+#endif
+}
+
+void nFix16Mat4TransformPoints(const nFix16Mat4_t *const a,
+                               const nFix16Vec3_t *in, nFix16Vec3_t *out,
+                               const size_t count)
+{
+    nFixKernels()->transform(a, in, out, count);
+}
+
+// FixedPoint.c
@@ -0,0 +1,431 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Matrices.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/Matrices.h"
+
+/**
+ * @file Matrices.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines matrix math.
+ */
+
+#include <math.h>
+
+#include "../../include/Nimble/System/Simd.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+#  include <arm_neon.h>
+#endif
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nMatKernels {
+    void (*points)(const nMat4_t *const a, const nVec3_t *in, nVec3_t *out,
+     const size_t count);
+    void (*pointsSoA)(const nMat4_t *const a, const nVec3SoA_t in,
+     const nVec3SoA_t out, const size_t count);
+} nMatKernels_t;
+
+/* Makes a matrix from the top three rows of an affine transform. */
+static nMat4_t nMat4FromRows(const nVec3_t r0, const float t0,
+ const nVec3_t r1, const float t1, const nVec3_t r2, const float t2)
+{
+    const nMat4_t t = {.col = {
+        nVec4Set(r0.x, r0.y, r0.z, t0),
+        nVec4Set(r1.x, r1.y, r1.z, t1),
+        nVec4Set(r2.x, r2.y, r2.z, t2),
+        nVec4Set(0.0f, 0.0f, 0.0f, 1.0f)
+    }};
+    return nMat4Transpose(t);
+}
+
+nMat4_t nMat4InverseAffine(const nMat4_t a)
+{
+    const nVec3_t c0 = nVec3Set(a.m[0], a.m[1], a.m[2]);
+    const nVec3_t c1 = nVec3Set(a.m[4], a.m[5], a.m[6]);
+    const nVec3_t c2 = nVec3Set(a.m[8], a.m[9], a.m[10]);
+    const nVec3_t t = nVec3Set(a.m[12], a.m[13], a.m[14]);
+
+    /* The rows of the inverse of the upper 3x3 are the cross products of its
+     * columns, divided by its determinant. */
+    const nVec3_t r0 = nVec3Cross(c1, c2);
+    const nVec3_t r1 = nVec3Cross(c2, c0);
+    const nVec3_t r2 = nVec3Cross(c0, c1);
+    const float invDet = 1.0f / nVec3Dot(c0, r0);
+    const nVec3_t i0 = nVec3Scale(r0, invDet);
+    const nVec3_t i1 = nVec3Scale(r1, invDet);
+    const nVec3_t i2 = nVec3Scale(r2, invDet);
+    return nMat4FromRows(i0, -nVec3Dot(i0, t), i1, -nVec3Dot(i1, t), i2,
+     -nVec3Dot(i2, t));
+}
+
+nMat4_t nMat4InverseRigid(const nMat4_t a)
+{
+    const nVec3_t c0 = nVec3Set(a.m[0], a.m[1], a.m[2]);
+    const nVec3_t c1 = nVec3Set(a.m[4], a.m[5], a.m[6]);
+    const nVec3_t c2 = nVec3Set(a.m[8], a.m[9], a.m[10]);
+    const nVec3_t t = nVec3Set(a.m[12], a.m[13], a.m[14]);
+    return nMat4FromRows(c0, -nVec3Dot(c0, t), c1, -nVec3Dot(c1, t), c2,
+     -nVec3Dot(c2, t));
+}
+
+nMat4_t nMat4LookAt(const nVec3_t eye, const nVec3_t target, const nVec3_t up)
+{
+    const nVec3_t f = nVec3Normalize(nVec3Sub(target, eye));
+    const nVec3_t s = nVec3Normalize(nVec3Cross(f, up));
+    const nVec3_t u = nVec3Cross(s, f);
+    return nMat4FromRows(s, -nVec3Dot(s, eye), u, -nVec3Dot(u, eye),
+     nVec3Scale(f, -1.0f), nVec3Dot(f, eye));
+}
+
+nMat4_t nMat4Perspective(const float fovY, const float aspect,
+ const float nearZ, const float farZ)
+{
+    const float f = 1.0f / tanf(fovY * 0.5f);
+    const float range = 1.0f / (nearZ - farZ);
+    nMat4_t r = {.m = {0.0f}};
+    r.m[0] = f / aspect;
+    r.m[5] = f;
+    r.m[11] = -1.0f;
+#if NMAT4_DEPTH_ZERO_TO_ONE
+    r.m[10] = farZ * range;
+    r.m[14] = farZ * nearZ * range;
+#else
+    r.m[10] = (farZ + nearZ) * range;
+    r.m[14] = 2.0f * farZ * nearZ * range;
+#endif
+    return r;
+}
+
+nMat4_t nMat4Orthographic(const float left, const float right,
+ const float bottom, const float top, const float nearZ, const float farZ)
+{
+    const float width = 1.0f / (right - left);
+    const float height = 1.0f / (top - bottom);
+    const float depth = 1.0f / (farZ - nearZ);
+    nMat4_t r = nMat4Identity();
+    r.m[0] = 2.0f * width;
+    r.m[5] = 2.0f * height;
+    r.m[12] = -(right + left) * width;
+    r.m[13] = -(top + bottom) * height;
+#if NMAT4_DEPTH_ZERO_TO_ONE
+    r.m[10] = -depth;
+    r.m[14] = -nearZ * depth;
+#else
+    r.m[10] = -2.0f * depth;
+    r.m[14] = -(farZ + nearZ) * depth;
+#endif
+    return r;
+}
+
+static void nMat4PointsScalar(const nMat4_t *const a, const nVec3_t *in,
+ nVec3_t *out, const size_t count)
+{
+    const nMat4_t m = *a;
+    for (size_t i = 0; i < count; i++) out[i] = nMat4TransformPoint(m, in[i]);
+}
+
+static void nMat4PointsSoAScalar(const nMat4_t *const a, const nVec3SoA_t in,
+ const nVec3SoA_t out, const size_t count)
+{
+    const float *const m = a->m;
+    for (size_t i = 0; i < count; i++)
+    {
+        const float x = in.x[i], y = in.y[i], z = in.z[i];
+        out.x[i] = (m[0] * x) + (m[4] * y) + (m[8] * z) + m[12];
+        out.y[i] = (m[1] * x) + (m[5] * y) + (m[9] * z) + m[13];
+        out.z[i] = (m[2] * x) + (m[6] * y) + (m[10] * z) + m[14];
+    }
+}
+
+/* Gets the points of a from index i on, for the narrower kernels to finish
+ * what does not fill a register. */
+static nVec3SoA_t nMat4SoAFrom(const nVec3SoA_t a, const size_t i)
+{
+    return (nVec3SoA_t) {.x = a.x + i, .y = a.y + i, .z = a.z + i};
+}
+
+static const nMatKernels_t NMAT_SCALAR = {
+    .points = nMat4PointsScalar,
+    .pointsSoA = nMat4PointsSoAScalar,
+};
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+/* The columns with W cleared, so transformed points keep a W of 0. */
+#define NMAT_COLUMN(a, i) _mm_blend_ps(_mm_loadu_ps((a)->m + ((i) * 4)),\
+ _mm_setzero_ps(), 8)
+
+NSIMD_TARGET("sse4.2")
+static void nMat4PointsSSE42(const nMat4_t *const a, const nVec3_t *in,
+ nVec3_t *out, const size_t count)
+{
+    const __m128 c0 = NMAT_COLUMN(a, 0), c1 = NMAT_COLUMN(a, 1);
+    const __m128 c2 = NMAT_COLUMN(a, 2), c3 = NMAT_COLUMN(a, 3);
+    for (size_t i = 0; i < count; i++)
+    {
+        _mm_prefetch((const char *) (in + i + NMAT4_PREFETCH), _MM_HINT_T0);
+        const __m128 p = _mm_loadu_ps(in[i].v);
+        __m128 r = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_shuffle_ps(p, p, 0x00)));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(p, p, 0x55)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(p, p, 0xaa)));
+        _mm_storeu_ps(out[i].v, r);
+    }
+}
+
+NSIMD_TARGET("sse4.2")
+static void nMat4PointsSoASSE42(const nMat4_t *const a, const nVec3SoA_t in,
+ const nVec3SoA_t out, const size_t count)
+{
+    const float *const m = a->m;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(in.x + i), y = _mm_loadu_ps(in.y + i);
+        const __m128 z = _mm_loadu_ps(in.z + i);
+        for (int row = 0; row < 3; row++)
+        {
+            __m128 r = _mm_add_ps(_mm_set1_ps(m[12 + row]),
+             _mm_mul_ps(_mm_set1_ps(m[row]), x));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[4 + row]), y));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[8 + row]), z));
+            _mm_storeu_ps(((row == 0) ? out.x : (row == 1) ? out.y : out.z) + i,
+             r);
+        }
+    }
+    nMat4PointsSoAScalar(a, nMat4SoAFrom(in, i), nMat4SoAFrom(out, i),
+     count - i);
+}
+
+static const nMatKernels_t NMAT_SSE42 = {
+    .points = nMat4PointsSSE42,
+    .pointsSoA = nMat4PointsSoASSE42,
+};
+
+/* Transforms two points at once, one in each half of the registers, the same
+ * way as nSimdMat4MulAVX2(). */
+NSIMD_TARGET("avx2,fma")
+static void nMat4PointsAVX2(const nMat4_t *const a, const nVec3_t *in,
+ nVec3_t *out, const size_t count)
+{
+    const __m128 a0 = NMAT_COLUMN(a, 0), a1 = NMAT_COLUMN(a, 1);
+    const __m128 a2 = NMAT_COLUMN(a, 2), a3 = NMAT_COLUMN(a, 3);
+    const __m256 c0 = _mm256_set_m128(a0, a0), c1 = _mm256_set_m128(a1, a1);
+    const __m256 c2 = _mm256_set_m128(a2, a2), c3 = _mm256_set_m128(a3, a3);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_prefetch((const char *) (in + i + NMAT4_PREFETCH), _MM_HINT_T0);
+        _mm_prefetch((const char *) (in + i + NMAT4_PREFETCH + 2),
+         _MM_HINT_T0);
+        const __m256 p01 = _mm256_loadu_ps(in[i].v);
+        const __m256 p23 = _mm256_loadu_ps(in[i + 2].v);
+        __m256 r01 = _mm256_fmadd_ps(c0, _mm256_permute_ps(p01, 0x00), c3);
+        __m256 r23 = _mm256_fmadd_ps(c0, _mm256_permute_ps(p23, 0x00), c3);
+        r01 = _mm256_fmadd_ps(c1, _mm256_permute_ps(p01, 0x55), r01);
+        r23 = _mm256_fmadd_ps(c1, _mm256_permute_ps(p23, 0x55), r23);
+        r01 = _mm256_fmadd_ps(c2, _mm256_permute_ps(p01, 0xaa), r01);
+        r23 = _mm256_fmadd_ps(c2, _mm256_permute_ps(p23, 0xaa), r23);
+        _mm256_storeu_ps(out[i].v, r01);
+        _mm256_storeu_ps(out[i + 2].v, r23);
+    }
+    nMat4PointsSSE42(a, in + i, out + i, count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nMat4PointsSoAAVX2(const nMat4_t *const a, const nVec3SoA_t in,
+ const nVec3SoA_t out, const size_t count)
+{
+    const float *const m = a->m;
+    float *const dst[3] = {out.x, out.y, out.z};
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(in.x + i);
+        const __m256 y = _mm256_loadu_ps(in.y + i);
+        const __m256 z = _mm256_loadu_ps(in.z + i);
+        for (int row = 0; row < 3; row++)
+        {
+            __m256 r = _mm256_fmadd_ps(_mm256_set1_ps(m[row]), x,
+             _mm256_set1_ps(m[12 + row]));
+            r = _mm256_fmadd_ps(_mm256_set1_ps(m[4 + row]), y, r);
+            r = _mm256_fmadd_ps(_mm256_set1_ps(m[8 + row]), z, r);
+            _mm256_storeu_ps(dst[row] + i, r);
+        }
+    }
+    nMat4PointsSoASSE42(a, nMat4SoAFrom(in, i), nMat4SoAFrom(out, i),
+     count - i);
+}
+
+static const nMatKernels_t NMAT_AVX2 = {
+    .points = nMat4PointsAVX2,
+    .pointsSoA = nMat4PointsSoAAVX2,
+};
+
+/* Transforms four points at once, one in each quarter of the registers. */
+NSIMD_TARGET("avx512f")
+static void nMat4PointsAVX512(const nMat4_t *const a, const nVec3_t *in,
+ nVec3_t *out, const size_t count)
+{
+    const __m512 c0 = _mm512_broadcast_f32x4(NMAT_COLUMN(a, 0));
+    const __m512 c1 = _mm512_broadcast_f32x4(NMAT_COLUMN(a, 1));
+    const __m512 c2 = _mm512_broadcast_f32x4(NMAT_COLUMN(a, 2));
+    const __m512 c3 = _mm512_broadcast_f32x4(NMAT_COLUMN(a, 3));
+    for (size_t i = 0; i < count; i += 4)
+    {
+        _mm_prefetch((const char *) (in + i + NMAT4_PREFETCH), _MM_HINT_T0);
+        const __mmask16 mask = (count - i >= 4) ? 0xffff :
+         (__mmask16) ((1U << ((count - i) * 4)) - 1);
+        const __m512 p = _mm512_maskz_loadu_ps(mask, in[i].v);
+        __m512 r = _mm512_fmadd_ps(c0, _mm512_permute_ps(p, 0x00), c3);
+        r = _mm512_fmadd_ps(c1, _mm512_permute_ps(p, 0x55), r);
+        r = _mm512_fmadd_ps(c2, _mm512_permute_ps(p, 0xaa), r);
+        _mm512_mask_storeu_ps(out[i].v, mask, r);
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nMat4PointsSoAAVX512(const nMat4_t *const a, const nVec3SoA_t in,
+ const nVec3SoA_t out, const size_t count)
+{
+    const float *const m = a->m;
+    float *const dst[3] = {out.x, out.y, out.z};
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 mask = (count - i >= 16) ? 0xffff :
+         (__mmask16) ((1U << (count - i)) - 1);
+        const __m512 x = _mm512_maskz_loadu_ps(mask, in.x + i);
+        const __m512 y = _mm512_maskz_loadu_ps(mask, in.y + i);
+        const __m512 z = _mm512_maskz_loadu_ps(mask, in.z + i);
+        for (int row = 0; row < 3; row++)
+        {
+            __m512 r = _mm512_fmadd_ps(_mm512_set1_ps(m[row]), x,
+             _mm512_set1_ps(m[12 + row]));
+            r = _mm512_fmadd_ps(_mm512_set1_ps(m[4 + row]), y, r);
+            r = _mm512_fmadd_ps(_mm512_set1_ps(m[8 + row]), z, r);
+            _mm512_mask_storeu_ps(dst[row] + i, mask, r);
+        }
+    }
+}
+
+static const nMatKernels_t NMAT_AVX512 = {
+    .points = nMat4PointsAVX512,
+    .pointsSoA = nMat4PointsSoAAVX512,
+};
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+static void nMat4PointsNEON(const nMat4_t *const a, const nVec3_t *in,
+ nVec3_t *out, const size_t count)
+{
+    const float32x4_t c0 = vsetq_lane_f32(0.0f, vld1q_f32(a->m), 3);
+    const float32x4_t c1 = vsetq_lane_f32(0.0f, vld1q_f32(a->m + 4), 3);
+    const float32x4_t c2 = vsetq_lane_f32(0.0f, vld1q_f32(a->m + 8), 3);
+    const float32x4_t c3 = vsetq_lane_f32(0.0f, vld1q_f32(a->m + 12), 3);
+    for (size_t i = 0; i < count; i++)
+    {
+        __builtin_prefetch(in + i + NMAT4_PREFETCH);
+        const float32x4_t p = vld1q_f32(in[i].v);
+        float32x4_t r = vfmaq_laneq_f32(c3, c0, p, 0);
+        r = vfmaq_laneq_f32(r, c1, p, 1);
+        r = vfmaq_laneq_f32(r, c2, p, 2);
+        vst1q_f32(out[i].v, r);
+    }
+}
+
+static void nMat4PointsSoANEON(const nMat4_t *const a, const nVec3SoA_t in,
+ const nVec3SoA_t out, const size_t count)
+{
+    const float *const m = a->m;
+    float *const dst[3] = {out.x, out.y, out.z};
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t x = vld1q_f32(in.x + i), y = vld1q_f32(in.y + i);
+        const float32x4_t z = vld1q_f32(in.z + i);
+        for (int row = 0; row < 3; row++)
+        {
+            float32x4_t r = vfmaq_n_f32(vdupq_n_f32(m[12 + row]), x, m[row]);
+            r = vfmaq_n_f32(r, y, m[4 + row]);
+            r = vfmaq_n_f32(r, z, m[8 + row]);
+            vst1q_f32(dst[row] + i, r);
+        }
+    }
+    nMat4PointsSoAScalar(a, nMat4SoAFrom(in, i), nMat4SoAFrom(out, i),
+     count - i);
+}
+
+static const nMatKernels_t NMAT_NEON = {
+    .points = nMat4PointsNEON,
+    .pointsSoA = nMat4PointsSoANEON,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(), which has already
+ * checked that the CPU supports it. */
+static const nMatKernels_t *nMatKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NMAT_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NMAT_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NMAT_SSE42;
+        default:
+            return &NMAT_SCALAR;
+    }
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    return (NSIMD.level >= NSIMD_LEVEL_NEON) ? &NMAT_NEON : &NMAT_SCALAR;
+#else
+    return &NMAT_SCALAR;
+#endif
+}
+
+void nMat4TransformPoints(const nMat4_t *const a, const nVec3_t *in,
+ nVec3_t *out, const size_t count)
+{
+    nMatKernels()->points(a, in, out, count);
+}
+
+void nMat4TransformPointsSoA(const nMat4_t *const a, const nVec3SoA_t in,
+ const nVec3SoA_t out, const size_t count)
+{
+    nMatKernels()->pointsSoA(a, in, out, count);
+}
+
+// Matrices.c
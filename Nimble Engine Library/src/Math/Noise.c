@@ -0,0 +1,1161 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Noise.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/Noise.h"
+
+/**
+ * @file Noise.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines SIMD gradient and simplex noise.
+ */
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/CPUInfo.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Simd.h"
+#include "../../include/Nimble/System/Threads.h"
+#include "../../include/Nimble/System/Time.h"
+
+#include <string.h>
+
+#define NNOISE_LANES 16 /**< The number of samples evaluated at once. */
+#define NNOISE_HASH_X 0x1b873593U /**< The odd multiplier of the X coordinate of a lattice point in its hash. */
+#define NNOISE_HASH_Y 0x19088711U /**< The multiplier of the Y coordinate. */
+#define NNOISE_HASH_Z 0x5bd1e995U /**< The multiplier of the Z coordinate. */
+#define NNOISE_HASH_W 0xcc9e2d51U /**< The multiplier of the W coordinate. */
+#define NNOISE_OCTAVE_SEED 0x9e3779b9U /**< Added to the seed for each octave. */
+#define NNOISE_WARP_SEED 0x85ebca6bU /**< Added to the seed for each warp axis. */
+#define NNOISE_ROWS_PER_TAKE 4 /**< The number of grid rows a thread takes at once. */
+#define NNOISE_SAMPLES_PER_THREAD 16384 /**< The fewest samples worth starting a thread for. */
+#define NNOISE_MAX_THREADS 64 /**< The most threads that fill one grid. */
+#define NNOISE_TILE_NONE UINT32_MAX /**< The index of no tile. */
+#define NNOISE_TILE_WAIT 20000 /**< The nanoseconds to sleep while another thread generates a tile. */
+
+#define NNOISE_TILE_FREE       0 /**< The tile holds no samples. */
+#define NNOISE_TILE_GENERATING 1 /**< The tile is being generated by the thread that missed it. */
+#define NNOISE_TILE_READY      2 /**< The samples of the tile can be read. */
+
+/* Scales each basis to about -1 to 1, measured over many samples. */
+static const float NNOISE_GRADIENT_SCALE[5] = {0.0f, 0.0f, 0.66f, 0.98f, 0.85f};
+static const float NNOISE_SIMPLEX_SCALE[5] = {0.0f, 0.0f, 45.0f, 76.0f, 62.0f};
+
+/* The skew from space to the simplex lattice, (sqrt(n + 1) - 1) / n, and
+ * the unskew back, (1 - 1 / sqrt(n + 1)) / n. */
+static const float NNOISE_SKEW[5] = {0.0f, 0.0f, 0.36602540f, 0.33333333f,
+ 0.30901699f};
+static const float NNOISE_UNSKEW[5] = {0.0f, 0.0f, 0.21132487f, 0.16666667f,
+ 0.13819660f};
+
+/* The noise is written once with the vector extensions of the compiler on 16
+ * lanes, and compiled for each SIMD level by inlining it into functions
+ * targeting that level. AVX-512 holds the lanes in one register, AVX2 in two,
+ * and SSE and NEON in four. */
+typedef float nNoiseVec_t __attribute__((vector_size(64)));
+typedef int32_t nNoiseInt_t __attribute__((vector_size(64)));
+typedef uint32_t nNoiseUint_t __attribute__((vector_size(64)));
+
+#define NNOISE_BODY static inline __attribute__((always_inline)) /**< Inlined into the function of each level. */
+
+/* The bodies are always inlined, so the ABI for passing vectors wider than
+ * the baseline registers that GCC warns about is never used. GCC reports it
+ * at the end of the file, so it is ignored for the rest of the file. */
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/**
+ * @brief The function of one level that samples the basis of a noise.
+ */
+typedef void (*nNoiseBase_t)(nNoiseVec_t *dst, const nNoise_t *const noise,
+ const uint32_t seed, const nNoiseVec_t *const p);
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nNoiseKernels {
+    void (*sample)(float *dst, const nNoise_t *const noise,
+     const nVec4SoA_t points, const size_t count);
+    void (*row)(float *dst, const nNoise_t *const noise, const int32_t x,
+     const float step, const float y, const float z, const float w,
+     const size_t count);
+} nNoiseKernels_t;
+
+/* GCC splits comparisons of vectors wider than the registers into scalar
+ * code, so masks are made by shifting sign bits instead. */
+
+/* Gets a mask of the lanes whose sign bit is set. */
+NNOISE_BODY nNoiseInt_t nNoiseNegative(const nNoiseVec_t a)
+{
+    return (nNoiseInt_t) a >> 31;
+}
+
+/* Gets a mask of the lanes below b, for small integers. */
+NNOISE_BODY nNoiseInt_t nNoiseBelow(const nNoiseInt_t a, const int32_t b)
+{
+    return (a - b) >> 31;
+}
+
+/* Selects a where the mask is set and b elsewhere. */
+NNOISE_BODY nNoiseVec_t nNoiseSelect(const nNoiseInt_t mask,
+ const nNoiseVec_t a, const nNoiseVec_t b)
+{
+    return (nNoiseVec_t) ((mask & (nNoiseInt_t) a) | (~mask & (nNoiseInt_t) b));
+}
+
+/* Negates the lanes of a where the bit of h is set. */
+NNOISE_BODY nNoiseVec_t nNoiseFlip(const nNoiseVec_t a, const nNoiseUint_t h,
+ const int bit)
+{
+    return (nNoiseVec_t) ((nNoiseUint_t) a ^ ((h >> bit) << 31));
+}
+
+NNOISE_BODY nNoiseInt_t nNoiseFloor(const nNoiseVec_t a,
+ nNoiseVec_t *const frac)
+{
+    /* Conversion truncates, which is one too high for negative fractions. */
+    nNoiseInt_t i = __builtin_convertvector(a, nNoiseInt_t);
+    i += nNoiseNegative(a - __builtin_convertvector(i, nNoiseVec_t));
+    *frac = a - __builtin_convertvector(i, nNoiseVec_t);
+    return i;
+}
+
+/* 6t^5 - 15t^4 + 10t^3, which has no change in slope or curvature at the
+ * lattice. */
+NNOISE_BODY nNoiseVec_t nNoiseFade(const nNoiseVec_t t)
+{
+    return t * t * t * ((t * ((t * 6.0f) - 15.0f)) + 10.0f);
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseLerp(const nNoiseVec_t t, const nNoiseVec_t a,
+ const nNoiseVec_t b)
+{
+    return a + (t * (b - a));
+}
+
+/* Gets 1 where the mask is set and 0 elsewhere. */
+NNOISE_BODY nNoiseVec_t nNoiseOne(const nNoiseInt_t mask)
+{
+    return (nNoiseVec_t) (mask & (nNoiseInt_t) ((nNoiseVec_t) {0} + 1.0f));
+}
+
+/* Gets the lattice coordinate of the cell of each lane, multiplied by the
+ * multiplier of its axis for the hash. The corner past it adds it again. */
+NNOISE_BODY nNoiseUint_t nNoiseCell(const nNoiseVec_t a,
+ const uint32_t multiplier, nNoiseVec_t *const frac)
+{
+    return (nNoiseUint_t) nNoiseFloor(a, frac) * multiplier;
+}
+
+/* Hashes a lattice point from the xor of its coordinates times their
+ * multipliers, finishing with the mix of MurmurHash3 so that every bit
+ * depends on every coordinate and the seed. */
+NNOISE_BODY nNoiseUint_t nNoiseHash(nNoiseUint_t h, const uint32_t seed)
+{
+    h ^= seed;
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    return h ^ (h >> 16);
+}
+
+/* Dots the offset from a lattice point with one of 8 gradients of its hash. */
+NNOISE_BODY nNoiseVec_t nNoiseGrad2(const nNoiseUint_t h, const nNoiseVec_t x,
+ const nNoiseVec_t y)
+{
+    const nNoiseInt_t low = nNoiseBelow((nNoiseInt_t) (h & 4), 1);
+    const nNoiseVec_t u = nNoiseSelect(low, x, y), v = nNoiseSelect(low, y, x);
+    return nNoiseFlip(u, h, 0) + nNoiseFlip(v + v, h, 1);
+}
+
+/* Dots the offset with one of the 12 edges of a cube. */
+NNOISE_BODY nNoiseVec_t nNoiseGrad3(const nNoiseUint_t h, const nNoiseVec_t x,
+ const nNoiseVec_t y, const nNoiseVec_t z)
+{
+    const nNoiseInt_t g = (nNoiseInt_t) (h & 15);
+    const nNoiseVec_t u = nNoiseSelect(nNoiseBelow(g, 8), x, y);
+    const nNoiseVec_t v = nNoiseSelect(nNoiseBelow(g, 4), y,
+     nNoiseSelect(nNoiseBelow((g | 2) ^ 14, 1), x, z));
+    return nNoiseFlip(u, h, 0) + nNoiseFlip(v, h, 1);
+}
+
+/* Dots the offset with one of the 32 edges of a tesseract. */
+NNOISE_BODY nNoiseVec_t nNoiseGrad4(const nNoiseUint_t h, const nNoiseVec_t x,
+ const nNoiseVec_t y, const nNoiseVec_t z, const nNoiseVec_t w)
+{
+    const nNoiseInt_t g = (nNoiseInt_t) (h & 31);
+    const nNoiseVec_t u = nNoiseSelect(nNoiseBelow(g, 24), x, y);
+    const nNoiseVec_t v = nNoiseSelect(nNoiseBelow(g, 16), y, z);
+    const nNoiseVec_t t = nNoiseSelect(nNoiseBelow(g, 8), z, w);
+    return nNoiseFlip(u, h, 0) + nNoiseFlip(v, h, 1) + nNoiseFlip(t, h, 2);
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseGradient2(const uint32_t seed,
+ const nNoiseVec_t *const p)
+{
+    nNoiseVec_t fx, fy;
+    const nNoiseUint_t hx = nNoiseCell(p[0], NNOISE_HASH_X, &fx);
+    const nNoiseUint_t hy = nNoiseCell(p[1], NNOISE_HASH_Y, &fy);
+    const nNoiseUint_t hx1 = hx + NNOISE_HASH_X, hy1 = hy + NNOISE_HASH_Y;
+    const nNoiseVec_t gx = fx - 1.0f, gy = fy - 1.0f, u = nNoiseFade(fx);
+
+    const nNoiseVec_t a = nNoiseLerp(u,
+     nNoiseGrad2(nNoiseHash(hx ^ hy, seed), fx, fy),
+     nNoiseGrad2(nNoiseHash(hx1 ^ hy, seed), gx, fy));
+    const nNoiseVec_t b = nNoiseLerp(u,
+     nNoiseGrad2(nNoiseHash(hx ^ hy1, seed), fx, gy),
+     nNoiseGrad2(nNoiseHash(hx1 ^ hy1, seed), gx, gy));
+    return nNoiseLerp(nNoiseFade(fy), a, b) * NNOISE_GRADIENT_SCALE[2];
+}
+
+/* Interpolates along X between the two corners of an edge of the cube, whose
+ * hashes share the rest of their coordinates. */
+NNOISE_BODY nNoiseVec_t nNoiseEdge3(const uint32_t seed, const nNoiseUint_t hx,
+ const nNoiseUint_t rest, const nNoiseVec_t fx, const nNoiseVec_t u,
+ const nNoiseVec_t y, const nNoiseVec_t z)
+{
+    return nNoiseLerp(u, nNoiseGrad3(nNoiseHash(hx ^ rest, seed), fx, y, z),
+     nNoiseGrad3(nNoiseHash((hx + NNOISE_HASH_X) ^ rest, seed), fx - 1.0f,
+     y, z));
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseGradient3(const uint32_t seed,
+ const nNoiseVec_t *const p)
+{
+    nNoiseVec_t fx, fy, fz;
+    const nNoiseUint_t hx = nNoiseCell(p[0], NNOISE_HASH_X, &fx);
+    const nNoiseUint_t hy = nNoiseCell(p[1], NNOISE_HASH_Y, &fy);
+    const nNoiseUint_t hz = nNoiseCell(p[2], NNOISE_HASH_Z, &fz);
+    const nNoiseUint_t hy1 = hy + NNOISE_HASH_Y, hz1 = hz + NNOISE_HASH_Z;
+    const nNoiseVec_t gy = fy - 1.0f, gz = fz - 1.0f;
+    const nNoiseVec_t u = nNoiseFade(fx), v = nNoiseFade(fy);
+
+    const nNoiseVec_t a = nNoiseLerp(v,
+     nNoiseEdge3(seed, hx, hy ^ hz, fx, u, fy, fz),
+     nNoiseEdge3(seed, hx, hy1 ^ hz, fx, u, gy, fz));
+    const nNoiseVec_t b = nNoiseLerp(v,
+     nNoiseEdge3(seed, hx, hy ^ hz1, fx, u, fy, gz),
+     nNoiseEdge3(seed, hx, hy1 ^ hz1, fx, u, gy, gz));
+    return nNoiseLerp(nNoiseFade(fz), a, b) * NNOISE_GRADIENT_SCALE[3];
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseEdge4(const uint32_t seed, const nNoiseUint_t hx,
+ const nNoiseUint_t rest, const nNoiseVec_t fx, const nNoiseVec_t u,
+ const nNoiseVec_t y, const nNoiseVec_t z, const nNoiseVec_t w)
+{
+    return nNoiseLerp(u, nNoiseGrad4(nNoiseHash(hx ^ rest, seed), fx, y, z, w),
+     nNoiseGrad4(nNoiseHash((hx + NNOISE_HASH_X) ^ rest, seed), fx - 1.0f,
+     y, z, w));
+}
+
+/* Interpolates along Y and Z between the edges of one cube of the tesseract,
+ * whose hashes share their W coordinate. */
+NNOISE_BODY nNoiseVec_t nNoiseCube4(const uint32_t seed, const nNoiseUint_t hx,
+ const nNoiseUint_t hy, const nNoiseUint_t hz, const nNoiseUint_t hw,
+ const nNoiseVec_t fx, const nNoiseVec_t fy, const nNoiseVec_t fz,
+ const nNoiseVec_t w, const nNoiseVec_t u, const nNoiseVec_t v,
+ const nNoiseVec_t t)
+{
+    const nNoiseUint_t hy1 = hy + NNOISE_HASH_Y, hz1 = hz + NNOISE_HASH_Z;
+    const nNoiseVec_t gy = fy - 1.0f, gz = fz - 1.0f;
+    const nNoiseVec_t a = nNoiseLerp(v,
+     nNoiseEdge4(seed, hx, hy ^ hz ^ hw, fx, u, fy, fz, w),
+     nNoiseEdge4(seed, hx, hy1 ^ hz ^ hw, fx, u, gy, fz, w));
+    const nNoiseVec_t b = nNoiseLerp(v,
+     nNoiseEdge4(seed, hx, hy ^ hz1 ^ hw, fx, u, fy, gz, w),
+     nNoiseEdge4(seed, hx, hy1 ^ hz1 ^ hw, fx, u, gy, gz, w));
+    return nNoiseLerp(t, a, b);
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseGradient4(const uint32_t seed,
+ const nNoiseVec_t *const p)
+{
+    nNoiseVec_t fx, fy, fz, fw;
+    const nNoiseUint_t hx = nNoiseCell(p[0], NNOISE_HASH_X, &fx);
+    const nNoiseUint_t hy = nNoiseCell(p[1], NNOISE_HASH_Y, &fy);
+    const nNoiseUint_t hz = nNoiseCell(p[2], NNOISE_HASH_Z, &fz);
+    const nNoiseUint_t hw = nNoiseCell(p[3], NNOISE_HASH_W, &fw);
+    const nNoiseVec_t u = nNoiseFade(fx), v = nNoiseFade(fy);
+    const nNoiseVec_t t = nNoiseFade(fz);
+
+    return nNoiseLerp(nNoiseFade(fw),
+     nNoiseCube4(seed, hx, hy, hz, hw, fx, fy, fz, fw, u, v, t),
+     nNoiseCube4(seed, hx, hy, hz, hw + NNOISE_HASH_W, fx, fy, fz,
+     fw - 1.0f, u, v, t)) * NNOISE_GRADIENT_SCALE[4];
+}
+
+/* Gets (0.5 - r^2)^4, the falloff of a corner of a simplex, which reaches zero
+ * before the corners of the neighbouring simplices. */
+NNOISE_BODY nNoiseVec_t nNoiseFalloff(const nNoiseVec_t r2)
+{
+    nNoiseVec_t t = 0.5f - r2;
+    t = nNoiseSelect(nNoiseNegative(t), (nNoiseVec_t) {0}, t);
+    t *= t;
+    return t * t;
+}
+
+/* The simplex steps along the axes from the largest offset in its cell to the
+ * smallest, so each axis is ranked by how many others it exceeds, with ties
+ * to the lower axis. Corner k then steps along the axes ranked at least
+ * dims - k. */
+
+NNOISE_BODY nNoiseVec_t nNoiseSimplex2(const uint32_t seed,
+ const nNoiseVec_t *const p)
+{
+    /* Skews the point onto the lattice of simplices to find its cell. */
+    const nNoiseVec_t skew = (p[0] + p[1]) * NNOISE_SKEW[2];
+    nNoiseVec_t frac;
+    const nNoiseInt_t cx = nNoiseFloor(p[0] + skew, &frac);
+    const nNoiseInt_t cy = nNoiseFloor(p[1] + skew, &frac);
+    const nNoiseVec_t unskew = __builtin_convertvector(cx + cy, nNoiseVec_t) *
+     NNOISE_UNSKEW[2];
+    const nNoiseVec_t x0 = p[0] - (__builtin_convertvector(cx, nNoiseVec_t) -
+     unskew);
+    const nNoiseVec_t y0 = p[1] - (__builtin_convertvector(cy, nNoiseVec_t) -
+     unskew);
+    const nNoiseUint_t hx = (nNoiseUint_t) cx * NNOISE_HASH_X;
+    const nNoiseUint_t hy = (nNoiseUint_t) cy * NNOISE_HASH_Y;
+
+    const nNoiseInt_t stepX = ~nNoiseNegative(x0 - y0), stepY = ~stepX;
+    const nNoiseVec_t x1 = x0 - nNoiseOne(stepX) + NNOISE_UNSKEW[2];
+    const nNoiseVec_t y1 = y0 - nNoiseOne(stepY) + NNOISE_UNSKEW[2];
+    const nNoiseVec_t x2 = x0 - 1.0f + (2.0f * NNOISE_UNSKEW[2]);
+    const nNoiseVec_t y2 = y0 - 1.0f + (2.0f * NNOISE_UNSKEW[2]);
+
+    const nNoiseVec_t n =
+     (nNoiseFalloff((x0 * x0) + (y0 * y0)) *
+      nNoiseGrad2(nNoiseHash(hx ^ hy, seed), x0, y0)) +
+     (nNoiseFalloff((x1 * x1) + (y1 * y1)) *
+      nNoiseGrad2(nNoiseHash((hx + (NNOISE_HASH_X & (nNoiseUint_t) stepX)) ^
+      (hy + (NNOISE_HASH_Y & (nNoiseUint_t) stepY)), seed), x1, y1)) +
+     (nNoiseFalloff((x2 * x2) + (y2 * y2)) *
+      nNoiseGrad2(nNoiseHash((hx + NNOISE_HASH_X) ^ (hy + NNOISE_HASH_Y),
+      seed), x2, y2));
+    return n * NNOISE_SIMPLEX_SCALE[2];
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseCorner3(const uint32_t seed,
+ const nNoiseUint_t hx, const nNoiseUint_t hy, const nNoiseUint_t hz,
+ const nNoiseVec_t x, const nNoiseVec_t y, const nNoiseVec_t z)
+{
+    return nNoiseFalloff((x * x) + (y * y) + (z * z)) *
+     nNoiseGrad3(nNoiseHash(hx ^ hy ^ hz, seed), x, y, z);
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseSimplex3(const uint32_t seed,
+ const nNoiseVec_t *const p)
+{
+    const nNoiseVec_t skew = (p[0] + p[1] + p[2]) * NNOISE_SKEW[3];
+    nNoiseVec_t frac;
+    const nNoiseInt_t cx = nNoiseFloor(p[0] + skew, &frac);
+    const nNoiseInt_t cy = nNoiseFloor(p[1] + skew, &frac);
+    const nNoiseInt_t cz = nNoiseFloor(p[2] + skew, &frac);
+    const nNoiseVec_t unskew = __builtin_convertvector(cx + cy + cz,
+     nNoiseVec_t) * NNOISE_UNSKEW[3];
+    const nNoiseVec_t x0 = p[0] - (__builtin_convertvector(cx, nNoiseVec_t) -
+     unskew);
+    const nNoiseVec_t y0 = p[1] - (__builtin_convertvector(cy, nNoiseVec_t) -
+     unskew);
+    const nNoiseVec_t z0 = p[2] - (__builtin_convertvector(cz, nNoiseVec_t) -
+     unskew);
+    const nNoiseUint_t hx = (nNoiseUint_t) cx * NNOISE_HASH_X;
+    const nNoiseUint_t hy = (nNoiseUint_t) cy * NNOISE_HASH_Y;
+    const nNoiseUint_t hz = (nNoiseUint_t) cz * NNOISE_HASH_Z;
+
+    const nNoiseInt_t xy = ~nNoiseNegative(x0 - y0);
+    const nNoiseInt_t xz = ~nNoiseNegative(x0 - z0);
+    const nNoiseInt_t yz = ~nNoiseNegative(y0 - z0);
+    const nNoiseInt_t rx = -(xy + xz), ry = -(~xy + yz), rz = -(~xz + ~yz);
+
+    const nNoiseInt_t sx1 = ~nNoiseBelow(rx, 2), sx2 = ~nNoiseBelow(rx, 1);
+    const nNoiseInt_t sy1 = ~nNoiseBelow(ry, 2), sy2 = ~nNoiseBelow(ry, 1);
+    const nNoiseInt_t sz1 = ~nNoiseBelow(rz, 2), sz2 = ~nNoiseBelow(rz, 1);
+    const float g = NNOISE_UNSKEW[3];
+
+    const nNoiseVec_t n =
+     nNoiseCorner3(seed, hx, hy, hz, x0, y0, z0) +
+     nNoiseCorner3(seed, hx + (NNOISE_HASH_X & (nNoiseUint_t) sx1),
+      hy + (NNOISE_HASH_Y & (nNoiseUint_t) sy1),
+      hz + (NNOISE_HASH_Z & (nNoiseUint_t) sz1),
+      x0 - nNoiseOne(sx1) + g, y0 - nNoiseOne(sy1) + g,
+      z0 - nNoiseOne(sz1) + g) +
+     nNoiseCorner3(seed, hx + (NNOISE_HASH_X & (nNoiseUint_t) sx2),
+      hy + (NNOISE_HASH_Y & (nNoiseUint_t) sy2),
+      hz + (NNOISE_HASH_Z & (nNoiseUint_t) sz2),
+      x0 - nNoiseOne(sx2) + (2.0f * g), y0 - nNoiseOne(sy2) + (2.0f * g),
+      z0 - nNoiseOne(sz2) + (2.0f * g)) +
+     nNoiseCorner3(seed, hx + NNOISE_HASH_X, hy + NNOISE_HASH_Y,
+      hz + NNOISE_HASH_Z, x0 - 1.0f + (3.0f * g), y0 - 1.0f + (3.0f * g),
+      z0 - 1.0f + (3.0f * g));
+    return n * NNOISE_SIMPLEX_SCALE[3];
+}
+
+/* Gets the corner of a 4D simplex that has stepped along the axes ranked at
+ * least 4 - k. */
+NNOISE_BODY nNoiseVec_t nNoiseCorner4(const uint32_t seed, const int k,
+ const nNoiseUint_t hx, const nNoiseUint_t hy, const nNoiseUint_t hz,
+ const nNoiseUint_t hw, const nNoiseInt_t rx, const nNoiseInt_t ry,
+ const nNoiseInt_t rz, const nNoiseInt_t rw, const nNoiseVec_t x0,
+ const nNoiseVec_t y0, const nNoiseVec_t z0, const nNoiseVec_t w0)
+{
+    const float g = (float) k * NNOISE_UNSKEW[4];
+    const nNoiseInt_t sx = ~nNoiseBelow(rx, 4 - k);
+    const nNoiseInt_t sy = ~nNoiseBelow(ry, 4 - k);
+    const nNoiseInt_t sz = ~nNoiseBelow(rz, 4 - k);
+    const nNoiseInt_t sw = ~nNoiseBelow(rw, 4 - k);
+    const nNoiseVec_t x = x0 - nNoiseOne(sx) + g, y = y0 - nNoiseOne(sy) + g;
+    const nNoiseVec_t z = z0 - nNoiseOne(sz) + g, w = w0 - nNoiseOne(sw) + g;
+    const nNoiseUint_t h = (hx + (NNOISE_HASH_X & (nNoiseUint_t) sx)) ^
+     (hy + (NNOISE_HASH_Y & (nNoiseUint_t) sy)) ^
+     (hz + (NNOISE_HASH_Z & (nNoiseUint_t) sz)) ^
+     (hw + (NNOISE_HASH_W & (nNoiseUint_t) sw));
+    return nNoiseFalloff((x * x) + (y * y) + (z * z) + (w * w)) *
+     nNoiseGrad4(nNoiseHash(h, seed), x, y, z, w);
+}
+
+NNOISE_BODY nNoiseVec_t nNoiseSimplex4(const uint32_t seed,
+ const nNoiseVec_t *const p)
+{
+    const nNoiseVec_t skew = (p[0] + p[1] + p[2] + p[3]) * NNOISE_SKEW[4];
+    nNoiseVec_t frac;
+    const nNoiseInt_t cx = nNoiseFloor(p[0] + skew, &frac);
+    const nNoiseInt_t cy = nNoiseFloor(p[1] + skew, &frac);
+    const nNoiseInt_t cz = nNoiseFloor(p[2] + skew, &frac);
+    const nNoiseInt_t cw = nNoiseFloor(p[3] + skew, &frac);
+    const nNoiseVec_t unskew = __builtin_convertvector(cx + cy + cz + cw,
+     nNoiseVec_t) * NNOISE_UNSKEW[4];
+    const nNoiseVec_t x0 = p[0] - (__builtin_convertvector(cx, nNoiseVec_t) -
+     unskew);
+    const nNoiseVec_t y0 = p[1] - (__builtin_convertvector(cy, nNoiseVec_t) -
+     unskew);
+    const nNoiseVec_t z0 = p[2] - (__builtin_convertvector(cz, nNoiseVec_t) -
+     unskew);
+    const nNoiseVec_t w0 = p[3] - (__builtin_convertvector(cw, nNoiseVec_t) -
+     unskew);
+    const nNoiseUint_t hx = (nNoiseUint_t) cx * NNOISE_HASH_X;
+    const nNoiseUint_t hy = (nNoiseUint_t) cy * NNOISE_HASH_Y;
+    const nNoiseUint_t hz = (nNoiseUint_t) cz * NNOISE_HASH_Z;
+    const nNoiseUint_t hw = (nNoiseUint_t) cw * NNOISE_HASH_W;
+
+    const nNoiseInt_t xy = ~nNoiseNegative(x0 - y0);
+    const nNoiseInt_t xz = ~nNoiseNegative(x0 - z0);
+    const nNoiseInt_t xw = ~nNoiseNegative(x0 - w0);
+    const nNoiseInt_t yz = ~nNoiseNegative(y0 - z0);
+    const nNoiseInt_t yw = ~nNoiseNegative(y0 - w0);
+    const nNoiseInt_t zw = ~nNoiseNegative(z0 - w0);
+    const nNoiseInt_t rx = -(xy + xz + xw), ry = -(~xy + yz + yw);
+    const nNoiseInt_t rz = -(~xz + ~yz + zw), rw = -(~xw + ~yw + ~zw);
+
+    return (nNoiseCorner4(seed, 0, hx, hy, hz, hw, rx, ry, rz, rw, x0, y0, z0,
+     w0) + nNoiseCorner4(seed, 1, hx, hy, hz, hw, rx, ry, rz, rw, x0, y0, z0,
+     w0) + nNoiseCorner4(seed, 2, hx, hy, hz, hw, rx, ry, rz, rw, x0, y0, z0,
+     w0) + nNoiseCorner4(seed, 3, hx, hy, hz, hw, rx, ry, rz, rw, x0, y0, z0,
+     w0) + nNoiseCorner4(seed, 4, hx, hy, hz, hw, rx, ry, rz, rw, x0, y0, z0,
+     w0)) * NNOISE_SIMPLEX_SCALE[4];
+}
+
+NNOISE_BODY void nNoiseBaseBody(nNoiseVec_t *dst, const nNoise_t *const noise,
+ const uint32_t seed, const nNoiseVec_t *const p)
+{
+    switch ((noise->basis * 8) + noise->dimensions)
+    {
+        case (NNOISE_GRADIENT * 8) + 2:
+            *dst = nNoiseGradient2(seed, p);
+            return;
+        case (NNOISE_GRADIENT * 8) + 3:
+            *dst = nNoiseGradient3(seed, p);
+            return;
+        case (NNOISE_GRADIENT * 8) + 4:
+            *dst = nNoiseGradient4(seed, p);
+            return;
+        case (NNOISE_SIMPLEX * 8) + 2:
+            *dst = nNoiseSimplex2(seed, p);
+            return;
+        case (NNOISE_SIMPLEX * 8) + 3:
+            *dst = nNoiseSimplex3(seed, p);
+            return;
+        default:
+            *dst = nNoiseSimplex4(seed, p);
+            return;
+    }
+}
+
+NNOISE_BODY void nNoiseFractalBody(float *dst, const nNoise_t *const noise,
+ nNoiseVec_t *const p, const size_t count, const nNoiseBase_t base)
+{
+    const int dims = noise->dimensions;
+    if (noise->warpAmplitude != 0.0f)
+    {
+        nNoiseVec_t q[4] = {{0}}, offset[4];
+        for (int d = 0; d < dims; d++) q[d] = p[d] * noise->warpFrequency;
+        for (int d = 0; d < dims; d++)
+        {
+            base(&offset[d], noise, noise->seed + ((uint32_t) (d + 1) *
+             NNOISE_WARP_SEED), q);
+        }
+        for (int d = 0; d < dims; d++) p[d] += offset[d] * noise->warpAmplitude;
+    }
+
+    nNoiseVec_t sum = {0};
+    float frequency = noise->frequency, amplitude = 1.0f, total = 0.0f;
+    for (uint32_t o = 0; o < noise->octaves; o++)
+    {
+        nNoiseVec_t q[4] = {{0}}, n;
+        for (int d = 0; d < dims; d++) q[d] = p[d] * frequency;
+        base(&n, noise, noise->seed + (o * NNOISE_OCTAVE_SEED), q);
+        if (noise->fractal == NNOISE_RIDGED)
+        {
+            n = 1.0f - (nNoiseVec_t) ((nNoiseUint_t) n & 0x7fffffffU);
+            n *= n;
+        }
+        sum += n * amplitude;
+        total += amplitude;
+        amplitude *= noise->gain;
+        frequency *= noise->lacunarity;
+    }
+    sum *= 1.0f / total;
+
+    if (count == NNOISE_LANES) memcpy(dst, &sum, sizeof(sum));
+    else memcpy(dst, &sum, count * sizeof(float));
+}
+
+NNOISE_BODY void nNoiseSampleBody(float *dst, const nNoise_t *const noise,
+ const nVec4SoA_t points, const size_t count, const nNoiseBase_t base)
+{
+    const float *const src[4] = {points.x, points.y, points.z, points.w};
+    for (size_t i = 0; i < count; i += NNOISE_LANES)
+    {
+        const size_t n = ((count - i) < NNOISE_LANES) ? count - i :
+         NNOISE_LANES;
+        nNoiseVec_t p[4] = {{0}};
+        for (int d = 0; d < noise->dimensions; d++)
+        {
+            if (n == NNOISE_LANES) memcpy(&p[d], src[d] + i, sizeof(p[d]));
+            else memcpy(&p[d], src[d] + i, n * sizeof(float));
+        }
+        nNoiseFractalBody(dst + i, noise, p, n, base);
+    }
+}
+
+NNOISE_BODY void nNoiseRowBody(float *dst, const nNoise_t *const noise,
+ const int32_t x, const float step, const float y, const float z,
+ const float w, const size_t count, const nNoiseBase_t base)
+{
+    const nNoiseInt_t lanes = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+     14, 15};
+    const nNoiseVec_t zero = {0};
+    for (size_t i = 0; i < count; i += NNOISE_LANES)
+    {
+        const size_t n = ((count - i) < NNOISE_LANES) ? count - i :
+         NNOISE_LANES;
+        nNoiseVec_t p[4] = {
+            __builtin_convertvector(lanes + (x + (int32_t) i), nNoiseVec_t) *
+             step,
+            zero + y,
+            zero + z,
+            zero + w,
+        };
+        nNoiseFractalBody(dst + i, noise, p, n, base);
+    }
+}
+
+static void nNoiseBaseScalar(nNoiseVec_t *dst, const nNoise_t *const noise,
+ const uint32_t seed, const nNoiseVec_t *const p)
+{
+    nNoiseBaseBody(dst, noise, seed, p);
+}
+
+static void nNoiseSampleScalar(float *dst, const nNoise_t *const noise,
+ const nVec4SoA_t points, const size_t count)
+{
+    nNoiseSampleBody(dst, noise, points, count, nNoiseBaseScalar);
+}
+
+static void nNoiseRowScalar(float *dst, const nNoise_t *const noise,
+ const int32_t x, const float step, const float y, const float z,
+ const float w, const size_t count)
+{
+    nNoiseRowBody(dst, noise, x, step, y, z, w, count, nNoiseBaseScalar);
+}
+
+static const nNoiseKernels_t NNOISE_SCALAR = {
+    .sample = nNoiseSampleScalar,
+    .row = nNoiseRowScalar,
+};
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static void nNoiseBaseSSE42(nNoiseVec_t *dst, const nNoise_t *const noise,
+ const uint32_t seed, const nNoiseVec_t *const p)
+{
+    nNoiseBaseBody(dst, noise, seed, p);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nNoiseSampleSSE42(float *dst, const nNoise_t *const noise,
+ const nVec4SoA_t points, const size_t count)
+{
+    nNoiseSampleBody(dst, noise, points, count, nNoiseBaseSSE42);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nNoiseRowSSE42(float *dst, const nNoise_t *const noise,
+ const int32_t x, const float step, const float y, const float z,
+ const float w, const size_t count)
+{
+    nNoiseRowBody(dst, noise, x, step, y, z, w, count, nNoiseBaseSSE42);
+}
+
+static const nNoiseKernels_t NNOISE_SSE42 = {
+    .sample = nNoiseSampleSSE42,
+    .row = nNoiseRowSSE42,
+};
+
+NSIMD_TARGET("avx2,fma")
+static void nNoiseBaseAVX2(nNoiseVec_t *dst, const nNoise_t *const noise,
+ const uint32_t seed, const nNoiseVec_t *const p)
+{
+    nNoiseBaseBody(dst, noise, seed, p);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nNoiseSampleAVX2(float *dst, const nNoise_t *const noise,
+ const nVec4SoA_t points, const size_t count)
+{
+    nNoiseSampleBody(dst, noise, points, count, nNoiseBaseAVX2);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nNoiseRowAVX2(float *dst, const nNoise_t *const noise,
+ const int32_t x, const float step, const float y, const float z,
+ const float w, const size_t count)
+{
+    nNoiseRowBody(dst, noise, x, step, y, z, w, count, nNoiseBaseAVX2);
+}
+
+static const nNoiseKernels_t NNOISE_AVX2 = {
+    .sample = nNoiseSampleAVX2,
+    .row = nNoiseRowAVX2,
+};
+
+NSIMD_TARGET("avx512f")
+static void nNoiseBaseAVX512(nNoiseVec_t *dst, const nNoise_t *const noise,
+ const uint32_t seed, const nNoiseVec_t *const p)
+{
+    nNoiseBaseBody(dst, noise, seed, p);
+}
+
+NSIMD_TARGET("avx512f")
+static void nNoiseSampleAVX512(float *dst, const nNoise_t *const noise,
+ const nVec4SoA_t points, const size_t count)
+{
+    nNoiseSampleBody(dst, noise, points, count, nNoiseBaseAVX512);
+}
+
+NSIMD_TARGET("avx512f")
+static void nNoiseRowAVX512(float *dst, const nNoise_t *const noise,
+ const int32_t x, const float step, const float y, const float z,
+ const float w, const size_t count)
+{
+    nNoiseRowBody(dst, noise, x, step, y, z, w, count, nNoiseBaseAVX512);
+}
+
+static const nNoiseKernels_t NNOISE_AVX512 = {
+    .sample = nNoiseSampleAVX512,
+    .row = nNoiseRowAVX512,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(), which has already
+ * checked that the CPU supports it. NEON is part of ARMv8, so the scalar
+ * kernels already compile to it there. */
+static const nNoiseKernels_t *nNoiseKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NNOISE_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NNOISE_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NNOISE_SSE42;
+        default:
+            return &NNOISE_SCALAR;
+    }
+#else
+    return &NNOISE_SCALAR;
+#endif
+}
+
+static int nNoiseValid(const nNoise_t *const noise)
+{
+    return ((noise->basis == NNOISE_GRADIENT) ||
+     (noise->basis == NNOISE_SIMPLEX)) && (noise->dimensions >= 2) &&
+     (noise->dimensions <= 4) && ((noise->fractal == NNOISE_FBM) ||
+     (noise->fractal == NNOISE_RIDGED)) && (noise->octaves >= 1) &&
+     (noise->octaves <= NNOISE_MAX_OCTAVES);
+}
+
+int nNoiseSample(float *dst, const nNoise_t *const noise,
+                 const nVec4SoA_t points, const size_t count)
+{
+    if (!dst || !noise) return NERROR_NULL;
+    if (!nNoiseValid(noise)) return NERROR_INV_ARG;
+    const float *const src[4] = {points.x, points.y, points.z, points.w};
+    for (int d = 0; d < noise->dimensions; d++)
+    {
+        if (!src[d]) return NERROR_NULL;
+    }
+
+    nNoiseKernels()->sample(dst, noise, points, count);
+    return NSUCCESS;
+}
+
+/**
+ * @brief A grid being filled by several threads.
+ */
+typedef struct nNoiseJob {
+    float *dst; /**< The samples. */
+    const nNoise_t *noise; /**< The noise to sample. */
+    const nNoiseGrid_t *grid; /**< The grid to fill. */
+    const nNoiseKernels_t *kernels; /**< The kernels of the bound level. */
+    size_t rows; /**< The number of rows in the grid. */
+    size_t next; /**< The next row to take, which is shared by the threads. */
+} nNoiseJob_t;
+
+static void nNoiseFillRows(nNoiseJob_t *const job)
+{
+    const nNoiseGrid_t *const grid = job->grid;
+    for (;;)
+    {
+        const size_t first = __atomic_fetch_add(&job->next,
+         NNOISE_ROWS_PER_TAKE, __ATOMIC_RELAXED);
+        if (first >= job->rows) return;
+
+        const size_t last = ((job->rows - first) < NNOISE_ROWS_PER_TAKE) ?
+         job->rows : first + NNOISE_ROWS_PER_TAKE;
+        for (size_t row = first; row < last; row++)
+        {
+            const int32_t y = grid->origin[1] + (int32_t) (row % grid->size[1]);
+            const int32_t z = grid->origin[2] + (int32_t) (row / grid->size[1]);
+            job->kernels->row(job->dst + (row * grid->size[0]), job->noise,
+             grid->origin[0], grid->step, (float) y * grid->step,
+             (float) z * grid->step, grid->w, grid->size[0]);
+        }
+    }
+}
+
+static nThreadRoutine_t nNoiseWorkerRoutine(void *data)
+{
+    nNoiseFillRows((nNoiseJob_t *) data);
+    return (nThreadRoutine_t) 0;
+}
+
+int nNoiseFillGrid(float *dst, const nNoise_t *const noise,
+                   const nNoiseGrid_t *const grid, uint32_t threads)
+{
+    if (!dst || !noise || !grid) return NERROR_NULL;
+    if (!nNoiseValid(noise)) return NERROR_INV_ARG;
+
+    nNoiseJob_t job = {
+        .dst = dst,
+        .noise = noise,
+        .grid = grid,
+        .kernels = nNoiseKernels(),
+        .rows = (size_t) grid->size[1] * grid->size[2],
+        .next = 0,
+    };
+    const size_t samples = job.rows * grid->size[0];
+    if (!samples) return NSUCCESS;
+
+    if (!threads)
+    {
+        if (!NCPU_DETAILS.logicalCores) nSysGetCPUInfo(NULL);
+        threads = NCPU_DETAILS.logicalCores ? NCPU_DETAILS.logicalCores : 1;
+    }
+    /* Each thread needs enough samples to pay for starting it. */
+    if (threads > samples / NNOISE_SAMPLES_PER_THREAD)
+    {
+        threads = (uint32_t) (samples / NNOISE_SAMPLES_PER_THREAD);
+    }
+    if (threads > job.rows / NNOISE_ROWS_PER_TAKE)
+    {
+        threads = (uint32_t) (job.rows / NNOISE_ROWS_PER_TAKE);
+    }
+    if (threads > NNOISE_MAX_THREADS) threads = NNOISE_MAX_THREADS;
+    if (!threads) threads = 1;
+
+    nThread_t workers[NNOISE_MAX_THREADS - 1];
+    uint32_t started = 0;
+    while ((started < threads - 1) &&
+     !nThreadCreate(&workers[started], nNoiseWorkerRoutine, &job))
+    {
+        started++;
+    }
+    nNoiseFillRows(&job);
+    for (uint32_t i = 0; i < started; i++) nThreadJoin(workers[i], NULL);
+    return NSUCCESS;
+}
+
+/**
+ * @brief The key of a noise tile.
+ *
+ * @note Keys are compared by their bytes, so they are cleared before they are
+ * set, and settings that do not change the samples are cleared too.
+ */
+typedef struct nNoiseTileKey {
+    nNoise_t noise; /**< The settings of the noise. */
+    float step; /**< The distance between neighbouring samples. */
+    float w; /**< The W coordinate of 4D noise. */
+    int32_t tile[3]; /**< The tile coordinate. */
+} nNoiseTileKey_t;
+
+/**
+ * @brief A tile of a noise cache, whose samples are at the same index in the
+ * arena.
+ */
+typedef struct nNoiseTile {
+    nNoiseTileKey_t key; /**< The key of the samples. */
+    uint64_t hash; /**< The hash of the key. */
+    uint32_t chain; /**< The next tile in the same bucket. */
+    uint32_t older; /**< The tile used before this one. */
+    uint32_t newer; /**< The tile used after this one. */
+    uint32_t holds; /**< The number of times the tile is held. */
+    int state; /**< #NNOISE_TILE_FREE, #NNOISE_TILE_GENERATING or #NNOISE_TILE_READY. */
+} nNoiseTile_t;
+
+struct nNoiseCache {
+    nMutex_t mutex; /**< Locks the buckets and the order of use. */
+    uint32_t size[3]; /**< The number of samples of each tile along each axis. */
+    size_t samples; /**< The number of samples of each tile. */
+    uint32_t capacity; /**< The number of tiles. */
+    uint32_t bucketMask; /**< The number of buckets minus one. */
+    uint32_t *buckets; /**< The first tile of each bucket of the hash table. */
+    nNoiseTile_t *tiles; /**< The tiles. */
+    float *arena; /**< The samples of every tile. */
+    uint32_t oldest; /**< The least recently used tile. */
+    uint32_t newest; /**< The most recently used tile. */
+    uint64_t hits; /**< The number of requested tiles that were cached. */
+    uint64_t misses; /**< The number of requested tiles that were generated. */
+};
+
+static void nNoiseTileKeySet(nNoiseTileKey_t *const key,
+ const nNoise_t *const noise, const float step, const float w,
+ const int32_t tile[3])
+{
+    memset(key, 0, sizeof(*key));
+    key->noise = *noise;
+    if (noise->warpAmplitude == 0.0f) key->noise.warpFrequency = 0.0f;
+    key->step = step;
+    key->w = (noise->dimensions == 4) ? w : 0.0f;
+    key->tile[0] = tile[0];
+    key->tile[1] = tile[1];
+    key->tile[2] = (noise->dimensions == 2) ? 0 : tile[2];
+}
+
+/* Hashes a key with 64-bit FNV-1a. */
+static uint64_t nNoiseTileHash(const nNoiseTileKey_t *const key)
+{
+    const unsigned char *bytes = (const unsigned char *) key;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < sizeof(*key); i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/* Moves a tile to the newest end of the order of use. */
+static void nNoiseCacheTouch(nNoiseCache_t *const cache, const uint32_t i)
+{
+    nNoiseTile_t *const tiles = cache->tiles;
+    if (cache->newest == i) return;
+
+    if (tiles[i].older != NNOISE_TILE_NONE)
+    {
+        tiles[tiles[i].older].newer = tiles[i].newer;
+    }
+    else cache->oldest = tiles[i].newer;
+    tiles[tiles[i].newer].older = tiles[i].older;
+
+    tiles[i].older = cache->newest;
+    tiles[i].newer = NNOISE_TILE_NONE;
+    tiles[cache->newest].newer = i;
+    cache->newest = i;
+}
+
+/* Takes the least recently used tile that is not held out of its bucket. */
+static uint32_t nNoiseCacheEvict(nNoiseCache_t *const cache)
+{
+    nNoiseTile_t *const tiles = cache->tiles;
+    for (uint32_t i = cache->oldest; i != NNOISE_TILE_NONE; i = tiles[i].newer)
+    {
+        if (__atomic_load_n(&tiles[i].holds, __ATOMIC_ACQUIRE)) continue;
+        if (tiles[i].state == NNOISE_TILE_FREE) return i;
+
+        uint32_t *link = &cache->buckets[tiles[i].hash & cache->bucketMask];
+        while (*link != i) link = &tiles[*link].chain;
+        *link = tiles[i].chain;
+        tiles[i].state = NNOISE_TILE_FREE;
+        return i;
+    }
+    return NNOISE_TILE_NONE;
+}
+
+int nNoiseCacheCreate(nNoiseCache_t **cache, const uint32_t size[3],
+                      const uint32_t capacity)
+{
+    if (!cache || !size) return NERROR_NULL;
+    if (!size[0] || !size[1] || !size[2] || !capacity ||
+     (capacity > (UINT32_MAX / 2))) return NERROR_INV_ARG;
+    const size_t samples = (size_t) size[0] * size[1] * size[2];
+    if (samples > (SIZE_MAX / sizeof(float) / capacity)) return NERROR_INV_ARG;
+
+    uint32_t buckets = 1;
+    while (buckets < (capacity * 2)) buckets <<= 1;
+
+    nNoiseCache_t *c = nAlloc(sizeof(nNoiseCache_t));
+    if (!c) return NERROR_NO_MEMORY;
+    memset(c, 0, sizeof(*c));
+    c->tiles = nAlloc(capacity * sizeof(nNoiseTile_t));
+    c->buckets = nAlloc(buckets * sizeof(uint32_t));
+    c->arena = nAlloc(capacity * samples * sizeof(float));
+    int err = (c->tiles && c->buckets && c->arena) ? NSUCCESS :
+     NERROR_NO_MEMORY;
+    if (!err) err = nThreadMutexCreate(&c->mutex);
+    if (err)
+    {
+        if (c->tiles) nFree((void **) &c->tiles);
+        if (c->buckets) nFree((void **) &c->buckets);
+        if (c->arena) nFree((void **) &c->arena);
+        nFree((void **) &c);
+        return err;
+    }
+
+    memcpy(c->size, size, sizeof(c->size));
+    c->samples = samples;
+    c->capacity = capacity;
+    c->bucketMask = buckets - 1;
+    for (uint32_t i = 0; i < buckets; i++) c->buckets[i] = NNOISE_TILE_NONE;
+    for (uint32_t i = 0; i < capacity; i++)
+    {
+        memset(&c->tiles[i], 0, sizeof(nNoiseTile_t));
+        c->tiles[i].chain = NNOISE_TILE_NONE;
+        c->tiles[i].older = i ? i - 1 : NNOISE_TILE_NONE;
+        c->tiles[i].newer = (i + 1 < capacity) ? i + 1 : NNOISE_TILE_NONE;
+        c->tiles[i].state = NNOISE_TILE_FREE;
+    }
+    c->oldest = 0;
+    c->newest = capacity - 1;
+    *cache = c;
+    return NSUCCESS;
+}
+
+void nNoiseCacheDestroy(nNoiseCache_t **cache)
+{
+    if (!cache || !*cache) return;
+    nNoiseCache_t *c = *cache;
+    nThreadMutexDestroy(&c->mutex);
+    nFree((void **) &c->tiles);
+    nFree((void **) &c->buckets);
+    nFree((void **) &c->arena);
+    nFree((void **) cache);
+}
+
+int nNoiseCacheAcquire(const float **samples, nNoiseCache_t *const cache,
+                       const nNoise_t *const noise, const float step,
+                       const float w, const int32_t tile[3])
+{
+    if (!samples || !cache || !noise || !tile) return NERROR_NULL;
+    if (!nNoiseValid(noise)) return NERROR_INV_ARG;
+
+    nNoiseTileKey_t key;
+    nNoiseTileKeySet(&key, noise, step, w, tile);
+    const uint64_t hash = nNoiseTileHash(&key);
+    nNoiseTile_t *const tiles = cache->tiles;
+
+    nThreadMutexLock(&cache->mutex);
+    uint32_t *const bucket = &cache->buckets[hash & cache->bucketMask];
+    uint32_t i = *bucket;
+    while ((i != NNOISE_TILE_NONE) && ((tiles[i].hash != hash) ||
+     memcmp(&tiles[i].key, &key, sizeof(key))))
+    {
+        i = tiles[i].chain;
+    }
+
+    const int generate = (i == NNOISE_TILE_NONE);
+    if (generate)
+    {
+        i = nNoiseCacheEvict(cache);
+        if (i == NNOISE_TILE_NONE)
+        {
+            nThreadMutexUnlock(&cache->mutex);
+            return NERROR_NO_MEMORY;
+        }
+        tiles[i].key = key;
+        tiles[i].hash = hash;
+        tiles[i].chain = *bucket;
+        tiles[i].state = NNOISE_TILE_GENERATING;
+        *bucket = i;
+        __atomic_add_fetch(&cache->misses, 1, __ATOMIC_RELAXED);
+    }
+    else __atomic_add_fetch(&cache->hits, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&tiles[i].holds, 1, __ATOMIC_RELAXED);
+    nNoiseCacheTouch(cache, i);
+    nThreadMutexUnlock(&cache->mutex);
+
+    float *const data = cache->arena + (i * cache->samples);
+    if (generate)
+    {
+        /* Generated without the lock, so that other tiles can be read and
+         * generated meanwhile. The calling threads are already spread across
+         * the tiles, so each is generated by one thread. */
+        const nNoiseGrid_t grid = {
+            .origin = {
+                key.tile[0] * (int32_t) cache->size[0],
+                key.tile[1] * (int32_t) cache->size[1],
+                key.tile[2] * (int32_t) cache->size[2],
+            },
+            .size = {cache->size[0], cache->size[1], cache->size[2]},
+            .step = step,
+            .w = w,
+        };
+        nNoiseFillGrid(data, noise, &grid, 1);
+        __atomic_store_n(&tiles[i].state, NNOISE_TILE_READY, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        while (__atomic_load_n(&tiles[i].state, __ATOMIC_ACQUIRE) !=
+         NNOISE_TILE_READY)
+        {
+            nTimeNanoSleep(NNOISE_TILE_WAIT);
+        }
+    }
+    *samples = data;
+    return NSUCCESS;
+}
+
+void nNoiseCacheRelease(nNoiseCache_t *const cache, const float *samples)
+{
+    if (!cache || !samples) return;
+    const size_t i = (size_t) (samples - cache->arena) / cache->samples;
+    __atomic_sub_fetch(&cache->tiles[i].holds, 1, __ATOMIC_RELEASE);
+}
+
+/* Divides, rounding toward negative infinity. */
+static int32_t nNoiseFloorDiv(const int64_t a, const uint32_t b)
+{
+    return (int32_t) ((a >= 0) ? a / b : -((-a + b - 1) / b));
+}
+
+int nNoiseCacheFillGrid(float *dst, nNoiseCache_t *const cache,
+                        const nNoise_t *const noise,
+                        const nNoiseGrid_t *const grid)
+{
+    if (!dst || !cache || !noise || !grid) return NERROR_NULL;
+    if (!grid->size[0] || !grid->size[1] || !grid->size[2]) return NSUCCESS;
+
+    /* 2D noise is the same at every Z, so every slice copies tile Z 0. */
+    const int flat = (noise->dimensions == 2);
+    const uint32_t *const size = cache->size;
+    int32_t first[3], last[3];
+    for (int a = 0; a < 3; a++)
+    {
+        first[a] = nNoiseFloorDiv(grid->origin[a], size[a]);
+        last[a] = nNoiseFloorDiv((int64_t) grid->origin[a] + grid->size[a] - 1,
+         size[a]);
+    }
+    if (flat) first[2] = last[2] = 0;
+
+    for (int32_t tz = first[2]; tz <= last[2]; tz++)
+    {
+        for (int32_t ty = first[1]; ty <= last[1]; ty++)
+        {
+            for (int32_t tx = first[0]; tx <= last[0]; tx++)
+            {
+                const int32_t tile[3] = {tx, ty, tz};
+                const float *src;
+                const int err = nNoiseCacheAcquire(&src, cache, noise,
+                 grid->step, grid->w, tile);
+                if (err) return err;
+
+                /* The part of the grid inside the tile, in grid samples. */
+                int64_t lo[3], hi[3];
+                for (int a = 0; a < 3; a++)
+                {
+                    const int64_t start = (int64_t) tile[a] * size[a];
+                    lo[a] = (start > grid->origin[a]) ? start :
+                     grid->origin[a];
+                    hi[a] = (int64_t) grid->origin[a] + grid->size[a];
+                    if (start + size[a] < hi[a]) hi[a] = start + size[a];
+                }
+                if (flat)
+                {
+                    lo[2] = grid->origin[2];
+                    hi[2] = (int64_t) grid->origin[2] + grid->size[2];
+                }
+
+                const size_t count = (size_t) (hi[0] - lo[0]);
+                for (int64_t z = lo[2]; z < hi[2]; z++)
+                {
+                    const int64_t sz = flat ? 0 : z - ((int64_t) tz * size[2]);
+                    for (int64_t y = lo[1]; y < hi[1]; y++)
+                    {
+                        const int64_t sy = y - ((int64_t) ty * size[1]);
+                        const int64_t sx = lo[0] - ((int64_t) tx * size[0]);
+                        memcpy(dst + ((((size_t) (z - grid->origin[2]) *
+                         grid->size[1]) + (size_t) (y - grid->origin[1])) *
+                         grid->size[0]) + (size_t) (lo[0] - grid->origin[0]),
+                         src + ((((size_t) sz * size[1]) + (size_t) sy) *
+                         size[0]) + (size_t) sx, count * sizeof(float));
+                    }
+                }
+                nNoiseCacheRelease(cache, src);
+            }
+        }
+    }
+    return NSUCCESS;
+}
+
+void nNoiseCacheStats(const nNoiseCache_t *const cache, uint64_t *hits,
+                      uint64_t *misses)
+{
+    if (!cache) return;
+    if (hits) *hits = __atomic_load_n(&cache->hits, __ATOMIC_RELAXED);
+    if (misses) *misses = __atomic_load_n(&cache->misses, __ATOMIC_RELAXED);
+}
+
+// Noise.c
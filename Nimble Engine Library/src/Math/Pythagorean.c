@@ -0,0 +1,604 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Pythagorean.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/Pythagorean.h"
+
+/**
+ * @file Pythagorean.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines distance queries on arrays of points.
+ */
+
+#include "../../include/Nimble/System/Simd.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+#  include <arm_neon.h>
+#endif
+
+/**
+ * @brief The nearest points found so far by nVec3NearestSoA().
+ */
+typedef struct nPythNearest {
+    uint32_t *indices; /**< The indices of the points, nearest first. */
+    float *distSq; /**< The squared distances of the points. */
+    size_t k; /**< The number of points to find. */
+    size_t found; /**< The number of points found so far. */
+    float worst; /**< Points must be nearer than this squared distance. */
+} nPythNearest_t;
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nPythKernels {
+    void (*rsqrt)(float *dst, const float *src, const size_t count);
+    void (*distSq)(float *dst, const nVec3SoA_t points, const nVec3_t origin,
+     const size_t count);
+    size_t (*within)(uint32_t *indices, const nVec3SoA_t points,
+     const nVec3_t origin, const float radiusSq, const size_t count);
+    void (*nearest)(nPythNearest_t *nearest, const nVec3SoA_t points,
+     const nVec3_t origin, const size_t count);
+} nPythKernels_t;
+
+/* Adds a point to the nearest points if it is nearer than the farthest of
+ * them. Points at the same distance keep the order they were found in, so the
+ * result does not depend on the kernel. */
+static void nPythInsert(nPythNearest_t *const nearest, const uint32_t index,
+ const float distSq)
+{
+    if (!(distSq < nearest->worst)) return;
+
+    size_t i = (nearest->found < nearest->k) ? nearest->found++ :
+     nearest->k - 1;
+    for (; (i > 0) && (nearest->distSq[i - 1] > distSq); i--)
+    {
+        nearest->distSq[i] = nearest->distSq[i - 1];
+        nearest->indices[i] = nearest->indices[i - 1];
+    }
+    nearest->distSq[i] = distSq;
+    nearest->indices[i] = index;
+
+    if (nearest->found == nearest->k)
+    {
+        nearest->worst = nearest->distSq[nearest->k - 1];
+    }
+}
+
+static float nPythDistSq(const nVec3SoA_t points, const nVec3_t origin,
+ const size_t i)
+{
+    const float dx = points.x[i] - origin.x;
+    const float dy = points.y[i] - origin.y;
+    const float dz = points.z[i] - origin.z;
+    return (dx * dx) + (dy * dy) + (dz * dz);
+}
+
+/* These finish the points from index i on, for the kernels that work on
+ * blocks of points. */
+static size_t nPythWithinFrom(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radiusSq, size_t i, const size_t count)
+{
+    size_t found = 0;
+    for (; i < count; i++)
+    {
+        if (nPythDistSq(points, origin, i) < radiusSq)
+        {
+            indices[found++] = (uint32_t) i;
+        }
+    }
+    return found;
+}
+
+static void nPythNearestFrom(nPythNearest_t *nearest, const nVec3SoA_t points,
+ const nVec3_t origin, size_t i, const size_t count)
+{
+    for (; i < count; i++)
+    {
+        nPythInsert(nearest, (uint32_t) i, nPythDistSq(points, origin, i));
+    }
+}
+
+static void nPythRsqrtScalar(float *dst, const float *src, const size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = nRsqrt(src[i]);
+}
+
+static void nPythDistSqScalar(float *dst, const nVec3SoA_t points,
+ const nVec3_t origin, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = nPythDistSq(points, origin, i);
+    }
+}
+
+static size_t nPythWithinScalar(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radiusSq, const size_t count)
+{
+    return nPythWithinFrom(indices, points, origin, radiusSq, 0, count);
+}
+
+static void nPythNearestScalar(nPythNearest_t *nearest,
+ const nVec3SoA_t points, const nVec3_t origin, const size_t count)
+{
+    nPythNearestFrom(nearest, points, origin, 0, count);
+}
+
+static const nPythKernels_t NPYTH_SCALAR = {
+    .rsqrt = nPythRsqrtScalar,
+    .distSq = nPythDistSqScalar,
+    .within = nPythWithinScalar,
+    .nearest = nPythNearestScalar,
+};
+
+/* The block kernels compare a register of squared distances at once, and
+ * only look at the lanes of a block when its comparison mask is not zero. */
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static __m128 nPythBlockSSE42(const nVec3SoA_t points, const __m128 ox,
+ const __m128 oy, const __m128 oz, const size_t i)
+{
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(points.x + i), ox);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(points.y + i), oy);
+    const __m128 dz = _mm_sub_ps(_mm_loadu_ps(points.z + i), oz);
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+     _mm_mul_ps(dz, dz));
+}
+
+NSIMD_TARGET("sse4.2")
+static void nPythRsqrtSSE42(float *dst, const float *src, const size_t count)
+{
+    const __m128 half = _mm_set1_ps(0.5f), threeHalves = _mm_set1_ps(1.5f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(src + i);
+        const __m128 y = _mm_rsqrt_ps(x);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(y, _mm_sub_ps(threeHalves,
+         _mm_mul_ps(_mm_mul_ps(half, x), _mm_mul_ps(y, y)))));
+    }
+    nPythRsqrtScalar(dst + i, src + i, count - i);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nPythDistSqSSE42(float *dst, const nVec3SoA_t points,
+ const nVec3_t origin, const size_t count)
+{
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y);
+    const __m128 oz = _mm_set1_ps(origin.z);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(dst + i, nPythBlockSSE42(points, ox, oy, oz, i));
+    }
+    for (; i < count; i++) dst[i] = nPythDistSq(points, origin, i);
+}
+
+NSIMD_TARGET("sse4.2")
+static size_t nPythWithinSSE42(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radiusSq, const size_t count)
+{
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y);
+    const __m128 oz = _mm_set1_ps(origin.z), r = _mm_set1_ps(radiusSq);
+    size_t found = 0, i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        unsigned mask = (unsigned) _mm_movemask_ps(_mm_cmplt_ps(
+         nPythBlockSSE42(points, ox, oy, oz, i), r));
+        for (; mask; mask &= mask - 1)
+        {
+            indices[found++] = (uint32_t) (i + (size_t) __builtin_ctz(mask));
+        }
+    }
+    return found + nPythWithinFrom(indices + found, points, origin, radiusSq,
+     i, count);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nPythNearestSSE42(nPythNearest_t *nearest,
+ const nVec3SoA_t points, const nVec3_t origin, const size_t count)
+{
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y);
+    const __m128 oz = _mm_set1_ps(origin.z);
+    float d[4];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 dv = nPythBlockSSE42(points, ox, oy, oz, i);
+        unsigned mask = (unsigned) _mm_movemask_ps(_mm_cmplt_ps(dv,
+         _mm_set1_ps(nearest->worst)));
+        if (!mask) continue;
+
+        _mm_storeu_ps(d, dv);
+        for (; mask; mask &= mask - 1)
+        {
+            const unsigned lane = (unsigned) __builtin_ctz(mask);
+            nPythInsert(nearest, (uint32_t) (i + lane), d[lane]);
+        }
+    }
+    nPythNearestFrom(nearest, points, origin, i, count);
+}
+
+static const nPythKernels_t NPYTH_SSE42 = {
+    .rsqrt = nPythRsqrtSSE42,
+    .distSq = nPythDistSqSSE42,
+    .within = nPythWithinSSE42,
+    .nearest = nPythNearestSSE42,
+};
+
+NSIMD_TARGET("avx2,fma")
+static __m256 nPythBlockAVX2(const nVec3SoA_t points, const __m256 ox,
+ const __m256 oy, const __m256 oz, const size_t i)
+{
+    const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(points.x + i), ox);
+    const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(points.y + i), oy);
+    const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(points.z + i), oz);
+    return _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy,
+     _mm256_mul_ps(dx, dx)));
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nPythRsqrtAVX2(float *dst, const float *src, const size_t count)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(src + i);
+        const __m256 y = _mm256_rsqrt_ps(x);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(y, _mm256_fnmadd_ps(
+         _mm256_mul_ps(half, x), _mm256_mul_ps(y, y), threeHalves)));
+    }
+    nPythRsqrtSSE42(dst + i, src + i, count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nPythDistSqAVX2(float *dst, const nVec3SoA_t points,
+ const nVec3_t origin, const size_t count)
+{
+    const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y);
+    const __m256 oz = _mm256_set1_ps(origin.z);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(dst + i, nPythBlockAVX2(points, ox, oy, oz, i));
+    }
+    for (; i < count; i++) dst[i] = nPythDistSq(points, origin, i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static size_t nPythWithinAVX2(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radiusSq, const size_t count)
+{
+    const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y);
+    const __m256 oz = _mm256_set1_ps(origin.z);
+    const __m256 r = _mm256_set1_ps(radiusSq);
+    size_t found = 0, i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        unsigned mask = (unsigned) _mm256_movemask_ps(_mm256_cmp_ps(
+         nPythBlockAVX2(points, ox, oy, oz, i), r, _CMP_LT_OQ));
+        for (; mask; mask &= mask - 1)
+        {
+            indices[found++] = (uint32_t) (i + (size_t) __builtin_ctz(mask));
+        }
+    }
+    return found + nPythWithinFrom(indices + found, points, origin, radiusSq,
+     i, count);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nPythNearestAVX2(nPythNearest_t *nearest,
+ const nVec3SoA_t points, const nVec3_t origin, const size_t count)
+{
+    const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y);
+    const __m256 oz = _mm256_set1_ps(origin.z);
+    float d[8];
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 dv = nPythBlockAVX2(points, ox, oy, oz, i);
+        unsigned mask = (unsigned) _mm256_movemask_ps(_mm256_cmp_ps(dv,
+         _mm256_set1_ps(nearest->worst), _CMP_LT_OQ));
+        if (!mask) continue;
+
+        _mm256_storeu_ps(d, dv);
+        for (; mask; mask &= mask - 1)
+        {
+            const unsigned lane = (unsigned) __builtin_ctz(mask);
+            nPythInsert(nearest, (uint32_t) (i + lane), d[lane]);
+        }
+    }
+    nPythNearestFrom(nearest, points, origin, i, count);
+}
+
+static const nPythKernels_t NPYTH_AVX2 = {
+    .rsqrt = nPythRsqrtAVX2,
+    .distSq = nPythDistSqAVX2,
+    .within = nPythWithinAVX2,
+    .nearest = nPythNearestAVX2,
+};
+
+/* Masks the lanes from i up to count, 16 at most. */
+#define NPYTH_MASK(count, i) (((count) - (i) >= 16) ? (__mmask16) 0xffff :\
+ (__mmask16) ((1U << ((count) - (i))) - 1))
+
+NSIMD_TARGET("avx512f")
+static __m512 nPythBlockAVX512(const nVec3SoA_t points, const __m512 ox,
+ const __m512 oy, const __m512 oz, const __mmask16 mask, const size_t i)
+{
+    const __m512 dx = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, points.x + i),
+     ox);
+    const __m512 dy = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, points.y + i),
+     oy);
+    const __m512 dz = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, points.z + i),
+     oz);
+    return _mm512_fmadd_ps(dz, dz, _mm512_fmadd_ps(dy, dy,
+     _mm512_mul_ps(dx, dx)));
+}
+
+NSIMD_TARGET("avx512f")
+static void nPythRsqrtAVX512(float *dst, const float *src, const size_t count)
+{
+    const __m512 half = _mm512_set1_ps(0.5f);
+    const __m512 threeHalves = _mm512_set1_ps(1.5f);
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 mask = NPYTH_MASK(count, i);
+        const __m512 x = _mm512_maskz_loadu_ps(mask, src + i);
+        const __m512 y = _mm512_maskz_rsqrt14_ps(mask, x);
+        _mm512_mask_storeu_ps(dst + i, mask, _mm512_mul_ps(y, _mm512_fnmadd_ps(
+         _mm512_mul_ps(half, x), _mm512_mul_ps(y, y), threeHalves)));
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nPythDistSqAVX512(float *dst, const nVec3SoA_t points,
+ const nVec3_t origin, const size_t count)
+{
+    const __m512 ox = _mm512_set1_ps(origin.x), oy = _mm512_set1_ps(origin.y);
+    const __m512 oz = _mm512_set1_ps(origin.z);
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 mask = NPYTH_MASK(count, i);
+        _mm512_mask_storeu_ps(dst + i, mask, nPythBlockAVX512(points, ox, oy,
+         oz, mask, i));
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static size_t nPythWithinAVX512(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radiusSq, const size_t count)
+{
+    const __m512 ox = _mm512_set1_ps(origin.x), oy = _mm512_set1_ps(origin.y);
+    const __m512 oz = _mm512_set1_ps(origin.z);
+    const __m512 r = _mm512_set1_ps(radiusSq);
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+     11, 12, 13, 14, 15);
+    size_t found = 0;
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 mask = NPYTH_MASK(count, i);
+        const __mmask16 in = _mm512_mask_cmp_ps_mask(mask, nPythBlockAVX512(
+         points, ox, oy, oz, mask, i), r, _CMP_LT_OQ);
+        if (!in) continue;
+
+        /* Packs the indices of the points in the radius together. */
+        _mm512_mask_compressstoreu_epi32(indices + found, in, _mm512_add_epi32(
+         _mm512_set1_epi32((int) i), lanes));
+        found += (size_t) __builtin_popcount(in);
+    }
+    return found;
+}
+
+NSIMD_TARGET("avx512f")
+static void nPythNearestAVX512(nPythNearest_t *nearest,
+ const nVec3SoA_t points, const nVec3_t origin, const size_t count)
+{
+    const __m512 ox = _mm512_set1_ps(origin.x), oy = _mm512_set1_ps(origin.y);
+    const __m512 oz = _mm512_set1_ps(origin.z);
+    float d[16];
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 mask = NPYTH_MASK(count, i);
+        const __m512 dv = nPythBlockAVX512(points, ox, oy, oz, mask, i);
+        unsigned in = _mm512_mask_cmp_ps_mask(mask, dv,
+         _mm512_set1_ps(nearest->worst), _CMP_LT_OQ);
+        if (!in) continue;
+
+        _mm512_storeu_ps(d, dv);
+        for (; in; in &= in - 1)
+        {
+            const unsigned lane = (unsigned) __builtin_ctz(in);
+            nPythInsert(nearest, (uint32_t) (i + lane), d[lane]);
+        }
+    }
+}
+
+static const nPythKernels_t NPYTH_AVX512 = {
+    .rsqrt = nPythRsqrtAVX512,
+    .distSq = nPythDistSqAVX512,
+    .within = nPythWithinAVX512,
+    .nearest = nPythNearestAVX512,
+};
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+static float32x4_t nPythBlockNEON(const nVec3SoA_t points,
+ const float32x4_t ox, const float32x4_t oy, const float32x4_t oz,
+ const size_t i)
+{
+    const float32x4_t dx = vsubq_f32(vld1q_f32(points.x + i), ox);
+    const float32x4_t dy = vsubq_f32(vld1q_f32(points.y + i), oy);
+    const float32x4_t dz = vsubq_f32(vld1q_f32(points.z + i), oz);
+    return vfmaq_f32(vfmaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+}
+
+static void nPythRsqrtNEON(float *dst, const float *src, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t x = vld1q_f32(src + i);
+        const float32x4_t y = vrsqrteq_f32(x);
+        vst1q_f32(dst + i, vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y)));
+    }
+    nPythRsqrtScalar(dst + i, src + i, count - i);
+}
+
+static void nPythDistSqNEON(float *dst, const nVec3SoA_t points,
+ const nVec3_t origin, const size_t count)
+{
+    const float32x4_t ox = vdupq_n_f32(origin.x), oy = vdupq_n_f32(origin.y);
+    const float32x4_t oz = vdupq_n_f32(origin.z);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(dst + i, nPythBlockNEON(points, ox, oy, oz, i));
+    }
+    for (; i < count; i++) dst[i] = nPythDistSq(points, origin, i);
+}
+
+static size_t nPythWithinNEON(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radiusSq, const size_t count)
+{
+    const float32x4_t ox = vdupq_n_f32(origin.x), oy = vdupq_n_f32(origin.y);
+    const float32x4_t oz = vdupq_n_f32(origin.z), r = vdupq_n_f32(radiusSq);
+    uint32_t in[4];
+    size_t found = 0, i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32x4_t mask = vcltq_f32(nPythBlockNEON(points, ox, oy, oz,
+         i), r);
+        if (!vmaxvq_u32(mask)) continue;
+
+        vst1q_u32(in, mask);
+        for (unsigned lane = 0; lane < 4; lane++)
+        {
+            if (in[lane]) indices[found++] = (uint32_t) (i + lane);
+        }
+    }
+    return found + nPythWithinFrom(indices + found, points, origin, radiusSq,
+     i, count);
+}
+
+static void nPythNearestNEON(nPythNearest_t *nearest,
+ const nVec3SoA_t points, const nVec3_t origin, const size_t count)
+{
+    const float32x4_t ox = vdupq_n_f32(origin.x), oy = vdupq_n_f32(origin.y);
+    const float32x4_t oz = vdupq_n_f32(origin.z);
+    float d[4];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t dv = nPythBlockNEON(points, ox, oy, oz, i);
+        if (!vmaxvq_u32(vcltq_f32(dv, vdupq_n_f32(nearest->worst)))) continue;
+
+        vst1q_f32(d, dv);
+        for (unsigned lane = 0; lane < 4; lane++)
+        {
+            nPythInsert(nearest, (uint32_t) (i + lane), d[lane]);
+        }
+    }
+    nPythNearestFrom(nearest, points, origin, i, count);
+}
+
+static const nPythKernels_t NPYTH_NEON = {
+    .rsqrt = nPythRsqrtNEON,
+    .distSq = nPythDistSqNEON,
+    .within = nPythWithinNEON,
+    .nearest = nPythNearestNEON,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(), which has already
+ * checked that the CPU supports it. */
+static const nPythKernels_t *nPythKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NPYTH_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NPYTH_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NPYTH_SSE42;
+        default:
+            return &NPYTH_SCALAR;
+    }
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    return (NSIMD.level >= NSIMD_LEVEL_NEON) ? &NPYTH_NEON : &NPYTH_SCALAR;
+#else
+    return &NPYTH_SCALAR;
+#endif
+}
+
+void nRsqrtArray(float *dst, const float *src, const size_t count)
+{
+    nPythKernels()->rsqrt(dst, src, count);
+}
+
+void nVec3DistanceSqSoA(float *dst, const nVec3SoA_t points,
+ const nVec3_t origin, const size_t count)
+{
+    nPythKernels()->distSq(dst, points, origin, count);
+}
+
+size_t nVec3WithinRadiusSoA(uint32_t *indices, const nVec3SoA_t points,
+ const nVec3_t origin, const float radius, const size_t count)
+{
+    const float radiusSq = (radius > 0.0f) ? radius * radius : 0.0f;
+    return nPythKernels()->within(indices, points, origin, radiusSq, count);
+}
+
+size_t nVec3NearestSoA(uint32_t *indices, float *distSq, const size_t k,
+ const nVec3SoA_t points, const nVec3_t origin, const float radius,
+ const size_t count)
+{
+    if (!k) return 0;
+
+    nPythNearest_t nearest = {
+        .indices = indices,
+        .distSq = distSq,
+        .k = k,
+        .found = 0,
+        .worst = (radius > 0.0f) ? radius * radius : 0.0f,
+    };
+    nPythKernels()->nearest(&nearest, points, origin, count);
+    return nearest.found;
+}
+
+// Pythagorean.c
@@ -0,0 +1,478 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Quaternions.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/Quaternions.h"
+
+/**
+ * @file Quaternions.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines quaternion math.
+ */
+
+#include <math.h>
+
+#include "../../include/Nimble/System/Simd.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+#  include <arm_neon.h>
+#endif
+
+/* Above this dot product, slerp is computed as nlerp, as the angle is too
+ * small for its division by the sine to be accurate. */
+#define NQUAT_SLERP_LINEAR 0.9995f
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nQuatKernels {
+    void (*mul)(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+     const size_t count);
+    void (*nlerp)(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+     const float t, const size_t count);
+} nQuatKernels_t;
+
+nQuat_t nQuatSlerp(const nQuat_t a, const nQuat_t b, const float t)
+{
+    float d = nQuatDot(a, b);
+    nQuat_t bNear = b;
+    if (d < 0.0f)
+    {
+        d = -d;
+        bNear = nQuatSet(-b.x, -b.y, -b.z, -b.w);
+    }
+    if (d > NQUAT_SLERP_LINEAR)
+    {
+        return nQuatNormalize((nQuat_t) {.m = nVecRegAdd(a.m, nVecRegMul(
+         nVecRegSub(bNear.m, a.m), nVecRegSplat(t)))});
+    }
+
+    const float theta = acosf(d);
+    const float invSin = 1.0f / sinf(theta);
+    const float wa = sinf((1.0f - t) * theta) * invSin;
+    const float wb = sinf(t * theta) * invSin;
+    return (nQuat_t) {.m = nVecRegAdd(nVecRegMul(a.m, nVecRegSplat(wa)),
+     nVecRegMul(bNear.m, nVecRegSplat(wb)))};
+}
+
+nMat4_t nQuatToMat4(const nQuat_t q)
+{
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    return (nMat4_t) {.col = {
+        nVec4Set(1.0f - (2.0f * (yy + zz)), 2.0f * (xy + wz),
+         2.0f * (xz - wy), 0.0f),
+        nVec4Set(2.0f * (xy - wz), 1.0f - (2.0f * (xx + zz)),
+         2.0f * (yz + wx), 0.0f),
+        nVec4Set(2.0f * (xz + wy), 2.0f * (yz - wx),
+         1.0f - (2.0f * (xx + yy)), 0.0f),
+        nVec4Set(0.0f, 0.0f, 0.0f, 1.0f)
+    }};
+}
+
+nQuat_t nQuatFromMat4(const nMat4_t a)
+{
+    /* Element (row, column) of the upper 3x3. */
+#define NQUAT_M(row, col) a.m[((col) * 4) + (row)]
+    const float trace = NQUAT_M(0, 0) + NQUAT_M(1, 1) + NQUAT_M(2, 2);
+
+    /* Solve for the largest component first, so that it is not divided by a
+     * number near zero. */
+    nQuat_t q;
+    if (trace > 0.0f)
+    {
+        const float s = 2.0f * sqrtf(trace + 1.0f);
+        q = nQuatSet((NQUAT_M(2, 1) - NQUAT_M(1, 2)) / s,
+         (NQUAT_M(0, 2) - NQUAT_M(2, 0)) / s,
+         (NQUAT_M(1, 0) - NQUAT_M(0, 1)) / s, 0.25f * s);
+    }
+    else if ((NQUAT_M(0, 0) > NQUAT_M(1, 1)) &&
+     (NQUAT_M(0, 0) > NQUAT_M(2, 2)))
+    {
+        const float s = 2.0f * sqrtf(1.0f + NQUAT_M(0, 0) - NQUAT_M(1, 1) -
+         NQUAT_M(2, 2));
+        q = nQuatSet(0.25f * s, (NQUAT_M(0, 1) + NQUAT_M(1, 0)) / s,
+         (NQUAT_M(0, 2) + NQUAT_M(2, 0)) / s,
+         (NQUAT_M(2, 1) - NQUAT_M(1, 2)) / s);
+    }
+    else if (NQUAT_M(1, 1) > NQUAT_M(2, 2))
+    {
+        const float s = 2.0f * sqrtf(1.0f + NQUAT_M(1, 1) - NQUAT_M(0, 0) -
+         NQUAT_M(2, 2));
+        q = nQuatSet((NQUAT_M(0, 1) + NQUAT_M(1, 0)) / s, 0.25f * s,
+         (NQUAT_M(1, 2) + NQUAT_M(2, 1)) / s,
+         (NQUAT_M(0, 2) - NQUAT_M(2, 0)) / s);
+    }
+    else
+    {
+        const float s = 2.0f * sqrtf(1.0f + NQUAT_M(2, 2) - NQUAT_M(0, 0) -
+         NQUAT_M(1, 1));
+        q = nQuatSet((NQUAT_M(0, 2) + NQUAT_M(2, 0)) / s,
+         (NQUAT_M(1, 2) + NQUAT_M(2, 1)) / s, 0.25f * s,
+         (NQUAT_M(1, 0) - NQUAT_M(0, 1)) / s);
+    }
+#undef NQUAT_M
+    return nQuatNormalize(q);
+}
+
+static void nQuatMulScalar(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = nQuatMul(a[i], b[i]);
+}
+
+static void nQuatNlerpScalar(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const float t, const size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = nQuatNlerp(a[i], b[i], t);
+}
+
+static const nQuatKernels_t NQUAT_SCALAR = {
+    .mul = nQuatMulScalar,
+    .nlerp = nQuatNlerpScalar,
+};
+
+/* The batch kernels hold one quaternion in each 128-bit lane, and only use
+ * in-lane shuffles, so each level runs the same steps on wider registers:
+ * - A product adds each component of a times b, shuffled with some signs
+ *   flipped, as nQuatMul() does.
+ * - A dot product is broadcast to every component of its lane by adding the
+ *   lane to two of its shuffles.
+ * - Normalizing multiplies by the reciprocal square root of the length
+ *   squared, refined with a Newton-Raphson step. */
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static void nQuatMulSSE42(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const size_t count)
+{
+    const __m128 xSigns = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const __m128 ySigns = _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f);
+    const __m128 zSigns = _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f);
+    for (size_t i = 0; i < count; i++)
+    {
+        const __m128 qa = _mm_loadu_ps(a[i].v), qb = _mm_loadu_ps(b[i].v);
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(qa, qa, 0xff), qb);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(qa, qa, 0x00),
+         _mm_xor_ps(_mm_shuffle_ps(qb, qb, 0x1b), xSigns)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(qa, qa, 0x55),
+         _mm_xor_ps(_mm_shuffle_ps(qb, qb, 0x4e), ySigns)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(qa, qa, 0xaa),
+         _mm_xor_ps(_mm_shuffle_ps(qb, qb, 0xb1), zSigns)));
+        _mm_storeu_ps(dst[i].v, r);
+    }
+}
+
+NSIMD_TARGET("sse4.2")
+static __m128 nQuatDotSSE42(const __m128 a, const __m128 b)
+{
+    const __m128 p = _mm_mul_ps(a, b);
+    const __m128 s = _mm_add_ps(p, _mm_shuffle_ps(p, p, 0xb1));
+    return _mm_add_ps(s, _mm_shuffle_ps(s, s, 0x4e));
+}
+
+NSIMD_TARGET("sse4.2")
+static void nQuatNlerpSSE42(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const float t, const size_t count)
+{
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 tv = _mm_set1_ps(t), h = _mm_set1_ps(t - 0.5f);
+    const __m128 c = _mm_set1_ps(t * (t - 0.5f) * (t - 1.0f));
+    for (size_t i = 0; i < count; i++)
+    {
+        const __m128 qa = _mm_loadu_ps(a[i].v), qb = _mm_loadu_ps(b[i].v);
+        const __m128 d = nQuatDotSSE42(qa, qb);
+        const __m128 qbNear = _mm_xor_ps(qb, _mm_and_ps(d, signBit));
+        const __m128 ad = _mm_andnot_ps(signBit, d);
+
+        /* nQuatNlerpAdjust() */
+        __m128 k = _mm_add_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(ad,
+         _mm_set1_ps(-1.43519f)));
+        k = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(ad, k));
+        k = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(ad, k));
+        __m128 kb = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(ad,
+         _mm_set1_ps(0.215638f)));
+        kb = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(ad, kb));
+        k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(k, h), h), kb);
+        const __m128 adjusted = _mm_add_ps(tv, _mm_mul_ps(c, k));
+
+        const __m128 r = _mm_add_ps(qa, _mm_mul_ps(_mm_sub_ps(qbNear, qa),
+         adjusted));
+        const __m128 lenSq = nQuatDotSSE42(r, r);
+        __m128 inv = _mm_rsqrt_ps(lenSq);
+        inv = _mm_mul_ps(inv, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(
+         _mm_mul_ps(_mm_set1_ps(0.5f), lenSq), _mm_mul_ps(inv, inv))));
+        _mm_storeu_ps(dst[i].v, _mm_mul_ps(r, inv));
+    }
+}
+
+static const nQuatKernels_t NQUAT_SSE42 = {
+    .mul = nQuatMulSSE42,
+    .nlerp = nQuatNlerpSSE42,
+};
+
+NSIMD_TARGET("avx2,fma")
+static void nQuatMulAVX2(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const size_t count)
+{
+    const __m256 xSigns = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f,
+     0.0f, -0.0f, 0.0f, -0.0f);
+    const __m256 ySigns = _mm256_setr_ps(0.0f, 0.0f, -0.0f, -0.0f,
+     0.0f, 0.0f, -0.0f, -0.0f);
+    const __m256 zSigns = _mm256_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f,
+     -0.0f, 0.0f, 0.0f, -0.0f);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256 qa = _mm256_loadu_ps(a[i].v);
+        const __m256 qb = _mm256_loadu_ps(b[i].v);
+        __m256 r = _mm256_mul_ps(_mm256_permute_ps(qa, 0xff), qb);
+        r = _mm256_fmadd_ps(_mm256_permute_ps(qa, 0x00), _mm256_xor_ps(
+         _mm256_permute_ps(qb, 0x1b), xSigns), r);
+        r = _mm256_fmadd_ps(_mm256_permute_ps(qa, 0x55), _mm256_xor_ps(
+         _mm256_permute_ps(qb, 0x4e), ySigns), r);
+        r = _mm256_fmadd_ps(_mm256_permute_ps(qa, 0xaa), _mm256_xor_ps(
+         _mm256_permute_ps(qb, 0xb1), zSigns), r);
+        _mm256_storeu_ps(dst[i].v, r);
+    }
+    nQuatMulSSE42(dst + i, a + i, b + i, count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static __m256 nQuatDotAVX2(const __m256 a, const __m256 b)
+{
+    const __m256 p = _mm256_mul_ps(a, b);
+    const __m256 s = _mm256_add_ps(p, _mm256_permute_ps(p, 0xb1));
+    return _mm256_add_ps(s, _mm256_permute_ps(s, 0x4e));
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nQuatNlerpAVX2(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const float t, const size_t count)
+{
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 tv = _mm256_set1_ps(t), h = _mm256_set1_ps(t - 0.5f);
+    const __m256 c = _mm256_set1_ps(t * (t - 0.5f) * (t - 1.0f));
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256 qa = _mm256_loadu_ps(a[i].v);
+        const __m256 qb = _mm256_loadu_ps(b[i].v);
+        const __m256 d = nQuatDotAVX2(qa, qb);
+        const __m256 qbNear = _mm256_xor_ps(qb, _mm256_and_ps(d, signBit));
+        const __m256 ad = _mm256_andnot_ps(signBit, d);
+
+        /* nQuatNlerpAdjust() */
+        __m256 k = _mm256_fmadd_ps(ad, _mm256_set1_ps(-1.43519f),
+         _mm256_set1_ps(3.55645f));
+        k = _mm256_fmadd_ps(ad, k, _mm256_set1_ps(-3.2452f));
+        k = _mm256_fmadd_ps(ad, k, _mm256_set1_ps(1.0904f));
+        __m256 kb = _mm256_fmadd_ps(ad, _mm256_set1_ps(0.215638f),
+         _mm256_set1_ps(-1.06021f));
+        kb = _mm256_fmadd_ps(ad, kb, _mm256_set1_ps(0.848013f));
+        k = _mm256_fmadd_ps(_mm256_mul_ps(k, h), h, kb);
+        const __m256 adjusted = _mm256_fmadd_ps(c, k, tv);
+
+        const __m256 r = _mm256_fmadd_ps(_mm256_sub_ps(qbNear, qa), adjusted,
+         qa);
+        const __m256 lenSq = nQuatDotAVX2(r, r);
+        __m256 inv = _mm256_rsqrt_ps(lenSq);
+        inv = _mm256_mul_ps(inv, _mm256_fnmadd_ps(_mm256_mul_ps(
+         _mm256_set1_ps(0.5f), lenSq), _mm256_mul_ps(inv, inv),
+         _mm256_set1_ps(1.5f)));
+        _mm256_storeu_ps(dst[i].v, _mm256_mul_ps(r, inv));
+    }
+    nQuatNlerpSSE42(dst + i, a + i, b + i, t, count - i);
+}
+
+static const nQuatKernels_t NQUAT_AVX2 = {
+    .mul = nQuatMulAVX2,
+    .nlerp = nQuatNlerpAVX2,
+};
+
+/* Masks the lanes of the quaternions from i on, 4 floats each. */
+#define NQUAT_MASK(count, i) (((count) - (i) >= 4) ? (__mmask16) 0xffff :\
+ (__mmask16) ((1U << (((count) - (i)) * 4)) - 1))
+
+NSIMD_TARGET("avx512f")
+static void nQuatMulAVX512(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const size_t count)
+{
+    const __m512 xSigns = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, -0.0f,
+     0.0f, -0.0f));
+    const __m512 ySigns = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, 0.0f,
+     -0.0f, -0.0f));
+    const __m512 zSigns = _mm512_broadcast_f32x4(_mm_setr_ps(-0.0f, 0.0f,
+     0.0f, -0.0f));
+    for (size_t i = 0; i < count; i += 4)
+    {
+        const __mmask16 mask = NQUAT_MASK(count, i);
+        const __m512 qa = _mm512_maskz_loadu_ps(mask, a[i].v);
+        const __m512 qb = _mm512_maskz_loadu_ps(mask, b[i].v);
+        __m512 r = _mm512_mul_ps(_mm512_permute_ps(qa, 0xff), qb);
+        r = _mm512_fmadd_ps(_mm512_permute_ps(qa, 0x00), _mm512_castsi512_ps(
+         _mm512_xor_si512(_mm512_castps_si512(_mm512_permute_ps(qb, 0x1b)),
+         _mm512_castps_si512(xSigns))), r);
+        r = _mm512_fmadd_ps(_mm512_permute_ps(qa, 0x55), _mm512_castsi512_ps(
+         _mm512_xor_si512(_mm512_castps_si512(_mm512_permute_ps(qb, 0x4e)),
+         _mm512_castps_si512(ySigns))), r);
+        r = _mm512_fmadd_ps(_mm512_permute_ps(qa, 0xaa), _mm512_castsi512_ps(
+         _mm512_xor_si512(_mm512_castps_si512(_mm512_permute_ps(qb, 0xb1)),
+         _mm512_castps_si512(zSigns))), r);
+        _mm512_mask_storeu_ps(dst[i].v, mask, r);
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static __m512 nQuatDotAVX512(const __m512 a, const __m512 b)
+{
+    const __m512 p = _mm512_mul_ps(a, b);
+    const __m512 s = _mm512_add_ps(p, _mm512_permute_ps(p, 0xb1));
+    return _mm512_add_ps(s, _mm512_permute_ps(s, 0x4e));
+}
+
+NSIMD_TARGET("avx512f")
+static void nQuatNlerpAVX512(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const float t, const size_t count)
+{
+    const __m512i signBit = _mm512_set1_epi32((int) 0x80000000);
+    const __m512 tv = _mm512_set1_ps(t), h = _mm512_set1_ps(t - 0.5f);
+    const __m512 c = _mm512_set1_ps(t * (t - 0.5f) * (t - 1.0f));
+    for (size_t i = 0; i < count; i += 4)
+    {
+        const __mmask16 mask = NQUAT_MASK(count, i);
+        const __m512 qa = _mm512_maskz_loadu_ps(mask, a[i].v);
+        const __m512 qb = _mm512_maskz_loadu_ps(mask, b[i].v);
+        const __m512 d = nQuatDotAVX512(qa, qb);
+        const __m512i dSign = _mm512_and_si512(_mm512_castps_si512(d),
+         signBit);
+        const __m512 qbNear = _mm512_castsi512_ps(_mm512_xor_si512(
+         _mm512_castps_si512(qb), dSign));
+        const __m512 ad = _mm512_abs_ps(d);
+
+        /* nQuatNlerpAdjust() */
+        __m512 k = _mm512_fmadd_ps(ad, _mm512_set1_ps(-1.43519f),
+         _mm512_set1_ps(3.55645f));
+        k = _mm512_fmadd_ps(ad, k, _mm512_set1_ps(-3.2452f));
+        k = _mm512_fmadd_ps(ad, k, _mm512_set1_ps(1.0904f));
+        __m512 kb = _mm512_fmadd_ps(ad, _mm512_set1_ps(0.215638f),
+         _mm512_set1_ps(-1.06021f));
+        kb = _mm512_fmadd_ps(ad, kb, _mm512_set1_ps(0.848013f));
+        k = _mm512_fmadd_ps(_mm512_mul_ps(k, h), h, kb);
+        const __m512 adjusted = _mm512_fmadd_ps(c, k, tv);
+
+        const __m512 r = _mm512_fmadd_ps(_mm512_sub_ps(qbNear, qa), adjusted,
+         qa);
+        const __m512 lenSq = nQuatDotAVX512(r, r);
+        __m512 inv = _mm512_maskz_rsqrt14_ps(mask, lenSq);
+        inv = _mm512_mul_ps(inv, _mm512_fnmadd_ps(_mm512_mul_ps(
+         _mm512_set1_ps(0.5f), lenSq), _mm512_mul_ps(inv, inv),
+         _mm512_set1_ps(1.5f)));
+        _mm512_mask_storeu_ps(dst[i].v, mask, _mm512_mul_ps(r, inv));
+    }
+}
+
+static const nQuatKernels_t NQUAT_AVX512 = {
+    .mul = nQuatMulAVX512,
+    .nlerp = nQuatNlerpAVX512,
+};
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+static void nQuatMulNEON(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const size_t count)
+{
+    const float xSignsArr[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+    const float ySignsArr[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+    const float zSignsArr[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+    const float32x4_t xSigns = vld1q_f32(xSignsArr);
+    const float32x4_t ySigns = vld1q_f32(ySignsArr);
+    const float32x4_t zSigns = vld1q_f32(zSignsArr);
+    for (size_t i = 0; i < count; i++)
+    {
+        const float32x4_t qa = vld1q_f32(a[i].v), qb = vld1q_f32(b[i].v);
+        /* b.wzyx, b.zwxy and b.yxwz */
+        const float32x4_t bYXWZ = vrev64q_f32(qb);
+        const float32x4_t bZWXY = vextq_f32(qb, qb, 2);
+        const float32x4_t bWZYX = vrev64q_f32(bZWXY);
+        float32x4_t r = vmulq_laneq_f32(qb, qa, 3);
+        r = vfmaq_laneq_f32(r, vmulq_f32(bWZYX, xSigns), qa, 0);
+        r = vfmaq_laneq_f32(r, vmulq_f32(bZWXY, ySigns), qa, 1);
+        r = vfmaq_laneq_f32(r, vmulq_f32(bYXWZ, zSigns), qa, 2);
+        vst1q_f32(dst[i].v, r);
+    }
+}
+
+static const nQuatKernels_t NQUAT_NEON = {
+    .mul = nQuatMulNEON,
+    .nlerp = nQuatNlerpScalar,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(), which has already
+ * checked that the CPU supports it. */
+static const nQuatKernels_t *nQuatKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NQUAT_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NQUAT_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NQUAT_SSE42;
+        default:
+            return &NQUAT_SCALAR;
+    }
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    return (NSIMD.level >= NSIMD_LEVEL_NEON) ? &NQUAT_NEON : &NQUAT_SCALAR;
+#else
+    return &NQUAT_SCALAR;
+#endif
+}
+
+void nQuatMulArray(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const size_t count)
+{
+    nQuatKernels()->mul(dst, a, b, count);
+}
+
+void nQuatNlerpArray(nQuat_t *dst, const nQuat_t *a, const nQuat_t *b,
+ const float t, const size_t count)
+{
+    nQuatKernels()->nlerp(dst, a, b, t, count);
+}
+
+// Quaternions.c
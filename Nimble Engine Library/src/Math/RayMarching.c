@@ -0,0 +1,847 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * RayMarching.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/RayMarching.h"
+
+/**
+ * @file RayMarching.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines a CPU ray marcher for scenes of signed distance
+ * fields.
+ */
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Simd.h"
+
+#include <math.h>
+#include <string.h>
+
+#define NRAY_LANES 16 /**< The number of rays in a packet. */
+#define NRAY_NORMAL_CHUNK 64 /**< The number of normals estimated at once. */
+#define NRAY_EMIT 0x80000000U /**< Marks a node whose children have been compiled. */
+#define NRAY_OP_SUBTRACTION_REVERSED 10 /**< A subtraction whose children were compiled in reverse order. */
+#define NRAY_REFILL 8 /**< The number of empty lanes in a packet that are refilled together. */
+#define NRAY_GRAZING 8.0f /**< The multiple of the epsilon within which a ray that runs out of steps is grazing a surface. */
+
+/* The marcher is written once with the vector extensions of the compiler on
+ * 16 lanes, and compiled for each SIMD level by inlining it into functions
+ * targeting that level, like the noise. */
+typedef float nRayVec_t __attribute__((vector_size(64)));
+typedef int32_t nRayInt_t __attribute__((vector_size(64)));
+typedef int32_t nRayInt8_t __attribute__((vector_size(32))); /**< Half of the lanes. */
+typedef int32_t nRayInt4_t __attribute__((vector_size(16))); /**< A quarter of the lanes. */
+
+#define NRAY_BODY static inline __attribute__((always_inline)) /**< Inlined into the function of each level. */
+
+/* The bodies are always inlined, so the ABI for passing vectors wider than
+ * the baseline registers that GCC warns about is never used. */
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/**
+ * @brief An instruction of a compiled scene.
+ */
+typedef struct nRayCode {
+    int op; /**< The operation, which is one of the NRAY_OP_* operations. */
+    float p[9]; /**< The parameters, with what can be precomputed from the node. */
+} nRayCode_t;
+
+struct nRayScene {
+    nRayCode_t *code; /**< The instructions in postfix order. */
+    uint32_t length; /**< The number of instructions. */
+};
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nRayKernels {
+    void (*distance)(float *dst, const nRayScene_t *const scene,
+     const nVec3SoA_t points, const size_t count);
+    void (*march)(float *dst, const nRayScene_t *const scene,
+     const nRayMarch_t *const march, const nVec3SoA_t origins,
+     const nVec3SoA_t directions, const float *tmax, const size_t count);
+} nRayKernels_t;
+
+/* GCC splits comparisons of vectors wider than the registers into scalar
+ * code, so masks are made by shifting sign bits instead. */
+
+/* Gets a mask of the lanes whose sign bit is set. */
+NRAY_BODY nRayInt_t nRayNegative(const nRayVec_t a)
+{
+    return (nRayInt_t) a >> 31;
+}
+
+/* Selects a where the mask is set and b elsewhere. */
+NRAY_BODY nRayVec_t nRaySelect(const nRayInt_t mask, const nRayVec_t a,
+ const nRayVec_t b)
+{
+    return (nRayVec_t) ((mask & (nRayInt_t) a) | (~mask & (nRayInt_t) b));
+}
+
+NRAY_BODY nRayVec_t nRayMin(const nRayVec_t a, const nRayVec_t b)
+{
+    return nRaySelect(nRayNegative(a - b), a, b);
+}
+
+NRAY_BODY nRayVec_t nRayMax(const nRayVec_t a, const nRayVec_t b)
+{
+    return nRaySelect(nRayNegative(a - b), b, a);
+}
+
+NRAY_BODY nRayVec_t nRayAbs(const nRayVec_t a)
+{
+    return (nRayVec_t) ((nRayInt_t) a & 0x7fffffff);
+}
+
+/* Gets the greater of a and 0. */
+NRAY_BODY nRayVec_t nRayPositive(const nRayVec_t a)
+{
+    return (nRayVec_t) ((nRayInt_t) a & ~nRayNegative(a));
+}
+
+/* Gets a mask of the lanes that are neither infinite nor NaN. */
+NRAY_BODY nRayInt_t nRayFinite(const nRayVec_t a)
+{
+    return (((nRayInt_t) a & 0x7fffffff) - 0x7f800000) >> 31;
+}
+
+/* Gets the square root of a, which is not negative. The library is built for
+ * size, which calls sqrtf() for each lane, so 1 / sqrt(a) is estimated from
+ * the bits of a and refined twice with Newton's method, and the root is
+ * corrected once more, which is within a few units of the last place. Zero
+ * stays zero, and a sum of squares that overflowed stays infinite rather than
+ * becoming garbage. */
+NRAY_BODY nRayVec_t nRaySqrt(const nRayVec_t a)
+{
+    const nRayVec_t half = a * 0.5f;
+    nRayVec_t y = (nRayVec_t) (0x5f375a86 - ((nRayInt_t) a >> 1));
+    y = y * (1.5f - (half * y * y));
+    y = y * (1.5f - (half * y * y));
+    const nRayVec_t s = a * y;
+    return nRaySelect(nRayFinite(a), s + (y * (half - (0.5f * s * s))), a);
+}
+
+NRAY_BODY nRayVec_t nRayLength2(const nRayVec_t x, const nRayVec_t y)
+{
+    return nRaySqrt((x * x) + (y * y));
+}
+
+NRAY_BODY nRayVec_t nRayLength3(const nRayVec_t x, const nRayVec_t y,
+ const nRayVec_t z)
+{
+    return nRaySqrt((x * x) + (y * y) + (z * z));
+}
+
+/* Gets a bit for each lane whose mask is set. The lanes are folded in halves
+ * rather than read one at a time, which is a stall on the store of the whole
+ * vector when the library is built for size. */
+NRAY_BODY uint32_t nRayBits(const nRayInt_t mask)
+{
+    const nRayInt_t bits = {1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5,
+     1 << 6, 1 << 7, 1 << 8, 1 << 9, 1 << 10, 1 << 11, 1 << 12, 1 << 13,
+     1 << 14, 1 << 15};
+    const nRayInt_t set = mask & bits;
+    nRayInt8_t low, high;
+    memcpy(&low, &set, sizeof(low));
+    memcpy(&high, (const char *) &set + sizeof(low), sizeof(high));
+    low |= high;
+    nRayInt4_t a, b;
+    memcpy(&a, &low, sizeof(a));
+    memcpy(&b, (const char *) &low + sizeof(a), sizeof(b));
+    a |= b;
+    return (uint32_t) (a[0] | a[1] | a[2] | a[3]);
+}
+
+/* Counts the set bits, without the instruction that not every level has. */
+NRAY_BODY uint32_t nRayCount(uint32_t bits)
+{
+    bits -= (bits >> 1) & 0x55555555U;
+    bits = (bits & 0x33333333U) + ((bits >> 2) & 0x33333333U);
+    bits = (bits + (bits >> 4)) & 0x0f0f0f0fU;
+    return (bits * 0x01010101U) >> 24;
+}
+
+/* Evaluates the distance of a scene at 16 points, running its instructions
+ * on a stack of distances. */
+NRAY_BODY nRayVec_t nRayEvalBody(const nRayScene_t *const scene,
+ const nRayVec_t x, const nRayVec_t y, const nRayVec_t z)
+{
+    const nRayVec_t zero = {0};
+    nRayVec_t stack[NRAY_MAX_STACK];
+    uint32_t top = 0;
+    const nRayCode_t *const end = scene->code + scene->length;
+    for (const nRayCode_t *code = scene->code; code < end; code++)
+    {
+        const float *const p = code->p;
+        switch (code->op)
+        {
+            case NRAY_OP_SPHERE:
+                stack[top++] = nRayLength3(x - p[0], y - p[1], z - p[2]) -
+                 p[3];
+                break;
+            case NRAY_OP_BOX:
+            {
+                /* The half extents are less the rounding. */
+                const nRayVec_t qx = nRayAbs(x - p[0]) - p[3];
+                const nRayVec_t qy = nRayAbs(y - p[1]) - p[4];
+                const nRayVec_t qz = nRayAbs(z - p[2]) - p[5];
+                stack[top++] = nRayLength3(nRayPositive(qx), nRayPositive(qy),
+                 nRayPositive(qz)) + nRayMin(nRayMax(qx, nRayMax(qy, qz)),
+                 zero) - p[6];
+                break;
+            }
+            case NRAY_OP_PLANE:
+                stack[top++] = (x * p[0]) + (y * p[1]) + (z * p[2]) - p[3];
+                break;
+            case NRAY_OP_CAPSULE:
+            {
+                /* The end is B - A, over the square of its length. */
+                const nRayVec_t ax = x - p[0];
+                const nRayVec_t ay = y - p[1];
+                const nRayVec_t az = z - p[2];
+                const nRayVec_t h = nRayMin(nRayPositive(((ax * p[3]) +
+                 (ay * p[4]) + (az * p[5])) * p[6]), zero + 1.0f);
+                stack[top++] = nRayLength3(ax - (p[3] * h), ay - (p[4] * h),
+                 az - (p[5] * h)) - p[7];
+                break;
+            }
+            case NRAY_OP_TORUS:
+                stack[top++] = nRayLength2(nRayLength2(x - p[0], z - p[2]) -
+                 p[3], y - p[1]) - p[4];
+                break;
+            case NRAY_OP_CYLINDER:
+            {
+                const nRayVec_t dx = nRayLength2(x - p[0], z - p[2]) - p[3];
+                const nRayVec_t dy = nRayAbs(y - p[1]) - p[4];
+                stack[top++] = nRayMin(nRayMax(dx, dy), zero) +
+                 nRayLength2(nRayPositive(dx), nRayPositive(dy));
+                break;
+            }
+            case NRAY_OP_UNION:
+                top--;
+                stack[top - 1] = nRayMin(stack[top - 1], stack[top]);
+                break;
+            case NRAY_OP_INTERSECTION:
+                top--;
+                stack[top - 1] = nRayMax(stack[top - 1], stack[top]);
+                break;
+            case NRAY_OP_SUBTRACTION:
+                top--;
+                stack[top - 1] = nRayMax(stack[top - 1], -stack[top]);
+                break;
+            case NRAY_OP_SUBTRACTION_REVERSED:
+                top--;
+                stack[top - 1] = nRayMax(stack[top], -stack[top - 1]);
+                break;
+            case NRAY_OP_SMOOTH_UNION:
+            {
+                /* The blend distance and its reciprocal. */
+                top--;
+                const nRayVec_t a = stack[top - 1];
+                const nRayVec_t b = stack[top];
+                const nRayVec_t h = nRayPositive(p[0] - nRayAbs(a - b)) * p[1];
+                stack[top - 1] = nRayMin(a, b) - (h * h * (p[0] * 0.25f));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return stack[0];
+}
+
+NRAY_BODY void nRayDistanceBody(float *dst, const nRayScene_t *const scene,
+ const nVec3SoA_t points, const size_t count)
+{
+    for (size_t i = 0; i < count; i += NRAY_LANES)
+    {
+        const size_t n = ((count - i) < NRAY_LANES) ? count - i : NRAY_LANES;
+        nRayVec_t x = {0}, y = {0}, z = {0};
+        if (n == NRAY_LANES)
+        {
+            memcpy(&x, points.x + i, sizeof(x));
+            memcpy(&y, points.y + i, sizeof(y));
+            memcpy(&z, points.z + i, sizeof(z));
+        }
+        else
+        {
+            memcpy(&x, points.x + i, n * sizeof(float));
+            memcpy(&y, points.y + i, n * sizeof(float));
+            memcpy(&z, points.z + i, n * sizeof(float));
+        }
+        const nRayVec_t d = nRayEvalBody(scene, x, y, z);
+        if (n == NRAY_LANES) memcpy(dst + i, &d, sizeof(d));
+        else memcpy(dst + i, &d, n * sizeof(float));
+    }
+}
+
+/**
+ * @brief The rays in the lanes of a packet, while lanes are refilled.
+ *
+ * Writing single lanes of a vector is slow, so the lanes are stored to
+ * arrays, refilled together, and loaded again once.
+ */
+typedef struct nRayLanes {
+    float ox[NRAY_LANES], oy[NRAY_LANES], oz[NRAY_LANES]; /**< The origins. */
+    float dx[NRAY_LANES], dy[NRAY_LANES], dz[NRAY_LANES]; /**< The directions, which are normalized once loaded. */
+    float t[NRAY_LANES]; /**< The distance along each ray. */
+    float far[NRAY_LANES]; /**< The greatest distance along each ray. */
+    float step[NRAY_LANES]; /**< The length of the last step. */
+    float radius[NRAY_LANES]; /**< The distance to the scene before the last step. */
+    float omega[NRAY_LANES]; /**< The relaxation, which is 1 once a step has failed. */
+    float result[NRAY_LANES]; /**< The result of each finished ray. */
+    int32_t steps[NRAY_LANES]; /**< The number of steps taken. */
+    int32_t active[NRAY_LANES]; /**< A mask of the lanes whose ray is being traced. */
+    size_t ray[NRAY_LANES]; /**< The index of the ray of each lane. */
+} nRayLanes_t;
+
+/* Puts the next ray with a direction into a lane. Returns whether the lane
+ * has a ray, which it does not once no rays are left. The directions are
+ * normalized together once the lanes are loaded, as sqrtf() is a call in a
+ * build for size. */
+NRAY_BODY int nRayLaneLoad(nRayLanes_t *const lanes, const int l,
+ size_t *const next, float *dst, const float relaxation,
+ const nVec3SoA_t origins, const nVec3SoA_t directions, const float *tmax,
+ const size_t count)
+{
+    while (*next < count)
+    {
+        const size_t r = (*next)++;
+        const float dx = directions.x[r];
+        const float dy = directions.y[r];
+        const float dz = directions.z[r];
+        if (!(((dx * dx) + (dy * dy) + (dz * dz)) > 0.0f) ||
+         !(tmax[r] >= 0.0f))
+        {
+            dst[r] = NRAY_MISS;
+            continue;
+        }
+
+        lanes->ox[l] = origins.x[r];
+        lanes->oy[l] = origins.y[r];
+        lanes->oz[l] = origins.z[r];
+        lanes->dx[l] = dx;
+        lanes->dy[l] = dy;
+        lanes->dz[l] = dz;
+        lanes->t[l] = 0.0f;
+        lanes->far[l] = tmax[r];
+        lanes->step[l] = 0.0f;
+        lanes->radius[l] = 0.0f;
+        lanes->omega[l] = relaxation;
+        lanes->steps[l] = 0;
+        lanes->active[l] = -1;
+        lanes->ray[l] = r;
+        return 1;
+    }
+    lanes->active[l] = 0;
+    return 0;
+}
+
+NRAY_BODY void nRayMarchBody(float *dst, const nRayScene_t *const scene,
+ const nRayMarch_t *const march, const nVec3SoA_t origins,
+ const nVec3SoA_t directions, const float *tmax, const size_t count)
+{
+    const float epsilon = march->epsilon;
+    const float grazing = march->epsilon * NRAY_GRAZING;
+    const float relaxation = march->relaxation;
+    const int32_t maxSteps = (march->maxSteps > INT32_MAX) ? INT32_MAX :
+     (int32_t) march->maxSteps;
+
+    nRayLanes_t lanes;
+    memset(&lanes, 0, sizeof(lanes));
+    size_t next = 0;
+    uint32_t live = 0;
+    for (int l = 0; l < NRAY_LANES; l++)
+    {
+        if (nRayLaneLoad(&lanes, l, &next, dst, relaxation, origins,
+         directions, tmax, count)) live |= 1U << l;
+    }
+
+    while (live)
+    {
+        nRayVec_t ox, oy, oz, dx, dy, dz, t, far, step, radius, omega;
+        nRayInt_t steps, active;
+        memcpy(&ox, lanes.ox, sizeof(ox));
+        memcpy(&oy, lanes.oy, sizeof(oy));
+        memcpy(&oz, lanes.oz, sizeof(oz));
+        memcpy(&dx, lanes.dx, sizeof(dx));
+        memcpy(&dy, lanes.dy, sizeof(dy));
+        memcpy(&dz, lanes.dz, sizeof(dz));
+        memcpy(&t, lanes.t, sizeof(t));
+        const nRayVec_t length = nRaySqrt((dx * dx) + (dy * dy) + (dz * dz));
+        dx /= length;
+        dy /= length;
+        dz /= length;
+        memcpy(&far, lanes.far, sizeof(far));
+        memcpy(&step, lanes.step, sizeof(step));
+        memcpy(&radius, lanes.radius, sizeof(radius));
+        memcpy(&omega, lanes.omega, sizeof(omega));
+        memcpy(&steps, lanes.steps, sizeof(steps));
+        memcpy(&active, lanes.active, sizeof(active));
+
+        /* Finished rays only leave the mask of active lanes, so that the
+         * loop has no branches on single lanes. It stops once enough lanes
+         * are idle to be worth refilling, or once every lane is idle when no
+         * rays are left. */
+        const uint32_t refill = (next < count) ? NRAY_REFILL : NRAY_LANES;
+        nRayVec_t result = {0};
+        uint32_t idle;
+        do
+        {
+            const nRayVec_t r = nRayEvalBody(scene, ox + (t * dx),
+             oy + (t * dy), oz + (t * dz));
+            const nRayVec_t distance = nRayAbs(r);
+
+            /* A relaxed step, which is longer than the distance before it,
+             * may have passed a surface where its sphere does not overlap
+             * the sphere before it, or where it ended inside the scene. The
+             * ray then goes back to the end of the plain step, which is known
+             * to be empty, and stops over-relaxing. */
+            const nRayInt_t relaxed = nRayNegative(radius - step);
+            const nRayInt_t fail = relaxed &
+             (~nRayNegative(step - (distance + radius)) | nRayNegative(r));
+
+            /* Only the end of a plain or verified step is a hit or beyond the
+             * greatest distance. A ray whose distance is no longer finite has
+             * left the scene. */
+            const nRayInt_t lost = ~(nRayFinite(t) & nRayFinite(distance));
+            const nRayInt_t beyond = (~fail & nRayNegative(far - t)) | lost;
+            const nRayInt_t hit = ~fail & ~beyond & nRayNegative(r - epsilon);
+            const nRayVec_t forward = omega * r;
+            const nRayVec_t from = t;
+            t = nRaySelect(fail, t - step + radius, t + forward);
+            step = nRaySelect(fail, radius, forward);
+            omega = nRaySelect(fail, (nRayVec_t) {0} + 1.0f, omega);
+            radius = nRaySelect(fail, radius, distance);
+            steps += 1;
+
+            /* A plain step past the greatest distance misses, while a relaxed
+             * one is verified at its end first. A ray that runs out of steps
+             * is grazing a surface if it is still near one, and otherwise
+             * misses. */
+            const nRayInt_t miss = beyond | (nRayNegative(far - t) &
+             ~nRayNegative(radius - step));
+            const nRayInt_t spent = ~((steps - maxSteps) >> 31);
+            const nRayInt_t graze = ~fail & nRayNegative(distance - grazing);
+            const nRayInt_t done = (hit | miss | spent) & active;
+            result = nRaySelect(done, nRaySelect(hit | (~miss & graze), from,
+             (nRayVec_t) {0} + NRAY_MISS), result);
+            active &= ~done;
+            idle = ~nRayBits(active) & ((1U << NRAY_LANES) - 1);
+        } while (nRayCount(idle) < refill);
+
+        memcpy(lanes.t, &t, sizeof(t));
+        memcpy(lanes.step, &step, sizeof(step));
+        memcpy(lanes.radius, &radius, sizeof(radius));
+        memcpy(lanes.omega, &omega, sizeof(omega));
+        memcpy(lanes.result, &result, sizeof(result));
+        memcpy(lanes.steps, &steps, sizeof(steps));
+        memcpy(lanes.active, &active, sizeof(active));
+        for (uint32_t finished = idle & live; finished;
+         finished &= finished - 1)
+        {
+            const int l = __builtin_ctz(finished);
+            dst[lanes.ray[l]] = lanes.result[l];
+            live &= ~(1U << l);
+            if (nRayLaneLoad(&lanes, l, &next, dst, relaxation, origins,
+             directions, tmax, count)) live |= 1U << l;
+        }
+    }
+}
+
+static void nRayDistanceScalar(float *dst, const nRayScene_t *const scene,
+ const nVec3SoA_t points, const size_t count)
+{
+    nRayDistanceBody(dst, scene, points, count);
+}
+
+static void nRayMarchScalar(float *dst, const nRayScene_t *const scene,
+ const nRayMarch_t *const march, const nVec3SoA_t origins,
+ const nVec3SoA_t directions, const float *tmax, const size_t count)
+{
+    nRayMarchBody(dst, scene, march, origins, directions, tmax, count);
+}
+
+static const nRayKernels_t NRAY_SCALAR = {
+    .distance = nRayDistanceScalar,
+    .march = nRayMarchScalar,
+};
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static void nRayDistanceSSE42(float *dst, const nRayScene_t *const scene,
+ const nVec3SoA_t points, const size_t count)
+{
+    nRayDistanceBody(dst, scene, points, count);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nRayMarchSSE42(float *dst, const nRayScene_t *const scene,
+ const nRayMarch_t *const march, const nVec3SoA_t origins,
+ const nVec3SoA_t directions, const float *tmax, const size_t count)
+{
+    nRayMarchBody(dst, scene, march, origins, directions, tmax, count);
+}
+
+static const nRayKernels_t NRAY_SSE42 = {
+    .distance = nRayDistanceSSE42,
+    .march = nRayMarchSSE42,
+};
+
+NSIMD_TARGET("avx2,fma")
+static void nRayDistanceAVX2(float *dst, const nRayScene_t *const scene,
+ const nVec3SoA_t points, const size_t count)
+{
+    nRayDistanceBody(dst, scene, points, count);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nRayMarchAVX2(float *dst, const nRayScene_t *const scene,
+ const nRayMarch_t *const march, const nVec3SoA_t origins,
+ const nVec3SoA_t directions, const float *tmax, const size_t count)
+{
+    nRayMarchBody(dst, scene, march, origins, directions, tmax, count);
+}
+
+static const nRayKernels_t NRAY_AVX2 = {
+    .distance = nRayDistanceAVX2,
+    .march = nRayMarchAVX2,
+};
+
+NSIMD_TARGET("avx512f")
+static void nRayDistanceAVX512(float *dst, const nRayScene_t *const scene,
+ const nVec3SoA_t points, const size_t count)
+{
+    nRayDistanceBody(dst, scene, points, count);
+}
+
+NSIMD_TARGET("avx512f")
+static void nRayMarchAVX512(float *dst, const nRayScene_t *const scene,
+ const nRayMarch_t *const march, const nVec3SoA_t origins,
+ const nVec3SoA_t directions, const float *tmax, const size_t count)
+{
+    nRayMarchBody(dst, scene, march, origins, directions, tmax, count);
+}
+
+static const nRayKernels_t NRAY_AVX512 = {
+    .distance = nRayDistanceAVX512,
+    .march = nRayMarchAVX512,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(). NEON is part of ARMv8,
+ * so the scalar kernels already compile to it there. */
+static const nRayKernels_t *nRayKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NRAY_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NRAY_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NRAY_SSE42;
+        default:
+            return &NRAY_SCALAR;
+    }
+#else
+    return &NRAY_SCALAR;
+#endif
+}
+
+/* Combines two children, as opposed to being a primitive. */
+static int nRayCombines(const int op)
+{
+    return (op >= NRAY_OP_UNION) && (op <= NRAY_OP_SMOOTH_UNION);
+}
+
+/* Encodes a node as an instruction, precomputing what it can. */
+static int nRayEncode(nRayCode_t *const code, const nRayNode_t *const node,
+ const int reversed)
+{
+    const float *const p = node->params;
+    memset(code, 0, sizeof(*code));
+    code->op = node->op;
+    switch (node->op)
+    {
+        case NRAY_OP_SPHERE:
+            if (!(p[3] >= 0.0f)) return NERROR_INV_ARG;
+            memcpy(code->p, p, 4 * sizeof(float));
+            return NSUCCESS;
+        case NRAY_OP_BOX:
+            if (!(p[6] >= 0.0f) || !(p[3] >= p[6]) || !(p[4] >= p[6]) ||
+             !(p[5] >= p[6])) return NERROR_INV_ARG;
+            memcpy(code->p, p, 7 * sizeof(float));
+            code->p[3] -= p[6];
+            code->p[4] -= p[6];
+            code->p[5] -= p[6];
+            return NSUCCESS;
+        case NRAY_OP_PLANE:
+        {
+            const float length = sqrtf((p[0] * p[0]) + (p[1] * p[1]) +
+             (p[2] * p[2]));
+            if (!(length > 0.0f)) return NERROR_INV_ARG;
+            code->p[0] = p[0] / length;
+            code->p[1] = p[1] / length;
+            code->p[2] = p[2] / length;
+            code->p[3] = p[3];
+            return NSUCCESS;
+        }
+        case NRAY_OP_CAPSULE:
+        {
+            if (!(p[6] >= 0.0f)) return NERROR_INV_ARG;
+            const float bx = p[3] - p[0];
+            const float by = p[4] - p[1];
+            const float bz = p[5] - p[2];
+            const float length = (bx * bx) + (by * by) + (bz * bz);
+            memcpy(code->p, p, 3 * sizeof(float));
+            code->p[3] = bx;
+            code->p[4] = by;
+            code->p[5] = bz;
+            code->p[6] = (length > 0.0f) ? 1.0f / length : 0.0f;
+            code->p[7] = p[6];
+            return NSUCCESS;
+        }
+        case NRAY_OP_TORUS:
+        case NRAY_OP_CYLINDER:
+            if (!(p[3] >= 0.0f) || !(p[4] >= 0.0f)) return NERROR_INV_ARG;
+            memcpy(code->p, p, 5 * sizeof(float));
+            return NSUCCESS;
+        case NRAY_OP_UNION:
+        case NRAY_OP_INTERSECTION:
+            return NSUCCESS;
+        case NRAY_OP_SUBTRACTION:
+            if (reversed) code->op = NRAY_OP_SUBTRACTION_REVERSED;
+            return NSUCCESS;
+        case NRAY_OP_SMOOTH_UNION:
+            if (!(p[0] >= 0.0f)) return NERROR_INV_ARG;
+            if (p[0] == 0.0f) code->op = NRAY_OP_UNION;
+            code->p[0] = p[0];
+            code->p[1] = (p[0] > 0.0f) ? 1.0f / p[0] : 0.0f;
+            return NSUCCESS;
+        default:
+            return NERROR_INV_ARG;
+    }
+}
+
+int nRaySceneCompile(nRayScene_t **scene, const nRayNode_t *nodes,
+                     const uint32_t count, const uint32_t root)
+{
+    if (!scene || !nodes) return NERROR_NULL;
+    if ((root >= count) || (count >= NRAY_EMIT)) return NERROR_INV_ARG;
+
+    /* Children come before their parents, so the length and the stack needed
+     * by each node are known once those of the nodes before it are. A child
+     * that needs more of the stack is compiled first, so that its parent
+     * needs one more only when both need the same. */
+    uint32_t *need = nAlloc(count * sizeof(uint32_t));
+    uint32_t *length = nAlloc(count * sizeof(uint32_t));
+    uint32_t *todo = nAlloc(((size_t) count * 2 + 1) * sizeof(uint32_t));
+    nRayScene_t *s = nAlloc(sizeof(nRayScene_t));
+    int err = (need && length && todo && s) ? NSUCCESS : NERROR_NO_MEMORY;
+    if (s) s->code = NULL;
+    for (uint32_t i = 0; !err && (i < count); i++)
+    {
+        nRayCode_t code;
+        err = nRayEncode(&code, &nodes[i], 0);
+        if (err) break;
+        if (!nRayCombines(nodes[i].op))
+        {
+            need[i] = 1;
+            length[i] = 1;
+            continue;
+        }
+
+        const uint32_t a = nodes[i].children[0];
+        const uint32_t b = nodes[i].children[1];
+        if ((a >= i) || (b >= i))
+        {
+            err = NERROR_INV_ARG;
+            break;
+        }
+        need[i] = (need[a] == need[b]) ? need[a] + 1 :
+         ((need[a] > need[b]) ? need[a] : need[b]);
+        const uint64_t total = 1 + (uint64_t) length[a] + length[b];
+        length[i] = (total > NRAY_MAX_CODE) ? NRAY_MAX_CODE + 1 :
+         (uint32_t) total;
+    }
+    if (!err && ((need[root] > NRAY_MAX_STACK) ||
+     (length[root] > NRAY_MAX_CODE))) err = NERROR_INV_ARG;
+    if (!err)
+    {
+        s->code = nAlloc(length[root] * sizeof(nRayCode_t));
+        if (!s->code) err = NERROR_NO_MEMORY;
+    }
+
+    if (!err)
+    {
+        /* Writes the nodes in postfix order. A node is taken once to queue its
+         * children, and again to write it after them. */
+        size_t top = 0;
+        s->length = 0;
+        todo[top++] = root;
+        while (top)
+        {
+            const uint32_t entry = todo[--top];
+            const uint32_t i = entry & ~NRAY_EMIT;
+            const nRayNode_t *const node = &nodes[i];
+            const uint32_t a = node->children[0];
+            const uint32_t b = node->children[1];
+            const int combines = nRayCombines(node->op);
+            const int reversed = combines && (need[b] > need[a]);
+            if (!combines || (entry & NRAY_EMIT))
+            {
+                nRayEncode(&s->code[s->length++], node, reversed);
+                continue;
+            }
+
+            todo[top++] = i | NRAY_EMIT;
+            todo[top++] = reversed ? a : b;
+            todo[top++] = reversed ? b : a;
+        }
+    }
+
+    if (need) nFree((void **) &need);
+    if (length) nFree((void **) &length);
+    if (todo) nFree((void **) &todo);
+    if (err)
+    {
+        if (s && s->code) nFree((void **) &s->code);
+        if (s) nFree((void **) &s);
+        return err;
+    }
+    *scene = s;
+    return NSUCCESS;
+}
+
+void nRaySceneDestroy(nRayScene_t **scene)
+{
+    if (!scene || !*scene) return;
+    nFree((void **) &(*scene)->code);
+    nFree((void **) scene);
+}
+
+int nRaySceneDistance(float *dst, const nRayScene_t *const scene,
+                      const nVec3SoA_t points, const size_t count)
+{
+    if (!dst || !scene || !points.x || !points.y || !points.z)
+    {
+        return NERROR_NULL;
+    }
+
+    nRayKernels()->distance(dst, scene, points, count);
+    return NSUCCESS;
+}
+
+int nRaySceneNormal(const nVec3SoA_t dst, const nRayScene_t *const scene,
+                    const nVec3SoA_t points, const size_t count,
+                    const float h)
+{
+    if (!dst.x || !dst.y || !dst.z || !scene || !points.x || !points.y ||
+     !points.z) return NERROR_NULL;
+    if (!(h > 0.0f)) return NERROR_INV_ARG;
+
+    /* The corners of a tetrahedron, whose samples weighted by their corners
+     * sum to the gradient with one fewer sample than central differences. */
+    static const float corners[4][3] = {
+        { 1.0f, -1.0f, -1.0f},
+        {-1.0f, -1.0f,  1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        { 1.0f,  1.0f,  1.0f},
+    };
+    const nRayKernels_t *const kernels = nRayKernels();
+    float x[4 * NRAY_NORMAL_CHUNK], y[4 * NRAY_NORMAL_CHUNK];
+    float z[4 * NRAY_NORMAL_CHUNK], d[4 * NRAY_NORMAL_CHUNK];
+    for (size_t i = 0; i < count; i += NRAY_NORMAL_CHUNK)
+    {
+        const size_t n = ((count - i) < NRAY_NORMAL_CHUNK) ? count - i :
+         NRAY_NORMAL_CHUNK;
+        for (int c = 0; c < 4; c++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                x[(c * n) + j] = points.x[i + j] + (corners[c][0] * h);
+                y[(c * n) + j] = points.y[i + j] + (corners[c][1] * h);
+                z[(c * n) + j] = points.z[i + j] + (corners[c][2] * h);
+            }
+        }
+        kernels->distance(d, scene, (nVec3SoA_t) {x, y, z}, 4 * n);
+
+        for (size_t j = 0; j < n; j++)
+        {
+            float g[3] = {0};
+            for (int c = 0; c < 4; c++)
+            {
+                g[0] += corners[c][0] * d[(c * n) + j];
+                g[1] += corners[c][1] * d[(c * n) + j];
+                g[2] += corners[c][2] * d[(c * n) + j];
+            }
+            const float length = sqrtf((g[0] * g[0]) + (g[1] * g[1]) +
+             (g[2] * g[2]));
+            const float inverse = (length > 0.0f) ? 1.0f / length : 0.0f;
+            dst.x[i + j] = g[0] * inverse;
+            dst.y[i + j] = g[1] * inverse;
+            dst.z[i + j] = g[2] * inverse;
+        }
+    }
+    return NSUCCESS;
+}
+
+int nRayMarchValid(const nRayMarch_t *const march)
+{
+    return (march->epsilon > 0.0f) && (march->relaxation >= 1.0f) &&
+     (march->relaxation < 2.0f) && (march->maxSteps > 0);
+}
+
+int nRayMarch(float *dst, const nRayScene_t *const scene,
+              const nRayMarch_t *const march, const nVec3SoA_t origins,
+              const nVec3SoA_t directions, const float *tmax,
+              const size_t count)
+{
+    if (!dst || !scene || !march || !origins.x || !origins.y || !origins.z ||
+     !directions.x || !directions.y || !directions.z || !tmax)
+    {
+        return NERROR_NULL;
+    }
+    if (!nRayMarchValid(march)) return NERROR_INV_ARG;
+
+    nRayKernels()->march(dst, scene, march, origins, directions, tmax, count);
+    return NSUCCESS;
+}
+
+// RayMarching.c
@@ -0,0 +1,984 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * RayQuery.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/RayQuery.h"
+
+/**
+ * @file RayQuery.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines batched ray casts against meshes and scenes of signed distance fields.
+ */
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/CPUInfo.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Simd.h"
+#include "../../include/Nimble/System/Threads.h"
+
+#include <math.h>
+#include <string.h>
+
+#define NRAY_PACKET 8 /**< The number of rays that walk a mesh together. */
+#define NRAY_LEAF_SIZE 4 /**< The most triangles in a box that is not split. */
+#define NRAY_BINS 12 /**< The number of bins a box is split into to find the best split. */
+#define NRAY_MAX_DEPTH 64 /**< The deepest box of a mesh, where boxes stop being split. */
+#define NRAY_MIN_DET 1e-12f /**< The smallest determinant of a ray that is not parallel to a triangle. */
+#define NRAY_MIN_DIRECTION 1e-20f /**< The smallest part of a direction, which keeps its inverse finite. */
+#define NRAY_CELL_BITS 9 /**< The bits of the cell of an origin along each axis in the sort key. */
+#define NRAY_RADIX_BITS 10 /**< The bits of the sort key sorted in each pass. */
+#define NRAY_RADIX_PASSES 3 /**< The passes that sort the octant and cell bits of the key. */
+#define NRAY_RAYS_PER_TAKE 256 /**< The number of sorted rays a thread takes at once. */
+#define NRAY_RAYS_PER_THREAD 4096 /**< The fewest rays worth starting a thread for. */
+#define NRAY_MAX_THREADS 64 /**< The most threads that cast one batch. */
+
+/* A packet is traced with the vector extensions of the compiler on its 8
+ * lanes, and compiled for each SIMD level by inlining it into functions
+ * targeting that level, like the ray marcher. */
+typedef float nRayLanes_t __attribute__((vector_size(32))); /**< A float for each ray of a packet. */
+typedef int32_t nRayMask_t __attribute__((vector_size(32))); /**< An integer for each ray of a packet. */
+typedef int32_t nRayHalf_t __attribute__((vector_size(16))); /**< Half of the lanes. */
+
+#define NRAY_BODY static inline __attribute__((always_inline)) /**< Inlined into the function of each level. */
+
+/* The bodies are always inlined, so the ABI for passing vectors wider than
+ * the baseline registers that GCC warns about is never used. */
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/**
+ * @brief A box of the hierarchy of a mesh.
+ */
+typedef struct nRayBox {
+    float min[3]; /**< The least corner of the box. */
+    float max[3]; /**< The greatest corner of the box. */
+    uint32_t index; /**< The first of both children if @c count is 0, or else the first triangle. */
+    uint32_t count; /**< The number of triangles, or 0 if the box is split. */
+    uint32_t mask; /**< The layers of the triangles in the box. */
+    uint32_t axis; /**< The axis the box is split along. */
+} nRayBox_t;
+
+/**
+ * @brief A triangle stored for the intersection test.
+ */
+typedef struct nRayTriangle {
+    float v0[3]; /**< The first vertex. */
+    float e1[3]; /**< The second vertex minus the first. */
+    float e2[3]; /**< The third vertex minus the first. */
+    uint32_t mask; /**< The layers of the triangle. */
+    uint32_t index; /**< The index of the triangle as it was given. */
+} nRayTriangle_t;
+
+struct nRayMesh {
+    nRayBox_t *boxes; /**< The boxes, with the box of the whole mesh first. */
+    nRayTriangle_t *triangles; /**< The triangles, in the order of the leaves. */
+    uint32_t triangleCount; /**< The number of triangles. */
+};
+
+/**
+ * @brief The bounds of a triangle while a mesh is built.
+ */
+typedef struct nRayBounds {
+    float min[3]; /**< The least corner. */
+    float max[3]; /**< The greatest corner. */
+    float center[3]; /**< The center, which decides the side of a split it goes on. */
+} nRayBounds_t;
+
+/**
+ * @brief A box that is yet to be split.
+ */
+typedef struct nRayTask {
+    uint32_t box; /**< The index of the box. */
+    uint32_t first; /**< The first of its triangles. */
+    uint32_t count; /**< The number of its triangles. */
+    uint32_t depth; /**< The depth of the box. */
+} nRayTask_t;
+
+static float nRayArea(const float *const min, const float *const max)
+{
+    const float x = max[0] - min[0];
+    const float y = max[1] - min[1];
+    const float z = max[2] - min[2];
+    return (x * y) + (y * z) + (z * x);
+}
+
+static void nRayGrow(float *const min, float *const max,
+                     const float *const pmin, const float *const pmax)
+{
+    for (int a = 0; a < 3; a++)
+    {
+        if (pmin[a] < min[a]) min[a] = pmin[a];
+        if (pmax[a] > max[a]) max[a] = pmax[a];
+    }
+}
+
+/* Finds the split of a box with the least surface area heuristic by sorting
+ * the centers of its triangles into bins along each axis. Returns 0 if every
+ * center is at the same place. */
+static int nRaySplit(const nRayBounds_t *const bounds,
+                     const uint32_t *const order, const uint32_t count,
+                     uint32_t *const axis, float *const split)
+{
+    float cmin[3] = {INFINITY, INFINITY, INFINITY};
+    float cmax[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float *const c = bounds[order[i]].center;
+        nRayGrow(cmin, cmax, c, c);
+    }
+
+    float best = INFINITY;
+    for (uint32_t a = 0; a < 3; a++)
+    {
+        const float extent = cmax[a] - cmin[a];
+        if (!(extent > 0.0f)) continue;
+
+        const float scale = (float) NRAY_BINS / extent;
+        uint32_t counts[NRAY_BINS] = {0};
+        float bmin[NRAY_BINS][3];
+        float bmax[NRAY_BINS][3];
+        for (int b = 0; b < NRAY_BINS; b++)
+        {
+            bmin[b][0] = bmin[b][1] = bmin[b][2] = INFINITY;
+            bmax[b][0] = bmax[b][1] = bmax[b][2] = -INFINITY;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const nRayBounds_t *const t = &bounds[order[i]];
+            int b = (int) ((t->center[a] - cmin[a]) * scale);
+            if (b >= NRAY_BINS) b = NRAY_BINS - 1;
+            counts[b]++;
+            nRayGrow(bmin[b], bmax[b], t->min, t->max);
+        }
+
+        /* The areas of the boxes right of each split are swept from the
+         * right, then the left boxes are swept from the left. */
+        float right[NRAY_BINS];
+        float rmin[3] = {INFINITY, INFINITY, INFINITY};
+        float rmax[3] = {-INFINITY, -INFINITY, -INFINITY};
+        uint32_t rcount = 0;
+        for (int b = NRAY_BINS - 1; b > 0; b--)
+        {
+            rcount += counts[b];
+            nRayGrow(rmin, rmax, bmin[b], bmax[b]);
+            right[b] = rcount ? nRayArea(rmin, rmax) * (float) rcount : 0.0f;
+        }
+
+        float lmin[3] = {INFINITY, INFINITY, INFINITY};
+        float lmax[3] = {-INFINITY, -INFINITY, -INFINITY};
+        uint32_t lcount = 0;
+        for (int b = 1; b < NRAY_BINS; b++)
+        {
+            lcount += counts[b - 1];
+            nRayGrow(lmin, lmax, bmin[b - 1], bmax[b - 1]);
+            if (!lcount || (lcount == count)) continue;
+
+            const float cost = (nRayArea(lmin, lmax) * (float) lcount) +
+             right[b];
+            if (cost < best)
+            {
+                best = cost;
+                *axis = a;
+                *split = cmin[a] + ((float) b / scale);
+            }
+        }
+    }
+    return best < INFINITY;
+}
+
+int nRayMeshCreate(nRayMesh_t **mesh, const nVec3SoA_t vertices,
+                   const uint32_t vertexCount, const uint32_t *indices,
+                   const uint32_t *masks, const uint32_t triangles)
+{
+    if (!mesh || !vertices.x || !vertices.y || !vertices.z || !indices)
+    {
+        return NERROR_NULL;
+    }
+    for (size_t i = 0; i < (size_t) triangles * 3; i++)
+    {
+        if (indices[i] >= vertexCount) return NERROR_INV_ARG;
+    }
+
+    /* A tree of n leaves has at most 2n - 1 boxes. */
+    const size_t capacity = triangles ? ((size_t) triangles * 2) - 1 : 1;
+    nRayMesh_t *m = nAlloc(sizeof(nRayMesh_t));
+    nRayBounds_t *bounds = nAlloc((triangles + 1) * sizeof(nRayBounds_t));
+    uint32_t *order = nAlloc((triangles + 1) * sizeof(uint32_t));
+    int err = NSUCCESS;
+    if (!m || !bounds || !order)
+    {
+        err = NERROR_NO_MEMORY;
+        goto end;
+    }
+    m->triangleCount = triangles;
+    m->boxes = nAlloc(capacity * sizeof(nRayBox_t));
+    m->triangles = nAlloc((triangles + 1) * sizeof(nRayTriangle_t));
+    if (!m->boxes || !m->triangles)
+    {
+        err = NERROR_NO_MEMORY;
+        goto end;
+    }
+
+    for (uint32_t i = 0; i < triangles; i++)
+    {
+        nRayBounds_t *const b = &bounds[i];
+        b->min[0] = b->min[1] = b->min[2] = INFINITY;
+        b->max[0] = b->max[1] = b->max[2] = -INFINITY;
+        for (int v = 0; v < 3; v++)
+        {
+            const uint32_t k = indices[((size_t) i * 3) + v];
+            const float p[3] = {vertices.x[k], vertices.y[k], vertices.z[k]};
+            nRayGrow(b->min, b->max, p, p);
+        }
+        for (int a = 0; a < 3; a++)
+        {
+            b->center[a] = (b->min[a] + b->max[a]) * 0.5f;
+        }
+        order[i] = i;
+    }
+
+    /* Each split takes one task and adds two, so there are at most one more
+     * tasks than the depth. An empty mesh has no boxes. */
+    nRayTask_t tasks[NRAY_MAX_DEPTH + 2];
+    uint32_t pending = triangles ? 1 : 0;
+    uint32_t boxCount = pending;
+    tasks[0] = (nRayTask_t) {0, 0, triangles, 0};
+    while (pending)
+    {
+        const nRayTask_t task = tasks[--pending];
+        nRayBox_t *const box = &m->boxes[task.box];
+        box->min[0] = box->min[1] = box->min[2] = INFINITY;
+        box->max[0] = box->max[1] = box->max[2] = -INFINITY;
+        for (uint32_t i = task.first; i < task.first + task.count; i++)
+        {
+            nRayGrow(box->min, box->max, bounds[order[i]].min,
+             bounds[order[i]].max);
+        }
+        box->index = task.first;
+        box->count = task.count;
+        box->axis = 0;
+        if ((task.count <= NRAY_LEAF_SIZE) || (task.depth >= NRAY_MAX_DEPTH))
+        {
+            continue;
+        }
+
+        /* Triangles that share a center are split in half by order, as no
+         * plane separates them. */
+        uint32_t axis = 0;
+        float split = 0.0f;
+        uint32_t half = task.count / 2;
+        if (nRaySplit(bounds, order + task.first, task.count, &axis, &split))
+        {
+            uint32_t *lo = order + task.first;
+            uint32_t *hi = lo + task.count - 1;
+            while (lo <= hi)
+            {
+                if (bounds[*lo].center[axis] < split) lo++;
+                else
+                {
+                    const uint32_t swap = *lo;
+                    *lo = *hi;
+                    *hi-- = swap;
+                }
+            }
+            half = (uint32_t) (lo - (order + task.first));
+            /* Rounding can put every center on one side of the split. */
+            if (!half || (half == task.count)) half = task.count / 2;
+        }
+
+        box->index = boxCount;
+        box->count = 0;
+        box->axis = axis;
+        tasks[pending++] = (nRayTask_t) {boxCount + 1, task.first + half,
+         task.count - half, task.depth + 1};
+        tasks[pending++] = (nRayTask_t) {boxCount, task.first, half,
+         task.depth + 1};
+        boxCount += 2;
+    }
+
+    for (uint32_t i = 0; i < triangles; i++)
+    {
+        nRayTriangle_t *const t = &m->triangles[i];
+        const uint32_t *const k = indices + ((size_t) order[i] * 3);
+        t->v0[0] = vertices.x[k[0]];
+        t->v0[1] = vertices.y[k[0]];
+        t->v0[2] = vertices.z[k[0]];
+        t->e1[0] = vertices.x[k[1]] - t->v0[0];
+        t->e1[1] = vertices.y[k[1]] - t->v0[1];
+        t->e1[2] = vertices.z[k[1]] - t->v0[2];
+        t->e2[0] = vertices.x[k[2]] - t->v0[0];
+        t->e2[1] = vertices.y[k[2]] - t->v0[1];
+        t->e2[2] = vertices.z[k[2]] - t->v0[2];
+        t->mask = masks ? masks[order[i]] : NRAY_MASK_ALL;
+        t->index = order[i];
+    }
+
+    /* Children come after their parents, so the layers are gathered up the
+     * tree in reverse. */
+    for (uint32_t i = boxCount; i-- > 0;)
+    {
+        nRayBox_t *const box = &m->boxes[i];
+        box->mask = 0;
+        if (box->count)
+        {
+            for (uint32_t t = 0; t < box->count; t++)
+            {
+                box->mask |= m->triangles[box->index + t].mask;
+            }
+        }
+        else
+        {
+            box->mask = m->boxes[box->index].mask |
+             m->boxes[box->index + 1].mask;
+        }
+    }
+
+end:
+    if (bounds) nFree((void **) &bounds);
+    if (order) nFree((void **) &order);
+    if (err)
+    {
+        if (m && m->boxes) nFree((void **) &m->boxes);
+        if (m && m->triangles) nFree((void **) &m->triangles);
+        if (m) nFree((void **) &m);
+    }
+    *mesh = m;
+    return err;
+}
+
+void nRayMeshDestroy(nRayMesh_t **mesh)
+{
+    if (!mesh || !*mesh) return;
+    nFree((void **) &(*mesh)->boxes);
+    nFree((void **) &(*mesh)->triangles);
+    nFree((void **) mesh);
+}
+
+/**
+ * @brief Rays that walk the boxes of a mesh together, a lane of each vector
+ * for each of the #NRAY_PACKET rays.
+ *
+ * The lanes past the last ray have no distance left, so they hit nothing.
+ */
+typedef struct nRayPacket {
+    nRayLanes_t ox; /**< The X origins. */
+    nRayLanes_t oy; /**< The Y origins. */
+    nRayLanes_t oz; /**< The Z origins. */
+    nRayLanes_t dx; /**< The normalized X directions. */
+    nRayLanes_t dy; /**< The normalized Y directions. */
+    nRayLanes_t dz; /**< The normalized Z directions. */
+    nRayLanes_t ix; /**< The inverse X directions. */
+    nRayLanes_t iy; /**< The inverse Y directions. */
+    nRayLanes_t iz; /**< The inverse Z directions. */
+    nRayLanes_t t; /**< The distance to the nearest hit so far, or the greatest distance. */
+    nRayMask_t mask; /**< The layers of the rays. */
+    nRayMask_t hit; /**< The triangle nearest so far, or #NRAY_NO_PRIMITIVE. */
+} nRayPacket_t;
+
+/**
+ * @brief Traces a packet through a mesh with the kernel of one instruction
+ * set level.
+ */
+typedef void (*nRayTrace_t)(nRayPacket_t *const p,
+                            const nRayMesh_t *const mesh);
+
+static float nRayInverse(float d)
+{
+    if (fabsf(d) < NRAY_MIN_DIRECTION)
+    {
+        d = (d < 0.0f) ? -NRAY_MIN_DIRECTION : NRAY_MIN_DIRECTION;
+    }
+    return 1.0f / d;
+}
+
+/* GCC splits comparisons of vectors wider than the registers into scalar
+ * code, so masks are made by shifting sign bits instead. */
+
+/* Gets a mask of the lanes whose sign bit is set. */
+NRAY_BODY nRayMask_t nRayLaneNegative(const nRayLanes_t a)
+{
+    return (nRayMask_t) a >> 31;
+}
+
+/* Gets a mask of the lanes that are not 0. */
+NRAY_BODY nRayMask_t nRayLaneNonzero(const nRayMask_t a)
+{
+    return (a | -a) >> 31;
+}
+
+/* Selects a where the mask is set and b elsewhere. */
+NRAY_BODY nRayLanes_t nRayLaneSelect(const nRayMask_t mask,
+ const nRayLanes_t a, const nRayLanes_t b)
+{
+    return (nRayLanes_t) ((mask & (nRayMask_t) a) | (~mask & (nRayMask_t) b));
+}
+
+NRAY_BODY nRayLanes_t nRayLaneMin(const nRayLanes_t a, const nRayLanes_t b)
+{
+    return nRayLaneSelect(nRayLaneNegative(a - b), a, b);
+}
+
+NRAY_BODY nRayLanes_t nRayLaneMax(const nRayLanes_t a, const nRayLanes_t b)
+{
+    return nRayLaneSelect(nRayLaneNegative(a - b), b, a);
+}
+
+NRAY_BODY nRayLanes_t nRayLaneAbs(const nRayLanes_t a)
+{
+    return (nRayLanes_t) ((nRayMask_t) a & 0x7fffffff);
+}
+
+/* Checks if any lane of the mask is set, folding the lanes in halves. */
+NRAY_BODY int nRayLaneAny(const nRayMask_t mask)
+{
+    nRayHalf_t low, high;
+    memcpy(&low, &mask, sizeof(low));
+    memcpy(&high, (const char *) &mask + sizeof(low), sizeof(high));
+    low |= high;
+    return (low[0] | low[1] | low[2] | low[3]) != 0;
+}
+
+/* Tests a box against every ray of a packet at once. */
+NRAY_BODY int nRayPacketBox(const nRayPacket_t *const p,
+ const nRayBox_t *const box)
+{
+    const nRayLanes_t zero = {0};
+    const nRayLanes_t x0 = (box->min[0] - p->ox) * p->ix;
+    const nRayLanes_t x1 = (box->max[0] - p->ox) * p->ix;
+    const nRayLanes_t y0 = (box->min[1] - p->oy) * p->iy;
+    const nRayLanes_t y1 = (box->max[1] - p->oy) * p->iy;
+    const nRayLanes_t z0 = (box->min[2] - p->oz) * p->iz;
+    const nRayLanes_t z1 = (box->max[2] - p->oz) * p->iz;
+    const nRayLanes_t near = nRayLaneMax(nRayLaneMax(nRayLaneMin(x0, x1),
+     nRayLaneMin(y0, y1)), nRayLaneMax(nRayLaneMin(z0, z1), zero));
+    const nRayLanes_t far = nRayLaneMin(nRayLaneMin(nRayLaneMax(x0, x1),
+     nRayLaneMax(y0, y1)), nRayLaneMin(nRayLaneMax(z0, z1), p->t));
+    return nRayLaneAny(~nRayLaneNegative(far - near) &
+     nRayLaneNonzero(p->mask & (int32_t) box->mask));
+}
+
+/* Tests a triangle against every ray of a packet at once, keeping the
+ * nearest hit of each ray. */
+NRAY_BODY void nRayPacketTriangle(nRayPacket_t *const p,
+ const nRayTriangle_t *const tri, const uint32_t index)
+{
+    const nRayLanes_t zero = {0};
+    const nRayLanes_t px = (p->dy * tri->e2[2]) - (p->dz * tri->e2[1]);
+    const nRayLanes_t py = (p->dz * tri->e2[0]) - (p->dx * tri->e2[2]);
+    const nRayLanes_t pz = (p->dx * tri->e2[1]) - (p->dy * tri->e2[0]);
+    const nRayLanes_t det = (tri->e1[0] * px) + (tri->e1[1] * py) +
+     (tri->e1[2] * pz);
+    const nRayMask_t facing = nRayLaneNegative(NRAY_MIN_DET -
+     nRayLaneAbs(det));
+    const nRayLanes_t inv = 1.0f / nRayLaneSelect(facing, det, zero + 1.0f);
+
+    const nRayLanes_t sx = p->ox - tri->v0[0];
+    const nRayLanes_t sy = p->oy - tri->v0[1];
+    const nRayLanes_t sz = p->oz - tri->v0[2];
+    const nRayLanes_t u = ((sx * px) + (sy * py) + (sz * pz)) * inv;
+    const nRayLanes_t qx = (sy * tri->e1[2]) - (sz * tri->e1[1]);
+    const nRayLanes_t qy = (sz * tri->e1[0]) - (sx * tri->e1[2]);
+    const nRayLanes_t qz = (sx * tri->e1[1]) - (sy * tri->e1[0]);
+    const nRayLanes_t v = ((p->dx * qx) + (p->dy * qy) + (p->dz * qz)) * inv;
+    const nRayLanes_t t = ((tri->e2[0] * qx) + (tri->e2[1] * qy) +
+     (tri->e2[2] * qz)) * inv;
+
+    const nRayMask_t hit = facing & ~nRayLaneNegative(u) &
+     ~nRayLaneNegative(v) & ~nRayLaneNegative(1.0f - (u + v)) &
+     nRayLaneNegative(zero - t) & nRayLaneNegative(t - p->t) &
+     nRayLaneNonzero(p->mask & (int32_t) tri->mask);
+    p->t = nRayLaneSelect(hit, t, p->t);
+    p->hit = (hit & (int32_t) index) | (~hit & p->hit);
+}
+
+/* Walks the boxes a packet passes through, nearest child first along the
+ * split axis. The rays of a packet were sorted by octant, so the direction of
+ * the first ray stands for all of them. The packet is copied so that its
+ * vectors stay in registers. */
+NRAY_BODY void nRayPacketTraceBody(nRayPacket_t *const packet,
+ const nRayMesh_t *const mesh)
+{
+    nRayPacket_t p = *packet;
+    uint32_t stack[NRAY_MAX_DEPTH + 2];
+    uint32_t pending = 1;
+    stack[0] = 0;
+    const float d[3] = {p.dx[0], p.dy[0], p.dz[0]};
+    while (pending)
+    {
+        const nRayBox_t *const box = &mesh->boxes[stack[--pending]];
+        if (!nRayPacketBox(&p, box)) continue;
+
+        if (box->count)
+        {
+            for (uint32_t i = box->index; i < box->index + box->count; i++)
+            {
+                nRayPacketTriangle(&p, &mesh->triangles[i], i);
+            }
+        }
+        else
+        {
+            const uint32_t near = (d[box->axis] < 0.0f) ? 1 : 0;
+            stack[pending++] = box->index + (near ^ 1);
+            stack[pending++] = box->index + near;
+        }
+    }
+    packet->t = p.t;
+    packet->hit = p.hit;
+}
+
+static void nRayPacketTraceScalar(nRayPacket_t *const p,
+ const nRayMesh_t *const mesh)
+{
+    nRayPacketTraceBody(p, mesh);
+}
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static void nRayPacketTraceSSE42(nRayPacket_t *const p,
+ const nRayMesh_t *const mesh)
+{
+    nRayPacketTraceBody(p, mesh);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nRayPacketTraceAVX2(nRayPacket_t *const p,
+ const nRayMesh_t *const mesh)
+{
+    nRayPacketTraceBody(p, mesh);
+}
+#endif
+
+/* Gets the kernel of the level bound by nSimdBind(). A packet fills one
+ * register of AVX2, so AVX-512 uses the same kernel. NEON is part of ARMv8,
+ * so the scalar kernel already compiles to it there. */
+static nRayTrace_t nRayPacketKernel(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+        case NSIMD_LEVEL_AVX2:
+            return nRayPacketTraceAVX2;
+        case NSIMD_LEVEL_SSE42:
+            return nRayPacketTraceSSE42;
+        default:
+            return nRayPacketTraceScalar;
+    }
+#else
+    return nRayPacketTraceScalar;
+#endif
+}
+
+/**
+ * @brief A batch of rays sorted for coherence, being cast by several threads.
+ */
+typedef struct nRayQuery {
+    nRayHits_t hits; /**< The hits, in the order of the batch. */
+    const nRayBatch_t *rays; /**< The rays, in the order of the batch. */
+    const nRayMesh_t *mesh; /**< The mesh to cast against, or #NULL. */
+    const nRayScene_t *scene; /**< The scene to cast against, or #NULL. */
+    const nRayMarch_t *march; /**< The settings of the tracing of the scene. */
+    uint64_t *sorted; /**< The index in the batch of each ray that can hit anything, below its sort key, in sorted order. */
+    size_t count; /**< The number of rays that can hit anything. */
+    size_t next; /**< The next sorted ray to take, which is shared by the threads. */
+} nRayQuery_t;
+
+/**
+ * @brief A ray gathered from a batch, with a normalized direction.
+ */
+typedef struct nRayGathered {
+    float o[3]; /**< The origin. */
+    float d[3]; /**< The normalized direction. */
+    float tmax; /**< The greatest distance. */
+    uint32_t mask; /**< The layers. */
+    uint32_t index; /**< The index in the batch. */
+} nRayGathered_t;
+
+static uint32_t nRaySpread(uint32_t x)
+{
+    x = (x | (x << 16)) & 0x030000FFU;
+    x = (x | (x << 8)) & 0x0300F00FU;
+    x = (x | (x << 4)) & 0x030C30C3U;
+    x = (x | (x << 2)) & 0x09249249U;
+    return x;
+}
+
+static void nRayMiss(const nRayHits_t *const hits, const size_t i)
+{
+    hits->t[i] = NRAY_MISS;
+    if (hits->primitives) hits->primitives[i] = NRAY_NO_PRIMITIVE;
+    if (hits->normals.x)
+    {
+        hits->normals.x[i] = 0.0f;
+        hits->normals.y[i] = 0.0f;
+        hits->normals.z[i] = 0.0f;
+    }
+}
+
+/* Sorts the rays that can hit anything by the octant of their direction, then
+ * by the Morton order of the cell of their origin within the bounds of the
+ * batch. Rays that cannot hit anything miss here and are left out. The rays
+ * themselves are gathered in sorted order by the threads that cast them. */
+static int nRayQuerySort(nRayQuery_t *const query, const uint32_t layers)
+{
+    const nRayBatch_t *const rays = query->rays;
+    const size_t count = rays->count;
+    uint64_t *sorted = nAlloc((count ? count : 1) * 2 * sizeof(uint64_t));
+    if (!sorted) return NERROR_NO_MEMORY;
+
+    uint64_t *swap = sorted + count;
+    float min[3] = {INFINITY, INFINITY, INFINITY};
+    float max[3] = {-INFINITY, -INFINITY, -INFINITY};
+    size_t active = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint32_t mask = rays->masks ? rays->masks[i] : NRAY_MASK_ALL;
+        const float dx = rays->directions.x[i];
+        const float dy = rays->directions.y[i];
+        const float dz = rays->directions.z[i];
+        nRayMiss(&query->hits, i);
+        if (!(mask & layers) || !(((dx * dx) + (dy * dy) + (dz * dz)) > 0.0f))
+        {
+            continue;
+        }
+
+        const float o[3] = {rays->origins.x[i], rays->origins.y[i],
+         rays->origins.z[i]};
+        nRayGrow(min, max, o, o);
+        swap[active++] = i;
+    }
+    query->count = active;
+
+    /* Every lane of the marcher evaluates the whole scene wherever its ray
+     * goes, so only rays cast against a mesh gain from being sorted. */
+    if (!query->mesh)
+    {
+        memcpy(sorted, swap, active * sizeof(uint64_t));
+        query->sorted = sorted;
+        return NSUCCESS;
+    }
+
+    const float cells = (float) ((1U << NRAY_CELL_BITS) - 1);
+    float scale[3];
+    for (int a = 0; a < 3; a++)
+    {
+        const float extent = max[a] - min[a];
+        scale[a] = (extent > 0.0f) ? cells / extent : 0.0f;
+    }
+
+    /* The digits of every pass are counted at once while the keys are made. */
+    uint32_t offsets[NRAY_RADIX_PASSES][1 << NRAY_RADIX_BITS];
+    memset(offsets, 0, sizeof(offsets));
+    for (size_t i = 0; i < active; i++)
+    {
+        const size_t r = (size_t) swap[i];
+        const uint32_t octant = (rays->directions.x[r] < 0.0f) |
+         ((rays->directions.y[r] < 0.0f) << 1) |
+         ((rays->directions.z[r] < 0.0f) << 2);
+        const uint32_t cx = (uint32_t) ((rays->origins.x[r] - min[0]) *
+         scale[0]);
+        const uint32_t cy = (uint32_t) ((rays->origins.y[r] - min[1]) *
+         scale[1]);
+        const uint32_t cz = (uint32_t) ((rays->origins.z[r] - min[2]) *
+         scale[2]);
+        const uint32_t key = (octant << (NRAY_CELL_BITS * 3)) |
+         nRaySpread(cx) | (nRaySpread(cy) << 1) | (nRaySpread(cz) << 2);
+        sorted[i] = ((uint64_t) key << 32) | r;
+        for (int p = 0; p < NRAY_RADIX_PASSES; p++)
+        {
+            offsets[p][(key >> (p * NRAY_RADIX_BITS)) &
+             ((1 << NRAY_RADIX_BITS) - 1)]++;
+        }
+    }
+
+    /* Least significant digit radix sort, skipping digits every key shares. */
+    for (int p = 0; p < NRAY_RADIX_PASSES; p++)
+    {
+        const int shift = 32 + (p * NRAY_RADIX_BITS);
+        const uint32_t digit = (1 << NRAY_RADIX_BITS) - 1;
+        uint32_t *const offset = offsets[p];
+        if (!active || (offset[(sorted[0] >> shift) & digit] == active))
+        {
+            continue;
+        }
+
+        uint32_t sum = 0;
+        for (int d = 0; d <= (int) digit; d++)
+        {
+            const uint32_t n = offset[d];
+            offset[d] = sum;
+            sum += n;
+        }
+        for (size_t i = 0; i < active; i++)
+        {
+            swap[offset[(sorted[i] >> shift) & digit]++] = sorted[i];
+        }
+        uint64_t *const s = sorted;
+        sorted = swap;
+        swap = s;
+    }
+
+    /* The buffer is freed from its start, whichever half holds the result. */
+    if (sorted > swap) memcpy(swap, sorted, active * sizeof(uint64_t));
+    query->sorted = (sorted < swap) ? sorted : swap;
+    return NSUCCESS;
+}
+
+static void nRayGather(nRayGathered_t *const ray,
+                       const nRayQuery_t *const query, const size_t i)
+{
+    const nRayBatch_t *const rays = query->rays;
+    const uint32_t r = (uint32_t) query->sorted[i];
+    const float dx = rays->directions.x[r];
+    const float dy = rays->directions.y[r];
+    const float dz = rays->directions.z[r];
+    const float length = 1.0f / sqrtf((dx * dx) + (dy * dy) + (dz * dz));
+    ray->o[0] = rays->origins.x[r];
+    ray->o[1] = rays->origins.y[r];
+    ray->o[2] = rays->origins.z[r];
+    ray->d[0] = dx * length;
+    ray->d[1] = dy * length;
+    ray->d[2] = dz * length;
+    ray->tmax = rays->tmax[r];
+    ray->mask = rays->masks ? rays->masks[r] : NRAY_MASK_ALL;
+    ray->index = r;
+}
+
+static void nRayQueryMeshRays(nRayQuery_t *const query, const size_t first,
+                              const size_t last)
+{
+    const nRayHits_t *const hits = &query->hits;
+    const nRayTrace_t trace = nRayPacketKernel();
+    nRayPacket_t p;
+    uint32_t index[NRAY_PACKET];
+    for (size_t i = first; i < last; i += NRAY_PACKET)
+    {
+        const size_t lanes = ((last - i) < NRAY_PACKET) ? last - i : NRAY_PACKET;
+        for (size_t l = 0; l < NRAY_PACKET; l++)
+        {
+            nRayGathered_t ray;
+            nRayGather(&ray, query, i + ((l < lanes) ? l : 0));
+            p.ox[l] = ray.o[0];
+            p.oy[l] = ray.o[1];
+            p.oz[l] = ray.o[2];
+            p.dx[l] = ray.d[0];
+            p.dy[l] = ray.d[1];
+            p.dz[l] = ray.d[2];
+            p.ix[l] = nRayInverse(ray.d[0]);
+            p.iy[l] = nRayInverse(ray.d[1]);
+            p.iz[l] = nRayInverse(ray.d[2]);
+            p.t[l] = (l < lanes) ? ray.tmax : -1.0f;
+            p.mask[l] = (l < lanes) ? (int32_t) ray.mask : 0;
+            p.hit[l] = (int32_t) NRAY_NO_PRIMITIVE;
+            index[l] = ray.index;
+        }
+        trace(&p, query->mesh);
+
+        for (size_t l = 0; l < lanes; l++)
+        {
+            const uint32_t hit = (uint32_t) p.hit[l];
+            if (hit == NRAY_NO_PRIMITIVE) continue;
+
+            const nRayTriangle_t *const tri = &query->mesh->triangles[hit];
+            const uint32_t r = index[l];
+            hits->t[r] = p.t[l];
+            if (hits->primitives) hits->primitives[r] = tri->index;
+            if (!hits->normals.x) continue;
+
+            float nx = (tri->e1[1] * tri->e2[2]) - (tri->e1[2] * tri->e2[1]);
+            float ny = (tri->e1[2] * tri->e2[0]) - (tri->e1[0] * tri->e2[2]);
+            float nz = (tri->e1[0] * tri->e2[1]) - (tri->e1[1] * tri->e2[0]);
+            float scale = 1.0f / sqrtf((nx * nx) + (ny * ny) + (nz * nz));
+            if (((nx * p.dx[l]) + (ny * p.dy[l]) + (nz * p.dz[l])) > 0.0f)
+            {
+                scale = -scale;
+            }
+            hits->normals.x[r] = nx * scale;
+            hits->normals.y[r] = ny * scale;
+            hits->normals.z[r] = nz * scale;
+        }
+    }
+}
+
+static void nRayQuerySceneRays(nRayQuery_t *const query, const size_t first,
+                               const size_t last)
+{
+    const nRayHits_t *const hits = &query->hits;
+    const size_t count = last - first;
+    float ox[NRAY_RAYS_PER_TAKE], oy[NRAY_RAYS_PER_TAKE];
+    float oz[NRAY_RAYS_PER_TAKE], dx[NRAY_RAYS_PER_TAKE];
+    float dy[NRAY_RAYS_PER_TAKE], dz[NRAY_RAYS_PER_TAKE];
+    float tmax[NRAY_RAYS_PER_TAKE], t[NRAY_RAYS_PER_TAKE];
+    uint32_t index[NRAY_RAYS_PER_TAKE];
+    for (size_t i = 0; i < count; i++)
+    {
+        nRayGathered_t ray;
+        nRayGather(&ray, query, first + i);
+        ox[i] = ray.o[0];
+        oy[i] = ray.o[1];
+        oz[i] = ray.o[2];
+        dx[i] = ray.d[0];
+        dy[i] = ray.d[1];
+        dz[i] = ray.d[2];
+        tmax[i] = ray.tmax;
+        index[i] = ray.index;
+    }
+    nRayMarch(t, query->scene, query->march, (nVec3SoA_t) {ox, oy, oz},
+     (nVec3SoA_t) {dx, dy, dz}, tmax, count);
+    for (size_t i = 0; i < count; i++) hits->t[index[i]] = t[i];
+    if (!hits->normals.x) return;
+
+    /* Misses are estimated at their origins, then cleared. The hit points
+     * replace the origins, and the normals replace the directions. */
+    for (size_t i = 0; i < count; i++)
+    {
+        const float s = (t[i] > 0.0f) ? t[i] : 0.0f;
+        ox[i] += dx[i] * s;
+        oy[i] += dy[i] * s;
+        oz[i] += dz[i] * s;
+    }
+    nRaySceneNormal((nVec3SoA_t) {dx, dy, dz}, query->scene,
+     (nVec3SoA_t) {ox, oy, oz}, count, query->march->epsilon);
+    for (size_t i = 0; i < count; i++)
+    {
+        const int hit = t[i] != NRAY_MISS;
+        hits->normals.x[index[i]] = hit ? dx[i] : 0.0f;
+        hits->normals.y[index[i]] = hit ? dy[i] : 0.0f;
+        hits->normals.z[index[i]] = hit ? dz[i] : 0.0f;
+    }
+}
+
+static void nRayQueryRays(nRayQuery_t *const query)
+{
+    for (;;)
+    {
+        const size_t first = __atomic_fetch_add(&query->next,
+         NRAY_RAYS_PER_TAKE, __ATOMIC_RELAXED);
+        if (first >= query->count) return;
+
+        const size_t last = ((query->count - first) < NRAY_RAYS_PER_TAKE) ?
+         query->count : first + NRAY_RAYS_PER_TAKE;
+        if (query->mesh) nRayQueryMeshRays(query, first, last);
+        else nRayQuerySceneRays(query, first, last);
+    }
+}
+
+static nThreadRoutine_t nRayQueryWorkerRoutine(void *data)
+{
+    nRayQueryRays((nRayQuery_t *) data);
+    return (nThreadRoutine_t) 0;
+}
+
+static int nRayQueryRun(nRayQuery_t *const query, const uint32_t layers,
+                        uint32_t threads)
+{
+    /* The rays are sorted with their index in 32 bits. */
+    if (query->rays->count > UINT32_MAX) return NERROR_INV_ARG;
+
+    const int err = nRayQuerySort(query, layers);
+    if (err) return err;
+
+    if (!threads)
+    {
+        if (!NCPU_DETAILS.logicalCores) nSysGetCPUInfo(NULL);
+        threads = NCPU_DETAILS.logicalCores ? NCPU_DETAILS.logicalCores : 1;
+    }
+    /* Each thread needs enough rays to pay for starting it. */
+    if (threads > query->count / NRAY_RAYS_PER_THREAD)
+    {
+        threads = (uint32_t) (query->count / NRAY_RAYS_PER_THREAD);
+    }
+    if (threads > NRAY_MAX_THREADS) threads = NRAY_MAX_THREADS;
+    if (!threads) threads = 1;
+
+    nThread_t workers[NRAY_MAX_THREADS - 1];
+    uint32_t started = 0;
+    while ((started < threads - 1) &&
+     !nThreadCreate(&workers[started], nRayQueryWorkerRoutine, query))
+    {
+        started++;
+    }
+    nRayQueryRays(query);
+    for (uint32_t i = 0; i < started; i++) nThreadJoin(workers[i], NULL);
+
+    nFree((void **) &query->sorted);
+    return NSUCCESS;
+}
+
+static int nRayBatchValid(const nRayHits_t *const hits,
+                          const nRayBatch_t *const rays)
+{
+    return hits->t && rays->origins.x && rays->origins.y && rays->origins.z &&
+     rays->directions.x && rays->directions.y && rays->directions.z &&
+     rays->tmax && (!hits->normals.x || (hits->normals.y && hits->normals.z));
+}
+
+int nRayQueryMesh(const nRayHits_t hits, const nRayMesh_t *const mesh,
+                  const nRayBatch_t *const rays, uint32_t threads)
+{
+    if (!mesh || !rays || !nRayBatchValid(&hits, rays)) return NERROR_NULL;
+
+    nRayQuery_t query = {
+        .hits = hits,
+        .rays = rays,
+        .mesh = mesh,
+        .next = 0,
+    };
+    /* Rays that share no layer with the whole mesh miss without being cast. */
+    const uint32_t layers = mesh->triangleCount ? mesh->boxes[0].mask : 0;
+    return nRayQueryRun(&query, layers, threads);
+}
+
+int nRayQueryScene(const nRayHits_t hits, const nRayScene_t *const scene,
+                   const nRayMarch_t *const march, const uint32_t mask,
+                   const nRayBatch_t *const rays, uint32_t threads)
+{
+    if (!scene || !march || !rays || !nRayBatchValid(&hits, rays))
+    {
+        return NERROR_NULL;
+    }
+    if (!nRayMarchValid(march)) return NERROR_INV_ARG;
+
+    nRayQuery_t query = {
+        .hits = hits,
+        .rays = rays,
+        .scene = scene,
+        .march = march,
+        .next = 0,
+    };
+    return nRayQueryRun(&query, mask, threads);
+}
+
+// RayQuery.c
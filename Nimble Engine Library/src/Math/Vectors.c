@@ -0,0 +1,707 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Vectors.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Math/Vectors.h"
+
+/**
+ * @file Vectors.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines vector math on arrays of vectors.
+ */
+
+#include "../../include/Nimble/System/Simd.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+#  include <arm_neon.h>
+#endif
+
+/**
+ * @brief The batch kernels of one instruction set level.
+ */
+typedef struct nVecKernels {
+    void (*dot3)(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+     const size_t count);
+    void (*cross3)(const nVec3SoA_t dst, const nVec3SoA_t a, const nVec3SoA_t b,
+     const size_t count);
+    void (*length3)(float *dst, const nVec3SoA_t a, const size_t count);
+    void (*normalize3)(const nVec3SoA_t dst, const nVec3SoA_t a,
+     const size_t count);
+    void (*lerp3)(const nVec3SoA_t dst, const nVec3SoA_t a, const nVec3SoA_t b,
+     const float t, const size_t count);
+    void (*dot4)(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+     const size_t count);
+} nVecKernels_t;
+
+/* Gets the vectors of a from index i on, for the scalar kernels to finish
+ * what does not fill a register. */
+static nVec3SoA_t nVec3SoAFrom(const nVec3SoA_t a, const size_t i)
+{
+    return (nVec3SoA_t) {.x = a.x + i, .y = a.y + i, .z = a.z + i};
+}
+
+static nVec4SoA_t nVec4SoAFrom(const nVec4SoA_t a, const size_t i)
+{
+    return (nVec4SoA_t) {.x = a.x + i, .y = a.y + i, .z = a.z + i,
+     .w = a.w + i};
+}
+
+static void nVec3DotScalar(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]);
+    }
+}
+
+static void nVec3CrossScalar(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float x = (a.y[i] * b.z[i]) - (a.z[i] * b.y[i]);
+        const float y = (a.z[i] * b.x[i]) - (a.x[i] * b.z[i]);
+        const float z = (a.x[i] * b.y[i]) - (a.y[i] * b.x[i]);
+        dst.x[i] = x;
+        dst.y[i] = y;
+        dst.z[i] = z;
+    }
+}
+
+static void nVec3LengthScalar(float *dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = sqrtf((a.x[i] * a.x[i]) + (a.y[i] * a.y[i]) +
+         (a.z[i] * a.z[i]));
+    }
+}
+
+static void nVec3NormalizeScalar(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float len = sqrtf((a.x[i] * a.x[i]) + (a.y[i] * a.y[i]) +
+         (a.z[i] * a.z[i]));
+        const float inv = (len > 0.0f) ? 1.0f / len : 0.0f;
+        dst.x[i] = a.x[i] * inv;
+        dst.y[i] = a.y[i] * inv;
+        dst.z[i] = a.z[i] * inv;
+    }
+}
+
+static void nVec3LerpScalar(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const float t, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst.x[i] = a.x[i] + ((b.x[i] - a.x[i]) * t);
+        dst.y[i] = a.y[i] + ((b.y[i] - a.y[i]) * t);
+        dst.z[i] = a.z[i] + ((b.z[i] - a.z[i]) * t);
+    }
+}
+
+static void nVec4DotScalar(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]) +
+         (a.w[i] * b.w[i]);
+    }
+}
+
+static const nVecKernels_t NVEC_SCALAR = {
+    .dot3 = nVec3DotScalar,
+    .cross3 = nVec3CrossScalar,
+    .length3 = nVec3LengthScalar,
+    .normalize3 = nVec3NormalizeScalar,
+    .lerp3 = nVec3LerpScalar,
+    .dot4 = nVec4DotScalar,
+};
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static void nVec3DotSSE42(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 r = _mm_mul_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.y + i),
+         _mm_loadu_ps(b.y + i)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.z + i),
+         _mm_loadu_ps(b.z + i)));
+        _mm_storeu_ps(dst + i, r);
+    }
+    nVec3DotScalar(dst + i, nVec3SoAFrom(a, i), nVec3SoAFrom(b, i), count - i);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nVec3CrossSSE42(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 ax = _mm_loadu_ps(a.x + i), ay = _mm_loadu_ps(a.y + i);
+        const __m128 az = _mm_loadu_ps(a.z + i), bx = _mm_loadu_ps(b.x + i);
+        const __m128 by = _mm_loadu_ps(b.y + i), bz = _mm_loadu_ps(b.z + i);
+        _mm_storeu_ps(dst.x + i, _mm_sub_ps(_mm_mul_ps(ay, bz),
+         _mm_mul_ps(az, by)));
+        _mm_storeu_ps(dst.y + i, _mm_sub_ps(_mm_mul_ps(az, bx),
+         _mm_mul_ps(ax, bz)));
+        _mm_storeu_ps(dst.z + i, _mm_sub_ps(_mm_mul_ps(ax, by),
+         _mm_mul_ps(ay, bx)));
+    }
+    nVec3CrossScalar(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i),
+     nVec3SoAFrom(b, i), count - i);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nVec3LengthSSE42(float *dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(a.x + i), y = _mm_loadu_ps(a.y + i);
+        const __m128 z = _mm_loadu_ps(a.z + i);
+        _mm_storeu_ps(dst + i, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(
+         _mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+    }
+    nVec3LengthScalar(dst + i, nVec3SoAFrom(a, i), count - i);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nVec3NormalizeSSE42(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(a.x + i), y = _mm_loadu_ps(a.y + i);
+        const __m128 z = _mm_loadu_ps(a.z + i);
+        const __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x),
+         _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 inv = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(lenSq)),
+         _mm_cmpgt_ps(lenSq, zero));
+        _mm_storeu_ps(dst.x + i, _mm_mul_ps(x, inv));
+        _mm_storeu_ps(dst.y + i, _mm_mul_ps(y, inv));
+        _mm_storeu_ps(dst.z + i, _mm_mul_ps(z, inv));
+    }
+    nVec3NormalizeScalar(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i), count - i);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nVec3LerpSSE42(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const float t, const size_t count)
+{
+    const __m128 tv = _mm_set1_ps(t);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 ax = _mm_loadu_ps(a.x + i), ay = _mm_loadu_ps(a.y + i);
+        const __m128 az = _mm_loadu_ps(a.z + i);
+        _mm_storeu_ps(dst.x + i, _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(
+         _mm_loadu_ps(b.x + i), ax), tv)));
+        _mm_storeu_ps(dst.y + i, _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(
+         _mm_loadu_ps(b.y + i), ay), tv)));
+        _mm_storeu_ps(dst.z + i, _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(
+         _mm_loadu_ps(b.z + i), az), tv)));
+    }
+    nVec3LerpScalar(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i),
+     nVec3SoAFrom(b, i), t, count - i);
+}
+
+NSIMD_TARGET("sse4.2")
+static void nVec4DotSSE42(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 r = _mm_mul_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.y + i),
+         _mm_loadu_ps(b.y + i)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.z + i),
+         _mm_loadu_ps(b.z + i)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.w + i),
+         _mm_loadu_ps(b.w + i)));
+        _mm_storeu_ps(dst + i, r);
+    }
+    nVec4DotScalar(dst + i, nVec4SoAFrom(a, i), nVec4SoAFrom(b, i), count - i);
+}
+
+static const nVecKernels_t NVEC_SSE42 = {
+    .dot3 = nVec3DotSSE42,
+    .cross3 = nVec3CrossSSE42,
+    .length3 = nVec3LengthSSE42,
+    .normalize3 = nVec3NormalizeSSE42,
+    .lerp3 = nVec3LerpSSE42,
+    .dot4 = nVec4DotSSE42,
+};
+
+NSIMD_TARGET("avx2,fma")
+static void nVec3DotAVX2(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 r = _mm256_mul_ps(_mm256_loadu_ps(a.x + i),
+         _mm256_loadu_ps(b.x + i));
+        r = _mm256_fmadd_ps(_mm256_loadu_ps(a.y + i), _mm256_loadu_ps(b.y + i),
+         r);
+        r = _mm256_fmadd_ps(_mm256_loadu_ps(a.z + i), _mm256_loadu_ps(b.z + i),
+         r);
+        _mm256_storeu_ps(dst + i, r);
+    }
+    nVec3DotSSE42(dst + i, nVec3SoAFrom(a, i), nVec3SoAFrom(b, i), count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nVec3CrossAVX2(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 ax = _mm256_loadu_ps(a.x + i);
+        const __m256 ay = _mm256_loadu_ps(a.y + i);
+        const __m256 az = _mm256_loadu_ps(a.z + i);
+        const __m256 bx = _mm256_loadu_ps(b.x + i);
+        const __m256 by = _mm256_loadu_ps(b.y + i);
+        const __m256 bz = _mm256_loadu_ps(b.z + i);
+        _mm256_storeu_ps(dst.x + i, _mm256_fmsub_ps(ay, bz,
+         _mm256_mul_ps(az, by)));
+        _mm256_storeu_ps(dst.y + i, _mm256_fmsub_ps(az, bx,
+         _mm256_mul_ps(ax, bz)));
+        _mm256_storeu_ps(dst.z + i, _mm256_fmsub_ps(ax, by,
+         _mm256_mul_ps(ay, bx)));
+    }
+    nVec3CrossSSE42(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i),
+     nVec3SoAFrom(b, i), count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nVec3LengthAVX2(float *dst, const nVec3SoA_t a, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(a.x + i);
+        const __m256 y = _mm256_loadu_ps(a.y + i);
+        const __m256 z = _mm256_loadu_ps(a.z + i);
+        _mm256_storeu_ps(dst + i, _mm256_sqrt_ps(_mm256_fmadd_ps(x, x,
+         _mm256_fmadd_ps(y, y, _mm256_mul_ps(z, z)))));
+    }
+    nVec3LengthSSE42(dst + i, nVec3SoAFrom(a, i), count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nVec3NormalizeAVX2(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(a.x + i);
+        const __m256 y = _mm256_loadu_ps(a.y + i);
+        const __m256 z = _mm256_loadu_ps(a.z + i);
+        const __m256 lenSq = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y,
+         _mm256_mul_ps(z, z)));
+        const __m256 inv = _mm256_and_ps(_mm256_div_ps(one,
+         _mm256_sqrt_ps(lenSq)), _mm256_cmp_ps(lenSq, zero, _CMP_GT_OQ));
+        _mm256_storeu_ps(dst.x + i, _mm256_mul_ps(x, inv));
+        _mm256_storeu_ps(dst.y + i, _mm256_mul_ps(y, inv));
+        _mm256_storeu_ps(dst.z + i, _mm256_mul_ps(z, inv));
+    }
+    nVec3NormalizeSSE42(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i), count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nVec3LerpAVX2(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const float t, const size_t count)
+{
+    const __m256 tv = _mm256_set1_ps(t);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 ax = _mm256_loadu_ps(a.x + i);
+        const __m256 ay = _mm256_loadu_ps(a.y + i);
+        const __m256 az = _mm256_loadu_ps(a.z + i);
+        _mm256_storeu_ps(dst.x + i, _mm256_fmadd_ps(_mm256_sub_ps(
+         _mm256_loadu_ps(b.x + i), ax), tv, ax));
+        _mm256_storeu_ps(dst.y + i, _mm256_fmadd_ps(_mm256_sub_ps(
+         _mm256_loadu_ps(b.y + i), ay), tv, ay));
+        _mm256_storeu_ps(dst.z + i, _mm256_fmadd_ps(_mm256_sub_ps(
+         _mm256_loadu_ps(b.z + i), az), tv, az));
+    }
+    nVec3LerpSSE42(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i),
+     nVec3SoAFrom(b, i), t, count - i);
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nVec4DotAVX2(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 r = _mm256_mul_ps(_mm256_loadu_ps(a.x + i),
+         _mm256_loadu_ps(b.x + i));
+        r = _mm256_fmadd_ps(_mm256_loadu_ps(a.y + i), _mm256_loadu_ps(b.y + i),
+         r);
+        r = _mm256_fmadd_ps(_mm256_loadu_ps(a.z + i), _mm256_loadu_ps(b.z + i),
+         r);
+        r = _mm256_fmadd_ps(_mm256_loadu_ps(a.w + i), _mm256_loadu_ps(b.w + i),
+         r);
+        _mm256_storeu_ps(dst + i, r);
+    }
+    nVec4DotSSE42(dst + i, nVec4SoAFrom(a, i), nVec4SoAFrom(b, i), count - i);
+}
+
+static const nVecKernels_t NVEC_AVX2 = {
+    .dot3 = nVec3DotAVX2,
+    .cross3 = nVec3CrossAVX2,
+    .length3 = nVec3LengthAVX2,
+    .normalize3 = nVec3NormalizeAVX2,
+    .lerp3 = nVec3LerpAVX2,
+    .dot4 = nVec4DotAVX2,
+};
+
+/* The AVX-512 kernels finish with a masked iteration rather than falling back
+ * to narrower kernels. */
+#define NVEC_MASK(n) ((__mmask16) ((1U << (n)) - 1))
+
+NSIMD_TARGET("avx512f")
+static void nVec3DotAVX512(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 m = (count - i >= 16) ? 0xffff : NVEC_MASK(count - i);
+        __m512 r = _mm512_mul_ps(_mm512_maskz_loadu_ps(m, a.x + i),
+         _mm512_maskz_loadu_ps(m, b.x + i));
+        r = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a.y + i),
+         _mm512_maskz_loadu_ps(m, b.y + i), r);
+        r = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a.z + i),
+         _mm512_maskz_loadu_ps(m, b.z + i), r);
+        _mm512_mask_storeu_ps(dst + i, m, r);
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nVec3CrossAVX512(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const size_t count)
+{
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 m = (count - i >= 16) ? 0xffff : NVEC_MASK(count - i);
+        const __m512 ax = _mm512_maskz_loadu_ps(m, a.x + i);
+        const __m512 ay = _mm512_maskz_loadu_ps(m, a.y + i);
+        const __m512 az = _mm512_maskz_loadu_ps(m, a.z + i);
+        const __m512 bx = _mm512_maskz_loadu_ps(m, b.x + i);
+        const __m512 by = _mm512_maskz_loadu_ps(m, b.y + i);
+        const __m512 bz = _mm512_maskz_loadu_ps(m, b.z + i);
+        _mm512_mask_storeu_ps(dst.x + i, m, _mm512_fmsub_ps(ay, bz,
+         _mm512_mul_ps(az, by)));
+        _mm512_mask_storeu_ps(dst.y + i, m, _mm512_fmsub_ps(az, bx,
+         _mm512_mul_ps(ax, bz)));
+        _mm512_mask_storeu_ps(dst.z + i, m, _mm512_fmsub_ps(ax, by,
+         _mm512_mul_ps(ay, bx)));
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nVec3LengthAVX512(float *dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 m = (count - i >= 16) ? 0xffff : NVEC_MASK(count - i);
+        const __m512 x = _mm512_maskz_loadu_ps(m, a.x + i);
+        const __m512 y = _mm512_maskz_loadu_ps(m, a.y + i);
+        const __m512 z = _mm512_maskz_loadu_ps(m, a.z + i);
+        _mm512_mask_storeu_ps(dst + i, m, _mm512_sqrt_ps(_mm512_fmadd_ps(x, x,
+         _mm512_fmadd_ps(y, y, _mm512_mul_ps(z, z)))));
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nVec3NormalizeAVX512(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1.0f);
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 m = (count - i >= 16) ? 0xffff : NVEC_MASK(count - i);
+        const __m512 x = _mm512_maskz_loadu_ps(m, a.x + i);
+        const __m512 y = _mm512_maskz_loadu_ps(m, a.y + i);
+        const __m512 z = _mm512_maskz_loadu_ps(m, a.z + i);
+        const __m512 lenSq = _mm512_fmadd_ps(x, x, _mm512_fmadd_ps(y, y,
+         _mm512_mul_ps(z, z)));
+        const __m512 inv = _mm512_maskz_div_ps(_mm512_cmp_ps_mask(lenSq, zero,
+         _CMP_GT_OQ), one, _mm512_sqrt_ps(lenSq));
+        _mm512_mask_storeu_ps(dst.x + i, m, _mm512_mul_ps(x, inv));
+        _mm512_mask_storeu_ps(dst.y + i, m, _mm512_mul_ps(y, inv));
+        _mm512_mask_storeu_ps(dst.z + i, m, _mm512_mul_ps(z, inv));
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nVec3LerpAVX512(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const float t, const size_t count)
+{
+    const __m512 tv = _mm512_set1_ps(t);
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 m = (count - i >= 16) ? 0xffff : NVEC_MASK(count - i);
+        const __m512 ax = _mm512_maskz_loadu_ps(m, a.x + i);
+        const __m512 ay = _mm512_maskz_loadu_ps(m, a.y + i);
+        const __m512 az = _mm512_maskz_loadu_ps(m, a.z + i);
+        _mm512_mask_storeu_ps(dst.x + i, m, _mm512_fmadd_ps(_mm512_sub_ps(
+         _mm512_maskz_loadu_ps(m, b.x + i), ax), tv, ax));
+        _mm512_mask_storeu_ps(dst.y + i, m, _mm512_fmadd_ps(_mm512_sub_ps(
+         _mm512_maskz_loadu_ps(m, b.y + i), ay), tv, ay));
+        _mm512_mask_storeu_ps(dst.z + i, m, _mm512_fmadd_ps(_mm512_sub_ps(
+         _mm512_maskz_loadu_ps(m, b.z + i), az), tv, az));
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static void nVec4DotAVX512(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+ const size_t count)
+{
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const __mmask16 m = (count - i >= 16) ? 0xffff : NVEC_MASK(count - i);
+        __m512 r = _mm512_mul_ps(_mm512_maskz_loadu_ps(m, a.x + i),
+         _mm512_maskz_loadu_ps(m, b.x + i));
+        r = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a.y + i),
+         _mm512_maskz_loadu_ps(m, b.y + i), r);
+        r = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a.z + i),
+         _mm512_maskz_loadu_ps(m, b.z + i), r);
+        r = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a.w + i),
+         _mm512_maskz_loadu_ps(m, b.w + i), r);
+        _mm512_mask_storeu_ps(dst + i, m, r);
+    }
+}
+
+static const nVecKernels_t NVEC_AVX512 = {
+    .dot3 = nVec3DotAVX512,
+    .cross3 = nVec3CrossAVX512,
+    .length3 = nVec3LengthAVX512,
+    .normalize3 = nVec3NormalizeAVX512,
+    .lerp3 = nVec3LerpAVX512,
+    .dot4 = nVec4DotAVX512,
+};
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+static void nVec3DotNEON(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t r = vmulq_f32(vld1q_f32(a.x + i), vld1q_f32(b.x + i));
+        r = vfmaq_f32(r, vld1q_f32(a.y + i), vld1q_f32(b.y + i));
+        r = vfmaq_f32(r, vld1q_f32(a.z + i), vld1q_f32(b.z + i));
+        vst1q_f32(dst + i, r);
+    }
+    nVec3DotScalar(dst + i, nVec3SoAFrom(a, i), nVec3SoAFrom(b, i), count - i);
+}
+
+static void nVec3CrossNEON(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t ax = vld1q_f32(a.x + i), ay = vld1q_f32(a.y + i);
+        const float32x4_t az = vld1q_f32(a.z + i), bx = vld1q_f32(b.x + i);
+        const float32x4_t by = vld1q_f32(b.y + i), bz = vld1q_f32(b.z + i);
+        vst1q_f32(dst.x + i, vfmsq_f32(vmulq_f32(ay, bz), az, by));
+        vst1q_f32(dst.y + i, vfmsq_f32(vmulq_f32(az, bx), ax, bz));
+        vst1q_f32(dst.z + i, vfmsq_f32(vmulq_f32(ax, by), ay, bx));
+    }
+    nVec3CrossScalar(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i),
+     nVec3SoAFrom(b, i), count - i);
+}
+
+static void nVec3LengthNEON(float *dst, const nVec3SoA_t a, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t x = vld1q_f32(a.x + i), y = vld1q_f32(a.y + i);
+        const float32x4_t z = vld1q_f32(a.z + i);
+        vst1q_f32(dst + i, vsqrtq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(z, z), y,
+         y), x, x)));
+    }
+    nVec3LengthScalar(dst + i, nVec3SoAFrom(a, i), count - i);
+}
+
+static void nVec3NormalizeNEON(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f), one = vdupq_n_f32(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t x = vld1q_f32(a.x + i), y = vld1q_f32(a.y + i);
+        const float32x4_t z = vld1q_f32(a.z + i);
+        const float32x4_t lenSq = vfmaq_f32(vfmaq_f32(vmulq_f32(z, z), y, y),
+         x, x);
+        const float32x4_t inv = vreinterpretq_f32_u32(vandq_u32(
+         vreinterpretq_u32_f32(vdivq_f32(one, vsqrtq_f32(lenSq))),
+         vcgtq_f32(lenSq, zero)));
+        vst1q_f32(dst.x + i, vmulq_f32(x, inv));
+        vst1q_f32(dst.y + i, vmulq_f32(y, inv));
+        vst1q_f32(dst.z + i, vmulq_f32(z, inv));
+    }
+    nVec3NormalizeScalar(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i), count - i);
+}
+
+static void nVec3LerpNEON(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const float t, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t ax = vld1q_f32(a.x + i), ay = vld1q_f32(a.y + i);
+        const float32x4_t az = vld1q_f32(a.z + i);
+        vst1q_f32(dst.x + i, vfmaq_n_f32(ax, vsubq_f32(vld1q_f32(b.x + i),
+         ax), t));
+        vst1q_f32(dst.y + i, vfmaq_n_f32(ay, vsubq_f32(vld1q_f32(b.y + i),
+         ay), t));
+        vst1q_f32(dst.z + i, vfmaq_n_f32(az, vsubq_f32(vld1q_f32(b.z + i),
+         az), t));
+    }
+    nVec3LerpScalar(nVec3SoAFrom(dst, i), nVec3SoAFrom(a, i),
+     nVec3SoAFrom(b, i), t, count - i);
+}
+
+static void nVec4DotNEON(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+ const size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t r = vmulq_f32(vld1q_f32(a.x + i), vld1q_f32(b.x + i));
+        r = vfmaq_f32(r, vld1q_f32(a.y + i), vld1q_f32(b.y + i));
+        r = vfmaq_f32(r, vld1q_f32(a.z + i), vld1q_f32(b.z + i));
+        r = vfmaq_f32(r, vld1q_f32(a.w + i), vld1q_f32(b.w + i));
+        vst1q_f32(dst + i, r);
+    }
+    nVec4DotScalar(dst + i, nVec4SoAFrom(a, i), nVec4SoAFrom(b, i), count - i);
+}
+
+static const nVecKernels_t NVEC_NEON = {
+    .dot3 = nVec3DotNEON,
+    .cross3 = nVec3CrossNEON,
+    .length3 = nVec3LengthNEON,
+    .normalize3 = nVec3NormalizeNEON,
+    .lerp3 = nVec3LerpNEON,
+    .dot4 = nVec4DotNEON,
+};
+#endif
+
+/* Gets the kernels of the level bound by nSimdBind(), which has already
+ * checked that the CPU supports it. */
+static const nVecKernels_t *nVecKernels(void)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    switch (NSIMD.level)
+    {
+        case NSIMD_LEVEL_AVX512:
+            return &NVEC_AVX512;
+        case NSIMD_LEVEL_AVX2:
+            return &NVEC_AVX2;
+        case NSIMD_LEVEL_SSE42:
+            return &NVEC_SSE42;
+        default:
+            return &NVEC_SCALAR;
+    }
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    return (NSIMD.level >= NSIMD_LEVEL_NEON) ? &NVEC_NEON : &NVEC_SCALAR;
+#else
+    return &NVEC_SCALAR;
+#endif
+}
+
+void nVec3DotSoA(float *dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const size_t count)
+{
+    nVecKernels()->dot3(dst, a, b, count);
+}
+
+void nVec3CrossSoA(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const nVec3SoA_t b, const size_t count)
+{
+    nVecKernels()->cross3(dst, a, b, count);
+}
+
+void nVec3LengthSoA(float *dst, const nVec3SoA_t a, const size_t count)
+{
+    nVecKernels()->length3(dst, a, count);
+}
+
+void nVec3NormalizeSoA(const nVec3SoA_t dst, const nVec3SoA_t a,
+ const size_t count)
+{
+    nVecKernels()->normalize3(dst, a, count);
+}
+
+void nVec3LerpSoA(const nVec3SoA_t dst, const nVec3SoA_t a, const nVec3SoA_t b,
+ const float t, const size_t count)
+{
+    nVecKernels()->lerp3(dst, a, b, t, count);
+}
+
+void nVec4DotSoA(float *dst, const nVec4SoA_t a, const nVec4SoA_t b,
+ const size_t count)
+{
+    nVecKernels()->dot4(dst, a, b, count);
+}
+
+// Vectors.c
@@ -53,13 +53,20 @@
 #include <windows.h>
 #else
 #include <signal.h>
+#include <unistd.h>
 #endif
 
+#include "../include/Nimble/System/CPUInfo.h"
 #include "../include/Nimble/System/Memory.h"
+#include "../include/Nimble/System/Simd.h"
 #include "../include/Nimble/Errors/Errors.h"
 #include "../include/Nimble/Errors/Crash.h"
+#include "../include/Nimble/Errors/CrashDump.h"
 #include "../include/Nimble/Output/Files.h"
+#include "../include/Nimble/Output/Logging.h"
 #include "../include/Nimble/System/Threads.h"
+#include "../include/Nimble/System/Time.h"
+#include "../include/Nimble/System/Watchdog.h"
 
 volatile _Bool NIMBLE_INITIALIZED = 0;
 
@@ -69,6 +76,12 @@ int NIMBLE_ARGC = 0;
 
 static void nEngineCleanup(void)
 {
+    nWatchdogStop();
+
+    /* Report errors that are still suppressed, and write remaining logs. */
+    nErrorFlushRepeats();
+    nLogStop();
+
     /* Free NIMBLE_ARGS */
     for (int i = 0; i < NIMBLE_ARGC; i++)
     {
@@ -85,6 +98,9 @@ static LONG nEngineHandleException(EXCEPTION_POINTERS *exceptionInfo)
 {
     const nTime_t errorTime = nTime();
 
+    /* Write the dump first, while the process is still intact. */
+    nCrashDumpWrite(0, exceptionInfo, exceptionInfo->ContextRecord);
+
     /** @todo Set info and crash; also use ExceptionRecord->ExceptionAddress and ExceptionInformation (with segv). */
     int error = NSUCCESS;
     char *infoStr = NULL;
@@ -446,52 +462,54 @@ static LONG nEngineHandleException(EXCEPTION_POINTERS *exceptionInfo)
     nCrashSafe(error, errorInfo);
 }
 #else
+/* Writes len bytes of str to stderr, as printing is not async-signal-safe. */
+static void nEngineWriteError(const char *const str, const size_t len)
+{
+    for (size_t done = 0; done < len;)
+    {
+        const ssize_t written = write(STDERR_FILENO, str + done, len - done);
+        if (written <= 0) return;
+        done += (size_t) written;
+    }
+}
+
 _Noreturn static void nEngineHandleException(const int signum, siginfo_t *info, void *context)
 {
-    char *infoStr = NULL;
-    size_t infoLen;
-    switch (signum)
+    if (signum == SIGTERM)
     {
-        case SIGTERM:
-            exit(SIGTERM);
-            /* NO RETURN */
-        case SIGSEGV:
-#  define formatStr "Caught a segmentation fault signal at address 0x%p."
-            infoLen = NCONST_STR_FORMAT_LEN(formatStr, 1, 0, 0, 0) + (sizeof(uintptr_t) * 2);
-            infoStr = nAlloc(infoLen + 1);
-            snprintf(infoStr, infoLen, formatStr, info->si_addr);
-            infoStr[infoLen] = '\0';
-#  undef formatStr
-        default:
-            const nTime_t errorTime = nTime();
-            const int error = nErrorFromSignal(signum);
+        exit(SIGTERM);
+        /* NO RETURN */
+    }
 
-            struct sigaction sa = {};
-            sa.sa_handler = SIG_DFL;
-            if (!sigemptyset(&sa.sa_mask))
-            {
-#  if NIMBLE_OS == NIMBLE_MACOS
-                sa.sa_flags = SA_SIGINFO;
-#  else
-                sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
-#  endif
+    /* Only async-signal-safe calls are made from here on, as the signal may
+     * have interrupted malloc() or a thread holding a lock. */
+    if (nCrashDumpWrite(signum, info, context) == NSUCCESS)
+    {
+        const char *const pathStr = nCrashDumpPath();
+#  define dumpStr "Crash dump written to "
+        nEngineWriteError(dumpStr, NCONST_STR_LEN(dumpStr));
+#  undef dumpStr
+        nEngineWriteError(pathStr, strlen(pathStr));
+        nEngineWriteError("\n", 1);
+    }
 
-                sigaction(SIGABRT, &sa, NULL);
-            }
+#  define crashStr "The program crashed from a fatal signal.\n"
+    nEngineWriteError(crashStr, NCONST_STR_LEN(crashStr));
+#  undef crashStr
 
-            nErrorInfo_t errorInfo;
-            if (!infoStr)
-            {
-#  define einfoStr "Caught a signal."
-                infoLen = NCONST_STR_LEN(einfoStr);
-                infoStr = nAlloc(infoLen + 1);
-#  undef einfoStr
-            }
-            nErrorInfoSet(&errorInfo, error, errorTime, infoStr, infoLen),
-             NULL, 0);
-            nCrashSafe(error, errorInfo);
-            /* NO RETURN */
-    }
+    /* Re-raise the signal with its default action, so the process ends the
+     * way it would have without the handler, with a core file if enabled. */
+    struct sigaction sa = {};
+    sa.sa_handler = SIG_DFL;
+    sigemptyset(&sa.sa_mask);
+    sigaction(signum, &sa, NULL);
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, signum);
+    sigprocmask(SIG_UNBLOCK, &set, NULL);
+    raise(signum);
+    _exit(128 + signum);
+    /* NO RETURN */
 }
 #endif
 
@@ -537,7 +555,7 @@ void nEngineSetSignalHandler(void)
     SetUnhandledExceptionFilter(nEngineHandleException);
 #else
     struct sigaction sa = {};
-    sa.sa_handler = nEngineHandleException;
+    sa.sa_sigaction = nEngineHandleException;
 #  define einfoStr "sigemptyset() failed in nEngineInit(), and the signal "\
  "handlers could not be set."
     nAssert(
@@ -554,9 +572,9 @@ void nEngineSetSignalHandler(void)
 
     /* Create new stack for signal handler. */
     stack_t ss;
-    ss.ss_sp = nAlloc(SIGSTKSZ);
-    ss.ss_size = SIGSTKSZ;
-    ss_flags = 0;
+    ss.ss_sp = nAlloc(NCRASH_SIGNAL_STACK);
+    ss.ss_size = NCRASH_SIGNAL_STACK;
+    ss.ss_flags = 0;
 #    define einfoStr "sigaltstack() failed in nEngineInit(), and the signal "\
  "handlers could not be set."
     nAssert(
@@ -582,6 +600,9 @@ void nEngineSetSignalHandler(void)
      NERROR_INTERNAL_FAILURE, einfoStr, NCONST_STR_LEN(einfoStr));
     nAssert(!sigaction(SIGSEGV, &sa, NULL),
      NERROR_INTERNAL_FAILURE, einfoStr, NCONST_STR_LEN(einfoStr));
+    nAssert(!sigaction(SIGBUS, &sa, NULL),
+     NERROR_INTERNAL_FAILURE, einfoStr, NCONST_STR_LEN(einfoStr));
+#  undef einfoStr
 #endif
 }
 
@@ -609,13 +630,40 @@ int nEngineInit(char **args, const int argc,
     );
 #undef einfoStr
 
-    /* Set signal callbacks. */
+    /* Prepare the crash dump writer, then set signal callbacks. */
+#define einfoStr "nCrashDumpInit() failed in nEngineInit()."
+    nErrorAssert(
+     !nCrashDumpInit(NULL),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    );
+#undef einfoStr
     nEngineSetSignalHandler();
+    nErrorStackRegister();
+
+    /* Detect the CPU's topology and features, and bind the SIMD kernels to
+     * the best variants it supports. */
+    nSysGetCPUInfo(NULL);
+    nSimdBind(NSIMD_LEVEL_MAX);
+
+    /* Measure the CPU's counter for nTicks(). */
+    nTimeCalibrate();
 
     /* Set Nimble callbacks. */
     nErrorSetCallback(errorCallback);
     nCrashSetCallback(crashCallback);
 
+    /* Start the logging thread. */
+#define einfoStr "nLogStart() failed in nEngineInit()."
+    nAssert(
+     !nLogStart(),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    );
+#undef einfoStr
+
     /* Copy args to NIMBLE_ARGS */
     nEngineCopyArgs(args, argc);
 
@@ -633,6 +681,16 @@ int nEngineInit(char **args, const int argc,
     );
 #undef einfoStr
     
+    /* Start checking the heartbeats of registered threads. */
+#define einfoStr "nWatchdogStart() failed in nEngineInit()."
+    nErrorAssert(
+     !nWatchdogStart(),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    );
+#undef einfoStr
+
     NIMBLE_INITIALIZED = 1;
 
     return NSUCCESS;
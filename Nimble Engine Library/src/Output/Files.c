@@ -45,6 +45,7 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "../../include/Nimble/NimbleEngine.h"
 #include "../../include/Nimble/System/Memory.h"
@@ -482,4 +483,95 @@ closeLbl:;
     return err;
 }
 
+int nFileListDir(const char *const dir, nFileListCallback_t callback,
+ void *data)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "Dir argument was NULL in nFileListDir()."
+    if (nErrorAssert(
+     dir != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#  define einfoStr "Callback argument was NULL in nFileListDir()."
+    if (nErrorAssert(
+     callback != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    const size_t dirLen = strlen(dir);
+#define einfoStr "The directory length is greater than PATH_MAX in "\
+ "nFileListDir()."
+    if (nErrorAssert(
+     dirLen + 2 < PATH_MAX,
+     NERROR_MAX_FILENAME,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_MAX_FILENAME;
+#undef einfoStr
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    char pattern[PATH_MAX + 1];
+    memcpy(pattern, dir, dirLen);
+    pattern[dirLen] = NFILE_DIR_SEP;
+    pattern[dirLen + 1] = '*';
+    pattern[dirLen + 2] = '\0';
+
+    WIN32_FIND_DATAA find;
+    HANDLE handle = FindFirstFileA(pattern, &find);
+#  define einfoStr "FindFirstFileA() failed in nFileListDir()."
+    if (nErrorAssert(
+     handle != INVALID_HANDLE_VALUE,
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_INTERNAL_FAILURE;
+#  undef einfoStr
+    do
+    {
+        if (find.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+        const uint64_t size = ((uint64_t) find.nFileSizeHigh << 32) |
+         find.nFileSizeLow;
+        if (callback(find.cFileName, size, data)) break;
+    }
+    while (FindNextFileA(handle, &find));
+    FindClose(handle);
+    return NSUCCESS;
+
+#else
+    DIR *dirp = opendir(dir);
+#  define einfoStr "opendir() failed in nFileListDir()."
+    if (nErrorAssert(
+     dirp != NULL,
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_INTERNAL_FAILURE;
+#  undef einfoStr
+
+    char path[PATH_MAX + 1];
+    memcpy(path, dir, dirLen);
+    path[dirLen] = NFILE_DIR_SEP;
+    struct dirent *entry;
+    while ((entry = readdir(dirp)))
+    {
+        const size_t nameLen = strlen(entry->d_name);
+        if (dirLen + 1 + nameLen > PATH_MAX) continue;
+        memcpy(path + dirLen + 1, entry->d_name, nameLen + 1);
+
+        struct stat st;
+        if (stat(path, &st) || !S_ISREG(st.st_mode)) continue;
+        if (callback(entry->d_name, (uint64_t) st.st_size, data)) break;
+    }
+    closedir(dirp);
+    return NSUCCESS;
+#endif
+}
+
 // Files.c
@@ -0,0 +1,1577 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Logging.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2021-01-06.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/Output/Logging.h"
+
+/**
+ * @file Logging.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2021-01-06
+ *
+ * @brief This class defines logging functions.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef NIMBLE_ZLIB
+#include <zlib.h>
+#endif
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+#include <sys/uio.h>
+#endif
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/Output/Files.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Threads.h"
+#include "../../include/Nimble/System/Time.h"
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+struct iovec {
+    void *iov_base;
+    size_t iov_len;
+};
+#endif
+
+#ifndef IOV_MAX
+#  define IOV_MAX 1024
+#endif
+
+#define NLOG_RECORD_MAX (NLOG_SLOT_SIZE * NLOG_RECORD_SLOTS_MAX)
+#define NLOG_DATA_MAX (NLOG_RECORD_MAX - sizeof(nLogRecord_t))
+
+/**
+ * @brief A single producer, single consumer ring of log records.
+ */
+typedef struct nLogRing {
+    struct nLogRing *volatile next; /* The next ring in the list. */
+    uint8_t *slots; /* NLOG_RING_SLOTS slots of NLOG_SLOT_SIZE bytes. */
+    uint32_t thread; /* The number of the thread that owns the ring. */
+    volatile uint32_t closed; /* Set when the owning thread exits. */
+    uint64_t droppedReported; /* Dropped records reported by the consumer. */
+    uint64_t pendingTail; /* Tail once the current batch is written. */
+    uint64_t pendingHead; /* Head when the current batch was started. */
+    struct nLogRing *retired; /* The next ring waiting to be freed. */
+    char pad0[64];
+
+    volatile uint64_t head; /* Written by the producer. */
+    uint64_t cachedTail; /* The producer's copy of tail. */
+    volatile uint64_t dropped; /* Records dropped because the ring was full. */
+    char pad1[64];
+
+    volatile uint64_t tail; /* Written by the consumer. */
+} nLogRing_t;
+
+volatile int nLogLevel = NLOG_INFO;
+
+static __thread nLogRing_t *logRing = NULL;
+static nLogRing_t *volatile logRings = NULL;
+static volatile uint32_t logThreadCount = 0;
+static nLogRing_t *logRetired = NULL; /* Only used by the logging thread. */
+
+static nThread_t logThread = NULL;
+static volatile int logRunning = 0;
+static volatile int logConsole = 1;
+static char *volatile logFileRequests[2] = {NULL, NULL}; /* Text, binary. */
+static volatile int logFileRequested = 0; /* A bit for each requested file. */
+static volatile uint64_t logWritten = 0; /* Increments after each batch. */
+
+static volatile uint64_t logRotateSize = NLOG_ROTATE_SIZE;
+static volatile uint64_t logRotateAge = NLOG_ROTATE_AGE;
+static volatile uint32_t logRetainFiles = NLOG_RETAIN_FILES;
+static volatile uint64_t logRetainSize = NLOG_RETAIN_SIZE;
+
+/**
+ * @brief A rotated log file segment for the archiver thread.
+ */
+typedef struct nLogArchiveJob {
+    char *pathStr; /* The path of the segment. */
+    size_t baseLen; /* The length of the path of the log file it was rotated from. */
+} nLogArchiveJob_t;
+
+static nThread_t logArchiver = NULL;
+static volatile int logArchiving = 0;
+static nLogArchiveJob_t logArchiveJobs[NLOG_ARCHIVE_QUEUE];
+static volatile uint32_t logArchiveHead = 0; /* Written by the logging thread. */
+static volatile uint32_t logArchiveTail = 0; /* Written by the archiver thread. */
+
+static const char *const logLevelStrs[] = {
+    "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL"
+};
+
+/* Thread exit handling, used to retire the rings of exited threads. */
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+static DWORD logKey = FLS_OUT_OF_INDEXES;
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+static pthread_key_t logKey;
+#elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+static tss_t logKey;
+#endif
+static volatile int logKeyState = 0;
+
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+static void WINAPI nLogThreadExit(void *data)
+#else
+static void nLogThreadExit(void *data)
+#endif
+{
+    nLogRing_t *ring = data;
+    if (!ring) return;
+    if (logRing == ring) logRing = NULL;
+    __atomic_store_n(&ring->closed, 1, __ATOMIC_RELEASE);
+}
+
+static void nLogKeyInit(void)
+{
+    int expected = 0;
+    if (__atomic_compare_exchange_n(&logKeyState, &expected, 1, 0,
+     __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+    {
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+        logKey = FlsAlloc(nLogThreadExit);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+        pthread_key_create(&logKey, nLogThreadExit);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+        tss_create(&logKey, nLogThreadExit);
+#endif
+        __atomic_store_n(&logKeyState, 2, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        while (__atomic_load_n(&logKeyState, __ATOMIC_ACQUIRE) != 2);
+    }
+}
+
+/**
+ * @brief Creates and registers the invoking thread's ring.
+ * @return The ring of the invoking thread.
+ */
+static nLogRing_t *nLogRingCreate(void)
+{
+    nLogRing_t *ring = nAlloc(sizeof(nLogRing_t));
+    memset(ring, 0, sizeof(nLogRing_t));
+    ring->slots = nAlloc(NLOG_SLOT_SIZE * NLOG_RING_SLOTS);
+    ring->thread = __atomic_add_fetch(&logThreadCount, 1, __ATOMIC_RELAXED);
+
+    if (__atomic_load_n(&logKeyState, __ATOMIC_ACQUIRE) != 2) nLogKeyInit();
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+    FlsSetValue(logKey, ring);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+    pthread_setspecific(logKey, ring);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+    tss_set(logKey, ring);
+#endif
+
+    nLogRing_t *next = __atomic_load_n(&logRings, __ATOMIC_RELAXED);
+    do
+    {
+        ring->next = next;
+    }
+    while (!__atomic_compare_exchange_n(&logRings, &next, ring, 1,
+     __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    logRing = ring;
+    return ring;
+}
+
+NIMBLE_INLINE
+uint64_t nLogNow(void)
+{
+    const nTime_t now = nTime();
+    return ((uint64_t) now.secs * NTIME_NS_IN_SEC) + now.nanos;
+}
+
+int nLogPush(const int level, const int argc, const uint8_t *const types,
+ const char *const format, ...)
+{
+    nLogRing_t *ring = logRing ? logRing : nLogRingCreate();
+
+    /* Pack the arguments. */
+    union {
+        nLogRecord_t record;
+        uint8_t bytes[NLOG_RECORD_MAX];
+    } buffer;
+    nLogRecord_t *record = &buffer.record;
+    uint8_t *data = record->data;
+    size_t len = 0;
+    const int count = (argc > NLOG_ARGS_MAX) ? NLOG_ARGS_MAX : argc;
+
+    va_list args;
+    va_start(args, format);
+    for (int i = 0; i < count; i++)
+    {
+        union {
+            int64_t i64;
+            uint64_t u64;
+            double f64;
+        } val;
+        uint8_t type;
+        switch (types[i + 1])
+        {
+            case NLOG_ARG_INT:
+                val.i64 = va_arg(args, int);
+                type = NLOG_TYPE_I64;
+                break;
+            case NLOG_ARG_UINT:
+                val.u64 = va_arg(args, unsigned int);
+                type = NLOG_TYPE_U64;
+                break;
+            case NLOG_ARG_LONG:
+                val.i64 = va_arg(args, long);
+                type = NLOG_TYPE_I64;
+                break;
+            case NLOG_ARG_ULONG:
+                val.u64 = va_arg(args, unsigned long);
+                type = NLOG_TYPE_U64;
+                break;
+            case NLOG_ARG_LLONG:
+                val.i64 = va_arg(args, long long);
+                type = NLOG_TYPE_I64;
+                break;
+            case NLOG_ARG_ULLONG:
+                val.u64 = va_arg(args, unsigned long long);
+                type = NLOG_TYPE_U64;
+                break;
+            case NLOG_ARG_DOUBLE:
+                val.f64 = va_arg(args, double);
+                type = NLOG_TYPE_F64;
+                break;
+            case NLOG_ARG_LDOUBLE:
+                val.f64 = (double) va_arg(args, long double);
+                type = NLOG_TYPE_F64;
+                break;
+            case NLOG_ARG_STR:
+            {
+                const char *str = va_arg(args, const char *);
+                if (!str) str = "(null)";
+                /* Truncate long strings, leaving room for the remaining
+                 * arguments. */
+                size_t strLen = strlen(str);
+                const size_t reserved = len + sizeof(uint16_t) +
+                 ((count - i - 1) * sizeof(uint64_t));
+                const size_t space = (reserved < NLOG_DATA_MAX) ?
+                 NLOG_DATA_MAX - reserved : 0;
+                if (strLen > space) strLen = space;
+                const uint16_t strLen16 = (uint16_t) strLen;
+                memcpy(data + len, &strLen16, sizeof(uint16_t));
+                memcpy(data + len + sizeof(uint16_t), str, strLen);
+                len += sizeof(uint16_t) + strLen;
+                record->types[i] = NLOG_TYPE_STR;
+                continue;
+            }
+            default:
+                val.u64 = (uintptr_t) va_arg(args, void *);
+                type = NLOG_TYPE_PTR;
+                break;
+        }
+        if (len + sizeof(uint64_t) > NLOG_DATA_MAX)
+        {
+            record->types[i] = NLOG_TYPE_STR;
+            memset(data + len, 0, sizeof(uint16_t));
+            len += sizeof(uint16_t);
+            continue;
+        }
+        memcpy(data + len, &val, sizeof(uint64_t));
+        len += sizeof(uint64_t);
+        record->types[i] = type;
+    }
+    va_end(args);
+
+    record->time = nLogNow();
+    record->format = format;
+    record->thread = ring->thread;
+    record->len = (uint16_t) len;
+    record->level = (uint8_t) level;
+    record->argc = (uint8_t) count;
+    const uint32_t slots = (sizeof(nLogRecord_t) + len + NLOG_SLOT_SIZE - 1) /
+     NLOG_SLOT_SIZE;
+    record->slots = (uint8_t) slots;
+
+    /* Reserve slots, padding to the start of the ring if the record would not
+     * be contiguous. */
+    uint64_t head = ring->head;
+    const uint32_t index = head & (NLOG_RING_SLOTS - 1);
+    const uint32_t pad = (index + slots > NLOG_RING_SLOTS) ?
+     NLOG_RING_SLOTS - index : 0;
+    if (head + pad + slots - ring->cachedTail > NLOG_RING_SLOTS)
+    {
+        ring->cachedTail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head + pad + slots - ring->cachedTail > NLOG_RING_SLOTS)
+        {
+            __atomic_store_n(&ring->dropped, ring->dropped + 1,
+             __ATOMIC_RELAXED);
+            return NERROR_OVERFLOW;
+        }
+    }
+    if (pad)
+    {
+        nLogRecord_t *padRecord = (nLogRecord_t *) (ring->slots +
+         ((size_t) index * NLOG_SLOT_SIZE));
+        padRecord->level = NLOG_PAD;
+        padRecord->slots = (uint8_t) ((pad > 0xFF) ? 0 : pad);
+        head += pad;
+    }
+
+    memcpy(ring->slots + ((head & (NLOG_RING_SLOTS - 1)) * NLOG_SLOT_SIZE),
+     record, sizeof(nLogRecord_t) + len);
+    __atomic_store_n(&ring->head, head + slots, __ATOMIC_RELEASE);
+    return NSUCCESS;
+}
+
+
+/**
+ * @brief Output of the logging thread, written with writev().
+ */
+typedef struct nLogBuffer {
+    struct iovec iov[NLOG_BATCH_IOV];
+    int iovCount;
+    char text[NLOG_BATCH_SIZE]; /* Copied bytes the buffers can point to. */
+    size_t textLen;
+} nLogBuffer_t;
+
+/**
+ * @brief A file sink of the logging thread.
+ */
+typedef struct nLogFile {
+    int fd; /* The open file, or -1. */
+    char *pathStr; /* The path of the file. */
+    uint64_t size; /* The size of the file. */
+    uint64_t openTime; /* The time the file was opened, in nanoseconds. */
+} nLogFile_t;
+
+/**
+ * @brief A format string written to the binary file.
+ */
+typedef struct nLogFormat {
+    const char *format;
+    uint32_t id;
+} nLogFormat_t;
+
+/**
+ * @brief The state of the logging thread.
+ */
+typedef struct nLogBatch {
+    nLogBuffer_t text; /* Text for the console and text file. */
+    nLogBuffer_t binary; /* Chunks for the binary file. */
+    nLogFile_t files[2]; /* The text and binary files. */
+
+    time_t lastSecs; /* The second lastTimeStr was formatted for. */
+    char lastTimeStr[32]; /* The formatted date and time of lastSecs. */
+    size_t lastTimeLen;
+
+    nLogFormat_t *formats; /* Format strings written to the binary file. */
+    uint32_t formatCount;
+    uint32_t formatCap; /* A power of two, or 0. */
+} nLogBatch_t;
+
+#define NLOG_FILE_TEXT   0 /* Index of the text file sink. */
+#define NLOG_FILE_BINARY 1 /* Index of the binary file sink. */
+
+/* Adds len bytes at ptr to the buffer without copying them. */
+NIMBLE_INLINE
+void nLogBufferRef(nLogBuffer_t *const buffer, const void *const ptr,
+ const size_t len)
+{
+    if (!len || (buffer->iovCount >= NLOG_BATCH_IOV)) return;
+    buffer->iov[buffer->iovCount].iov_base = (void *) ptr;
+    buffer->iov[buffer->iovCount].iov_len = len;
+    buffer->iovCount++;
+}
+
+/* Copies len bytes to the text of the buffer, merging them with the last iovec
+ * if it ends there. */
+static void nLogBufferCopy(nLogBuffer_t *const buffer, const void *const src,
+ size_t len)
+{
+    if (len > NLOG_BATCH_SIZE - buffer->textLen)
+    {
+        len = NLOG_BATCH_SIZE - buffer->textLen;
+    }
+    if (!len) return;
+    char *dst = buffer->text + buffer->textLen;
+    memcpy(dst, src, len);
+    buffer->textLen += len;
+
+    struct iovec *last = buffer->iovCount ?
+     &buffer->iov[buffer->iovCount - 1] : NULL;
+    if (last && ((char *) last->iov_base + last->iov_len == dst))
+    {
+        last->iov_len += len;
+    }
+    else
+    {
+        nLogBufferRef(buffer, dst, len);
+    }
+}
+
+/* Formats a single conversion into the text of the buffer. */
+static void nLogBufferPrintf(nLogBuffer_t *const buffer,
+ const char *const spec, ...)
+{
+    char str[256];
+    va_list args;
+    va_start(args, spec);
+    const int len = vsnprintf(str, sizeof(str), spec, args);
+    va_end(args);
+    if (len > 0)
+    {
+        nLogBufferCopy(buffer, str, ((size_t) len < sizeof(str)) ?
+         (size_t) len : sizeof(str) - 1);
+    }
+}
+
+/* Checks if the buffer may not fit another record. */
+NIMBLE_INLINE
+int nLogBufferFull(const nLogBuffer_t *const buffer)
+{
+    return (buffer->iovCount > NLOG_BATCH_IOV - (4 * NLOG_ARGS_MAX) - 8) ||
+     (buffer->textLen > NLOG_BATCH_SIZE - (NLOG_ARGS_MAX * 256) - 256);
+}
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+static ssize_t writev(int fd, const struct iovec *iov, int iovCount)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovCount; i++)
+    {
+        const int wr = write(fd, iov[i].iov_base, (unsigned int) iov[i].iov_len);
+        if (wr < 0) return total ? total : -1;
+        total += wr;
+        if ((size_t) wr < iov[i].iov_len) break;
+    }
+    return total;
+}
+#endif
+
+/**
+ * @brief Writes all of the buffer to fd, continuing after partial writes.
+ * @return The number of bytes written.
+ */
+static uint64_t nLogBufferWrite(const nLogBuffer_t *const buffer, const int fd)
+{
+    uint64_t written = 0;
+    struct iovec iov[NLOG_BATCH_IOV];
+    memcpy(iov, buffer->iov, sizeof(struct iovec) * buffer->iovCount);
+    struct iovec *next = iov;
+    int count = buffer->iovCount;
+    while (count > 0)
+    {
+        ssize_t wr = writev(fd, next, (count > IOV_MAX) ? IOV_MAX : count);
+        if (wr < 0)
+        {
+            if (errno == EINTR) continue;
+#define einfoStr "writev() failed in the logging thread."
+            nErrorThrow(NERROR_INTERNAL_FAILURE, einfoStr,
+             NCONST_STR_LEN(einfoStr), 1);
+#undef einfoStr
+            return written;
+        }
+        written += wr;
+        while (count && ((size_t) wr >= next->iov_len))
+        {
+            wr -= next->iov_len;
+            next++;
+            count--;
+        }
+        if (count)
+        {
+            next->iov_base = (char *) next->iov_base + wr;
+            next->iov_len -= wr;
+        }
+    }
+    return written;
+}
+
+/* Writes the batch to each sink and releases the records it points to. */
+static void nLogBatchWrite(nLogBatch_t *const batch)
+{
+    if (batch->text.iovCount)
+    {
+        if (__atomic_load_n(&logConsole, __ATOMIC_RELAXED))
+        {
+            nLogBufferWrite(&batch->text, STDERR_FILENO);
+        }
+        nLogFile_t *file = &batch->files[NLOG_FILE_TEXT];
+        if (file->fd >= 0) file->size += nLogBufferWrite(&batch->text, file->fd);
+    }
+    if (batch->binary.iovCount)
+    {
+        nLogFile_t *file = &batch->files[NLOG_FILE_BINARY];
+        if (file->fd >= 0)
+        {
+            file->size += nLogBufferWrite(&batch->binary, file->fd);
+        }
+    }
+    batch->text.iovCount = 0;
+    batch->text.textLen = 0;
+    batch->binary.iovCount = 0;
+    batch->binary.textLen = 0;
+
+    for (nLogRing_t *ring = __atomic_load_n(&logRings, __ATOMIC_ACQUIRE); ring;
+     ring = ring->next)
+    {
+        __atomic_store_n(&ring->tail, ring->pendingTail, __ATOMIC_RELEASE);
+    }
+    __atomic_add_fetch(&logWritten, 1, __ATOMIC_RELEASE);
+}
+
+/* Reads the argument at *offset of record, and advances the offset. */
+static int nLogRecordArg(const nLogRecord_t *const record, const int index,
+ size_t *const offset, uint64_t *const num, const char **str, size_t *strLen)
+{
+    if (index >= record->argc) return 0;
+    const uint8_t type = record->types[index];
+    if (type == NLOG_TYPE_STR)
+    {
+        uint16_t len;
+        memcpy(&len, record->data + *offset, sizeof(uint16_t));
+        *str = (const char *) record->data + *offset + sizeof(uint16_t);
+        *strLen = len;
+        *offset += sizeof(uint16_t) + len;
+    }
+    else
+    {
+        memcpy(num, record->data + *offset, sizeof(uint64_t));
+        *offset += sizeof(uint64_t);
+    }
+    return type;
+}
+
+/**
+ * @brief Adds the formatted text of @p record to @p batch.
+ *
+ * The format string is converted one specification at a time. Literal text and
+ * string arguments are referenced in place, so the records can not be released
+ * until the batch is written.
+ */
+static void nLogBatchRecord(nLogBatch_t *const batch,
+ const nLogRecord_t *const record)
+{
+    /* Prefix */
+    const time_t secs = (time_t) (record->time / NTIME_NS_IN_SEC);
+    if (secs != batch->lastSecs)
+    {
+        struct tm tm;
+#if NIMBLE_OS == NIMBLE_WINDOWS
+        localtime_s(&tm, &secs);
+#else
+        localtime_r(&secs, &tm);
+#endif
+        batch->lastTimeLen = strftime(batch->lastTimeStr,
+         sizeof(batch->lastTimeStr), "%Y-%m-%d %H:%M:%S", &tm);
+        batch->lastSecs = secs;
+    }
+    char prefixStr[96];
+    const int prefixLen = snprintf(prefixStr, sizeof(prefixStr),
+     "[%.*s.%03u] [%s] [T%" PRIu32 "] ", (int) batch->lastTimeLen,
+     batch->lastTimeStr,
+     (unsigned) ((record->time % NTIME_NS_IN_SEC) / NTIME_NS_IN_MS),
+     (record->level <= NLOG_FATAL) ? logLevelStrs[record->level] : "?????",
+     record->thread);
+    nLogBufferCopy(&batch->text, prefixStr, prefixLen);
+
+    /* Message */
+    const char *format = record->format;
+    size_t offset = 0;
+    int arg = 0;
+    while (*format)
+    {
+        const char *spec = strchr(format, '%');
+        if (!spec)
+        {
+            nLogBufferRef(&batch->text, format, strlen(format));
+            break;
+        }
+        nLogBufferRef(&batch->text, format, spec - format);
+
+        /* Parse the specification, copying it without a length modifier. */
+        char specStr[64];
+        size_t specLen = 0;
+        const char *ptr = spec + 1;
+        specStr[specLen++] = '%';
+        while (*ptr && strchr("-+ #0'", *ptr) && (specLen < 16))
+        {
+            specStr[specLen++] = *ptr++;
+        }
+        for (int part = 0; part < 2; part++)
+        {
+            if (part)
+            {
+                if (*ptr != '.') break;
+                specStr[specLen++] = *ptr++;
+            }
+            if (*ptr == '*')
+            {
+                /* Substitute the width or precision argument. */
+                uint64_t num = 0;
+                const char *str;
+                size_t strLen;
+                nLogRecordArg(record, arg++, &offset, &num, &str, &strLen);
+                specLen += snprintf(specStr + specLen, 16, "%d", (int) num);
+                ptr++;
+            }
+            else
+            {
+                while ((*ptr >= '0') && (*ptr <= '9') && (specLen < 40))
+                {
+                    specStr[specLen++] = *ptr++;
+                }
+            }
+        }
+        while (*ptr && strchr("hlLqjzt", *ptr)) ptr++;
+        const char conv = *ptr;
+        if (conv) ptr++;
+        format = ptr;
+
+        if (conv == '%')
+        {
+            nLogBufferCopy(&batch->text, "%", 1);
+            continue;
+        }
+        if (!conv || (conv == 'n')) continue;
+
+        uint64_t num = 0;
+        const char *str = NULL;
+        size_t strLen = 0;
+        const int type = nLogRecordArg(record, arg++, &offset, &num, &str,
+         &strLen);
+        if (!type)
+        {
+            nLogBufferCopy(&batch->text, "(?)", 3);
+            continue;
+        }
+
+        switch (conv)
+        {
+            case 's':
+                if (type != NLOG_TYPE_STR)
+                {
+                    nLogBufferCopy(&batch->text, "(?)", 3);
+                }
+                else if (specLen == 1)
+                {
+                    nLogBufferRef(&batch->text, str, strLen);
+                }
+                else
+                {
+                    /* Apply the width and precision to the stored length. */
+                    const char *dot = memchr(specStr, '.', specLen);
+                    size_t len = strLen;
+                    if (dot)
+                    {
+                        const size_t precision = strtoul(dot + 1, NULL, 10);
+                        if (precision < len) len = precision;
+                        specLen = dot - specStr;
+                    }
+                    memcpy(specStr + specLen, ".*s", 4);
+                    nLogBufferPrintf(&batch->text, specStr, (int) len, str);
+                }
+                break;
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            case 'c':
+                if (type == NLOG_TYPE_STR)
+                {
+                    nLogBufferCopy(&batch->text, "(?)", 3);
+                    break;
+                }
+                if (type == NLOG_TYPE_F64)
+                {
+                    double f64;
+                    memcpy(&f64, &num, sizeof(double));
+                    num = (uint64_t) (int64_t) f64;
+                }
+                if (conv == 'c')
+                {
+                    specStr[specLen++] = 'c';
+                    specStr[specLen] = '\0';
+                    nLogBufferPrintf(&batch->text, specStr, (int) num);
+                }
+                else
+                {
+                    specStr[specLen++] = 'l';
+                    specStr[specLen++] = 'l';
+                    specStr[specLen++] = conv;
+                    specStr[specLen] = '\0';
+                    nLogBufferPrintf(&batch->text, specStr, (long long) num);
+                }
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            case 'a': case 'A':
+            {
+                double f64;
+                if (type == NLOG_TYPE_STR)
+                {
+                    nLogBufferCopy(&batch->text, "(?)", 3);
+                    break;
+                }
+                if (type == NLOG_TYPE_F64) memcpy(&f64, &num, sizeof(double));
+                else if (type == NLOG_TYPE_I64) f64 = (double) (int64_t) num;
+                else f64 = (double) num;
+                specStr[specLen++] = conv;
+                specStr[specLen] = '\0';
+                nLogBufferPrintf(&batch->text, specStr, f64);
+                break;
+            }
+            case 'p':
+                specStr[specLen++] = 'p';
+                specStr[specLen] = '\0';
+                nLogBufferPrintf(&batch->text, specStr, (type == NLOG_TYPE_STR) ?
+                 (void *) str : (void *) (uintptr_t) num);
+                break;
+            default:
+                nLogBufferCopy(&batch->text, "(?)", 3);
+                break;
+        }
+    }
+
+    nLogBufferCopy(&batch->text, "\n", 1);
+}
+
+/* Adds a chunk header and len bytes at data to the binary buffer. */
+static void nLogBatchChunk(nLogBatch_t *const batch, const uint32_t kind,
+ const void *const data, const uint32_t len)
+{
+    const nLogChunk_t chunk = {.kind = kind, .len = len};
+    nLogBufferCopy(&batch->binary, &chunk, sizeof(chunk));
+    nLogBufferCopy(&batch->binary, data, len);
+}
+
+/**
+ * @brief Gets the number of the format string of a record, writing the format
+ * string to the binary buffer the first time it is seen.
+ */
+static uint32_t nLogBatchFormat(nLogBatch_t *const batch,
+ const char *const format)
+{
+    if (batch->formatCount >= batch->formatCap / 2)
+    {
+        /* Grow the table and rehash. */
+        const uint32_t oldCap = batch->formatCap;
+        nLogFormat_t *old = batch->formats;
+        batch->formatCap = oldCap ? oldCap * 2 : 256;
+        batch->formats = nAlloc(sizeof(nLogFormat_t) * batch->formatCap);
+        memset(batch->formats, 0, sizeof(nLogFormat_t) * batch->formatCap);
+        for (uint32_t i = 0; i < oldCap; i++)
+        {
+            if (!old[i].format) continue;
+            uint32_t h = (uint32_t) (((uintptr_t) old[i].format >> 3) *
+             UINT32_C(0x9E3779B1));
+            while (batch->formats[h & (batch->formatCap - 1)].format) h++;
+            batch->formats[h & (batch->formatCap - 1)] = old[i];
+        }
+        if (old) nFree((void **) &old);
+    }
+
+    uint32_t h = (uint32_t) (((uintptr_t) format >> 3) * UINT32_C(0x9E3779B1));
+    for (;; h++)
+    {
+        nLogFormat_t *entry = &batch->formats[h & (batch->formatCap - 1)];
+        if (entry->format == format) return entry->id;
+        if (!entry->format)
+        {
+            entry->format = format;
+            entry->id = batch->formatCount++;
+
+            const size_t len = strlen(format);
+            const nLogChunk_t chunk = {
+                .kind = NLOG_CHUNK_FORMAT,
+                .len = (uint32_t) (sizeof(uint32_t) + len)
+            };
+            nLogBufferCopy(&batch->binary, &chunk, sizeof(chunk));
+            nLogBufferCopy(&batch->binary, &entry->id, sizeof(uint32_t));
+            nLogBufferRef(&batch->binary, format, len);
+            return entry->id;
+        }
+    }
+}
+
+/**
+ * @brief Adds @p record to the binary buffer of @p batch.
+ *
+ * The packed arguments are referenced in place, so the records can not be
+ * released until the batch is written.
+ */
+static void nLogBatchBinaryRecord(nLogBatch_t *const batch,
+ const nLogRecord_t *const record)
+{
+    const nLogRecordChunk_t header = {
+        .time = record->time,
+        .format = nLogBatchFormat(batch, record->format),
+        .thread = record->thread,
+        .len = record->len,
+        .level = record->level,
+        .argc = record->argc,
+        .reserved = 0
+    };
+    const nLogChunk_t chunk = {
+        .kind = NLOG_CHUNK_RECORD,
+        .len = (uint32_t) (sizeof(header) + record->argc + record->len)
+    };
+    nLogBufferCopy(&batch->binary, &chunk, sizeof(chunk));
+    nLogBufferCopy(&batch->binary, &header, sizeof(header));
+    nLogBufferRef(&batch->binary, record->types, record->argc);
+    nLogBufferRef(&batch->binary, record->data, record->len);
+}
+
+/**
+ * @brief Opens file sink @p index of @p batch at @p pathStr, which is then
+ * owned by the batch.
+ */
+static void nLogBatchOpenFile(nLogBatch_t *const batch, const int index,
+ char *pathStr)
+{
+    nLogFile_t *file = &batch->files[index];
+    file->size = 0;
+    file->openTime = nLogNow();
+    if (nFileOpen(pathStr, NFILE_F_WRITE | NFILE_F_CREATE | NFILE_F_APPEND,
+     &file->fd))
+    {
+        file->fd = -1;
+        nFree((void **) &pathStr);
+        return;
+    }
+    file->pathStr = pathStr;
+    const off_t size = lseek(file->fd, 0, SEEK_END);
+    file->size = (size > 0) ? (uint64_t) size : 0;
+
+    if (index == NLOG_FILE_BINARY)
+    {
+        /* Start a new session, which resets the format numbers. */
+        batch->formatCount = 0;
+        if (batch->formats)
+        {
+            memset(batch->formats, 0, sizeof(nLogFormat_t) * batch->formatCap);
+        }
+        nLogSessionChunk_t session = {
+            .magic = NLOG_BINARY_MAGIC,
+            .version = NLOG_BINARY_VERSION,
+            .order = NLOG_BINARY_ORDER,
+            .time = file->openTime
+        };
+        nLogBatchChunk(batch, NLOG_CHUNK_SESSION, &session, sizeof(session));
+    }
+}
+
+/* Closes file sink index of batch. */
+static void nLogBatchCloseFile(nLogBatch_t *const batch, const int index)
+{
+    nLogFile_t *file = &batch->files[index];
+    if (file->fd >= 0) nFileClose(&file->fd);
+    if (file->pathStr) nFree((void **) &file->pathStr);
+    file->fd = -1;
+    file->size = 0;
+}
+
+/* Applies the changes of the file sinks requested by nLogSetFile() and
+ * nLogSetBinaryFile(). */
+static void nLogBatchOpenFiles(nLogBatch_t *const batch)
+{
+    /* Write what was logged before the change to the old files. */
+    nLogBatchWrite(batch);
+
+    const int requested = __atomic_exchange_n(&logFileRequested, 0,
+     __ATOMIC_ACQUIRE);
+    for (int i = 0; i < 2; i++)
+    {
+        if (!(requested & (1 << i))) continue;
+        char *pathStr = __atomic_exchange_n(&logFileRequests[i], NULL,
+         __ATOMIC_ACQUIRE);
+        nLogBatchCloseFile(batch, i);
+        if (pathStr) nLogBatchOpenFile(batch, i, pathStr);
+    }
+}
+
+/**
+ * @brief Renames file sink @p index of @p batch to a segment, opens a new file
+ * in its place, and queues the segment for the archiver thread.
+ *
+ * @note The buffers of the batch must be written before this is invoked.
+ */
+static void nLogBatchRotate(nLogBatch_t *const batch, const int index)
+{
+    nLogFile_t *file = &batch->files[index];
+    char *pathStr = file->pathStr;
+    file->pathStr = NULL;
+    nFileClose(&file->fd);
+
+    /* Name the segment by the time it was rotated, so that the names of the
+     * segments sort by age. */
+    const uint64_t now = nLogNow();
+    const time_t secs = (time_t) (now / NTIME_NS_IN_SEC);
+    struct tm tm;
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    localtime_s(&tm, &secs);
+#else
+    localtime_r(&secs, &tm);
+#endif
+    char timeStr[32];
+    const size_t timeLen = strftime(timeStr, sizeof(timeStr), "%Y%m%d-%H%M%S",
+     &tm);
+    const size_t baseLen = strlen(pathStr);
+    char *segmentStr = nAlloc(baseLen + timeLen + 7);
+    memcpy(segmentStr, pathStr, baseLen);
+    snprintf(segmentStr + baseLen, timeLen + 7, ".%s.%03u", timeStr,
+     (unsigned) ((now % NTIME_NS_IN_SEC) / NTIME_NS_IN_MS));
+
+    if (nFileRename(pathStr, segmentStr))
+    {
+        nFree((void **) &segmentStr);
+    }
+    nLogBatchOpenFile(batch, index, pathStr);
+    if (!segmentStr) return;
+
+    /* Queue the segment, or leave it uncompressed if the queue is full. */
+    const uint32_t head = logArchiveHead;
+    if (head - __atomic_load_n(&logArchiveTail, __ATOMIC_ACQUIRE) >=
+     NLOG_ARCHIVE_QUEUE)
+    {
+        nFree((void **) &segmentStr);
+        return;
+    }
+    logArchiveJobs[head & (NLOG_ARCHIVE_QUEUE - 1)] = (nLogArchiveJob_t) {
+        .pathStr = segmentStr,
+        .baseLen = baseLen
+    };
+    __atomic_store_n(&logArchiveHead, head + 1, __ATOMIC_RELEASE);
+}
+
+/* Rotates the file sinks of batch that are too large or too old. */
+static void nLogBatchRotateFiles(nLogBatch_t *const batch)
+{
+    const uint64_t maxSize = __atomic_load_n(&logRotateSize, __ATOMIC_RELAXED);
+    const uint64_t maxAge = __atomic_load_n(&logRotateAge, __ATOMIC_RELAXED) *
+     NTIME_NS_IN_SEC;
+    if (!maxSize && !maxAge) return;
+
+    uint64_t now = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        const nLogFile_t *file = &batch->files[i];
+        if (file->fd < 0) continue;
+        if (maxAge && !now) now = nLogNow();
+        if ((maxSize && (file->size >= maxSize)) ||
+         (maxAge && (now - file->openTime >= maxAge)))
+        {
+            nLogBatchRotate(batch, i);
+        }
+    }
+}
+
+/**
+ * @brief Writes the published records of every ring in time order.
+ * @return The number of records written.
+ */
+static size_t nLogConsume(nLogBatch_t *const batch)
+{
+    /* Snapshot the published records. Rings added after this are read on the
+     * next pass. */
+    nLogRing_t *rings = __atomic_load_n(&logRings, __ATOMIC_ACQUIRE);
+    for (nLogRing_t *ring = rings; ring; ring = ring->next)
+    {
+        ring->pendingTail = ring->tail;
+        ring->pendingHead = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    }
+
+    /* Only format text if it is written anywhere. */
+    const int formatText = (batch->files[NLOG_FILE_TEXT].fd >= 0) ||
+     __atomic_load_n(&logConsole, __ATOMIC_RELAXED);
+
+    size_t written = 0;
+    for (;;)
+    {
+        /* Merge the rings by the time of their next records. */
+        nLogRing_t *next = NULL;
+        const nLogRecord_t *nextRecord = NULL;
+        for (nLogRing_t *ring = rings; ring; ring = ring->next)
+        {
+            while (ring->pendingTail != ring->pendingHead)
+            {
+                const nLogRecord_t *record = (const nLogRecord_t *)
+                 (ring->slots + ((ring->pendingTail & (NLOG_RING_SLOTS - 1)) *
+                 NLOG_SLOT_SIZE));
+                if (record->level != NLOG_PAD)
+                {
+                    if (!nextRecord || (record->time < nextRecord->time))
+                    {
+                        next = ring;
+                        nextRecord = record;
+                    }
+                    break;
+                }
+                ring->pendingTail += record->slots ? record->slots :
+                 NLOG_RING_SLOTS - (ring->pendingTail & (NLOG_RING_SLOTS - 1));
+            }
+        }
+        if (!next) break;
+
+        /* Leave room for the worst case of a record. */
+        if (nLogBufferFull(&batch->text) || nLogBufferFull(&batch->binary))
+        {
+            nLogBatchWrite(batch);
+        }
+        if (formatText) nLogBatchRecord(batch, nextRecord);
+        if (batch->files[NLOG_FILE_BINARY].fd >= 0)
+        {
+            nLogBatchBinaryRecord(batch, nextRecord);
+        }
+        next->pendingTail += nextRecord->slots;
+        written++;
+    }
+
+    /* Report dropped records. */
+    for (nLogRing_t *ring = rings; ring; ring = ring->next)
+    {
+        const uint64_t dropped = __atomic_load_n(&ring->dropped,
+         __ATOMIC_RELAXED);
+        if (dropped != ring->droppedReported)
+        {
+            nLogBufferPrintf(&batch->text, "[Dropped %" PRIu64 " log records "
+             "of thread T%" PRIu32 ", as its ring was full.]\n",
+             dropped - ring->droppedReported, ring->thread);
+            if (batch->files[NLOG_FILE_BINARY].fd >= 0)
+            {
+                const nLogDroppedChunk_t droppedChunk = {
+                    .thread = ring->thread,
+                    .reserved = 0,
+                    .count = dropped - ring->droppedReported
+                };
+                nLogBatchChunk(batch, NLOG_CHUNK_DROPPED, &droppedChunk,
+                 sizeof(droppedChunk));
+            }
+            ring->droppedReported = dropped;
+        }
+    }
+
+    nLogBatchWrite(batch);
+    return written;
+}
+
+/* Unlinks the rings of exited threads once they are empty. The first ring is
+ * kept, as producers only ever change the list head. Unlinked rings are freed
+ * on the next call, as the crash dump may be walking the list when one is
+ * unlinked, and an unlinked ring still points into the list. */
+static void nLogRetireRings(void)
+{
+    while (logRetired)
+    {
+        nLogRing_t *ring = logRetired;
+        logRetired = ring->retired;
+        nFree((void **) &ring->slots);
+        nFree((void **) &ring);
+    }
+
+    nLogRing_t *prev = __atomic_load_n(&logRings, __ATOMIC_ACQUIRE);
+    if (!prev) return;
+    nLogRing_t *ring = prev->next;
+    while (ring)
+    {
+        nLogRing_t *next = ring->next;
+        if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE) &&
+         (ring->tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)))
+        {
+            __atomic_store_n(&prev->next, next, __ATOMIC_RELEASE);
+            ring->retired = logRetired;
+            logRetired = ring;
+        }
+        else
+        {
+            prev = ring;
+        }
+        ring = next;
+    }
+}
+
+#ifdef NIMBLE_ZLIB
+/**
+ * @brief Compresses the file at @p srcStr to a gzip file at @p dstStr.
+ * @return #NSUCCESS is returned if successful; otherwise an error is returned
+ * and @p dstStr is deleted.
+ */
+static int nLogCompress(const char *const srcStr, const char *const dstStr)
+{
+    int src, dst;
+    int err = nFileOpen(srcStr, NFILE_F_READ | NFILE_F_RAW, &src);
+    if (err) return err;
+    err = nFileOpen(dstStr, NFILE_F_WRITE | NFILE_F_RAW | NFILE_F_CREATE |
+     NFILE_F_CLEAR, &dst);
+    if (err)
+    {
+        nFileClose(&src);
+        return err;
+    }
+
+    uint8_t *in = nAlloc(NLOG_ARCHIVE_BUFFER * 2);
+    uint8_t *out = in + NLOG_ARCHIVE_BUFFER;
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    /* 16 is added to the window bits for a gzip header. */
+    err = (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+     Z_DEFAULT_STRATEGY) == Z_OK) ? NSUCCESS : NERROR_INTERNAL_FAILURE;
+    int flush = Z_NO_FLUSH;
+    while (!err && (flush != Z_FINISH))
+    {
+        const ssize_t rd = nFileRead(src, in, NLOG_ARCHIVE_BUFFER);
+        if (rd < 0)
+        {
+            err = NERROR_INTERNAL_FAILURE;
+            break;
+        }
+        flush = rd ? Z_NO_FLUSH : Z_FINISH;
+        stream.next_in = in;
+        stream.avail_in = (uInt) rd;
+        do
+        {
+            stream.next_out = out;
+            stream.avail_out = NLOG_ARCHIVE_BUFFER;
+            deflate(&stream, flush);
+            size_t have = NLOG_ARCHIVE_BUFFER - stream.avail_out;
+            uint8_t *ptr = out;
+            while (have)
+            {
+                const ssize_t wr = nFileWrite(dst, ptr, have);
+                if (wr <= 0)
+                {
+                    err = NERROR_INTERNAL_FAILURE;
+                    break;
+                }
+                ptr += wr;
+                have -= wr;
+            }
+        }
+        while (!err && !stream.avail_out);
+    }
+    deflateEnd(&stream);
+    nFree((void **) &in);
+    nFileClose(&src);
+    nFileClose(&dst);
+    if (err) nFileDelete(dstStr);
+    return err;
+}
+#endif
+
+/**
+ * @brief The rotated segments of a log file found by nLogRetain().
+ */
+typedef struct nLogSegments {
+    const char *baseStr; /* The name of the log file. */
+    size_t baseLen;
+    char **names;
+    uint64_t *sizes;
+    size_t count;
+    size_t cap;
+} nLogSegments_t;
+
+/* Collects the files named like segments of the log file. */
+static int nLogRetainList(const char *const name, const uint64_t size,
+ void *data)
+{
+    nLogSegments_t *segments = data;
+    if (strncmp(name, segments->baseStr, segments->baseLen) ||
+     (name[segments->baseLen] != '.') ||
+     (name[segments->baseLen + 1] < '0') || (name[segments->baseLen + 1] > '9'))
+    {
+        return 0;
+    }
+    if (segments->count == segments->cap)
+    {
+        segments->cap = segments->cap ? segments->cap * 2 : 32;
+        segments->names = nRealloc(segments->names,
+         sizeof(char *) * segments->cap);
+        segments->sizes = nRealloc(segments->sizes,
+         sizeof(uint64_t) * segments->cap);
+    }
+    segments->names[segments->count] = nStringDuplicate(name, strlen(name));
+    segments->sizes[segments->count] = size;
+    segments->count++;
+    return 0;
+}
+
+/**
+ * @brief Deletes the oldest segments of the log file at @p pathStr that exceed
+ * the retention limits set by nLogSetRotation().
+ */
+static void nLogRetain(const char *const pathStr, const size_t pathLen)
+{
+    const uint32_t maxFiles = __atomic_load_n(&logRetainFiles,
+     __ATOMIC_RELAXED);
+    const uint64_t maxTotal = __atomic_load_n(&logRetainSize, __ATOMIC_RELAXED);
+    if (!maxFiles && !maxTotal) return;
+
+    /* Split the path into its directory and name. */
+    size_t dirLen = pathLen;
+    while (dirLen && (pathStr[dirLen - 1] != NFILE_DIR_SEP) &&
+     (pathStr[dirLen - 1] != '/'))
+    {
+        dirLen--;
+    }
+    char *dirStr = dirLen ? nStringDuplicate(pathStr, dirLen - 1) :
+     nStringDuplicate(".", 1);
+    nLogSegments_t segments = {
+        .baseStr = pathStr + dirLen,
+        .baseLen = pathLen - dirLen,
+        .names = NULL,
+        .sizes = NULL,
+        .count = 0,
+        .cap = 0
+    };
+    if (nFileListDir(dirLen ? dirStr : ".", nLogRetainList, &segments))
+    {
+        nFree((void **) &dirStr);
+        return;
+    }
+
+    /* Sort the segments from newest to oldest by their names. */
+    for (size_t i = 1; i < segments.count; i++)
+    {
+        char *name = segments.names[i];
+        const uint64_t size = segments.sizes[i];
+        size_t j = i;
+        for (; j && (strcmp(segments.names[j - 1], name) < 0); j--)
+        {
+            segments.names[j] = segments.names[j - 1];
+            segments.sizes[j] = segments.sizes[j - 1];
+        }
+        segments.names[j] = name;
+        segments.sizes[j] = size;
+    }
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < segments.count; i++)
+    {
+        total += segments.sizes[i];
+        if ((maxFiles && (i >= maxFiles)) || (maxTotal && (total > maxTotal)))
+        {
+            const size_t nameLen = strlen(segments.names[i]);
+            char *segmentStr = nAlloc(dirLen + nameLen + 1);
+            memcpy(segmentStr, pathStr, dirLen);
+            memcpy(segmentStr + dirLen, segments.names[i], nameLen + 1);
+            nFileDelete(segmentStr);
+            nFree((void **) &segmentStr);
+        }
+        nFree((void **) &segments.names[i]);
+    }
+    if (segments.names) nFree((void **) &segments.names);
+    if (segments.sizes) nFree((void **) &segments.sizes);
+    nFree((void **) &dirStr);
+}
+
+/**
+ * @brief Compresses rotated segments and applies the retention limits, so that
+ * the logging thread never waits on either.
+ */
+static nThreadRoutine_t nLogArchiverRoutine(void *data)
+{
+    (void) data;
+    nThreadLowerPriority();
+    /* The log files to apply the retention limits to once the queue is empty,
+     * so that no queued segment gets deleted. */
+    char *retainStrs[NLOG_ARCHIVE_QUEUE];
+    int retainCount = 0;
+    for (;;)
+    {
+        const uint32_t tail = logArchiveTail;
+        if (tail == __atomic_load_n(&logArchiveHead, __ATOMIC_ACQUIRE))
+        {
+            for (int i = 0; i < retainCount; i++)
+            {
+                nLogRetain(retainStrs[i], strlen(retainStrs[i]));
+                nFree((void **) &retainStrs[i]);
+            }
+            retainCount = 0;
+
+            /* Stop once the logging thread has stopped and the queue is
+             * empty. */
+            if (!__atomic_load_n(&logArchiving, __ATOMIC_ACQUIRE)) break;
+            nTimeNanoSleep(NLOG_FLUSH_INTERVAL * 10 * NTIME_NS_IN_MS);
+            continue;
+        }
+
+        nLogArchiveJob_t job = logArchiveJobs[tail & (NLOG_ARCHIVE_QUEUE - 1)];
+        __atomic_store_n(&logArchiveTail, tail + 1, __ATOMIC_RELEASE);
+#ifdef NIMBLE_ZLIB
+        const size_t pathLen = strlen(job.pathStr);
+        char *gzipStr = nAlloc(pathLen + 4);
+        memcpy(gzipStr, job.pathStr, pathLen);
+        memcpy(gzipStr + pathLen, ".gz", 4);
+        if (!nLogCompress(job.pathStr, gzipStr)) nFileDelete(job.pathStr);
+        nFree((void **) &gzipStr);
+#endif
+        int found = 0;
+        for (int i = 0; i < retainCount; i++)
+        {
+            if (!strncmp(retainStrs[i], job.pathStr, job.baseLen) &&
+             !retainStrs[i][job.baseLen])
+            {
+                found = 1;
+                break;
+            }
+        }
+        if (!found && (retainCount < NLOG_ARCHIVE_QUEUE))
+        {
+            retainStrs[retainCount++] = nStringDuplicate(job.pathStr,
+             job.baseLen);
+        }
+        nFree((void **) &job.pathStr);
+    }
+    return (nThreadRoutine_t) 0;
+}
+
+static nThreadRoutine_t nLogThreadRoutine(void *data)
+{
+    (void) data;
+    nLogBatch_t *batch = nAlloc(sizeof(nLogBatch_t));
+    batch->text.iovCount = 0;
+    batch->text.textLen = 0;
+    batch->binary.iovCount = 0;
+    batch->binary.textLen = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        batch->files[i].fd = -1;
+        batch->files[i].pathStr = NULL;
+        batch->files[i].size = 0;
+        batch->files[i].openTime = 0;
+    }
+    batch->lastSecs = -1;
+    batch->formats = NULL;
+    batch->formatCount = 0;
+    batch->formatCap = 0;
+
+    while (__atomic_load_n(&logRunning, __ATOMIC_ACQUIRE))
+    {
+        if (__atomic_load_n(&logFileRequested, __ATOMIC_ACQUIRE))
+        {
+            nLogBatchOpenFiles(batch);
+        }
+        const size_t written = nLogConsume(batch);
+        nLogBatchRotateFiles(batch);
+        if (!written)
+        {
+            nLogRetireRings();
+            nTimeNanoSleep(NLOG_FLUSH_INTERVAL * NTIME_NS_IN_MS);
+        }
+    }
+
+    /* Write the remaining records. */
+    while (nLogConsume(batch));
+    for (int i = 0; i < 2; i++) nLogBatchCloseFile(batch, i);
+    if (batch->formats) nFree((void **) &batch->formats);
+    nFree((void **) &batch);
+    return (nThreadRoutine_t) 0;
+}
+
+int nLogStart(void)
+{
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&logRunning, &expected, 1, 0,
+     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        return NSUCCESS;
+    }
+
+    __atomic_store_n(&logArchiving, 1, __ATOMIC_RELEASE);
+    int err = nThreadCreate(&logArchiver, nLogArchiverRoutine, NULL);
+    if (err)
+    {
+        __atomic_store_n(&logArchiving, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&logRunning, 0, __ATOMIC_RELEASE);
+        return err;
+    }
+    err = nThreadCreate(&logThread, nLogThreadRoutine, NULL);
+    if (err)
+    {
+        __atomic_store_n(&logArchiving, 0, __ATOMIC_RELEASE);
+        nThreadJoin(logArchiver, NULL);
+        logArchiver = NULL;
+        __atomic_store_n(&logRunning, 0, __ATOMIC_RELEASE);
+        return err;
+    }
+    return NSUCCESS;
+}
+
+void nLogStop(void)
+{
+    if (!__atomic_exchange_n(&logRunning, 0, __ATOMIC_ACQ_REL)) return;
+    nThreadJoin(logThread, NULL);
+    logThread = NULL;
+
+    /* The archiver finishes the segments rotated before the logging thread
+     * stopped. */
+    __atomic_store_n(&logArchiving, 0, __ATOMIC_RELEASE);
+    nThreadJoin(logArchiver, NULL);
+    logArchiver = NULL;
+}
+
+int nLogRunning(void)
+{
+    return __atomic_load_n(&logRunning, __ATOMIC_ACQUIRE);
+}
+
+void nLogFlush(void)
+{
+    if (!nLogRunning()) return;
+    /* Two full batches guarantee a pass started after this was invoked. */
+    const uint64_t written = __atomic_load_n(&logWritten, __ATOMIC_ACQUIRE);
+    while (nLogRunning() &&
+     (__atomic_load_n(&logWritten, __ATOMIC_ACQUIRE) - written < 2))
+    {
+        nTimeNanoSleep(NTIME_NS_IN_MS);
+    }
+}
+
+/* Requests the logging thread to change the file sink at index. */
+static void nLogRequestFile(const int index, const char *const pathStr)
+{
+    char *copyStr = pathStr ? nStringDuplicate(pathStr, strlen(pathStr)) : NULL;
+    char *oldStr = __atomic_exchange_n(&logFileRequests[index], copyStr,
+     __ATOMIC_ACQ_REL);
+    if (oldStr) nFree((void **) &oldStr);
+    __atomic_or_fetch(&logFileRequested, 1 << index, __ATOMIC_RELEASE);
+}
+
+void nLogSetFile(const char *const pathStr)
+{
+    nLogRequestFile(NLOG_FILE_TEXT, pathStr);
+}
+
+void nLogSetBinaryFile(const char *const pathStr)
+{
+    nLogRequestFile(NLOG_FILE_BINARY, pathStr);
+}
+
+void nLogSetConsole(const int enabled)
+{
+    __atomic_store_n(&logConsole, enabled, __ATOMIC_RELAXED);
+}
+
+void nLogSetRotation(const uint64_t maxSize, const uint64_t maxAge,
+ const uint32_t maxFiles, const uint64_t maxTotal)
+{
+    __atomic_store_n(&logRotateSize, maxSize, __ATOMIC_RELAXED);
+    __atomic_store_n(&logRotateAge, maxAge, __ATOMIC_RELAXED);
+    __atomic_store_n(&logRetainFiles, maxFiles, __ATOMIC_RELAXED);
+    __atomic_store_n(&logRetainSize, maxTotal, __ATOMIC_RELAXED);
+}
+
+/* Writes len bytes at data to fd, retrying partial writes. */
+static int nLogCrashWriteAll(const int fd, const void *const data, size_t len)
+{
+    const uint8_t *ptr = data;
+    while (len)
+    {
+        const ssize_t written = write(fd, ptr, len);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        ptr += written;
+        len -= (size_t) written;
+    }
+    return 0;
+}
+
+/* Writes the header of a chunk of len bytes. */
+static int nLogCrashChunk(const int fd, const uint32_t kind,
+ const uint32_t len)
+{
+    const nLogChunk_t chunk = {.kind = kind, .len = len};
+    return nLogCrashWriteAll(fd, &chunk, sizeof(chunk));
+}
+
+uint32_t nLogCrashWrite(const int fd)
+{
+    nLogSessionChunk_t session = {
+        .magic = NLOG_BINARY_MAGIC,
+        .version = NLOG_BINARY_VERSION,
+        .order = NLOG_BINARY_ORDER,
+        .time = nLogNow()
+    };
+    if (nLogCrashChunk(fd, NLOG_CHUNK_SESSION, sizeof(session)) ||
+     nLogCrashWriteAll(fd, &session, sizeof(session))) return 0;
+
+    /* Each record gets its own format number, as there is no memory to
+     * deduplicate them with. */
+    uint32_t count = 0;
+    for (nLogRing_t *ring = __atomic_load_n(&logRings, __ATOMIC_ACQUIRE); ring;
+     ring = ring->next)
+    {
+        const uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head - tail > NLOG_RING_SLOTS) continue;
+        while (tail != head)
+        {
+            const nLogRecord_t *record = (const nLogRecord_t *) (ring->slots +
+             ((tail & (NLOG_RING_SLOTS - 1)) * NLOG_SLOT_SIZE));
+            if (record->level == NLOG_PAD)
+            {
+                tail += record->slots ? record->slots :
+                 NLOG_RING_SLOTS - (tail & (NLOG_RING_SLOTS - 1));
+                continue;
+            }
+            if (!record->slots || (record->slots > NLOG_RECORD_SLOTS_MAX) ||
+             (record->level > NLOG_FATAL) || (record->argc > NLOG_ARGS_MAX) ||
+             !record->format) break;
+
+            const uint32_t format = count;
+            const uint32_t formatLen = (uint32_t) strlen(record->format);
+            if (nLogCrashChunk(fd, NLOG_CHUNK_FORMAT, sizeof(format) +
+             formatLen) || nLogCrashWriteAll(fd, &format, sizeof(format)) ||
+             nLogCrashWriteAll(fd, record->format, formatLen)) return count;
+
+            const nLogRecordChunk_t header = {
+                .time = record->time,
+                .format = format,
+                .thread = record->thread,
+                .len = record->len,
+                .level = record->level,
+                .argc = record->argc,
+                .reserved = 0
+            };
+            if (nLogCrashChunk(fd, NLOG_CHUNK_RECORD, sizeof(header) +
+             record->argc + record->len) ||
+             nLogCrashWriteAll(fd, &header, sizeof(header)) ||
+             nLogCrashWriteAll(fd, record->types, record->argc) ||
+             nLogCrashWriteAll(fd, record->data, record->len)) return count;
+            tail += record->slots;
+            count++;
+        }
+    }
+    return count;
+}
+
+// Logging.c
@@ -42,13 +42,28 @@
  */
 
 #include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/Memory.h"
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+#  include <windows.h>
+#elif NIMBLE_OS == NIMBLE_MACOS
+#  include <sys/sysctl.h>
+#  include <unistd.h>
+#else
+#  include <unistd.h>
+#  if (NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)
+#    include <sys/auxv.h>
+#  endif
+#endif
 
 char NCPU_INFO[129] = {0};
 size_t NCPU_INFO_LEN = 0;
+nCPUInfo_t NCPU_DETAILS = {0};
 
 #if NIMBLE_INST == NIMBLE_INST_ARM
 /* Architecture definitions */
@@ -116,7 +131,7 @@ void nGetInfoReg(uint64_t *val1)
         "movl %%ebx,%1\n"
         "movl %%ecx,%2\n"
         "movl %%edx,%3\n"
-        : "=g" (*val2),  "=g" (*val1),
+        : "=g" (*val1), "=g" (*val2),
           "=g" (*val3), "=g" (*val4)
         : "r" (operation)
         : "%eax", "%ebx", "%ecx", "%edx"
@@ -131,9 +146,418 @@ void nGetInfoReg(uint64_t *val1)
 #endif
 }
 
+#if NIMBLE_INST == NIMBLE_INST_x86
+/* Runs cpuid with a subleaf, which nGetInfoReg() does not set. */
+NIMBLE_INLINE
+void nCPUID(const uint32_t leaf, const uint32_t subleaf, uint32_t regs[4])
+{
+    asm volatile("cpuid"
+     : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+     : "a" (leaf), "c" (subleaf));
+}
+#endif
+
+/* Adds a cache to info, keeping the caches ordered by level. Caches that are
+ * already known are ignored. */
+static void nCPUAddCache(nCPUInfo_t *const info, const nCPUCache_t *const cache)
+{
+    if (!cache->level || !cache->size) return;
+    uint32_t i = 0;
+    for (; i < info->cacheCount; i++)
+    {
+        if ((info->caches[i].level == cache->level) &&
+         (info->caches[i].type == cache->type)) return;
+        if (info->caches[i].level > cache->level) break;
+    }
+    if (info->cacheCount >= NCPU_MAX_CACHES) return;
+
+    memmove(info->caches + i + 1, info->caches + i,
+     (info->cacheCount - i) * sizeof(nCPUCache_t));
+    info->caches[i] = *cache;
+    info->cacheCount++;
+}
+
+/* Detects the supported instruction set features. */
+static void nCPUDetectFeatures(nCPUInfo_t *const info)
+{
+#if NIMBLE_INST == NIMBLE_INST_x86
+    uint32_t regs[4];
+    nCPUID(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+
+    nCPUID(1, 0, regs);
+    const uint32_t ecx = regs[2], edx = regs[3];
+    uint64_t features = 0;
+    if (edx & (1U << 26)) features |= NCPU_FEATURE_SSE2;
+    if (ecx & (1U << 0))  features |= NCPU_FEATURE_SSE3;
+    if (ecx & (1U << 9))  features |= NCPU_FEATURE_SSSE3;
+    if (ecx & (1U << 19)) features |= NCPU_FEATURE_SSE41;
+    if (ecx & (1U << 20)) features |= NCPU_FEATURE_SSE42 | NCPU_FEATURE_CRC32;
+    if (ecx & (1U << 23)) features |= NCPU_FEATURE_POPCNT;
+    if (ecx & (1U << 25)) features |= NCPU_FEATURE_AES;
+
+    /* The AVX registers can only be used if the OS saves them on context
+     * switches, which is reported by XCR0. */
+    uint64_t xcr0 = 0;
+    if (ecx & (1U << 27))
+    {
+        uint32_t lo, hi;
+        asm volatile("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        xcr0 = ((uint64_t) hi << 32) | lo;
+    }
+    const int avxSaved = (xcr0 & 0x6) == 0x6;
+    const int avx512Saved = (xcr0 & 0xe6) == 0xe6;
+    if (avxSaved)
+    {
+        if (ecx & (1U << 28)) features |= NCPU_FEATURE_AVX;
+        if (ecx & (1U << 12)) features |= NCPU_FEATURE_FMA;
+        if (ecx & (1U << 29)) features |= NCPU_FEATURE_F16C;
+    }
+
+    if (maxLeaf >= 7)
+    {
+        nCPUID(7, 0, regs);
+        const uint32_t ebx = regs[1];
+        if (ebx & (1U << 3)) features |= NCPU_FEATURE_BMI1;
+        if (ebx & (1U << 8)) features |= NCPU_FEATURE_BMI2;
+        if (ebx & (1U << 19)) features |= NCPU_FEATURE_ADX;
+        if (avxSaved && (ebx & (1U << 5))) features |= NCPU_FEATURE_AVX2;
+        if (avx512Saved && (ebx & (1U << 16)))
+        {
+            features |= NCPU_FEATURE_AVX512F;
+            if (ebx & (1U << 17)) features |= NCPU_FEATURE_AVX512DQ;
+            if (ebx & (1U << 30)) features |= NCPU_FEATURE_AVX512BW;
+            if (ebx & (1U << 31)) features |= NCPU_FEATURE_AVX512VL;
+        }
+    }
+    info->features = features;
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    /* Advanced SIMD is required by AArch64. */
+    info->features = NCPU_FEATURE_NEON;
+#  if (NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    const unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    if (hwcap & (1UL << 3))  info->features |= NCPU_FEATURE_AES;
+    if (hwcap & (1UL << 7))  info->features |= NCPU_FEATURE_CRC32;
+    if (hwcap & (1UL << 22)) info->features |= NCPU_FEATURE_SVE;
+    if (hwcap2 & (1UL << 1)) info->features |= NCPU_FEATURE_SVE2;
+#  elif NIMBLE_OS == NIMBLE_MACOS
+    /* Apple silicon implements the ARMv8.4 crypto and CRC extensions. */
+    info->features |= NCPU_FEATURE_AES | NCPU_FEATURE_CRC32;
+#  elif NIMBLE_OS == NIMBLE_WINDOWS
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE))
+     info->features |= NCPU_FEATURE_AES;
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE))
+     info->features |= NCPU_FEATURE_CRC32;
+#  endif
+#endif
+}
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+/* Detects the caches with the deterministic cache parameters of cpuid, for
+ * systems that do not report them. */
+static void nCPUDetectCachesCPUID(nCPUInfo_t *const info)
+{
+    uint32_t regs[4];
+    nCPUID(0, 0, regs);
+    uint32_t leaf = (regs[0] >= 4) ? 4 : 0;
+
+    /* AMD reports the same format with its topology extensions. */
+    nCPUID(0x80000001, 0, regs);
+    if (regs[2] & (1U << 22)) leaf = 0x8000001D;
+    if (!leaf) return;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        nCPUID(leaf, i, regs);
+        const uint32_t type = regs[0] & 0x1f;
+        if (!type) break;
+
+        const nCPUCache_t cache = {
+            .level = (regs[0] >> 5) & 0x7,
+            .type = type,
+            .lineSize = (regs[1] & 0xfff) + 1,
+            .ways = ((regs[1] >> 22) & 0x3ff) + 1,
+            .size = (((regs[1] >> 22) & 0x3ff) + 1) *
+             (((regs[1] >> 12) & 0x3ff) + 1) * ((regs[1] & 0xfff) + 1) *
+             (regs[2] + 1),
+            .sharing = ((regs[0] >> 14) & 0xfff) + 1,
+        };
+        nCPUAddCache(info, &cache);
+    }
+}
+#endif
+
+#if (NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)
+/* Reads the first line of a sysfs file. Returns the length read, or 0 if the
+ * file could not be read. */
+static size_t nCPUReadSys(const char *const path, char *const buf,
+ const size_t size)
+{
+    FILE *file = fopen(path, "r");
+    if (!file) return 0;
+    if (!fgets(buf, (int) size, file)) buf[0] = '\0';
+    fclose(file);
+
+    size_t len = strlen(buf);
+    while (len && ((buf[len - 1] == '\n') || (buf[len - 1] == ' '))) len--;
+    buf[len] = '\0';
+    return len;
+}
+
+/* Counts the CPUs in a sysfs CPU list, such as "0-3,8-11". */
+static uint32_t nCPUCountList(const char *str)
+{
+    uint32_t count = 0;
+    while (*str)
+    {
+        char *end;
+        const unsigned long first = strtoul(str, &end, 10);
+        unsigned long last = first;
+        if (end == str) break;
+        if (*end == '-') last = strtoul(end + 1, &end, 10);
+        if (last >= first) count += (uint32_t) (last - first + 1);
+        str = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+/* Detects the topology and caches from sysfs. */
+static void nCPUDetectTopology(nCPUInfo_t *const info)
+{
+    char path[128];
+    char buf[256];
+
+    const long configured = sysconf(_SC_NPROCESSORS_CONF);
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    info->logicalCores = (online > 0) ? (uint32_t) online : 1;
+
+    /* Each physical core is a unique pair of package and core ID. */
+    if (configured > 0)
+    {
+        uint64_t *cores = nAlloc(configured * sizeof(uint64_t));
+        uint32_t *packages = nAlloc(configured * sizeof(uint32_t));
+        uint32_t coreCount = 0, packageCount = 0;
+        for (long cpu = 0; cpu < configured; cpu++)
+        {
+            snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%ld/topology/physical_package_id",
+             cpu);
+            if (!nCPUReadSys(path, buf, sizeof(buf))) continue;
+            const uint32_t package = (uint32_t) strtoul(buf, NULL, 10);
+            snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%ld/topology/core_id", cpu);
+            if (!nCPUReadSys(path, buf, sizeof(buf))) continue;
+            const uint64_t core = ((uint64_t) package << 32) |
+             (uint32_t) strtoul(buf, NULL, 10);
+
+            uint32_t i = 0;
+            for (; (i < coreCount) && (cores[i] != core); i++);
+            if (i == coreCount) cores[coreCount++] = core;
+            for (i = 0; (i < packageCount) && (packages[i] != package); i++);
+            if (i == packageCount) packages[packageCount++] = package;
+        }
+        info->physicalCores = coreCount;
+        info->packages = packageCount;
+        nFree((void **) &cores);
+        nFree((void **) &packages);
+    }
+
+    /* The online nodes are listed like CPUs, such as "0-1". */
+    if (nCPUReadSys("/sys/devices/system/node/online", buf, sizeof(buf)))
+    {
+        info->numaNodes = nCPUCountList(buf);
+    }
+
+    for (int index = 0; index < 16; index++)
+    {
+        nCPUCache_t cache = {0};
+        snprintf(path, sizeof(path),
+         "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        if (!nCPUReadSys(path, buf, sizeof(buf))) break;
+        cache.level = (uint32_t) strtoul(buf, NULL, 10);
+
+        snprintf(path, sizeof(path),
+         "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        nCPUReadSys(path, buf, sizeof(buf));
+        if (!strcmp(buf, "Data")) cache.type = NCPU_CACHE_DATA;
+        else if (!strcmp(buf, "Instruction"))
+         cache.type = NCPU_CACHE_INSTRUCTION;
+        else cache.type = NCPU_CACHE_UNIFIED;
+
+        snprintf(path, sizeof(path),
+         "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        if (nCPUReadSys(path, buf, sizeof(buf)))
+        {
+            char *end;
+            cache.size = (uint32_t) strtoul(buf, &end, 10);
+            if (*end == 'K') cache.size <<= 10;
+            else if (*end == 'M') cache.size <<= 20;
+        }
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/"
+         "index%d/coherency_line_size", index);
+        if (nCPUReadSys(path, buf, sizeof(buf)))
+         cache.lineSize = (uint32_t) strtoul(buf, NULL, 10);
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/"
+         "index%d/ways_of_associativity", index);
+        if (nCPUReadSys(path, buf, sizeof(buf)))
+         cache.ways = (uint32_t) strtoul(buf, NULL, 10);
+
+        snprintf(path, sizeof(path),
+         "/sys/devices/system/cpu/cpu0/cache/index%d/shared_cpu_list", index);
+        cache.sharing = nCPUReadSys(path, buf, sizeof(buf)) ?
+         nCPUCountList(buf) : 1;
+
+        nCPUAddCache(info, &cache);
+    }
+}
+#elif NIMBLE_OS == NIMBLE_WINDOWS
+/* Detects the topology and caches from the logical processor information. */
+static void nCPUDetectTopology(nCPUInfo_t *const info)
+{
+    DWORD size = 0;
+    GetLogicalProcessorInformationEx(RelationAll, NULL, &size);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) return;
+
+    char *buffer = nAlloc(size);
+    if (!GetLogicalProcessorInformationEx(RelationAll,
+     (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX) buffer, &size))
+    {
+        nFree((void **) &buffer);
+        return;
+    }
+
+    for (DWORD offset = 0; offset < size;)
+    {
+        const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *const entry =
+         (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *) (buffer + offset);
+        switch (entry->Relationship)
+        {
+            case RelationProcessorCore:
+                info->physicalCores++;
+                for (WORD i = 0; i < entry->Processor.GroupCount; i++)
+                {
+                    info->logicalCores += (uint32_t)
+                     __builtin_popcountll(entry->Processor.GroupMask[i].Mask);
+                }
+                break;
+            case RelationProcessorPackage:
+                info->packages++;
+                break;
+            case RelationNumaNode:
+                info->numaNodes++;
+                break;
+            case RelationCache:
+            {
+                const CACHE_RELATIONSHIP *const c = &entry->Cache;
+                const nCPUCache_t cache = {
+                    .level = c->Level,
+                    .type = (c->Type == CacheData) ? NCPU_CACHE_DATA :
+                     (c->Type == CacheInstruction) ? NCPU_CACHE_INSTRUCTION :
+                     NCPU_CACHE_UNIFIED,
+                    .size = c->CacheSize,
+                    .lineSize = c->LineSize,
+                    .ways = (c->Associativity == CACHE_FULLY_ASSOCIATIVE) ?
+                     0 : c->Associativity,
+                    .sharing = (uint32_t)
+                     __builtin_popcountll(c->GroupMask.Mask),
+                };
+                nCPUAddCache(info, &cache);
+                break;
+            }
+            default:
+                break;
+        }
+        offset += entry->Size;
+    }
+    nFree((void **) &buffer);
+}
+#elif NIMBLE_OS == NIMBLE_MACOS
+/* Reads a 32-bit sysctl value. Returns 0 if it does not exist. */
+static uint32_t nCPUSysctl(const char *const name)
+{
+    uint64_t value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, NULL, 0)) return 0;
+    return (size == sizeof(uint32_t)) ? *(uint32_t *) &value :
+     (uint32_t) value;
+}
+
+/* Detects the topology and caches from sysctl. */
+static void nCPUDetectTopology(nCPUInfo_t *const info)
+{
+    info->logicalCores = nCPUSysctl("hw.logicalcpu");
+    info->physicalCores = nCPUSysctl("hw.physicalcpu");
+    info->packages = nCPUSysctl("hw.packages");
+
+    const uint32_t lineSize = nCPUSysctl("hw.cachelinesize");
+    const uint32_t logical = nCPUSysctl("hw.logicalcpu_max");
+    nCPUCache_t cache = {
+        .level = 1, .type = NCPU_CACHE_DATA, .lineSize = lineSize,
+        .size = nCPUSysctl("hw.l1dcachesize"), .sharing = 1,
+    };
+    nCPUAddCache(info, &cache);
+    cache.type = NCPU_CACHE_INSTRUCTION;
+    cache.size = nCPUSysctl("hw.l1icachesize");
+    nCPUAddCache(info, &cache);
+
+    /* The performance level lists how many processors share the cache. */
+    cache.type = NCPU_CACHE_UNIFIED;
+    cache.level = 2;
+    cache.size = nCPUSysctl("hw.l2cachesize");
+    cache.sharing = nCPUSysctl("hw.perflevel0.cpusperl2");
+    if (!cache.sharing) cache.sharing = logical;
+    nCPUAddCache(info, &cache);
+    cache.level = 3;
+    cache.size = nCPUSysctl("hw.l3cachesize");
+    cache.sharing = logical;
+    nCPUAddCache(info, &cache);
+}
+#else
+/* Detects the number of processors, which is all that is portable. */
+static void nCPUDetectTopology(nCPUInfo_t *const info)
+{
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    info->logicalCores = (online > 0) ? (uint32_t) online : 1;
+}
+#endif
+
+/* Detects the topology, caches, and features of the CPU. */
+static void nCPUDetect(nCPUInfo_t *const info)
+{
+    memset(info, 0, sizeof(nCPUInfo_t));
+    nCPUDetectFeatures(info);
+    nCPUDetectTopology(info);
+#if NIMBLE_INST == NIMBLE_INST_x86
+    if (!info->cacheCount) nCPUDetectCachesCPUID(info);
+#endif
+
+    /* Fill in anything the system did not report. */
+    if (!info->logicalCores) info->logicalCores = 1;
+    if (!info->physicalCores) info->physicalCores = info->logicalCores;
+    if (!info->packages) info->packages = 1;
+    if (!info->numaNodes) info->numaNodes = 1;
+    info->threadsPerCore = info->logicalCores / info->physicalCores;
+    if (!info->threadsPerCore) info->threadsPerCore = 1;
+
+    info->cacheLineSize = 64;
+    for (uint32_t i = 0; i < info->cacheCount; i++)
+    {
+        if ((info->caches[i].level == 1) && info->caches[i].lineSize &&
+         (info->caches[i].type != NCPU_CACHE_INSTRUCTION))
+        {
+            info->cacheLineSize = info->caches[i].lineSize;
+            break;
+        }
+    }
+}
+
 char *nSysGetCPUInfo(size_t *len)
 {
-    /** @todo Get more CPU info (logical/physical processors) and use function similar to lscpu. */
+    if (!NCPU_DETAILS.logicalCores) nCPUDetect(&NCPU_DETAILS);
+
     if (!NCPU_INFO[0])
     {
 #if NIMBLE_INST == NIMBLE_INST_x86
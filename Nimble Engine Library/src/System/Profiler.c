@@ -0,0 +1,553 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Profiler.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/System/Profiler.h"
+
+/**
+ * @file Profiler.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the instrumentation profiler.
+ */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/Output/Files.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Threads.h"
+
+#define NPROFILE_NAME_MAX 64
+#define NPROFILE_WRITE_BUFFER 65536
+
+/**
+ * @brief A single producer, single consumer buffer of profiler events.
+ */
+typedef struct nProfileBuffer {
+    struct nProfileBuffer *volatile next; /* The next buffer in the list. */
+    nProfileEvent_t *events; /* NPROFILE_BUFFER_EVENTS events. */
+    uint32_t thread; /* The number of the thread that owns the buffer. */
+    volatile uint32_t closed; /* Set when the owning thread exits. */
+    char nameStr[NPROFILE_NAME_MAX]; /* The name of the thread. */
+    volatile uint32_t named; /* Odd while the name is written, and even once it is. */
+    uint32_t namedWritten; /* The value of named last written by the consumer. */
+    uint64_t droppedWritten; /* Dropped events last written by the consumer. */
+    char pad0[64];
+
+    volatile uint64_t head; /* Written by the producer. */
+    uint64_t cachedTail; /* The producer's copy of tail. */
+    volatile uint64_t dropped; /* Events dropped because the buffer was full. */
+    char pad1[64];
+
+    volatile uint64_t tail; /* Written by the consumer. */
+} nProfileBuffer_t;
+
+/**
+ * @brief The state of a trace file being written.
+ */
+typedef struct nProfileWriter {
+    int fd; /* The file descriptor of the trace. */
+    size_t len; /* The length of buf. */
+    uint64_t count; /* The number of events written. */
+    char buf[NPROFILE_WRITE_BUFFER]; /* The text not yet written to fd. */
+} nProfileWriter_t;
+
+volatile int nProfileEnabled = 1;
+
+static __thread nProfileBuffer_t *profileBuffer = NULL;
+static nProfileBuffer_t *volatile profileBuffers = NULL;
+static volatile uint32_t profileThreadCount = 0;
+static volatile int64_t profileFrame = 0;
+static volatile int profileWriting = 0; /* Held while a trace is written. */
+
+static nThread_t profileRoller = NULL;
+static volatile int profileRolling = 0;
+static nProfileWriter_t *profileRollWriter = NULL;
+
+/* Thread exit handling, used to retire the buffers of exited threads. */
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+static DWORD profileKey = FLS_OUT_OF_INDEXES;
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+static pthread_key_t profileKey;
+#elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+static tss_t profileKey;
+#endif
+static volatile int profileKeyState = 0;
+
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+static void WINAPI nProfileThreadExit(void *data)
+#else
+static void nProfileThreadExit(void *data)
+#endif
+{
+    nProfileBuffer_t *buffer = data;
+    if (!buffer) return;
+    if (profileBuffer == buffer) profileBuffer = NULL;
+    __atomic_store_n(&buffer->closed, 1, __ATOMIC_RELEASE);
+}
+
+static void nProfileKeyInit(void)
+{
+    int expected = 0;
+    if (__atomic_compare_exchange_n(&profileKeyState, &expected, 1, 0,
+     __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+    {
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+        profileKey = FlsAlloc(nProfileThreadExit);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+        pthread_key_create(&profileKey, nProfileThreadExit);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+        tss_create(&profileKey, nProfileThreadExit);
+#endif
+        __atomic_store_n(&profileKeyState, 2, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        while (__atomic_load_n(&profileKeyState, __ATOMIC_ACQUIRE) != 2);
+    }
+}
+
+/**
+ * @brief Creates and registers the invoking thread's buffer.
+ * @return The buffer of the invoking thread.
+ */
+static nProfileBuffer_t *nProfileBufferCreate(void)
+{
+    nProfileBuffer_t *buffer = nAlloc(sizeof(nProfileBuffer_t));
+    memset(buffer, 0, sizeof(nProfileBuffer_t));
+    buffer->events = nAlloc(NPROFILE_BUFFER_EVENTS * sizeof(nProfileEvent_t));
+    /* Touch the pages now rather than faulting them in while recording. */
+    memset(buffer->events, 0, NPROFILE_BUFFER_EVENTS * sizeof(nProfileEvent_t));
+    buffer->thread = __atomic_add_fetch(&profileThreadCount, 1,
+     __ATOMIC_RELAXED);
+
+    if (__atomic_load_n(&profileKeyState, __ATOMIC_ACQUIRE) != 2)
+    {
+        nProfileKeyInit();
+    }
+#if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
+    FlsSetValue(profileKey, buffer);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+    pthread_setspecific(profileKey, buffer);
+#elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+    tss_set(profileKey, buffer);
+#endif
+
+    nProfileBuffer_t *next = __atomic_load_n(&profileBuffers,
+     __ATOMIC_RELAXED);
+    do
+    {
+        buffer->next = next;
+    }
+    while (!__atomic_compare_exchange_n(&profileBuffers, &next, buffer, 1,
+     __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    profileBuffer = buffer;
+    return buffer;
+}
+
+void nProfileRecord(const nProfileSite_t *const site, const uint64_t time,
+ const int64_t value)
+{
+    nProfileBuffer_t *buffer = profileBuffer;
+    if (!buffer) buffer = nProfileBufferCreate();
+
+    const uint64_t head = buffer->head;
+    if (head - buffer->cachedTail >= NPROFILE_BUFFER_EVENTS)
+    {
+        buffer->cachedTail = __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+        if (head - buffer->cachedTail >= NPROFILE_BUFFER_EVENTS)
+        {
+            __atomic_store_n(&buffer->dropped, buffer->dropped + 1,
+             __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+    nProfileEvent_t *const event =
+     &buffer->events[head & (NPROFILE_BUFFER_EVENTS - 1)];
+    event->time = time;
+    event->site = site;
+    event->value = value;
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void nProfileFrame(const nProfileSite_t *const site)
+{
+    if (!nProfileEnabled) return;
+    nProfileRecord(site, nTicks(),
+     __atomic_add_fetch(&profileFrame, 1, __ATOMIC_RELAXED));
+}
+
+void nProfileThreadName(const char *const nameStr)
+{
+    if (!nameStr) return;
+    nProfileBuffer_t *buffer = profileBuffer;
+    if (!buffer) buffer = nProfileBufferCreate();
+
+    /* The consumer copies the name while named is even and unchanged, so the
+     * name is only written while named is odd. */
+    size_t len = strlen(nameStr);
+    if (len >= NPROFILE_NAME_MAX) len = NPROFILE_NAME_MAX - 1;
+    __atomic_add_fetch(&buffer->named, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(buffer->nameStr, nameStr, len);
+    buffer->nameStr[len] = '\0';
+    __atomic_add_fetch(&buffer->named, 1, __ATOMIC_RELEASE);
+}
+
+/* Writes the buffered text of writer to its file. */
+static int nProfileWriterFlush(nProfileWriter_t *const writer)
+{
+    size_t offset = 0;
+    while (offset < writer->len)
+    {
+        const ssize_t wr = nFileWrite(writer->fd, writer->buf + offset,
+         writer->len - offset);
+        if (wr <= 0) return NERROR_INTERNAL_FAILURE;
+        offset += (size_t) wr;
+    }
+    writer->len = 0;
+    return NSUCCESS;
+}
+
+/* Appends formatted text to writer, flushing it when nearly full. Each
+ * event is far smaller than the reserved space. */
+static void nProfileWriterPrintf(nProfileWriter_t *const writer,
+ const char *const format, ...)
+{
+    if (writer->len > NPROFILE_WRITE_BUFFER - 1024) nProfileWriterFlush(writer);
+
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(writer->buf + writer->len,
+     NPROFILE_WRITE_BUFFER - writer->len, format, args);
+    va_end(args);
+    if (len > 0) writer->len += (size_t) len;
+    if (writer->len >= NPROFILE_WRITE_BUFFER)
+    {
+        writer->len = NPROFILE_WRITE_BUFFER - 1;
+    }
+}
+
+/* Appends str as a JSON string, without the quotes. */
+static void nProfileWriterString(nProfileWriter_t *const writer,
+ const char *str)
+{
+    for (size_t i = 0; str[i] && (i < 256); i++)
+    {
+        if (writer->len > NPROFILE_WRITE_BUFFER - 8) nProfileWriterFlush(writer);
+        const unsigned char c = (unsigned char) str[i];
+        if ((c == '"') || (c == '\\'))
+        {
+            writer->buf[writer->len++] = '\\';
+            writer->buf[writer->len++] = (char) c;
+        }
+        else if (c < 0x20)
+        {
+            writer->len += (size_t) snprintf(writer->buf + writer->len, 8,
+             "\\u%04x", c);
+        }
+        else
+        {
+            writer->buf[writer->len++] = (char) c;
+        }
+    }
+}
+
+/* Starts the next event of the trace, separating it from the last. */
+static void nProfileWriterNext(nProfileWriter_t *const writer)
+{
+    nProfileWriterPrintf(writer, writer->count ? ",\n" : "\n");
+    writer->count++;
+}
+
+/* Appends an event in the Chrome trace event format. */
+static void nProfileWriteEvent(nProfileWriter_t *const writer,
+ const nProfileBuffer_t *const buffer, const nProfileEvent_t *const event)
+{
+    const double ts = (double) nTicksToNanos(event->time) / NTIME_NS_IN_US;
+    const nProfileSite_t *const site = event->site;
+    nProfileWriterNext(writer);
+    nProfileWriterPrintf(writer, "{\"name\":\"");
+    nProfileWriterString(writer, site->name);
+    switch (site->type)
+    {
+        case NPROFILE_TYPE_ZONE:
+            nProfileWriterPrintf(writer, "\",\"cat\":\"zone\",\"ph\":\"X\","
+             "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%" PRIu32 ","
+             "\"args\":{\"file\":\"", ts,
+             (double) nTicksToNanos((uint64_t) event->value) / NTIME_NS_IN_US,
+             buffer->thread);
+            nProfileWriterString(writer, site->file);
+            nProfileWriterPrintf(writer, "\",\"line\":%d}}", site->line);
+            break;
+        case NPROFILE_TYPE_COUNTER:
+            nProfileWriterPrintf(writer, "\",\"ph\":\"C\",\"ts\":%.3f,"
+             "\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"value\":%" PRId64 "}}",
+             ts, buffer->thread, event->value);
+            break;
+        case NPROFILE_TYPE_FRAME:
+        default:
+            nProfileWriterPrintf(writer, "\",\"ph\":\"i\",\"s\":\"g\","
+             "\"ts\":%.3f,\"pid\":1,\"tid\":%" PRIu32 ","
+             "\"args\":{\"frame\":%" PRId64 "}}",
+             ts, buffer->thread, event->value);
+            break;
+    }
+}
+
+/* Frees the buffers of exited threads once they are empty. The first buffer
+ * is kept, as producers only ever change the list head. */
+static void nProfileRetireBuffers(void)
+{
+    nProfileBuffer_t *prev = __atomic_load_n(&profileBuffers,
+     __ATOMIC_ACQUIRE);
+    if (!prev) return;
+    nProfileBuffer_t *buffer = prev->next;
+    while (buffer)
+    {
+        nProfileBuffer_t *next = buffer->next;
+        if (__atomic_load_n(&buffer->closed, __ATOMIC_ACQUIRE) &&
+         (buffer->tail == __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE)))
+        {
+            prev->next = next;
+            nFree((void **) &buffer->events);
+            nFree((void **) &buffer);
+        }
+        else
+        {
+            prev = buffer;
+        }
+        buffer = next;
+    }
+}
+
+/* Writes the events of every buffer to writer and removes them from the
+ * buffers. Returns the number of events written. */
+static uint64_t nProfileDrain(nProfileWriter_t *const writer)
+{
+    uint64_t written = 0;
+    for (nProfileBuffer_t *buffer = __atomic_load_n(&profileBuffers,
+     __ATOMIC_ACQUIRE); buffer; buffer = buffer->next)
+    {
+        uint32_t named = __atomic_load_n(&buffer->named, __ATOMIC_ACQUIRE);
+        if (named != buffer->namedWritten)
+        {
+            /* Copy the name until it was not being written before or during
+             * the copy. */
+            char nameStr[NPROFILE_NAME_MAX];
+            for (;;)
+            {
+                if (!(named & 1))
+                {
+                    memcpy(nameStr, buffer->nameStr, NPROFILE_NAME_MAX);
+                    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                    const uint32_t after = __atomic_load_n(&buffer->named,
+                     __ATOMIC_RELAXED);
+                    if (after == named) break;
+                    named = after;
+                }
+                else named = __atomic_load_n(&buffer->named, __ATOMIC_ACQUIRE);
+            }
+            nameStr[NPROFILE_NAME_MAX - 1] = '\0';
+
+            nProfileWriterNext(writer);
+            nProfileWriterPrintf(writer, "{\"name\":\"thread_name\","
+             "\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"name\":\"",
+             buffer->thread);
+            nProfileWriterString(writer, nameStr);
+            nProfileWriterPrintf(writer, "\"}}");
+            buffer->namedWritten = named;
+        }
+
+        const uint64_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+        uint64_t tail = buffer->tail;
+        for (; tail != head; tail++)
+        {
+            nProfileWriteEvent(writer, buffer,
+             &buffer->events[tail & (NPROFILE_BUFFER_EVENTS - 1)]);
+            written++;
+        }
+        __atomic_store_n(&buffer->tail, tail, __ATOMIC_RELEASE);
+
+        const uint64_t dropped = __atomic_load_n(&buffer->dropped,
+         __ATOMIC_RELAXED);
+        if (dropped != buffer->droppedWritten)
+        {
+            nProfileWriterNext(writer);
+            nProfileWriterPrintf(writer, "{\"name\":\"Dropped events\","
+             "\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%" PRIu32 ","
+             "\"args\":{\"value\":%" PRIu64 "}}",
+             (double) nTicksToNanos(nTicks()) / NTIME_NS_IN_US,
+             buffer->thread, dropped);
+            buffer->droppedWritten = dropped;
+        }
+    }
+    nProfileRetireBuffers();
+    return written;
+}
+
+/* Waits to be the only thread writing a trace. */
+static void nProfileLock(void)
+{
+    while (__atomic_exchange_n(&profileWriting, 1, __ATOMIC_ACQUIRE))
+    {
+        nTimeNanoSleep(NTIME_NS_IN_MS);
+    }
+}
+
+static void nProfileUnlock(void)
+{
+    __atomic_store_n(&profileWriting, 0, __ATOMIC_RELEASE);
+}
+
+/* Creates a writer for a new trace file at pathStr. */
+static int nProfileWriterOpen(const char *const pathStr,
+ nProfileWriter_t **const writer)
+{
+    *writer = nAlloc(sizeof(nProfileWriter_t));
+    (*writer)->len = 0;
+    (*writer)->count = 0;
+    const int err = nFileOpen(pathStr,
+     NFILE_F_WRITE | NFILE_F_CREATE | NFILE_F_CLEAR, &(*writer)->fd);
+    if (err) nFree((void **) writer);
+    return err;
+}
+
+int nProfileDump(const char *const pathStr)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "pathStr argument was NULL in nProfileDump()."
+    if (nErrorAssert(
+     pathStr != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    nProfileWriter_t *writer;
+    int err = nProfileWriterOpen(pathStr, &writer);
+    if (err) return err;
+
+    nProfileLock();
+    nProfileWriterPrintf(writer, "{\"displayTimeUnit\":\"ms\","
+     "\"traceEvents\":[");
+    nProfileDrain(writer);
+    nProfileWriterPrintf(writer, "\n]}\n");
+    nProfileUnlock();
+
+    err = nProfileWriterFlush(writer);
+    nFileClose(&writer->fd);
+    nFree((void **) &writer);
+    return err;
+}
+
+static nThreadRoutine_t nProfileRollerRoutine(void *data)
+{
+    nProfileWriter_t *writer = data;
+    nThreadLowerPriority();
+    nProfileThreadName("Profiler");
+    while (__atomic_load_n(&profileRolling, __ATOMIC_ACQUIRE))
+    {
+        nProfileLock();
+        nProfileDrain(writer);
+        nProfileUnlock();
+        nProfileWriterFlush(writer);
+        nTimeNanoSleep(NPROFILE_ROLL_INTERVAL * NTIME_NS_IN_MS);
+    }
+
+    nProfileLock();
+    nProfileDrain(writer);
+    nProfileUnlock();
+    nProfileWriterPrintf(writer, "\n]\n");
+    nProfileWriterFlush(writer);
+    return (nThreadRoutine_t) 0;
+}
+
+int nProfileStartRolling(const char *const pathStr)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "pathStr argument was NULL in nProfileStartRolling()."
+    if (nErrorAssert(
+     pathStr != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&profileRolling, &expected, 1, 0,
+     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        return NSUCCESS;
+    }
+
+    int err = nProfileWriterOpen(pathStr, &profileRollWriter);
+    if (err)
+    {
+        __atomic_store_n(&profileRolling, 0, __ATOMIC_RELEASE);
+        return err;
+    }
+    nProfileWriterPrintf(profileRollWriter, "[");
+
+    err = nThreadCreate(&profileRoller, nProfileRollerRoutine,
+     profileRollWriter);
+    if (err)
+    {
+        nFileClose(&profileRollWriter->fd);
+        nFree((void **) &profileRollWriter);
+        __atomic_store_n(&profileRolling, 0, __ATOMIC_RELEASE);
+    }
+    return err;
+}
+
+void nProfileStopRolling(void)
+{
+    if (!__atomic_exchange_n(&profileRolling, 0, __ATOMIC_ACQ_REL)) return;
+    nThreadJoin(profileRoller, NULL);
+    profileRoller = NULL;
+    nFileClose(&profileRollWriter->fd);
+    nFree((void **) &profileRollWriter);
+}
+
+// Profiler.c
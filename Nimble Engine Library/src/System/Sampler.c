@@ -0,0 +1,609 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Sampler.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE /**< Needed for F_SETSIG and F_SETOWN_EX. */
+#endif
+#include "../../include/Nimble/System/Sampler.h"
+
+/**
+ * @file Sampler.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the sampling profiler.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+#if (NIMBLE_OS == NIMBLE_LINUX) || (NIMBLE_OS == NIMBLE_ANDROID)
+#  define NSAMPLER_PERF /**< Sample each thread with perf_event_open(). */
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/Errors/Symbols.h"
+#include "../../include/Nimble/Output/Files.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Threads.h"
+#include "../../include/Nimble/System/Time.h"
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+#define NSAMPLER_SLOT_FREE    0
+#define NSAMPLER_SLOT_WRITING 1
+#define NSAMPLER_SLOT_READY   2
+
+#define NSAMPLER_MODE_PERF   1
+#define NSAMPLER_MODE_ITIMER 2
+
+/**
+ * @brief A sample written by the signal handler.
+ */
+typedef struct nSamplerSlot {
+    volatile uint32_t state; /* The NSAMPLER_SLOT_* state of the slot. */
+    uint32_t depth; /* The number of addresses in stack. */
+    void *stack[NSAMPLER_STACK_MAX]; /* The program counter, then the return addresses. */
+} nSamplerSlot_t;
+
+/**
+ * @brief A unique stack and the number of times it was sampled.
+ */
+typedef struct nSamplerStack {
+    uint64_t hash; /* The hash of stack, or 0 if the entry is empty. */
+    uint64_t count; /* The number of samples of the stack. */
+    uint32_t depth; /* The number of addresses in stack. */
+    void **stack; /* The program counter, then the return addresses. */
+} nSamplerStack_t;
+
+#ifdef NSAMPLER_PERF
+/**
+ * @brief The performance event sampling a thread.
+ */
+typedef struct nSamplerEvent {
+    pid_t tid; /* The ID of the sampled thread. */
+    int fd; /* The file descriptor of the event. */
+    int seen; /* Set when the thread was found by the last scan. */
+} nSamplerEvent_t;
+
+static nSamplerEvent_t *samplerEvents = NULL;
+static size_t samplerEventCount = 0;
+static size_t samplerEventCap = 0;
+static pid_t samplerTid = 0; /* The sampler thread, which is not sampled. */
+#endif
+
+static nSamplerSlot_t *samplerSlots = NULL;
+static volatile uint64_t samplerHead = 0;
+static volatile uint64_t samplerDropped = 0;
+
+static nSamplerStack_t *samplerStacks = NULL;
+static size_t samplerStackCount = 0;
+static size_t samplerStackCap = 0;
+static nMutex_t samplerMutex = NULL; /* Held while samplerStacks is used. */
+
+static volatile int samplerRunning = 0;
+static int samplerMode = 0;
+static uint64_t samplerPeriod = 0; /* Nanoseconds of CPU time per sample. */
+static struct sigaction samplerOldAction;
+static nThread_t samplerThread = NULL;
+
+/* Records the stack of the interrupted thread. Everything here must be
+ * async-signal-safe. */
+static void nSamplerHandler(int sig, siginfo_t *info, void *context)
+{
+    (void) sig;
+    const int savedErrno = errno;
+
+    if (__atomic_load_n(&samplerRunning, __ATOMIC_ACQUIRE))
+    {
+        const uint64_t index = __atomic_fetch_add(&samplerHead, 1,
+         __ATOMIC_RELAXED);
+        nSamplerSlot_t *const slot = &samplerSlots[index & (NSAMPLER_RING - 1)];
+        uint32_t expected = NSAMPLER_SLOT_FREE;
+        if (__atomic_compare_exchange_n(&slot->state, &expected,
+         NSAMPLER_SLOT_WRITING, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            slot->depth = nErrorStackWalkContext(context, NULL, slot->stack,
+             NSAMPLER_STACK_MAX);
+            __atomic_store_n(&slot->state, NSAMPLER_SLOT_READY,
+             __ATOMIC_RELEASE);
+        }
+        else
+        {
+            __atomic_add_fetch(&samplerDropped, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+#ifdef NSAMPLER_PERF
+    /* Each overflow disables the event until it is refreshed. */
+    if ((samplerMode == NSAMPLER_MODE_PERF) &&
+     ((info->si_code == POLL_IN) || (info->si_code == POLL_HUP)))
+    {
+        ioctl(info->si_fd, PERF_EVENT_IOC_REFRESH, 1);
+    }
+#else
+    (void) info;
+#endif
+    errno = savedErrno;
+}
+
+/* Hashes the addresses of a stack. The result is never 0, which marks empty
+ * entries. */
+static uint64_t nSamplerHash(void *const *const stack, const uint32_t depth)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint32_t i = 0; i < depth; i++)
+    {
+        hash = (hash ^ (uint64_t) (uintptr_t) stack[i]) * 0x100000001b3ULL;
+    }
+    return hash ? hash : 1;
+}
+
+/* Counts a sample in samplerStacks, growing it when 3/4 full. */
+static void nSamplerCount(void *const *const stack, const uint32_t depth)
+{
+    if ((samplerStackCount + 1) * 4 > samplerStackCap * 3)
+    {
+        const size_t oldCap = samplerStackCap;
+        nSamplerStack_t *oldStacks = samplerStacks;
+        samplerStackCap = oldCap ? oldCap * 2 : 1024;
+        samplerStacks = nAlloc(samplerStackCap * sizeof(nSamplerStack_t));
+        memset(samplerStacks, 0, samplerStackCap * sizeof(nSamplerStack_t));
+        for (size_t i = 0; i < oldCap; i++)
+        {
+            if (!oldStacks[i].hash) continue;
+            size_t j = oldStacks[i].hash & (samplerStackCap - 1);
+            while (samplerStacks[j].hash) j = (j + 1) & (samplerStackCap - 1);
+            samplerStacks[j] = oldStacks[i];
+        }
+        if (oldStacks) nFree((void **) &oldStacks);
+    }
+
+    const uint64_t hash = nSamplerHash(stack, depth);
+    size_t i = hash & (samplerStackCap - 1);
+    for (; samplerStacks[i].hash; i = (i + 1) & (samplerStackCap - 1))
+    {
+        nSamplerStack_t *const entry = &samplerStacks[i];
+        if ((entry->hash == hash) && (entry->depth == depth) &&
+         !memcmp(entry->stack, stack, depth * sizeof(void *)))
+        {
+            entry->count++;
+            return;
+        }
+    }
+
+    samplerStacks[i].hash = hash;
+    samplerStacks[i].count = 1;
+    samplerStacks[i].depth = depth;
+    samplerStacks[i].stack = nAlloc((depth ? depth : 1) * sizeof(void *));
+    memcpy(samplerStacks[i].stack, stack, depth * sizeof(void *));
+    samplerStackCount++;
+}
+
+/* Moves the samples written by the signal handler into samplerStacks. The
+ * slots are scanned in full, as a slot skipped by a full ring may otherwise
+ * stall an ordered scan. */
+static void nSamplerCollect(void)
+{
+    nThreadMutexLock(&samplerMutex);
+    for (size_t i = 0; i < NSAMPLER_RING; i++)
+    {
+        nSamplerSlot_t *const slot = &samplerSlots[i];
+        if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) !=
+         NSAMPLER_SLOT_READY) continue;
+        nSamplerCount(slot->stack, slot->depth);
+        __atomic_store_n(&slot->state, NSAMPLER_SLOT_FREE, __ATOMIC_RELEASE);
+    }
+    nThreadMutexUnlock(&samplerMutex);
+}
+
+#ifdef NSAMPLER_PERF
+/* Opens a task clock for thread tid that signals it after each period.
+ * Returns the file descriptor, or -1 if it could not be opened. */
+static int nSamplerPerfOpen(const pid_t tid)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_SOFTWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_SW_TASK_CLOCK;
+    attr.sample_period = samplerPeriod;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    const int fd = (int) syscall(SYS_perf_event_open, &attr, tid, -1, -1,
+     PERF_FLAG_FD_CLOEXEC);
+    if (fd < 0) return -1;
+
+    struct f_owner_ex owner = {F_OWNER_TID, tid};
+    if ((fcntl(fd, F_SETFL, O_ASYNC) < 0) ||
+     (fcntl(fd, F_SETSIG, SIGPROF) < 0) ||
+     (fcntl(fd, F_SETOWN_EX, &owner) < 0) ||
+     (ioctl(fd, PERF_EVENT_IOC_RESET, 0) < 0) ||
+     (ioctl(fd, PERF_EVENT_IOC_REFRESH, 1) < 0))
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Opens an event for thread tid, if it has none. */
+static void nSamplerScanTask(const pid_t tid)
+{
+    if (tid == samplerTid) return;
+
+    for (size_t i = 0; i < samplerEventCount; i++)
+    {
+        if (samplerEvents[i].tid == tid)
+        {
+            samplerEvents[i].seen = 1;
+            return;
+        }
+    }
+
+    const int fd = nSamplerPerfOpen(tid);
+    if (fd < 0) return;
+    if (samplerEventCount == samplerEventCap)
+    {
+        samplerEventCap = samplerEventCap ? samplerEventCap * 2 : 64;
+        samplerEvents = samplerEvents ?
+         nRealloc(samplerEvents, samplerEventCap * sizeof(nSamplerEvent_t)) :
+         nAlloc(samplerEventCap * sizeof(nSamplerEvent_t));
+    }
+    samplerEvents[samplerEventCount].tid = tid;
+    samplerEvents[samplerEventCount].fd = fd;
+    samplerEvents[samplerEventCount].seen = 1;
+    samplerEventCount++;
+}
+
+/* Samples new threads and closes the events of exited threads. */
+static void nSamplerScanThreads(void)
+{
+    for (size_t i = 0; i < samplerEventCount; i++) samplerEvents[i].seen = 0;
+    /* Each thread is a directory, which nFileListDir() does not list. */
+    DIR *dir = opendir("/proc/self/task");
+    if (dir)
+    {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL)
+        {
+            if ((entry->d_name[0] < '0') || (entry->d_name[0] > '9')) continue;
+            nSamplerScanTask((pid_t) strtol(entry->d_name, NULL, 10));
+        }
+        closedir(dir);
+    }
+    for (size_t i = 0; i < samplerEventCount;)
+    {
+        if (samplerEvents[i].seen)
+        {
+            i++;
+            continue;
+        }
+        close(samplerEvents[i].fd);
+        samplerEvents[i] = samplerEvents[--samplerEventCount];
+    }
+}
+
+/* Closes the events of all threads. */
+static void nSamplerCloseEvents(void)
+{
+    for (size_t i = 0; i < samplerEventCount; i++)
+    {
+        ioctl(samplerEvents[i].fd, PERF_EVENT_IOC_DISABLE, 0);
+        close(samplerEvents[i].fd);
+    }
+    samplerEventCount = 0;
+    samplerEventCap = 0;
+    if (samplerEvents) nFree((void **) &samplerEvents);
+}
+#endif
+
+static nThreadRoutine_t nSamplerRoutine(void *data)
+{
+    (void) data;
+    nThreadLowerPriority();
+#ifdef NSAMPLER_PERF
+    samplerTid = (pid_t) syscall(SYS_gettid);
+    uint64_t nextScan = 0;
+#endif
+    while (__atomic_load_n(&samplerRunning, __ATOMIC_ACQUIRE))
+    {
+#ifdef NSAMPLER_PERF
+        if (samplerMode == NSAMPLER_MODE_PERF)
+        {
+            const uint64_t now = nTimeMonotonic();
+            if (now >= nextScan)
+            {
+                nSamplerScanThreads();
+                nextScan = now + (NSAMPLER_SCAN_INTERVAL * NTIME_NS_IN_MS);
+            }
+        }
+#endif
+        nSamplerCollect();
+        nTimeNanoSleep(10 * NTIME_NS_IN_MS);
+    }
+
+#ifdef NSAMPLER_PERF
+    nSamplerCloseEvents();
+#endif
+    return (nThreadRoutine_t) 0;
+}
+
+int nSamplerStart(const uint32_t frequency)
+{
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&samplerRunning, &expected, 1, 0,
+     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        return NSUCCESS;
+    }
+
+    if (!samplerSlots)
+    {
+        samplerSlots = nAlloc(NSAMPLER_RING * sizeof(nSamplerSlot_t));
+        memset(samplerSlots, 0, NSAMPLER_RING * sizeof(nSamplerSlot_t));
+    }
+    if (!samplerMutex) nThreadMutexCreate(&samplerMutex);
+    samplerPeriod = NTIME_NS_IN_SEC / (frequency ? frequency :
+     NSAMPLER_FREQUENCY);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = nSamplerHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+#define einfoStr "sigaction() failed in nSamplerStart()."
+    if (nErrorAssert(
+     !sigaction(SIGPROF, &sa, &samplerOldAction),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    ))
+    {
+        __atomic_store_n(&samplerRunning, 0, __ATOMIC_RELEASE);
+        return NERROR_INTERNAL_FAILURE;
+    }
+#undef einfoStr
+
+    samplerMode = NSAMPLER_MODE_ITIMER;
+#ifdef NSAMPLER_PERF
+    /* Performance events are often not permitted in containers, so check if
+     * one can be opened before relying on them. */
+    const int fd = nSamplerPerfOpen((pid_t) syscall(SYS_gettid));
+    if (fd >= 0)
+    {
+        close(fd);
+        samplerMode = NSAMPLER_MODE_PERF;
+    }
+#endif
+
+    if (samplerMode == NSAMPLER_MODE_ITIMER)
+    {
+        struct itimerval timer;
+        timer.it_interval.tv_sec = samplerPeriod / NTIME_NS_IN_SEC;
+        timer.it_interval.tv_usec = (samplerPeriod % NTIME_NS_IN_SEC) /
+         NTIME_NS_IN_US;
+        timer.it_value = timer.it_interval;
+#define einfoStr "setitimer() failed in nSamplerStart()."
+        if (nErrorAssert(
+         !setitimer(ITIMER_PROF, &timer, NULL),
+         NERROR_INTERNAL_FAILURE,
+         einfoStr,
+         NCONST_STR_LEN(einfoStr)
+        ))
+        {
+            sigaction(SIGPROF, &samplerOldAction, NULL);
+            __atomic_store_n(&samplerRunning, 0, __ATOMIC_RELEASE);
+            return NERROR_INTERNAL_FAILURE;
+        }
+#undef einfoStr
+    }
+
+    const int err = nThreadCreate(&samplerThread, nSamplerRoutine, NULL);
+    if (err)
+    {
+        nSamplerStop();
+        return err;
+    }
+    return NSUCCESS;
+}
+
+void nSamplerStop(void)
+{
+    if (!__atomic_exchange_n(&samplerRunning, 0, __ATOMIC_ACQ_REL)) return;
+    if (samplerMode == NSAMPLER_MODE_ITIMER)
+    {
+        const struct itimerval timer = {{0, 0}, {0, 0}};
+        setitimer(ITIMER_PROF, &timer, NULL);
+    }
+    if (samplerThread)
+    {
+        nThreadJoin(samplerThread, NULL);
+        samplerThread = NULL;
+    }
+
+    /* Signals already raised by the events or timer are ignored rather than
+     * killing the process. */
+    struct sigaction ignore;
+    memset(&ignore, 0, sizeof(ignore));
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPROF, &ignore, NULL);
+    nTimeNanoSleep(NTIME_NS_IN_MS);
+    sigaction(SIGPROF, &samplerOldAction, NULL);
+    samplerMode = 0;
+    nSamplerCollect();
+}
+
+/**
+ * @brief A line of folded output.
+ */
+typedef struct nSamplerLine {
+    char *str; /* The symbolized stack. */
+    uint64_t count; /* The number of samples of the stack. */
+} nSamplerLine_t;
+
+static int nSamplerLineCompare(const void *a, const void *b)
+{
+    return strcmp(((const nSamplerLine_t *) a)->str,
+     ((const nSamplerLine_t *) b)->str);
+}
+
+/* Writes the function of addr, or its module if unknown. */
+static void nSamplerWriteFrame(FILE *const file, const void *const addr)
+{
+    nErrorSymbol_t symbol;
+    if (nErrorSymbolize(addr, &symbol)) fprintf(file, "%p", addr);
+    else if (symbol.funcStr) fputs(symbol.funcStr, file);
+    else if (symbol.moduleStr)
+    {
+        const char *nameStr = strrchr(symbol.moduleStr, '/');
+        fputs(nameStr ? nameStr + 1 : symbol.moduleStr, file);
+    }
+    else fprintf(file, "%p", addr);
+}
+
+int nSamplerWrite(const char *const pathStr, const int reset)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "pathStr argument was NULL in nSamplerWrite()."
+    if (nErrorAssert(
+     pathStr != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+
+    FILE *file = fopen(pathStr, "w");
+#define einfoStr "fopen() failed in nSamplerWrite()."
+    if (nErrorAssert(
+     file != NULL,
+     NERROR_NO_FILE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NO_FILE;
+#undef einfoStr
+
+    if (samplerSlots) nSamplerCollect();
+    if (!samplerMutex) nThreadMutexCreate(&samplerMutex);
+    nThreadMutexLock(&samplerMutex);
+    nSamplerLine_t *lines = nAlloc((samplerStackCount ? samplerStackCount : 1) *
+     sizeof(nSamplerLine_t));
+    size_t lineCount = 0;
+    for (size_t i = 0; i < samplerStackCap; i++)
+    {
+        nSamplerStack_t *const entry = &samplerStacks[i];
+        if (!entry->hash) continue;
+
+        /* The first address is where the thread was interrupted, and the rest
+         * are return addresses, which are symbolized as the call before them. */
+        size_t size;
+        FILE *line = open_memstream(&lines[lineCount].str, &size);
+        if (!line) continue;
+        for (uint32_t level = entry->depth; level-- > 0;)
+        {
+            nSamplerWriteFrame(line, level ? (const char *) entry->stack[level]
+             - 1 : entry->stack[level]);
+            if (level) fputc(';', line);
+        }
+        fclose(line);
+        lines[lineCount++].count = entry->count;
+
+        if (reset)
+        {
+            nFree((void **) &entry->stack);
+            entry->hash = 0;
+        }
+    }
+    if (reset) samplerStackCount = 0;
+    nThreadMutexUnlock(&samplerMutex);
+
+    /* Stacks that differ only in addresses within the same functions are
+     * merged, as flame graphs expect each stack once. */
+    qsort(lines, lineCount, sizeof(nSamplerLine_t), nSamplerLineCompare);
+    for (size_t i = 0; i < lineCount;)
+    {
+        uint64_t count = 0;
+        size_t j = i;
+        for (; (j < lineCount) && !strcmp(lines[i].str, lines[j].str); j++)
+        {
+            count += lines[j].count;
+        }
+        fprintf(file, "%s %" PRIu64 "\n", lines[i].str, count);
+        for (; i < j; i++) free(lines[i].str);
+    }
+    nFree((void **) &lines);
+
+    const int err = ferror(file) ? NERROR_IO : NSUCCESS;
+    fclose(file);
+    return err;
+}
+#else
+int nSamplerStart(const uint32_t frequency)
+{
+    (void) frequency;
+#  define einfoStr "nSamplerStart() is not supported on Windows."
+    nErrorThrow(NERROR_NOT_SUPPORTED, einfoStr, NCONST_STR_LEN(einfoStr), 0);
+#  undef einfoStr
+    return NERROR_NOT_SUPPORTED;
+}
+
+void nSamplerStop(void)
+{
+}
+
+int nSamplerWrite(const char *const pathStr, const int reset)
+{
+    (void) pathStr;
+    (void) reset;
+    return NERROR_NOT_SUPPORTED;
+}
+#endif
+
+// Sampler.c
@@ -0,0 +1,471 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Simd.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/System/Simd.h"
+
+/**
+ * @file Simd.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines SIMD kernels dispatched at runtime.
+ */
+
+#include <string.h>
+
+#include "../../include/Nimble/System/CPUInfo.h"
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+#  include <immintrin.h>
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+#  include <arm_acle.h>
+#  include <arm_neon.h>
+#endif
+
+/* The CRC-32C of each byte, with the reflected polynomial 0x82f63b78. It is
+ * a constant so the scalar kernel can be used from any thread before
+ * nSimdBind(). */
+static const uint32_t NSIMD_CRC32C_TABLE[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c,
+    0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b,
+    0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c,
+    0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc,
+    0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a,
+    0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512,
+    0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad,
+    0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a,
+    0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf,
+    0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f,
+    0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927,
+    0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f,
+    0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e,
+    0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859,
+    0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e,
+    0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de,
+    0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c,
+    0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4,
+    0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b,
+    0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c,
+    0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5,
+    0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975,
+    0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d,
+    0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905,
+    0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8,
+    0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff,
+    0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8,
+    0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78,
+    0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee,
+    0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6,
+    0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69,
+    0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e,
+    0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+static uint32_t nSimdCRC32CScalar(uint32_t crc, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    crc = ~crc;
+    for (; size; size--, p++)
+    {
+        crc = (crc >> 8) ^ NSIMD_CRC32C_TABLE[(crc ^ *p) & 0xff];
+    }
+    return ~crc;
+}
+
+static float nSimdDotScalar(const float *a, const float *b, size_t count)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+static void nSimdMulAddScalar(float *dst, const float *a, const float *b,
+ const float *c, size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = (a[i] * b[i]) + c[i];
+}
+
+static void nSimdMat4MulScalar(float *dst, const float *a, const float *b,
+ size_t count)
+{
+    for (size_t i = 0; i < count; i++, dst += 16, a += 16, b += 16)
+    {
+        float r[16];
+        for (int col = 0; col < 4; col++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                r[(col * 4) + row] = (a[row] * b[col * 4]) +
+                 (a[4 + row] * b[(col * 4) + 1]) +
+                 (a[8 + row] * b[(col * 4) + 2]) +
+                 (a[12 + row] * b[(col * 4) + 3]);
+            }
+        }
+        memcpy(dst, r, sizeof(r));
+    }
+}
+
+static const nSimdKernels_t NSIMD_SCALAR = {
+    .level = NSIMD_LEVEL_SCALAR,
+    .crc32c = nSimdCRC32CScalar,
+    .dot = nSimdDotScalar,
+    .mulAdd = nSimdMulAddScalar,
+    .mat4Mul = nSimdMat4MulScalar,
+};
+
+nSimdKernels_t NSIMD = {
+    .level = NSIMD_LEVEL_SCALAR,
+    .crc32c = nSimdCRC32CScalar,
+    .dot = nSimdDotScalar,
+    .mulAdd = nSimdMulAddScalar,
+    .mat4Mul = nSimdMat4MulScalar,
+};
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+NSIMD_TARGET("sse4.2")
+static uint32_t nSimdCRC32CSSE42(uint32_t crc, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    uint64_t c = ~crc;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t),
+     p += sizeof(uint64_t))
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        c = _mm_crc32_u64(c, v);
+    }
+    for (; size; size--, p++) c = _mm_crc32_u8((uint32_t) c, *p);
+    return ~(uint32_t) c;
+}
+
+NSIMD_TARGET("sse4.2")
+static float nSimdDotSSE42(const float *a, const float *b, size_t count)
+{
+    __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i),
+         _mm_loadu_ps(b + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4),
+         _mm_loadu_ps(b + i + 4)));
+    }
+    sum0 = _mm_add_ps(sum0, sum1);
+    sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+    sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+    float sum = _mm_cvtss_f32(sum0);
+    for (; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+NSIMD_TARGET("sse4.2")
+static void nSimdMulAddSSE42(float *dst, const float *a, const float *b,
+ const float *c, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i),
+         _mm_loadu_ps(b + i)), _mm_loadu_ps(c + i)));
+    }
+    for (; i < count; i++) dst[i] = (a[i] * b[i]) + c[i];
+}
+
+NSIMD_TARGET("sse4.2")
+static void nSimdMat4MulSSE42(float *dst, const float *a, const float *b,
+ size_t count)
+{
+    for (size_t i = 0; i < count; i++, dst += 16, a += 16, b += 16)
+    {
+        const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+        __m128 r[4];
+        for (int col = 0; col < 4; col++)
+        {
+            const float *const bc = b + (col * 4);
+            r[col] = _mm_add_ps(
+             _mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(bc[0])),
+              _mm_mul_ps(a1, _mm_set1_ps(bc[1]))),
+             _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(bc[2])),
+              _mm_mul_ps(a3, _mm_set1_ps(bc[3]))));
+        }
+        for (int col = 0; col < 4; col++) _mm_storeu_ps(dst + (col * 4), r[col]);
+    }
+}
+
+NSIMD_TARGET("avx2,fma")
+static float nSimdDotAVX2(const float *a, const float *b, size_t count)
+{
+    __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+         sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8),
+         _mm256_loadu_ps(b + i + 8), sum1);
+    }
+    sum0 = _mm256_add_ps(sum0, sum1);
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum0),
+     _mm256_extractf128_ps(sum0, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+    float sum = _mm_cvtss_f32(sum4);
+    for (; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+NSIMD_TARGET("avx2,fma")
+static void nSimdMulAddAVX2(float *dst, const float *a, const float *b,
+ const float *c, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i),
+         _mm256_loadu_ps(b + i), _mm256_loadu_ps(c + i)));
+    }
+    for (; i < count; i++) dst[i] = (a[i] * b[i]) + c[i];
+}
+
+/* Computes two columns at once, with a column of a in each half of the
+ * registers, and the matching element of each column of b spread over its
+ * half by an in-lane permute. */
+NSIMD_TARGET("avx2,fma")
+static void nSimdMat4MulAVX2(float *dst, const float *a, const float *b,
+ size_t count)
+{
+    for (size_t i = 0; i < count; i++, dst += 16, a += 16, b += 16)
+    {
+        const __m256 a0 = _mm256_broadcast_ps((const __m128 *) a);
+        const __m256 a1 = _mm256_broadcast_ps((const __m128 *) (a + 4));
+        const __m256 a2 = _mm256_broadcast_ps((const __m128 *) (a + 8));
+        const __m256 a3 = _mm256_broadcast_ps((const __m128 *) (a + 12));
+        const __m256 b01 = _mm256_loadu_ps(b), b23 = _mm256_loadu_ps(b + 8);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xaa), r01);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xff), r01);
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xaa), r23);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xff), r23);
+
+        _mm256_storeu_ps(dst, r01);
+        _mm256_storeu_ps(dst + 8, r23);
+    }
+}
+
+NSIMD_TARGET("avx512f")
+static float nSimdDotAVX512(const float *a, const float *b, size_t count)
+{
+    __m512 sum = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        sum = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+         sum);
+    }
+    if (i < count)
+    {
+        const __mmask16 mask = (__mmask16) ((1U << (count - i)) - 1);
+        sum = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i),
+         _mm512_maskz_loadu_ps(mask, b + i), sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+NSIMD_TARGET("avx512f")
+static void nSimdMulAddAVX512(float *dst, const float *a, const float *b,
+ const float *c, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(_mm512_loadu_ps(a + i),
+         _mm512_loadu_ps(b + i), _mm512_loadu_ps(c + i)));
+    }
+    if (i < count)
+    {
+        const __mmask16 mask = (__mmask16) ((1U << (count - i)) - 1);
+        _mm512_mask_storeu_ps(dst + i, mask, _mm512_fmadd_ps(
+         _mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i),
+         _mm512_maskz_loadu_ps(mask, c + i)));
+    }
+}
+
+/* Computes a whole matrix in one register, the same way as
+ * nSimdMat4MulAVX2(). */
+NSIMD_TARGET("avx512f")
+static void nSimdMat4MulAVX512(float *dst, const float *a, const float *b,
+ size_t count)
+{
+    for (size_t i = 0; i < count; i++, dst += 16, a += 16, b += 16)
+    {
+        const __m512 bm = _mm512_loadu_ps(b);
+        __m512 r = _mm512_mul_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a)),
+         _mm512_permute_ps(bm, 0x00));
+        r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 4)),
+         _mm512_permute_ps(bm, 0x55), r);
+        r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 8)),
+         _mm512_permute_ps(bm, 0xaa), r);
+        r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 12)),
+         _mm512_permute_ps(bm, 0xff), r);
+        _mm512_storeu_ps(dst, r);
+    }
+}
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+NSIMD_TARGET("+crc")
+static uint32_t nSimdCRC32CNEON(uint32_t crc, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    crc = ~crc;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t),
+     p += sizeof(uint64_t))
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        crc = __crc32cd(crc, v);
+    }
+    for (; size; size--, p++) crc = __crc32cb(crc, *p);
+    return ~crc;
+}
+
+static float nSimdDotNEON(const float *a, const float *b, size_t count)
+{
+    float32x4_t sum0 = vdupq_n_f32(0.0f), sum1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        sum0 = vfmaq_f32(sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+        sum1 = vfmaq_f32(sum1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float sum = vaddvq_f32(vaddq_f32(sum0, sum1));
+    for (; i < count; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+static void nSimdMulAddNEON(float *dst, const float *a, const float *b,
+ const float *c, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(dst + i, vfmaq_f32(vld1q_f32(c + i), vld1q_f32(a + i),
+         vld1q_f32(b + i)));
+    }
+    for (; i < count; i++) dst[i] = (a[i] * b[i]) + c[i];
+}
+
+static void nSimdMat4MulNEON(float *dst, const float *a, const float *b,
+ size_t count)
+{
+    for (size_t i = 0; i < count; i++, dst += 16, a += 16, b += 16)
+    {
+        const float32x4_t a0 = vld1q_f32(a), a1 = vld1q_f32(a + 4);
+        const float32x4_t a2 = vld1q_f32(a + 8), a3 = vld1q_f32(a + 12);
+        float32x4_t r[4];
+        for (int col = 0; col < 4; col++)
+        {
+            const float32x4_t bc = vld1q_f32(b + (col * 4));
+            r[col] = vmulq_laneq_f32(a0, bc, 0);
+            r[col] = vfmaq_laneq_f32(r[col], a1, bc, 1);
+            r[col] = vfmaq_laneq_f32(r[col], a2, bc, 2);
+            r[col] = vfmaq_laneq_f32(r[col], a3, bc, 3);
+        }
+        for (int col = 0; col < 4; col++) vst1q_f32(dst + (col * 4), r[col]);
+    }
+}
+#endif
+
+int nSimdBind(const int maxLevel)
+{
+    nSysGetCPUInfo(NULL);
+    nSimdKernels_t kernels = NSIMD_SCALAR;
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+    if ((maxLevel >= NSIMD_LEVEL_SSE42) &&
+     nCPUHasFeatures(NCPU_FEATURE_SSE42))
+    {
+        kernels.level = NSIMD_LEVEL_SSE42;
+        kernels.crc32c = nSimdCRC32CSSE42;
+        kernels.dot = nSimdDotSSE42;
+        kernels.mulAdd = nSimdMulAddSSE42;
+        kernels.mat4Mul = nSimdMat4MulSSE42;
+    }
+    if ((maxLevel >= NSIMD_LEVEL_AVX2) &&
+     nCPUHasFeatures(NCPU_FEATURE_AVX2 | NCPU_FEATURE_FMA))
+    {
+        kernels.level = NSIMD_LEVEL_AVX2;
+        kernels.dot = nSimdDotAVX2;
+        kernels.mulAdd = nSimdMulAddAVX2;
+        kernels.mat4Mul = nSimdMat4MulAVX2;
+    }
+    if ((maxLevel >= NSIMD_LEVEL_AVX512) &&
+     nCPUHasFeatures(NCPU_FEATURE_AVX512F))
+    {
+        kernels.level = NSIMD_LEVEL_AVX512;
+        kernels.dot = nSimdDotAVX512;
+        kernels.mulAdd = nSimdMulAddAVX512;
+        kernels.mat4Mul = nSimdMat4MulAVX512;
+    }
+#elif NIMBLE_INST == NIMBLE_INST_ARM
+    if ((maxLevel >= NSIMD_LEVEL_NEON) && nCPUHasFeatures(NCPU_FEATURE_NEON))
+    {
+        kernels.level = NSIMD_LEVEL_NEON;
+        kernels.dot = nSimdDotNEON;
+        kernels.mulAdd = nSimdMulAddNEON;
+        kernels.mat4Mul = nSimdMat4MulNEON;
+        if (nCPUHasFeatures(NCPU_FEATURE_CRC32))
+        {
+            kernels.crc32c = nSimdCRC32CNEON;
+        }
+    }
+#endif
+
+    NSIMD = kernels;
+    return kernels.level;
+}
+
+// Simd.c
@@ -51,49 +51,97 @@
 #include <threads.h>
 #endif
 
+#if NIMBLE_OS == NIMBLE_LINUX
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/System/Memory.h"
+
+/**
+ * @brief The start of a thread created by nThreadCreate().
+ */
+typedef struct nThreadStart {
+    nThreadRoutine_t (*start)(void *); /* The routine the thread runs. */
+    void *data; /* The argument passed to start. */
+} nThreadStart_t;
+
+/* Records the new thread's stack for nErrorStackWalk() before running it. */
+static nThreadRoutine_t nThreadEntry(void *data)
+{
+    nThreadStart_t *entry = data;
+    nThreadRoutine_t (*const start)(void *) = entry->start;
+    void *const startData = entry->data;
+    nFree((void **) &entry);
+
+    nErrorStackRegister();
+    return start(startData);
+}
 
 int nThreadCreate(nThread_t *thread, nThreadRoutine_t (*start)(void *),
  void *data)
 {
     nThread_t thrd;
     int err;
+    nThreadStart_t *entry = nAlloc(sizeof(nThreadStart_t));
+    entry->start = start;
+    entry->data = data;
 #if NIMBLE_THREADS == NIMBLE_THREADS_WINAPI
 #  define einfoStr "CreateThread() failed in nThreadCreate()."
-    thrd = CreateThread(NULL, 0, start, data, 0, NULL);
+    thrd = CreateThread(NULL, 0, nThreadEntry, entry, 0, NULL);
     err = nErrorAssert(
      thrd != NULL,
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
-    if (err) return err;
+    if (err)
+    {
+        nFree((void **) &entry);
+        return err;
+    }
 #  undef einfoStr
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+    thrd = nAlloc(sizeof(pthread_t));
 #  define einfoStr "pthread_create() failed in nThreadCreate()."
     err = nErrorAssert(
-     !pthread_create(thrd, NULL, start, data),
+     !pthread_create(thrd, NULL, nThreadEntry, entry),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
-    if (err) return err;
+    if (err)
+    {
+        nFree((void **) &entry);
+        nFree((void **) &thrd);
+        return err;
+    }
 #  undef einfoStr
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+    thrd = nAlloc(sizeof(thrd_t));
 #  define einfoStr "thrd_create() failed in nThreadCreate()."
     err = nErrorAssert(
-     thrd_create(thrd, start, data) == thrd_success,
+     thrd_create(thrd, nThreadEntry, entry) == thrd_success,
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
-    if (err) return err;
+    if (err)
+    {
+        nFree((void **) &entry);
+        nFree((void **) &thrd);
+        return err;
+    }
 #undef einfoStr
 
 #endif
-    if (thread) *thread = thrd;
+    /* Nothing can join a thread whose identity is not kept. */
+    if (!thread) return nThreadDetach(thrd);
+    *thread = thrd;
     return NSUCCESS;
 }
 
@@ -141,29 +189,31 @@ int nThreadJoin(nThread_t thread, int *ret)
 #  undef einfoStr
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
-    int r;
-    int *pr = &r;
+    void *pr = NULL;
 #  define einfoStr "pthread_join() failed in nThreadJoin()."
     err = nErrorAssert(
-     !pthread_join(thread, (void **) &pr),
+     !pthread_join(*thread, &pr),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
     if (err) return err;
 #  undef einfoStr
+    nFree((void **) &thread);
+    int r = (int) (intptr_t) pr;
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
-int r;
+    int r;
 #  define einfoStr "thrd_join() failed in nThreadJoin()."
     err = nErrorAssert(
-     thrd_join(thread, &r) == thrd_success,
+     thrd_join(*thread, &r) == thrd_success,
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
     if (err) return err;
 #  undef einfoStr
+    nFree((void **) &thread);
 
 #endif
     if (ret) *ret = (int) r;
@@ -194,24 +244,76 @@ int nThreadDetach(nThread_t thread)
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
 #  define einfoStr "pthread_detach() failed in nThreadDetach()."
-    return nErrorAssert(
-     !pthread_detach(thread),
+    const int err = nErrorAssert(
+     !pthread_detach(*thread),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
 #  undef einfoStr
+    if (!err) nFree((void **) &thread);
+    return err;
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
 #  define einfoStr "thrd_detach() failed in nThreadDetach()."
+    const int err = nErrorAssert(
+     thrd_detach(*thread) == thrd_success,
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    );
+#  undef einfoStr
+    if (!err) nFree((void **) &thread);
+    return err;
+
+#endif
+}
+
+int nThreadLowerPriority(void)
+{
+#if NIMBLE_OS == NIMBLE_WINDOWS
+#  define einfoStr "SetThreadPriority() failed in nThreadLowerPriority()."
     return nErrorAssert(
-     thrd_detach(thread) == thrd_success,
+     SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
 #  undef einfoStr
 
+#elif NIMBLE_OS == NIMBLE_LINUX
+    /* Linux applies nice values to each thread rather than the process. */
+#  define einfoStr "setpriority() failed in nThreadLowerPriority()."
+    return nErrorAssert(
+     !setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), 19),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    );
+#  undef einfoStr
+
+#elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+    int policy;
+    struct sched_param param;
+#  define einfoStr "pthread_setschedparam() failed in nThreadLowerPriority()."
+    if (nErrorAssert(
+     !pthread_getschedparam(pthread_self(), &policy, &param),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_INTERNAL_FAILURE;
+    param.sched_priority = sched_get_priority_min(policy);
+    return nErrorAssert(
+     !pthread_setschedparam(pthread_self(), policy, &param),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    );
+#  undef einfoStr
+
+#else
+    /* C11 threads have no priorities. */
+    return NSUCCESS;
 #endif
 }
 
@@ -239,24 +341,30 @@ int nThreadMutexCreate(nMutex_t *mutex)
 #  undef einfoStr
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+    *mutex = nAlloc(sizeof(pthread_mutex_t));
 #  define einfoStr "pthread_mutex_init() failed in nThreadMutexCreate()."
-    return nErrorAssert(
-     !pthread_mutex_init(mutex, NULL),
+    const int err = nErrorAssert(
+     !pthread_mutex_init(*mutex, NULL),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
 #  undef einfoStr
+    if (err) nFree((void **) mutex);
+    return err;
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
+    *mutex = nAlloc(sizeof(mtx_t));
 #  define einfoStr "mtx_init() failed in nThreadMutexCreate()."
-    return nErrorAssert(
-     mtx_init(mutex, mtx_plain) == thrd_success,
+    const int err = nErrorAssert(
+     mtx_init(*mutex, mtx_plain) == thrd_success,
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
 #  undef einfoStr
+    if (err) nFree((void **) mutex);
+    return err;
 
 #endif
 }
@@ -286,7 +394,7 @@ int nThreadMutexLock(nMutex_t *mutex)
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
 #  define einfoStr "pthread_mutex_lock() failed in nThreadMutexLock()."
     return nErrorAssert(
-     !pthread_mutex_lock(mutex),
+     !pthread_mutex_lock(*mutex),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
@@ -296,7 +404,7 @@ int nThreadMutexLock(nMutex_t *mutex)
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
 #  define einfoStr "mtx_lock() failed in nThreadMutexLock()."
     return nErrorAssert(
-     mtx_lock(mutex) == thrd_success,
+     mtx_lock(*mutex) == thrd_success,
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
@@ -331,7 +439,7 @@ int nThreadMutexUnlock(nMutex_t *mutex)
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
 #  define einfoStr "pthread_mutex_unlock() failed in nThreadMutexUnlock()."
     return nErrorAssert(
-     !pthread_mutex_unlock(mutex),
+     !pthread_mutex_unlock(*mutex),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
@@ -341,7 +449,7 @@ int nThreadMutexUnlock(nMutex_t *mutex)
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
 #  define einfoStr "mtx_unlock() failed in nThreadMutexUnlock()."
     return nErrorAssert(
-     mtx_unlock(mutex) == thrd_success,
+     mtx_unlock(*mutex) == thrd_success,
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
@@ -375,24 +483,23 @@ int nThreadMutexDestroy(nMutex_t *mutex)
 #  undef einfoStr
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_PTHREAD
+    if (!*mutex) return NSUCCESS;
 #  define einfoStr "pthread_mutex_destroy() failed in nThreadMutexDestroy()."
-    return nErrorAssert(
-     !pthread_mutex_destroy(mutex),
+    const int err = nErrorAssert(
+     !pthread_mutex_destroy(*mutex),
      NERROR_INTERNAL_FAILURE,
      einfoStr,
      NCONST_STR_LEN(einfoStr)
     );
 #  undef einfoStr
+    if (!err) nFree((void **) mutex);
+    return err;
 
 #elif NIMBLE_THREADS == NIMBLE_THREADS_C11
-#  define einfoStr "mtx_destroy() failed in nThreadMutexDestroy()."
-    return nErrorAssert(
-     mtx_destroy(mutex) == thrd_success,
-     NERROR_INTERNAL_FAILURE,
-     einfoStr,
-     NCONST_STR_LEN(einfoStr)
-    );
-#  undef einfoStr
+    if (!*mutex) return NSUCCESS;
+    mtx_destroy(*mutex);
+    nFree((void **) mutex);
+    return NSUCCESS;
 
 #endif
 }
@@ -41,6 +41,316 @@
  * @brief This class defines time functions.
  */
 
-/// @todo Some time functions
+#include "../../include/Nimble/Errors/ErrorValues.h"
+
+#include <string.h>
+
+uint64_t NTIME_TICK_FREQ = NTIME_NS_IN_SEC;
+int NTIME_TICK_COUNTER = 0;
+uint64_t NTIME_TICK_NS_MULT = 1ULL << 32;
+#if NIMBLE_OS == NIMBLE_WINDOWS
+uint64_t NTIME_QPC_FREQ = 0;
+#endif
+
+#if NIMBLE_INST == NIMBLE_INST_x86
+/* Checks for an invariant TSC, which runs at a constant rate in all P-, C-,
+ * and T-states. */
+static int nTimeTSCInvariant(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+     : "a" (0x80000000U), "c" (0));
+    if (eax < 0x80000007U) return 0;
+    asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+     : "a" (0x80000007U), "c" (0));
+    return (edx >> 8) & 1;
+}
+#endif
+
+/* Measures the frequency of the CPU's counter against the monotonic clock. */
+static uint64_t nTimeMeasureTicks(void)
+{
+    uint64_t best = 0;
+    uint64_t bestError = UINT64_MAX;
+    for (int i = 0; i < 3; i++)
+    {
+        /* Bracket each read of the clock with reads of the counter, and keep
+         * the pass where they were closest together. */
+        uint64_t t0 = nTicksRaw();
+        const uint64_t start = nTimeMonotonic();
+        uint64_t t1 = nTicksRaw();
+        nTimeNanoSleep((NTIME_CALIBRATE_MS * NTIME_NS_IN_MS) / 3);
+        uint64_t t2 = nTicksRaw();
+        const uint64_t end = nTimeMonotonic();
+        uint64_t t3 = nTicksRaw();
+
+        const uint64_t nanos = end - start;
+        if (!nanos) continue;
+        const uint64_t error = (t1 - t0) + (t3 - t2);
+        if (error < bestError)
+        {
+            bestError = error;
+            const uint64_t ticks = ((t2 + t3) / 2) - ((t0 + t1) / 2);
+            best = nTimeMulDiv(ticks, NTIME_NS_IN_SEC, nanos);
+        }
+    }
+    return best;
+}
+
+int nTimeCalibrate(void)
+{
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    NTIME_QPC_FREQ = (uint64_t) freq.QuadPart;
+#endif
+
+    uint64_t tickFreq = 0;
+#if NIMBLE_INST == NIMBLE_INST_x86
+    if (nTimeTSCInvariant()) tickFreq = nTimeMeasureTicks();
+#elif defined(__aarch64__)
+    /* The generic timer always runs at the frequency it reports. */
+    asm volatile("mrs %0, cntfrq_el0" : "=r" (tickFreq));
+    if (!tickFreq) tickFreq = nTimeMeasureTicks();
+#endif
+
+    if (tickFreq)
+    {
+        /* Round to the nearest 10 kHz to hide the error of the measurement. */
+        tickFreq = ((tickFreq + 5000) / 10000) * 10000;
+        NTIME_TICK_FREQ = tickFreq;
+        /* A second in nanoseconds shifted by 32 still fits in 64 bits. */
+        NTIME_TICK_NS_MULT = (((uint64_t) NTIME_NS_IN_SEC) << 32) / tickFreq;
+        __atomic_store_n(&NTIME_TICK_COUNTER, 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_store_n(&NTIME_TICK_COUNTER, 0, __ATOMIC_RELEASE);
+        NTIME_TICK_FREQ = NTIME_NS_IN_SEC;
+        NTIME_TICK_NS_MULT = 1ULL << 32;
+    }
+    return NSUCCESS;
+}
+
+void nTimerWheelInit(nTimerWheel_t *const wheel, const uint64_t resolution)
+{
+    memset(wheel->slots, 0, sizeof(wheel->slots));
+    memset(wheel->pending, 0, sizeof(wheel->pending));
+    wheel->tick = 0;
+    wheel->resolution = resolution ? resolution : NTIMER_RESOLUTION;
+    wheel->start = nTimeMonotonic();
+    wheel->count = 0;
+}
+
+/* Adds timer to the slot of the lowest level that its expiry fits in. */
+static void nTimerAdd(nTimerWheel_t *const wheel, nTimer_t *const timer)
+{
+    uint64_t delta = timer->expires - wheel->tick;
+    uint64_t expires = timer->expires;
+    if ((int64_t) delta < 0)
+    {
+        delta = 0;
+        expires = wheel->tick;
+    }
+
+    int level = 0;
+    while ((level < NTIMER_LEVELS - 1) &&
+     (delta >= (1ULL << (NTIMER_LEVEL_BITS * (level + 1)))))
+    {
+        level++;
+    }
+    /* Timers beyond the top level wait in its furthest slot, and are added
+     * again each time it is cascaded. */
+    const uint64_t max = (1ULL << (NTIMER_LEVEL_BITS * NTIMER_LEVELS)) - 1;
+    if (delta > max) expires = wheel->tick + max;
+
+    const int index = (int) ((expires >> (NTIMER_LEVEL_BITS * level)) &
+     (NTIMER_SLOTS - 1));
+    nTimer_t **slot = &wheel->slots[level][index];
+    if (!level) wheel->pending[index / 64] |= 1ULL << (index % 64);
+    timer->next = *slot;
+    if (*slot) (*slot)->pprev = &timer->next;
+    timer->pprev = slot;
+    *slot = timer;
+}
+
+/* Removes timer from its slot. */
+NIMBLE_INLINE
+void nTimerUnlink(nTimer_t *const timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next) timer->next->pprev = timer->pprev;
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+void nTimerSchedule(nTimerWheel_t *const wheel, nTimer_t *const timer,
+ const uint64_t delay, const uint64_t interval)
+{
+    if (timer->pprev) nTimerUnlink(timer);
+    else wheel->count++;
+    timer->expires = wheel->tick + ((delay + wheel->resolution - 1) /
+     wheel->resolution);
+    timer->interval = interval ? (interval + wheel->resolution - 1) /
+     wheel->resolution : 0;
+    nTimerAdd(wheel, timer);
+}
+
+void nTimerCancel(nTimerWheel_t *const wheel, nTimer_t *const timer)
+{
+    timer->interval = 0;
+    if (!timer->pprev) return;
+    nTimerUnlink(timer);
+    wheel->count--;
+}
+
+/* Moves the timers of a slot of a higher level down. Returns the index of the
+ * slot, which is 0 when the next level also needs to be cascaded. */
+static int nTimerCascade(nTimerWheel_t *const wheel, const int level)
+{
+    const int index = (int) ((wheel->tick >> (NTIMER_LEVEL_BITS * level)) &
+     (NTIMER_SLOTS - 1));
+    nTimer_t *timer = wheel->slots[level][index];
+    wheel->slots[level][index] = NULL;
+    while (timer)
+    {
+        nTimer_t *next = timer->next;
+        nTimerAdd(wheel, timer);
+        timer = next;
+    }
+    return index;
+}
+
+/* Gets the first tick from the current one, up to the next cascade, whose slot
+ * of the lowest level may hold timers. Bits of slots emptied by cancelling are
+ * only cleared when their tick is run, so the slot may turn out to be empty. */
+static uint64_t nTimerNextSlot(const nTimerWheel_t *const wheel)
+{
+    const int index = (int) (wheel->tick & (NTIMER_SLOTS - 1));
+    const uint64_t base = wheel->tick - index;
+    for (int word = index / 64; word < NTIMER_SLOTS / 64; word++)
+    {
+        uint64_t bits = wheel->pending[word];
+        if (word == index / 64) bits &= ~0ULL << (index % 64);
+        if (bits) return base + (word * 64) + __builtin_ctzll(bits);
+    }
+    return base + NTIMER_SLOTS;
+}
+
+size_t nTimerWheelAdvance(nTimerWheel_t *const wheel, const uint64_t now)
+{
+    if (now < wheel->start) return 0;
+    const uint64_t target = (now - wheel->start) / wheel->resolution;
+    size_t fired = 0;
+    while (wheel->tick <= target)
+    {
+        if (!wheel->count)
+        {
+            /* Nothing can expire, so skip to the target. */
+            wheel->tick = target + 1;
+            break;
+        }
+
+        const int index = (int) (wheel->tick & (NTIMER_SLOTS - 1));
+        if (!index)
+        {
+            for (int level = 1; (level < NTIMER_LEVELS) &&
+             !nTimerCascade(wheel, level); level++);
+        }
+
+        if (!(wheel->pending[index / 64] & (1ULL << (index % 64))))
+        {
+            /* Skip the empty slots up to the next one with timers, stopping at
+             * the next cascade so the higher levels are moved down. */
+            const uint64_t next = nTimerNextSlot(wheel);
+            wheel->tick = (next <= target) ? next : target + 1;
+            continue;
+        }
+        wheel->pending[index / 64] &= ~(1ULL << (index % 64));
+
+        /* Move the expired timers to a list of their own, so that timers
+         * scheduled by the callbacks are not run until their tick. */
+        nTimer_t *expired = wheel->slots[0][index];
+        wheel->slots[0][index] = NULL;
+        if (expired) expired->pprev = &expired;
+        const uint64_t tick = wheel->tick++;
+
+        nTimer_t *timer;
+        while ((timer = expired))
+        {
+            nTimerUnlink(timer);
+            wheel->count--;
+            fired++;
+            timer->callback(timer, timer->data);
+
+            /* Repeat unless the callback scheduled or cancelled the timer. */
+            if (!timer->pprev && timer->interval)
+            {
+                timer->expires = tick + timer->interval;
+                wheel->count++;
+                nTimerAdd(wheel, timer);
+            }
+        }
+    }
+    return fired;
+}
+
+uint64_t nTimerWheelNextTick(const nTimerWheel_t *const wheel)
+{
+    /* The higher levels are cascaded before the lowest level slot of a tick
+     * that wraps around is checked, so that tick always has work. */
+    const uint64_t tick = (wheel->tick & (NTIMER_SLOTS - 1)) ?
+     nTimerNextSlot(wheel) : wheel->tick;
+    return wheel->start + (tick * wheel->resolution);
+}
+
+/* The expected slice duration is tracked per thread as the mean plus one
+ * standard deviation of the observed durations of previous slices, in
+ * nanoseconds. */
+static __thread double sliceMean = NTIME_SLEEP_SLICE_NS;
+static __thread double sliceM2 = 0;
+static __thread uint64_t sliceCount = 1;
+
+uint64_t nTimeSleepUntil(const uint64_t deadline)
+{
+    uint64_t now = nTimeMonotonic();
+    if (now >= deadline) return 0;
+
+    for (;;)
+    {
+        const double expected = sliceMean + ((sliceCount > 1) ?
+         __builtin_sqrt(sliceM2 / (double) (sliceCount - 1)) : 0);
+        if ((double) (deadline - now) <= expected) break;
+
+        nTimeNanoSleep(NTIME_SLEEP_SLICE_NS);
+        const uint64_t then = nTimeMonotonic();
+        const double duration = (double) (then - now);
+        now = then;
+
+        /* Welford's algorithm, restarted periodically to follow changes of the
+         * scheduler's behavior. */
+        if (sliceCount >= 1000)
+        {
+            sliceCount = 1;
+            sliceM2 = 0;
+        }
+        sliceCount++;
+        const double delta = duration - sliceMean;
+        sliceMean += delta / (double) sliceCount;
+        sliceM2 += delta * (duration - sliceMean);
+        if (now >= deadline) return now - deadline;
+    }
+
+    /* Spin for the rest. */
+    while ((now = nTimeMonotonic()) < deadline)
+    {
+#if NIMBLE_INST == NIMBLE_INST_x86
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+    return now - deadline;
+}
 
 // Time.c
@@ -0,0 +1,363 @@
+#include "../../include/Nimble/NimbleLicense.h"
+/*
+ * Watchdog.c
+ * Nimble Engine
+ *
+ * Created by Avery Aaron on 2026-10-19.
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ */
+
+#include "../../include/Nimble/System/Watchdog.h"
+
+/**
+ * @file Watchdog.c
+ * @author Avery Aaron
+ * @copyright
+ * @parblock
+ * The MIT License (MIT)
+ * Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * @endparblock
+ * @date 2026-10-19
+ *
+ * @brief This class defines the watchdog that reports stalled threads.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if NIMBLE_OS == NIMBLE_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+#include "../../include/Nimble/Errors/Errors.h"
+#include "../../include/Nimble/Errors/Symbols.h"
+#include "../../include/Nimble/Output/Logging.h"
+#include "../../include/Nimble/System/Memory.h"
+#include "../../include/Nimble/System/Threads.h"
+#include "../../include/Nimble/System/Time.h"
+
+#define NWATCHDOG_FREE     0
+#define NWATCHDOG_ACTIVE   1
+#define NWATCHDOG_CHANGING 2 /* The slot is being registered or unregistered. */
+
+#define NWATCHDOG_OK       0
+#define NWATCHDOG_CAPTURE  1 /* The thread was interrupted to capture its stack. */
+#define NWATCHDOG_REPORTED 2
+
+/**
+ * @brief A thread registered with the watchdog.
+ */
+typedef struct nWatchdogThread {
+    volatile uint32_t state; /* The NWATCHDOG_FREE, _ACTIVE or _CHANGING state. */
+    uint32_t stall; /* The NWATCHDOG_OK, _CAPTURE or _REPORTED stall state. */
+    volatile uint64_t heartbeat; /* The nTicks() of the last heartbeat. */
+    uint64_t timeout; /* The nanoseconds allowed between heartbeats. */
+    uint64_t stallBeat; /* The heartbeat that the stall was found after. */
+    uint64_t captureTime; /* The nTicks() that the stack capture began. */
+    volatile uint32_t stackReady; /* Set once stack is written. */
+    volatile uint32_t capturing; /* Set while the watchdog interrupts the thread. */
+    int stackLevels; /* The number of addresses in stack. */
+    void *stack[NWATCHDOG_STACK_MAX]; /* The stack of the stalled thread. */
+    char name[NWATCHDOG_NAME_MAX]; /* The name of the thread. */
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    HANDLE thread; /* A handle to the thread that can suspend it. */
+    const void *stackTop; /* The top of the thread's stack. */
+#else
+    pthread_t thread; /* The thread to signal. */
+#endif
+} nWatchdogThread_t;
+
+static nWatchdogThread_t watchdogThreads[NWATCHDOG_THREADS_MAX];
+static __thread nWatchdogThread_t *watchdogSelf = NULL;
+static volatile int watchdogRunning = 0;
+static nThread_t watchdogThread = NULL;
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+/* Captures the stack of a stalled thread. This only writes to the thread's
+ * preallocated slot, so it is async-signal-safe. */
+static void nWatchdogHandler(int sig, siginfo_t *info, void *context)
+{
+    (void) sig;
+    (void) info;
+    nWatchdogThread_t *const self = watchdogSelf;
+    if (!self || (__atomic_load_n(&self->stackReady, __ATOMIC_ACQUIRE)))
+    {
+        return;
+    }
+    self->stackLevels = nErrorStackWalkContext(context, NULL, self->stack,
+     NWATCHDOG_STACK_MAX);
+    __atomic_store_n(&self->stackReady, 1, __ATOMIC_RELEASE);
+}
+#endif
+
+/* Interrupts a stalled thread to capture its stack. On Windows the thread is
+ * suspended and its stack walked here, so the capture is already done on
+ * return. */
+static void nWatchdogCapture(nWatchdogThread_t *const slot)
+{
+    __atomic_store_n(&slot->stackReady, 0, __ATOMIC_RELEASE);
+
+    /* The thread may be unregistering and exiting, and must not be
+     * interrupted after it has. nWatchdogUnregister() waits for this. */
+    __atomic_store_n(&slot->capturing, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&slot->state, __ATOMIC_SEQ_CST) != NWATCHDOG_ACTIVE)
+    {
+        __atomic_store_n(&slot->capturing, 0, __ATOMIC_RELEASE);
+        return;
+    }
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    if (SuspendThread(slot->thread) != (DWORD) -1)
+    {
+        CONTEXT context;
+        memset(&context, 0, sizeof(context));
+        context.ContextFlags = CONTEXT_FULL;
+        if (GetThreadContext(slot->thread, &context))
+        {
+            slot->stackLevels = nErrorStackWalkContext(&context,
+             slot->stackTop, slot->stack, NWATCHDOG_STACK_MAX);
+            slot->stackReady = 1;
+        }
+        ResumeThread(slot->thread);
+    }
+#else
+    pthread_kill(slot->thread, NWATCHDOG_SIGNAL);
+#endif
+    __atomic_store_n(&slot->capturing, 0, __ATOMIC_RELEASE);
+}
+
+/* Throws the stall of a thread, with its stack if it was captured. */
+static void nWatchdogReport(nWatchdogThread_t *const slot, const uint64_t late)
+{
+    char *stackStr = NULL;
+    size_t stackLen = 0;
+    if (__atomic_load_n(&slot->stackReady, __ATOMIC_ACQUIRE) &&
+     (slot->stackLevels > 0))
+    {
+        stackStr = nErrorStackString(slot->stack, slot->stackLevels, &stackLen);
+    }
+
+#define formatStr "Thread \"%s\" has not sent a watchdog heartbeat for %"\
+ PRIu64 " ms, over its timeout of %" PRIu64 " ms.\n%s"
+    const char *const tailStr = stackStr ? stackStr :
+     "Its stack could not be captured.";
+    const size_t infoLen = NCONST_STR_LEN(formatStr) + NWATCHDOG_NAME_MAX +
+     40 + strlen(tailStr);
+    char *infoStr = nAlloc(infoLen + 1);
+    const int len = snprintf(infoStr, infoLen + 1, formatStr, slot->name,
+     late / NTIME_NS_IN_MS, slot->timeout / NTIME_NS_IN_MS, tailStr);
+#undef formatStr
+    nErrorThrow(NERROR_TIMER, infoStr, (len > 0) ? (size_t) len : 0, 0);
+    nFree((void **) &infoStr);
+    if (stackStr) nFree((void **) &stackStr);
+}
+
+/* Checks the heartbeat of each registered thread. */
+static void nWatchdogCheck(void)
+{
+    const uint64_t now = nTicks();
+    for (size_t i = 0; i < NWATCHDOG_THREADS_MAX; i++)
+    {
+        nWatchdogThread_t *const slot = &watchdogThreads[i];
+        if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) !=
+         NWATCHDOG_ACTIVE) continue;
+
+        const uint64_t heartbeat = __atomic_load_n(&slot->heartbeat,
+         __ATOMIC_RELAXED);
+        if (slot->stall != NWATCHDOG_OK)
+        {
+            if (heartbeat != slot->stallBeat)
+            {
+                if (slot->stall == NWATCHDOG_REPORTED)
+                {
+                    nLog(NLOG_WARN, "Thread \"%s\" recovered after %" PRIu64
+                     " ms without a watchdog heartbeat.", slot->name,
+                     nTicksToNanos(heartbeat - slot->stallBeat) /
+                     NTIME_NS_IN_MS);
+                }
+                slot->stall = NWATCHDOG_OK;
+            }
+            else if ((slot->stall == NWATCHDOG_CAPTURE) &&
+             (__atomic_load_n(&slot->stackReady, __ATOMIC_ACQUIRE) ||
+             (nTicksToNanos(now - slot->captureTime) >=
+             (NWATCHDOG_INTERVAL * NTIME_NS_IN_MS))))
+            {
+                /* A thread that never handles the signal is reported without
+                 * its stack after one interval. */
+                slot->stall = NWATCHDOG_REPORTED;
+                nWatchdogReport(slot, nTicksToNanos(now - heartbeat));
+            }
+            continue;
+        }
+
+        if ((now > heartbeat) && (nTicksToNanos(now - heartbeat) >
+         slot->timeout))
+        {
+            slot->stall = NWATCHDOG_CAPTURE;
+            slot->stallBeat = heartbeat;
+            slot->captureTime = now;
+            nWatchdogCapture(slot);
+        }
+    }
+}
+
+static nThreadRoutine_t nWatchdogRoutine(void *data)
+{
+    (void) data;
+    while (__atomic_load_n(&watchdogRunning, __ATOMIC_ACQUIRE))
+    {
+        nWatchdogCheck();
+        nTimeNanoSleep(NWATCHDOG_INTERVAL * NTIME_NS_IN_MS);
+    }
+    return (nThreadRoutine_t) 0;
+}
+
+int nWatchdogStart(void)
+{
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&watchdogRunning, &expected, 1, 0,
+     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        return NSUCCESS;
+    }
+
+#if NIMBLE_OS != NIMBLE_WINDOWS
+    /* The handler runs on the alternate signal stack where one is set, so a
+     * thread stalled by a stack overflow can still be captured. */
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = nWatchdogHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+    sigemptyset(&sa.sa_mask);
+#  define einfoStr "sigaction() failed in nWatchdogStart()."
+    if (nErrorAssert(
+     !sigaction(NWATCHDOG_SIGNAL, &sa, NULL),
+     NERROR_INTERNAL_FAILURE,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    ))
+    {
+        __atomic_store_n(&watchdogRunning, 0, __ATOMIC_RELEASE);
+        return NERROR_INTERNAL_FAILURE;
+    }
+#  undef einfoStr
+#endif
+
+    const int err = nThreadCreate(&watchdogThread, nWatchdogRoutine, NULL);
+    if (err)
+    {
+        __atomic_store_n(&watchdogRunning, 0, __ATOMIC_RELEASE);
+        return err;
+    }
+    return NSUCCESS;
+}
+
+void nWatchdogStop(void)
+{
+    if (!__atomic_exchange_n(&watchdogRunning, 0, __ATOMIC_ACQ_REL)) return;
+    if (watchdogThread)
+    {
+        nThreadJoin(watchdogThread, NULL);
+        watchdogThread = NULL;
+    }
+}
+
+int nWatchdogRegister(const char *const nameStr, const uint32_t timeout)
+{
+#ifndef NIMBLE_NO_ARG_CHECK
+#  define einfoStr "nameStr argument was NULL in nWatchdogRegister()."
+    if (nErrorAssert(
+     nameStr != NULL,
+     NERROR_NULL,
+     einfoStr,
+     NCONST_STR_LEN(einfoStr)
+    )) return NERROR_NULL;
+#  undef einfoStr
+#endif
+    if (watchdogSelf) return NERROR_WARN;
+
+    for (size_t i = 0; i < NWATCHDOG_THREADS_MAX; i++)
+    {
+        nWatchdogThread_t *const slot = &watchdogThreads[i];
+        uint32_t expected = NWATCHDOG_FREE;
+        /* Claim the slot, but keep the watchdog from checking it until it is
+         * filled in. */
+        if (!__atomic_compare_exchange_n(&slot->state, &expected,
+         NWATCHDOG_CHANGING, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            continue;
+        }
+
+        strncpy(slot->name, nameStr, NWATCHDOG_NAME_MAX - 1);
+        slot->name[NWATCHDOG_NAME_MAX - 1] = '\0';
+        slot->timeout = (uint64_t) (timeout ? timeout : NWATCHDOG_TIMEOUT) *
+         NTIME_NS_IN_MS;
+        slot->stall = NWATCHDOG_OK;
+        slot->stackReady = 0;
+        slot->heartbeat = nTicks();
+        if (!nErrorStackTop()) nErrorStackRegister();
+#if NIMBLE_OS == NIMBLE_WINDOWS
+        slot->thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT,
+         FALSE, GetCurrentThreadId());
+        slot->stackTop = nErrorStackTop();
+#else
+        slot->thread = pthread_self();
+#endif
+        watchdogSelf = slot;
+        __atomic_store_n(&slot->state, NWATCHDOG_ACTIVE, __ATOMIC_RELEASE);
+        return NSUCCESS;
+    }
+
+#define einfoStr "Too many threads were registered in nWatchdogRegister()."
+    nErrorThrow(NERROR_OVERFLOW, einfoStr, NCONST_STR_LEN(einfoStr), 0);
+#undef einfoStr
+    return NERROR_OVERFLOW;
+}
+
+void nWatchdogUnregister(void)
+{
+    nWatchdogThread_t *const slot = watchdogSelf;
+    if (!slot) return;
+    __atomic_store_n(&slot->state, NWATCHDOG_CHANGING, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&slot->capturing, __ATOMIC_SEQ_CST))
+    {
+        nTimeNanoSleep(NTIME_NS_IN_US);
+    }
+    watchdogSelf = NULL;
+#if NIMBLE_OS == NIMBLE_WINDOWS
+    if (slot->thread) CloseHandle(slot->thread);
+    slot->thread = NULL;
+#endif
+    __atomic_store_n(&slot->state, NWATCHDOG_FREE, __ATOMIC_RELEASE);
+}
+
+void nWatchdogHeartbeat(void)
+{
+    nWatchdogThread_t *const slot = watchdogSelf;
+    if (slot) __atomic_store_n(&slot->heartbeat, nTicks(), __ATOMIC_RELAXED);
+}
+
+// Watchdog.c
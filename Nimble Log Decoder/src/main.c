@@ -0,0 +1,623 @@
+/*
+*  main.c
+*  Nimble Engine
+*
+*  Created by Avery Aaron on 2020-08-09.
+*  Copyright (C) 2020-2021 Avery Aaron <business.AiLovesAi@gmail.com>
+*
+*/
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <Nimble/Output/Logging.h>
+
+
+#define FOLLOW_INTERVAL 200 /* Milliseconds to wait for more of a followed file. */
+#define THREADS_MAX 64 /* The maximum number of --thread filters. */
+#define CHUNK_MAX (1 << 24) /* Chunks larger than this are treated as corrupt. */
+#define NS_IN_SEC UINT64_C(1000000000) /* Nanoseconds in a second. */
+#define NS_IN_MS UINT64_C(1000000) /* Nanoseconds in a millisecond. */
+
+static const char *const levelStrs[] = {
+    "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL"
+};
+
+/**
+ * @brief The options given on the command line.
+ */
+typedef struct options {
+    const char *pathStr;
+    int level;
+    uint32_t threads[THREADS_MAX];
+    int threadCount;
+    uint64_t since; /* Nanoseconds since the epoch, or 0. */
+    uint64_t until; /* Nanoseconds since the epoch, or UINT64_MAX. */
+    int follow;
+} options_t;
+
+/**
+ * @brief The format strings of the current session.
+ */
+typedef struct formats {
+    char **strs;
+    uint32_t count;
+} formats_t;
+
+/**
+ * @brief A record read from the file.
+ */
+typedef struct record {
+    nLogRecordChunk_t header;
+    const uint8_t *types;
+    const uint8_t *data;
+} record_t;
+
+
+static void sleepMillis(const unsigned millis)
+{
+#ifdef _WIN32
+    Sleep(millis);
+#else
+    struct timespec time = {
+        .tv_sec = millis / 1000,
+        .tv_nsec = (long) (millis % 1000) * 1000000L
+    };
+    nanosleep(&time, NULL);
+#endif
+}
+
+static void usage(const char *const nameStr)
+{
+    fprintf(stderr, "Usage: %s [options] <file>\n"
+     "  -l, --level <level>  Only show records of at least this level (trace, "
+     "debug, info, warn, error, fatal).\n"
+     "  -t, --thread <n>     Only show records of thread n. May be given more "
+     "than once.\n"
+     "  -s, --since <time>   Only show records at or after the time.\n"
+     "  -u, --until <time>   Only show records before the time.\n"
+     "  -f, --follow         Keep reading records as they are appended to the "
+     "file.\n"
+     "Times are seconds since the epoch, or local times in the form "
+     "YYYY-MM-DD[ HH:MM[:SS]].\n", nameStr);
+}
+
+/* Parses a level name or number. Returns -1 if it is invalid. */
+static int parseLevel(const char *const str)
+{
+    static const char *const names[] = {
+        "trace", "debug", "info", "warn", "error", "fatal"
+    };
+    for (int i = 0; i <= NLOG_FATAL; i++)
+    {
+        if (!strcmp(str, names[i])) return i;
+    }
+    char *end;
+    const long level = strtol(str, &end, 10);
+    if (*end || (end == str) || (level < NLOG_TRACE) || (level > NLOG_FATAL))
+    {
+        return -1;
+    }
+    return (int) level;
+}
+
+/* Parses a time to nanoseconds since the epoch. Returns 0 if it is invalid. */
+static int parseTime(const char *const str, uint64_t *const time)
+{
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    int count = sscanf(str, "%d-%d-%d%*[ T]%d:%d:%d", &tm.tm_year, &tm.tm_mon,
+     &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+    if (count >= 3)
+    {
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        tm.tm_isdst = -1;
+        const time_t secs = mktime(&tm);
+        if (secs == (time_t) -1) return 0;
+        *time = (uint64_t) secs * NS_IN_SEC;
+        return 1;
+    }
+
+    char *end;
+    const unsigned long long secs = strtoull(str, &end, 10);
+    if (*end || (end == str)) return 0;
+    *time = (uint64_t) secs * NS_IN_SEC;
+    return 1;
+}
+
+static int parseOptions(const int argc, char **argv, options_t *const options)
+{
+    options->pathStr = NULL;
+    options->level = NLOG_TRACE;
+    options->threadCount = 0;
+    options->since = 0;
+    options->until = UINT64_MAX;
+    options->follow = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "-f") || !strcmp(arg, "--follow"))
+        {
+            options->follow = 1;
+            continue;
+        }
+        if (!strcmp(arg, "-h") || !strcmp(arg, "--help")) return 0;
+        if ((arg[0] != '-') || !arg[1])
+        {
+            if (options->pathStr) return 0;
+            options->pathStr = arg;
+            continue;
+        }
+        if (!value)
+        {
+            fprintf(stderr, "Missing value of %s.\n", arg);
+            return 0;
+        }
+        i++;
+
+        if (!strcmp(arg, "-l") || !strcmp(arg, "--level"))
+        {
+            options->level = parseLevel(value);
+            if (options->level < 0)
+            {
+                fprintf(stderr, "Invalid level: %s\n", value);
+                return 0;
+            }
+        }
+        else if (!strcmp(arg, "-t") || !strcmp(arg, "--thread"))
+        {
+            if (options->threadCount >= THREADS_MAX) return 0;
+            /* Accept the T prefix records are printed with. */
+            const char *num = ((value[0] == 'T') || (value[0] == 't')) ?
+             value + 1 : value;
+            char *end;
+            const unsigned long thread = strtoul(num, &end, 10);
+            if (*end || (end == num))
+            {
+                fprintf(stderr, "Invalid thread: %s\n", value);
+                return 0;
+            }
+            options->threads[options->threadCount++] = (uint32_t) thread;
+        }
+        else if (!strcmp(arg, "-s") || !strcmp(arg, "--since"))
+        {
+            if (!parseTime(value, &options->since))
+            {
+                fprintf(stderr, "Invalid time: %s\n", value);
+                return 0;
+            }
+        }
+        else if (!strcmp(arg, "-u") || !strcmp(arg, "--until"))
+        {
+            if (!parseTime(value, &options->until))
+            {
+                fprintf(stderr, "Invalid time: %s\n", value);
+                return 0;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return 0;
+        }
+    }
+    return options->pathStr != NULL;
+}
+
+static int threadMatches(const options_t *const options, const uint32_t thread)
+{
+    if (!options->threadCount) return 1;
+    for (int i = 0; i < options->threadCount; i++)
+    {
+        if (options->threads[i] == thread) return 1;
+    }
+    return 0;
+}
+
+static int recordMatches(const options_t *const options,
+ const uint64_t time, const int level, const uint32_t thread)
+{
+    return (level >= options->level) && (time >= options->since) &&
+     (time < options->until) && threadMatches(options, thread);
+}
+
+/* Prints the time, level, and thread prefix of a record. */
+static void printPrefix(const uint64_t time, const char *const levelStr,
+ const uint32_t thread)
+{
+    const time_t secs = (time_t) (time / NS_IN_SEC);
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &secs);
+#else
+    localtime_r(&secs, &tm);
+#endif
+    char timeStr[32];
+    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &tm);
+    printf("[%s.%03u] [%s] [T%" PRIu32 "] ", timeStr,
+     (unsigned) ((time % NS_IN_SEC) / NS_IN_MS), levelStr, thread);
+}
+
+/* Reads the argument at *offset of record, and advances the offset. */
+static int recordArg(const record_t *const record, const int index,
+ size_t *const offset, uint64_t *const num, const char **str,
+ size_t *const strLen)
+{
+    if (index >= record->header.argc) return 0;
+    const uint8_t type = record->types[index];
+    if (type == NLOG_TYPE_STR)
+    {
+        uint16_t len;
+        if (*offset + sizeof(uint16_t) > record->header.len) return 0;
+        memcpy(&len, record->data + *offset, sizeof(uint16_t));
+        if (*offset + sizeof(uint16_t) + len > record->header.len) return 0;
+        *str = (const char *) record->data + *offset + sizeof(uint16_t);
+        *strLen = len;
+        *offset += sizeof(uint16_t) + len;
+    }
+    else
+    {
+        if (*offset + sizeof(uint64_t) > record->header.len) return 0;
+        memcpy(num, record->data + *offset, sizeof(uint64_t));
+        *offset += sizeof(uint64_t);
+    }
+    return type;
+}
+
+/**
+ * @brief Prints the message of @p record.
+ *
+ * This converts the format string one specification at a time the same way
+ * the logging thread does.
+ */
+static void printMessage(const record_t *const record, const char *format)
+{
+    size_t offset = 0;
+    int arg = 0;
+    while (*format)
+    {
+        const char *spec = strchr(format, '%');
+        if (!spec)
+        {
+            fputs(format, stdout);
+            break;
+        }
+        fwrite(format, 1, spec - format, stdout);
+
+        /* Copy the flags, width, and precision, and skip the length. */
+        char specStr[64];
+        size_t specLen = 0;
+        const char *ptr = spec + 1;
+        specStr[specLen++] = '%';
+        while (*ptr && strchr("-+ #0'", *ptr) && (specLen < 16))
+        {
+            specStr[specLen++] = *ptr++;
+        }
+        for (int part = 0; part < 2; part++)
+        {
+            if (part)
+            {
+                if (*ptr != '.') break;
+                specStr[specLen++] = *ptr++;
+            }
+            if (*ptr == '*')
+            {
+                uint64_t num = 0;
+                const char *str;
+                size_t strLen;
+                recordArg(record, arg++, &offset, &num, &str, &strLen);
+                specLen += snprintf(specStr + specLen, 16, "%d", (int) num);
+                ptr++;
+            }
+            else
+            {
+                while ((*ptr >= '0') && (*ptr <= '9') && (specLen < 40))
+                {
+                    specStr[specLen++] = *ptr++;
+                }
+            }
+        }
+        while (*ptr && strchr("hlLqjzt", *ptr)) ptr++;
+        const char conv = *ptr;
+        if (conv) ptr++;
+        format = ptr;
+
+        if (conv == '%')
+        {
+            putchar('%');
+            continue;
+        }
+        if (!conv || (conv == 'n')) continue;
+
+        uint64_t num = 0;
+        const char *str = NULL;
+        size_t strLen = 0;
+        const int type = recordArg(record, arg++, &offset, &num, &str, &strLen);
+        if (!type || ((type == NLOG_TYPE_STR) && (conv != 's') &&
+         (conv != 'p')))
+        {
+            fputs("(?)", stdout);
+            continue;
+        }
+
+        switch (conv)
+        {
+            case 's':
+            {
+                if (type != NLOG_TYPE_STR)
+                {
+                    fputs("(?)", stdout);
+                    break;
+                }
+                const char *dot = memchr(specStr, '.', specLen);
+                size_t len = strLen;
+                if (dot)
+                {
+                    const size_t precision = strtoul(dot + 1, NULL, 10);
+                    if (precision < len) len = precision;
+                    specLen = dot - specStr;
+                }
+                memcpy(specStr + specLen, ".*s", 4);
+                printf(specStr, (int) len, str);
+                break;
+            }
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            case 'c':
+                if (type == NLOG_TYPE_F64)
+                {
+                    double f64;
+                    memcpy(&f64, &num, sizeof(double));
+                    num = (uint64_t) (int64_t) f64;
+                }
+                if (conv == 'c')
+                {
+                    specStr[specLen++] = 'c';
+                    specStr[specLen] = '\0';
+                    printf(specStr, (int) num);
+                }
+                else
+                {
+                    specStr[specLen++] = 'l';
+                    specStr[specLen++] = 'l';
+                    specStr[specLen++] = conv;
+                    specStr[specLen] = '\0';
+                    printf(specStr, (long long) num);
+                }
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            case 'a': case 'A':
+            {
+                double f64;
+                if (type == NLOG_TYPE_F64) memcpy(&f64, &num, sizeof(double));
+                else if (type == NLOG_TYPE_I64) f64 = (double) (int64_t) num;
+                else f64 = (double) num;
+                specStr[specLen++] = conv;
+                specStr[specLen] = '\0';
+                printf(specStr, f64);
+                break;
+            }
+            case 'p':
+                if (type == NLOG_TYPE_STR) printf("%.*s", (int) strLen, str);
+                else printf("0x%" PRIx64, num);
+                break;
+            default:
+                fputs("(?)", stdout);
+                break;
+        }
+    }
+    putchar('\n');
+}
+
+static void formatsClear(formats_t *const formats)
+{
+    for (uint32_t i = 0; i < formats->count; i++) free(formats->strs[i]);
+    free(formats->strs);
+    formats->strs = NULL;
+    formats->count = 0;
+}
+
+static int formatsSet(formats_t *const formats, const uint32_t id,
+ const char *const str, const size_t len)
+{
+    if (id >= formats->count)
+    {
+        char **strs = realloc(formats->strs, sizeof(char *) * (id + 1));
+        if (!strs) return 0;
+        memset(strs + formats->count, 0,
+         sizeof(char *) * (id + 1 - formats->count));
+        formats->strs = strs;
+        formats->count = id + 1;
+    }
+    free(formats->strs[id]);
+    formats->strs[id] = malloc(len + 1);
+    if (!formats->strs[id]) return 0;
+    memcpy(formats->strs[id], str, len);
+    formats->strs[id][len] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Handles a chunk of the file.
+ * @return Zero is returned if the file can not be decoded further.
+ */
+static int decodeChunk(const options_t *const options, formats_t *const formats,
+ const nLogChunk_t *const chunk, const uint8_t *const data)
+{
+    switch (chunk->kind)
+    {
+        case NLOG_CHUNK_SESSION:
+        {
+            nLogSessionChunk_t session;
+            if (chunk->len < sizeof(session)) return 0;
+            memcpy(&session, data, sizeof(session));
+            if (memcmp(session.magic, NLOG_BINARY_MAGIC, sizeof(session.magic)))
+            {
+                fprintf(stderr, "%s is not a binary log file.\n",
+                 options->pathStr);
+                return 0;
+            }
+            if (session.order != NLOG_BINARY_ORDER)
+            {
+                fprintf(stderr, "%s was written with a different byte order.\n",
+                 options->pathStr);
+                return 0;
+            }
+            if (session.version != NLOG_BINARY_VERSION)
+            {
+                fprintf(stderr, "%s has unsupported version %" PRIu32 ".\n",
+                 options->pathStr, session.version);
+                return 0;
+            }
+            formatsClear(formats);
+            return 1;
+        }
+        case NLOG_CHUNK_FORMAT:
+        {
+            uint32_t id;
+            if (chunk->len < sizeof(id)) return 0;
+            memcpy(&id, data, sizeof(id));
+            if (id >= CHUNK_MAX) return 0;
+            return formatsSet(formats, id, (const char *) data + sizeof(id),
+             chunk->len - sizeof(id));
+        }
+        case NLOG_CHUNK_RECORD:
+        {
+            record_t record;
+            if (chunk->len < sizeof(record.header)) return 1;
+            memcpy(&record.header, data, sizeof(record.header));
+            if (chunk->len != sizeof(record.header) + record.header.argc +
+             record.header.len)
+            {
+                return 1;
+            }
+            record.types = data + sizeof(record.header);
+            record.data = record.types + record.header.argc;
+            if (!recordMatches(options, record.header.time, record.header.level,
+             record.header.thread))
+            {
+                return 1;
+            }
+
+            printPrefix(record.header.time, (record.header.level <= NLOG_FATAL)
+             ? levelStrs[record.header.level] : "?????", record.header.thread);
+            if ((record.header.format < formats->count) &&
+             formats->strs[record.header.format])
+            {
+                printMessage(&record, formats->strs[record.header.format]);
+            }
+            else
+            {
+                printf("(Unknown format %" PRIu32 ")\n", record.header.format);
+            }
+            return 1;
+        }
+        case NLOG_CHUNK_DROPPED:
+        {
+            nLogDroppedChunk_t dropped;
+            if (chunk->len < sizeof(dropped)) return 1;
+            memcpy(&dropped, data, sizeof(dropped));
+            if (!threadMatches(options, dropped.thread)) return 1;
+            printf("[Dropped %" PRIu64 " log records of thread T%" PRIu32
+             ", as its ring was full.]\n", dropped.count, dropped.thread);
+            return 1;
+        }
+        default:
+            /* Skip chunks added by later versions. */
+            return 1;
+    }
+}
+
+/**
+ * @brief Reads exactly @p size bytes, waiting for them to be written when
+ * following the file.
+ * @return Zero is returned at the end of the file.
+ */
+static int readFully(const options_t *const options, FILE *const file,
+ void *const dst, const size_t size)
+{
+    size_t got = 0;
+    while (got < size)
+    {
+        got += fread((uint8_t *) dst + got, 1, size - got, file);
+        if (got == size) break;
+        if (ferror(file) || !options->follow) return 0;
+        /* Wait for the rest of the chunk. */
+        fflush(stdout);
+        clearerr(file);
+        sleepMillis(FOLLOW_INTERVAL);
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    options_t options;
+    if (!parseOptions(argc, argv, &options))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *file = fopen(options.pathStr, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open %s.\n", options.pathStr);
+        return EXIT_FAILURE;
+    }
+
+    formats_t formats = {.strs = NULL, .count = 0};
+    uint8_t *data = NULL;
+    size_t dataCap = 0;
+    int ret = EXIT_SUCCESS;
+    int started = 0;
+    nLogChunk_t chunk;
+    while (readFully(&options, file, &chunk, sizeof(chunk)))
+    {
+        if ((chunk.len > CHUNK_MAX) ||
+         (!started && (chunk.kind != NLOG_CHUNK_SESSION)))
+        {
+            fprintf(stderr, "%s is corrupt.\n", options.pathStr);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        started = 1;
+        if (chunk.len > dataCap)
+        {
+            uint8_t *newData = realloc(data, chunk.len);
+            if (!newData)
+            {
+                ret = EXIT_FAILURE;
+                break;
+            }
+            data = newData;
+            dataCap = chunk.len;
+        }
+        if (!readFully(&options, file, data, chunk.len)) break;
+        if (!decodeChunk(&options, &formats, &chunk, data))
+        {
+            ret = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    formatsClear(&formats);
+    free(data);
+    fclose(file);
+    return ret;
+}
+
+// main.c